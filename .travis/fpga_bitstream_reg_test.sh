@@ -23,4 +23,23 @@ python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/generate_bitstream
 echo -e "Testing loading architecture bitstream from an external file";
 python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/load_external_architecture_bitstream --debug --show_thread_logs
 
+echo -e "Testing bitstream generation with multiple threads";
+./build/libopenfpga/libfpgabitstream/test_bitstream_fragment
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/multithread_bitstream --debug --show_thread_logs
+# The bitstream built with multiple threads should be the same as the one built in a single thread
+diff -I "Date:" openfpga_flow/tasks/fpga_bitstream/multithread_bitstream/latest/k6_frac_N10_tileable_adder_register_scan_chain_depop50_40nm/and2/MIN_ROUTE_CHAN_WIDTH/arch_bitstream_1_thread.xml openfpga_flow/tasks/fpga_bitstream/multithread_bitstream/latest/k6_frac_N10_tileable_adder_register_scan_chain_depop50_40nm/and2/MIN_ROUTE_CHAN_WIDTH/arch_bitstream_4_threads.xml
+
+echo -e "Testing incremental bitstream generation when the architecture is unchanged";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/incremental_bitstream/tree_mux --debug --show_thread_logs
+# All the tiles of the previous bitstream should be reused, resulting in the same bitstream as a full build
+grep "rebuilt 0 tiles" openfpga_flow/tasks/fpga_bitstream/incremental_bitstream/tree_mux/latest/k6_frac_N10_tileable_40nm/and2/MIN_ROUTE_CHAN_WIDTH/openfpgashell.log
+diff -I "Date:" openfpga_flow/tasks/fpga_bitstream/incremental_bitstream/tree_mux/latest/k6_frac_N10_tileable_40nm/and2/MIN_ROUTE_CHAN_WIDTH/full_arch_bitstream.xml openfpga_flow/tasks/fpga_bitstream/incremental_bitstream/tree_mux/latest/k6_frac_N10_tileable_40nm/and2/MIN_ROUTE_CHAN_WIDTH/arch_bitstream.xml
+
+echo -e "Testing incremental bitstream generation when the architecture is changed";
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_bitstream/incremental_bitstream/stdcell_mux --debug --show_thread_logs
+# No tile of the previous bitstream should be reused
+grep "Fabric or architecture is changed since the previous run" openfpga_flow/tasks/fpga_bitstream/incremental_bitstream/stdcell_mux/latest/k6_frac_N10_tileable_40nm/and2/MIN_ROUTE_CHAN_WIDTH/openfpgashell.log
+grep "Reused the bitstream of 0 tiles" openfpga_flow/tasks/fpga_bitstream/incremental_bitstream/stdcell_mux/latest/k6_frac_N10_tileable_40nm/and2/MIN_ROUTE_CHAN_WIDTH/openfpgashell.log
+diff -I "Date:" openfpga_flow/tasks/fpga_bitstream/incremental_bitstream/stdcell_mux/latest/k6_frac_N10_tileable_40nm/and2/MIN_ROUTE_CHAN_WIDTH/full_arch_bitstream.xml openfpga_flow/tasks/fpga_bitstream/incremental_bitstream/stdcell_mux/latest/k6_frac_N10_tileable_40nm/and2/MIN_ROUTE_CHAN_WIDTH/arch_bitstream.xml
+
 end_section "OpenFPGA.TaskTun"
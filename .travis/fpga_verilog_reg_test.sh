@@ -74,6 +74,11 @@ echo -e "Testing Secured FPGA fabrics";
 python3 openfpga_flow/scripts/run_fpga_task.py fpga_verilog/fabric_key/generate_vanilla_key --debug --show_thread_logs
 python3 openfpga_flow/scripts/run_fpga_task.py fpga_verilog/fabric_key/generate_random_key --debug --show_thread_logs
 python3 openfpga_flow/scripts/run_fpga_task.py fpga_verilog/fabric_key/load_external_key --debug --show_thread_logs
+python3 openfpga_flow/scripts/run_fpga_task.py fpga_verilog/fabric_key/load_external_binary_key --debug --show_thread_logs
+# The fabric built from the binary fabric key should be the same as the one built from the XML fabric key
+cmp openfpga_flow/tasks/fpga_verilog/fabric_key/load_external_binary_key/latest/k4_N4_tileable_40nm/and2/MIN_ROUTE_CHAN_WIDTH/fabric_key.bin openfpga_flow/fabric_keys/k4_N4_2x2_sample_key.bin
+diff -I "Date:" openfpga_flow/tasks/fpga_verilog/fabric_key/load_external_key/latest/k4_N4_tileable_40nm/and2/MIN_ROUTE_CHAN_WIDTH/fabric_bitstream.xml openfpga_flow/tasks/fpga_verilog/fabric_key/load_external_binary_key/latest/k4_N4_tileable_40nm/and2/MIN_ROUTE_CHAN_WIDTH/fabric_bitstream.xml
+diff -r -I "Date:" openfpga_flow/tasks/fpga_verilog/fabric_key/load_external_key/latest/k4_N4_tileable_40nm/and2/MIN_ROUTE_CHAN_WIDTH/SRC openfpga_flow/tasks/fpga_verilog/fabric_key/load_external_binary_key/latest/k4_N4_tileable_40nm/and2/MIN_ROUTE_CHAN_WIDTH/SRC
 
 echo -e "Testing Power-gating designs";
 python3 openfpga_flow/scripts/run_fpga_task.py fpga_verilog/power_gated_design/power_gated_inverter --show_thread_logs --debug
@@ -584,17 +584,11 @@ size_t CircuitLibrary::num_model_ports_by_type(const CircuitModelId& model_id,
   VTR_ASSERT(valid_model_id(model_id));
   /* Search the port look up */
   VTR_ASSERT(port_type < model_port_lookup_[model_id].size());
-  size_t num_ports = 0;
-  for (auto port : model_port_lookup_[model_id][port_type]) {
-    /* By pass non-global ports if required by user */
-    if ( (false == include_global_port)
-     &&  (true == port_is_global(port)) ) {
-      continue;
-    }
-    num_ports++;
-  } 
-
-  return num_ports;
+  /* By pass non-global ports if required by user */
+  if (false == include_global_port) {
+    return model_non_global_port_lookup_[model_id][port_type].size();
+  }
+  return model_port_lookup_[model_id][port_type].size();
 }
 
 /* Find all the ports belong to a circuit model */
@@ -759,39 +753,26 @@ std::vector<CircuitPortId> CircuitLibrary::model_global_ports_by_type(const Circ
 }
 
 /* Find the ports of a circuit model by a given type, return a list of qualified ports */
-std::vector<CircuitPortId> CircuitLibrary::model_ports_by_type(const CircuitModelId& model_id, 
-                                                               const enum e_circuit_model_port_type& type) const {
-  std::vector<CircuitPortId> port_ids;
-  for (const auto& port_id : model_ports(model_id)) {
-    /* We skip unmatched ports */
-    if ( type != port_type(port_id) ) {
-      continue; 
-    }
-    port_ids.push_back(port_id);
-  } 
-  return port_ids;
+const std::vector<CircuitPortId>& CircuitLibrary::model_ports_by_type(const CircuitModelId& model_id, 
+                                                                      const enum e_circuit_model_port_type& type) const {
+  /* validate the model_id */
+  VTR_ASSERT(valid_model_id(model_id));
+  return model_port_lookup_[model_id][type];
 }
 
 /* Find the ports of a circuit model by a given type, return a list of qualified ports 
  * with an option to include/exclude global ports
  */
-std::vector<CircuitPortId> CircuitLibrary::model_ports_by_type(const CircuitModelId& model_id, 
-                                                               const enum e_circuit_model_port_type& type,
-                                                               const bool& ignore_global_port) const {
-  std::vector<CircuitPortId> port_ids;
-  for (const auto& port_id : model_port_lookup_[model_id][type]) {
-    /* We skip unmatched ports */
-    if ( type != port_type(port_id) ) {
-      continue; 
-    }
-    /* We skip global ports if specified. Note: I/O port should be kept */
-    if ( (true == ignore_global_port)
-      && (true == port_is_global(port_id)) ) {
-      continue; 
-    }
-    port_ids.push_back(port_id);
-  } 
-  return port_ids;
+const std::vector<CircuitPortId>& CircuitLibrary::model_ports_by_type(const CircuitModelId& model_id, 
+                                                                      const enum e_circuit_model_port_type& type,
+                                                                      const bool& ignore_global_port) const {
+  /* validate the model_id */
+  VTR_ASSERT(valid_model_id(model_id));
+  /* We skip global ports if specified. Note: I/O port should be kept */
+  if (true == ignore_global_port) {
+    return model_non_global_port_lookup_[model_id][type];
+  }
+  return model_port_lookup_[model_id][type];
 }
 
 /* Create a vector for all the ports whose directionality is input
@@ -1066,23 +1047,11 @@ CircuitModelId CircuitLibrary::model(const char* name) const {
 
 /* Find a circuit model by a given name and return its id */
 CircuitModelId CircuitLibrary::model(const std::string& name) const { 
-  CircuitModelId ret = CircuitModelId::INVALID();
-  size_t num_found = 0;
-  for (circuit_model_string_iterator it = model_names_.begin();
-       it != model_names_.end();
-       it++) {
-    /* Bypass unmatched names */
-    if ( 0 != name.compare(*it) ) {
-      continue;
-    }
-    /* Find one and record it 
-     * FIXME: I feel that we may have a better way in getting the CircuitModelId
-     */
-    ret = CircuitModelId(it - model_names_.begin()); 
-    num_found++;
+  std::unordered_map<std::string, CircuitModelId>::const_iterator it = model_name_lookup_.find(name);
+  if (it == model_name_lookup_.end()) {
+    return CircuitModelId::INVALID();
   }
-  VTR_ASSERT((0 == num_found) || (1 == num_found));
-  return ret;
+  return it->second;
 }
 
 /* Get the CircuitModelId of a default circuit model with a given type */
@@ -1195,8 +1164,9 @@ CircuitModelId CircuitLibrary::add_model(const enum e_circuit_model_type& type)
   wire_rc_.emplace_back();
   wire_num_levels_.push_back(-1);
 
-  /* Build the fast look-up for circuit models */
+  /* Build the fast look-up for circuit models and their ports */
   build_model_lookup();
+  build_model_port_lookup();
 
   return model_id;
 }
@@ -1205,6 +1175,17 @@ CircuitModelId CircuitLibrary::add_model(const enum e_circuit_model_type& type)
 void CircuitLibrary::set_model_name(const CircuitModelId& model_id, const std::string& name) {
   /* validate the model_id */
   VTR_ASSERT(valid_model_id(model_id));
+  /* Update the fast look-up by names.
+   * If any name is shared by multiple models, the first model is kept,
+   * which will be reported by the checker of circuit library 
+   */
+  std::unordered_map<std::string, CircuitModelId>::iterator it = model_name_lookup_.find(model_names_[model_id]);
+  if ( (it != model_name_lookup_.end())
+    && (model_id == it->second) ) {
+    model_name_lookup_.erase(it);
+  }
+  model_name_lookup_.emplace(name, model_id);
+
   model_names_[model_id] = name;
   return;
 }
@@ -1462,6 +1443,8 @@ void CircuitLibrary::set_port_is_global(const CircuitPortId& circuit_port_id,
   /* validate the circuit_port_id */
   VTR_ASSERT(valid_circuit_port_id(circuit_port_id));
   port_is_global_[circuit_port_id] = is_global;
+  /* Global ports are excluded in the fast look-up */
+  build_model_port_lookup();
   return;
 }
 
@@ -2305,13 +2288,18 @@ void CircuitLibrary::build_model_port_lookup() {
   invalidate_model_port_lookup();
   /* Classify circuit models by type */
   model_port_lookup_.resize(model_ids_.size());
+  model_non_global_port_lookup_.resize(model_ids_.size());
   for (const auto& model_id : model_ids_) {
     model_port_lookup_[model_id].resize(NUM_CIRCUIT_MODEL_PORT_TYPES);
+    model_non_global_port_lookup_[model_id].resize(NUM_CIRCUIT_MODEL_PORT_TYPES);
   }
   /* Walk through models and categorize */
   for (const auto& port : port_ids_) {
     CircuitModelId model_id = port_model_ids_[port];
     model_port_lookup_[model_id][port_type(port)].push_back(port);
+    if (false == port_is_global(port)) {
+      model_non_global_port_lookup_[model_id][port_type(port)].push_back(port);
+    }
   }
   return;
 }
@@ -2371,6 +2359,7 @@ void CircuitLibrary::invalidate_model_lookup() const {
 /* Empty fast lookup for circuit ports for a model */
 void CircuitLibrary::invalidate_model_port_lookup() const {
   model_port_lookup_.clear();
+  model_non_global_port_lookup_.clear();
   return;
 }
 
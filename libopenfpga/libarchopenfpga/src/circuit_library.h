@@ -13,6 +13,7 @@
 /* Header files should be included in a sequence */
 /* Standard header files required go first */
 #include <string>
+#include <unordered_map>
 
 #include "vtr_geometry.h"
 
@@ -264,8 +265,9 @@ class CircuitLibrary {
                                                           const bool& recursive,
                                                           const bool& ignore_config_memories) const;
 
-    std::vector<CircuitPortId> model_ports_by_type(const CircuitModelId& model_id, const enum e_circuit_model_port_type& port_type) const;
-    std::vector<CircuitPortId> model_ports_by_type(const CircuitModelId& model_id, const enum e_circuit_model_port_type& port_type, const bool& include_global_port) const;
+    /* The port lists are cached in the library and remain valid until any port is added or modified */
+    const std::vector<CircuitPortId>& model_ports_by_type(const CircuitModelId& model_id, const enum e_circuit_model_port_type& port_type) const;
+    const std::vector<CircuitPortId>& model_ports_by_type(const CircuitModelId& model_id, const enum e_circuit_model_port_type& port_type, const bool& ignore_global_port) const;
     std::vector<CircuitPortId> model_input_ports(const CircuitModelId& model_id) const;
     std::vector<CircuitPortId> model_output_ports(const CircuitModelId& model_id) const;
     std::vector<size_t> pins(const CircuitPortId& circuit_port_id) const;
@@ -509,6 +511,10 @@ class CircuitLibrary {
     mutable CircuitModelLookup model_lookup_; /* [model_type][model_ids] */
     typedef vtr::vector<CircuitModelId, std::vector<std::vector<CircuitPortId>>> CircuitModelPortLookup;
     mutable CircuitModelPortLookup model_port_lookup_; /* [model_id][port_type][port_ids] */
+    mutable CircuitModelPortLookup model_non_global_port_lookup_; /* [model_id][port_type][port_ids] excluding global ports */
+
+    /* fast look-up for circuit models by names, which is updated when a model is named */
+    std::unordered_map<std::string, CircuitModelId> model_name_lookup_;
 
     /* Verilog generator options */ 
     vtr::vector<CircuitModelId, bool> dump_structural_verilog_;
@@ -10,7 +10,7 @@
  * Constructors
  ***********************************************************************/
 ConfigProtocol::ConfigProtocol() {
-  return;
+  num_regions_ = 1;
 }
 
 /************************************************************************
@@ -28,6 +28,10 @@ CircuitModelId ConfigProtocol::memory_model() const {
   return memory_model_;
 }
 
+size_t ConfigProtocol::num_regions() const {
+  return num_regions_;
+}
+
 /************************************************************************
  * Public Mutators
  ***********************************************************************/
@@ -42,3 +46,8 @@ void ConfigProtocol::set_memory_model_name(const std::string& memory_model_name)
 void ConfigProtocol::set_memory_model(const CircuitModelId& memory_model) {
   memory_model_ = memory_model;
 }
+
+void ConfigProtocol::set_num_regions(const size_t& num_regions) {
+  VTR_ASSERT(0 < num_regions);
+  num_regions_ = num_regions;
+}
@@ -15,10 +15,12 @@ class ConfigProtocol {
     e_config_protocol_type type() const;
     std::string memory_model_name() const;
     CircuitModelId memory_model() const;
+    size_t num_regions() const;
   public: /* Public Mutators */
     void set_type(const e_config_protocol_type& type);
     void set_memory_model_name(const std::string& memory_model_name);
     void set_memory_model(const CircuitModelId& memory_model);
+    void set_num_regions(const size_t& num_regions);
   private: /* Internal data */
     /* The type of configuration protocol. 
      * In other words, it is about how to organize and access each configurable memory 
@@ -28,6 +30,12 @@ class ConfigProtocol {
     /* The circuit model of configuration memory to be used in the protocol */
     std::string memory_model_name_;
     CircuitModelId memory_model_;
+
+    /* Number of configuration regions of the top-level module.
+     * Each region has its own configuration ports,
+     * so that all the regions can be configured in parallel
+     */
+    size_t num_regions_;
 };
 
 #endif
@@ -1,6 +1,7 @@
 #ifndef OPENFPGA_ARCH_H
 #define OPENFPGA_ARCH_H
 
+#include <string>
 #include <vector>
 #include <map>
 
@@ -23,6 +24,9 @@ namespace openfpga {
  * This is to keep everything well modularized
  */
 struct Arch {
+  /* Secure hash digest of the architecture file to uniquely identify this architecture */
+  std::string architecture_id;
+
   /* Circuit models */
   CircuitLibrary circuit_lib;
   
@@ -64,6 +64,22 @@ void read_xml_config_organization(pugi::xml_node& xml_config_orgz,
 
   config_protocol.set_memory_model_name(get_attribute(xml_config_orgz, "circuit_model_name", loc_data).as_string());
 
+  /* Find the number of configuration regions, which is 1 by default */
+  int num_regions = get_attribute(xml_config_orgz, "num_regions", loc_data, pugiutil::ReqOpt::OPTIONAL).as_int(1);
+  if (1 > num_regions) {
+    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_config_orgz),
+                   "Invalid 'num_regions' attribute '%d'! Expect a positive number\n",
+                   num_regions);
+  }
+
+  if ( (CONFIG_MEM_STANDALONE == config_orgz_type)
+    && (1 < num_regions) ) {
+    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_config_orgz),
+                   "Configuration protocol '%s' does not support multiple regions!\n",
+                   type_attr);
+  }
+
+  config_protocol.set_num_regions(num_regions);
 }
 
 /********************************************************************
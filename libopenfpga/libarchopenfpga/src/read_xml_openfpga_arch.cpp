@@ -11,6 +11,7 @@
 
 /* Headers from vtrutil library */
 #include "vtr_time.h"
+#include "vtr_digest.h"
 
 /* Headers from libarchfpga */
 #include "arch_error.h"
@@ -34,6 +35,9 @@ openfpga::Arch read_xml_openfpga_arch(const char* arch_file_name) {
 
   openfpga::Arch openfpga_arch;
 
+  /* Create a unique identifier for this architecture file based on its contents */
+  openfpga_arch.architecture_id = vtr::secure_digest_file(arch_file_name);
+
   pugi::xml_node Next;
 
   /* Parse the file */
@@ -29,6 +29,7 @@ void write_xml_config_organization(std::fstream& fp,
 
   write_xml_attribute(fp, "type", CONFIG_PROTOCOL_TYPE_STRING[config_protocol.type()]);
   write_xml_attribute(fp, "circuit_model_name", circuit_lib.model_name(config_protocol.memory_model()).c_str());
+  write_xml_attribute(fp, "num_regions", config_protocol.num_regions());
 
   fp << "/>" << "\n";
 }
@@ -0,0 +1,99 @@
+/********************************************************************
+ * Micro-benchmark on the fast look-ups of circuit library
+ * 1. find circuit models by names
+ * 2. find ports of circuit models by types
+ * The look-up results are validated against a brute-force search
+ *
+ * Usage: benchmark_circuit_library_lookup <num_iterations> <arch_file> [<arch_file> ...]
+ * For example, run on all the k6_frac_N10 architectures
+ *   benchmark_circuit_library_lookup 10000 openfpga_flow/openfpga_arch/k6_frac_N10*.xml
+ *******************************************************************/
+#include <cstdlib>
+#include <chrono>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from readarchopenfpga */
+#include "read_xml_openfpga_arch.h"
+
+/********************************************************************
+ * Validate the look-ups with a brute-force search on the library
+ *******************************************************************/
+static
+void validate_circuit_library_lookup(const CircuitLibrary& circuit_lib) {
+  for (const CircuitModelId& model : circuit_lib.models()) {
+    VTR_ASSERT(model == circuit_lib.model(circuit_lib.model_name(model)));
+
+    for (size_t itype = 0; itype < NUM_CIRCUIT_MODEL_PORT_TYPES; ++itype) {
+      e_circuit_model_port_type port_type = e_circuit_model_port_type(itype);
+      std::vector<CircuitPortId> all_ports;
+      std::vector<CircuitPortId> non_global_ports;
+      for (const CircuitPortId& port : circuit_lib.model_ports(model)) {
+        if (port_type != circuit_lib.port_type(port)) {
+          continue;
+        }
+        all_ports.push_back(port);
+        if (false == circuit_lib.port_is_global(port)) {
+          non_global_ports.push_back(port);
+        }
+      }
+      VTR_ASSERT(all_ports == circuit_lib.model_ports_by_type(model, port_type));
+      VTR_ASSERT(all_ports == circuit_lib.model_ports_by_type(model, port_type, false));
+      VTR_ASSERT(non_global_ports == circuit_lib.model_ports_by_type(model, port_type, true));
+      VTR_ASSERT(all_ports.size() == circuit_lib.num_model_ports_by_type(model, port_type, true));
+      VTR_ASSERT(non_global_ports.size() == circuit_lib.num_model_ports_by_type(model, port_type, false));
+    }
+  }
+  VTR_ASSERT(CircuitModelId::INVALID() == circuit_lib.model(std::string("a_circuit_model_which_does_not_exist")));
+}
+
+int main(int argc, const char** argv) {
+  /* Ensure we have the number of iterations and at least one architecture */
+  VTR_ASSERT(3 <= argc);
+
+  size_t num_iterations = std::atoi(argv[1]);
+
+  for (int iarg = 2; iarg < argc; ++iarg) {
+    const openfpga::Arch& openfpga_arch = read_xml_openfpga_arch(argv[iarg]);
+    const CircuitLibrary& circuit_lib = openfpga_arch.circuit_lib;
+
+    validate_circuit_library_lookup(circuit_lib);
+
+    /* Collect the names to search, as netlist writers do */
+    std::vector<std::string> model_names;
+    for (const CircuitModelId& model : circuit_lib.models()) {
+      model_names.push_back(circuit_lib.model_name(model));
+    }
+
+    /* Accumulate the results so that the look-ups are not optimized away */
+    size_t checksum = 0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t iter = 0; iter < num_iterations; ++iter) {
+      for (const std::string& model_name : model_names) {
+        checksum += size_t(circuit_lib.model(model_name));
+      }
+    }
+    std::chrono::duration<double> model_time = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (size_t iter = 0; iter < num_iterations; ++iter) {
+      for (const CircuitModelId& model : circuit_lib.models()) {
+        for (size_t itype = 0; itype < NUM_CIRCUIT_MODEL_PORT_TYPES; ++itype) {
+          checksum += circuit_lib.model_ports_by_type(model, e_circuit_model_port_type(itype)).size();
+          checksum += circuit_lib.model_ports_by_type(model, e_circuit_model_port_type(itype), true).size();
+        }
+      }
+    }
+    std::chrono::duration<double> port_time = std::chrono::steady_clock::now() - start;
+
+    VTR_LOG("%s: %lu circuit models, %lu iterations (checksum=%lu)\n",
+            argv[iarg], circuit_lib.num_models(), num_iterations, checksum);
+    VTR_LOG("\tFind circuit models by names took %g seconds\n", model_time.count());
+    VTR_LOG("\tFind circuit model ports by types took %g seconds\n", port_time.count());
+  }
+
+  return 0;
+}
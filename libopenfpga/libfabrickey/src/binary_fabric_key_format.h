@@ -0,0 +1,78 @@
+#ifndef BINARY_FABRIC_KEY_FORMAT_H
+#define BINARY_FABRIC_KEY_FORMAT_H
+
+/********************************************************************
+ * This file defines the binary format of fabric key
+ *
+ * It is much more compact than the XML format for fabric keys with
+ * hundreds of thousands of keys: the names of keys are interned in
+ * a module table, and each key refers to its module by index.
+ * The file is read and written key by key, without building any
+ * document in memory.
+ *
+ * All the integers are stored in little-endian.
+ *
+ * File layout
+ * -----------
+ *
+ *   +-------------------------------------------------------+ 0
+ *   | Header                                                |
+ *   |   magic number (8 bytes)     : "OFPGAFKY"             |
+ *   |   version (uint32)                                    |
+ *   |   reserved (uint32)                                   |
+ *   |   number of modules (uint64)                          |
+ *   |   number of keys (uint64)                             |
+ *   +-------------------------------------------------------+ 32
+ *   | Module table                                          |
+ *   |   For each module: length of name (uint32), name      |
+ *   +-------------------------------------------------------+
+ *   | Key records                                           |
+ *   |   For each key: module (uint32), value (uint64),      |
+ *   |                 length of alias (uint32), alias       |
+ *   +-------------------------------------------------------+
+ *
+ * Keys are stored in the sequence of their ids.
+ * A key without name refers to the module BINARY_FABRIC_KEY_NO_MODULE.
+ * A key without alias has an alias of zero length.
+ *******************************************************************/
+#include <cstddef>
+#include <cstdint>
+
+constexpr char BINARY_FABRIC_KEY_MAGIC[] = "OFPGAFKY";
+constexpr size_t BINARY_FABRIC_KEY_MAGIC_SIZE = 8;
+constexpr uint32_t BINARY_FABRIC_KEY_VERSION = 1;
+
+/* Byte offsets of the fields in the header */
+constexpr size_t BINARY_FABRIC_KEY_VERSION_OFFSET = 8;
+constexpr size_t BINARY_FABRIC_KEY_NUM_MODULES_OFFSET = 16;
+constexpr size_t BINARY_FABRIC_KEY_NUM_KEYS_OFFSET = 24;
+constexpr size_t BINARY_FABRIC_KEY_HEADER_SIZE = 32;
+
+/* Byte offsets of the fields in a key record, before the alias */
+constexpr size_t BINARY_FABRIC_KEY_RECORD_MODULE_OFFSET = 0;
+constexpr size_t BINARY_FABRIC_KEY_RECORD_VALUE_OFFSET = 4;
+constexpr size_t BINARY_FABRIC_KEY_RECORD_ALIAS_SIZE_OFFSET = 12;
+constexpr size_t BINARY_FABRIC_KEY_RECORD_SIZE = 16;
+
+/* Module index of the keys without name */
+constexpr uint32_t BINARY_FABRIC_KEY_NO_MODULE = 0xffffffff;
+
+/* Encode/decode integers in little-endian */
+inline void encode_binary_fabric_key_uint(const uint64_t& value,
+                                          const size_t& num_bytes,
+                                          unsigned char* buffer) {
+  for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+    buffer[ibyte] = static_cast<unsigned char>((value >> (8 * ibyte)) & 0xff);
+  }
+}
+
+inline uint64_t decode_binary_fabric_key_uint(const unsigned char* buffer,
+                                              const size_t& num_bytes) {
+  uint64_t value = 0;
+  for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+    value |= static_cast<uint64_t>(buffer[ibyte]) << (8 * ibyte);
+  }
+  return value;
+}
+
+#endif
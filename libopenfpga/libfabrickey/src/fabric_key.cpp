@@ -20,14 +20,23 @@ FabricKey::fabric_key_range FabricKey::keys() const {
   return vtr::make_range(key_ids_.begin(), key_ids_.end());
 }
 
+FabricKey::fabric_key_module_range FabricKey::modules() const {
+  return vtr::make_range(module_ids_.begin(), module_ids_.end());
+}
+
 /************************************************************************
  * Public Accessors : Basic data query 
  ***********************************************************************/
 /* Access the name of a key */
-std::string FabricKey::key_name(const FabricKeyId& key_id) const {
+const std::string& FabricKey::key_name(const FabricKeyId& key_id) const {
   /* validate the key_id */
   VTR_ASSERT(valid_key_id(key_id));
-  return key_names_[key_id]; 
+  /* A key without module has an empty name */
+  static const std::string EMPTY_NAME;
+  if (false == valid_module_id(key_modules_[key_id])) {
+    return EMPTY_NAME;
+  }
+  return module_names_[key_modules_[key_id]]; 
 }
 
 /* Access the value of a key */
@@ -38,12 +47,42 @@ size_t FabricKey::key_value(const FabricKeyId& key_id) const {
 }
 
 /* Access the alias of a key */
-std::string FabricKey::key_alias(const FabricKeyId& key_id) const {
+const std::string& FabricKey::key_alias(const FabricKeyId& key_id) const {
   /* validate the key_id */
   VTR_ASSERT(valid_key_id(key_id));
   return key_alias_[key_id]; 
 }
 
+/* Access the module of a key */
+FabricKeyModuleId FabricKey::key_module(const FabricKeyId& key_id) const {
+  /* validate the key_id */
+  VTR_ASSERT(valid_key_id(key_id));
+  return key_modules_[key_id]; 
+}
+
+/* Access the name of a module */
+const std::string& FabricKey::module_name(const FabricKeyModuleId& module_id) const {
+  /* validate the module_id */
+  VTR_ASSERT(valid_module_id(module_id));
+  return module_names_[module_id]; 
+}
+
+FabricKeyModuleId FabricKey::find_module(const std::string& name) const {
+  auto result = module_name2ids_.find(name);
+  if (result == module_name2ids_.end()) {
+    return FabricKeyModuleId::INVALID();
+  }
+  return result->second;
+}
+
+size_t FabricKey::num_keys() const {
+  return key_ids_.size();
+}
+
+size_t FabricKey::num_modules() const {
+  return module_ids_.size();
+}
+
 bool FabricKey::empty() const {
   return 0 == key_ids_.size();
 }
@@ -53,7 +92,7 @@ bool FabricKey::empty() const {
  ***********************************************************************/
 void FabricKey::reserve_keys(const size_t& num_keys) {
   key_ids_.reserve(num_keys);
-  key_names_.reserve(num_keys);
+  key_modules_.reserve(num_keys);
   key_values_.reserve(num_keys);
   key_alias_.reserve(num_keys);
 }
@@ -63,19 +102,49 @@ FabricKeyId FabricKey::create_key() {
   /* Create a new id */
   FabricKeyId key = FabricKeyId(key_ids_.size());
   key_ids_.push_back(key);
-  key_names_.emplace_back();
+  key_modules_.push_back(FabricKeyModuleId::INVALID());
   key_values_.emplace_back();
   key_alias_.emplace_back();
   
   return key;
 }
 
+/* Add a module and return its id, which is shared by all the keys in the same name */
+FabricKeyModuleId FabricKey::add_module(const std::string& name) {
+  FabricKeyModuleId module = find_module(name);
+  if (true == valid_module_id(module)) {
+    return module;
+  }
+
+  /* Create a new id */
+  module = FabricKeyModuleId(module_ids_.size());
+  module_ids_.push_back(module);
+  module_names_.push_back(name);
+  module_name2ids_[name] = module;
+
+  return module;
+}
+
+/* Set the name of a key, an empty name removes the module of the key */
 void FabricKey::set_key_name(const FabricKeyId& key_id,
                              const std::string& name) {
   /* validate the key_id */
   VTR_ASSERT(valid_key_id(key_id));
 
-  key_names_[key_id] = name;
+  if (true == name.empty()) {
+    key_modules_[key_id] = FabricKeyModuleId::INVALID();
+    return;
+  }
+  key_modules_[key_id] = add_module(name);
+}
+
+void FabricKey::set_key_module(const FabricKeyId& key_id,
+                               const FabricKeyModuleId& module_id) {
+  /* validate the key_id and module_id */
+  VTR_ASSERT(valid_key_id(key_id));
+  VTR_ASSERT(valid_module_id(module_id));
+
+  key_modules_[key_id] = module_id;
 }
 
 void FabricKey::set_key_value(const FabricKeyId& key_id,
@@ -101,3 +170,7 @@ void FabricKey::set_key_alias(const FabricKeyId& key_id,
 bool FabricKey::valid_key_id(const FabricKeyId& key_id) const {
   return ( size_t(key_id) < key_ids_.size() ) && ( key_id == key_ids_[key_id] ); 
 }
+
+bool FabricKey::valid_module_id(const FabricKeyModuleId& module_id) const {
+  return ( size_t(module_id) < module_ids_.size() ) && ( module_id == module_ids_[module_id] ); 
+}
@@ -7,6 +7,7 @@
 #include <string>
 #include <map>
 #include <array>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_vector.h"
@@ -23,44 +24,73 @@
  *   // Add a key with name and value
  *   FabricKeyId key = fabic_key.create_key(key_name, key_value);
  *
+ * The names of keys, i.e., the names of modules, are interned:
+ * each distinct name is stored once as a module of the fabric key,
+ * and the keys refer to their modules by ids.
+ * Since a fabric key has many keys but only a few modules,
+ * readers can resolve the modules once rather than for each key.
+ *
  *******************************************************************/
 class FabricKey {
   public: /* Types */
     typedef vtr::vector<FabricKeyId, FabricKeyId>::const_iterator fabric_key_iterator;
+    typedef vtr::vector<FabricKeyModuleId, FabricKeyModuleId>::const_iterator fabric_key_module_iterator;
     /* Create range */
     typedef vtr::Range<fabric_key_iterator> fabric_key_range;
+    typedef vtr::Range<fabric_key_module_iterator> fabric_key_module_range;
   public:  /* Constructors */
     FabricKey();
   public: /* Accessors: aggregates */
     fabric_key_range keys() const;
+    fabric_key_module_range modules() const;
   public: /* Public Accessors: Basic data query */
-    std::string key_name(const FabricKeyId& key_id) const;
+    /* The name of a key is the name of its module, which is empty if the key has no module */
+    const std::string& key_name(const FabricKeyId& key_id) const;
     size_t key_value(const FabricKeyId& key_id) const;
-    std::string key_alias(const FabricKeyId& key_id) const;
+    const std::string& key_alias(const FabricKeyId& key_id) const;
+    /* The module of a key, which is invalid if the key has no name */
+    FabricKeyModuleId key_module(const FabricKeyId& key_id) const;
+    const std::string& module_name(const FabricKeyModuleId& module_id) const;
+    /* Find a module by name, return an invalid id if not found */
+    FabricKeyModuleId find_module(const std::string& name) const;
+    size_t num_keys() const;
+    size_t num_modules() const;
     bool empty() const;
   public: /* Public Mutators: model-related */
     void reserve_keys(const size_t& num_keys);
     FabricKeyId create_key();
+    /* Add a module in a given name, return the existing one if the name is used */
+    FabricKeyModuleId add_module(const std::string& name);
     void set_key_name(const FabricKeyId& key_id,
                       const std::string& name);
+    void set_key_module(const FabricKeyId& key_id,
+                        const FabricKeyModuleId& module_id);
     void set_key_value(const FabricKeyId& key_id,
                        const size_t& value);
     void set_key_alias(const FabricKeyId& key_id,
                        const std::string& alias);
   public: /* Public invalidators/validators */
     bool valid_key_id(const FabricKeyId& key_id) const;
+    bool valid_module_id(const FabricKeyModuleId& module_id) const;
   private: /* Internal data */
     /* Unique ids for each key */
     vtr::vector<FabricKeyId, FabricKeyId> key_ids_;
 
-    /* Names for each key */
-    vtr::vector<FabricKeyId, std::string> key_names_;
+    /* Modules for each key, which represent the names of keys */
+    vtr::vector<FabricKeyId, FabricKeyModuleId> key_modules_;
 
     /* Values for each key */
     vtr::vector<FabricKeyId, size_t> key_values_;
 
     /* Optional alias for each key, with which a key can also be represented */
     vtr::vector<FabricKeyId, std::string> key_alias_;
+
+    /* Unique ids and names for each module */
+    vtr::vector<FabricKeyModuleId, FabricKeyModuleId> module_ids_;
+    vtr::vector<FabricKeyModuleId, std::string> module_names_;
+
+    /* Fast look-up for modules by names */
+    std::unordered_map<std::string, FabricKeyModuleId> module_name2ids_;
 };
 
 #endif
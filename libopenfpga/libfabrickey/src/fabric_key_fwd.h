@@ -13,8 +13,10 @@
 #include "vtr_strong_id.h"
 
 struct fabric_key_id_tag;
+struct fabric_key_module_id_tag;
 
 typedef vtr::StrongId<fabric_key_id_tag> FabricKeyId;
+typedef vtr::StrongId<fabric_key_module_id_tag> FabricKeyModuleId;
 
 /* Short declaration of class */
 class FabricKey;
@@ -0,0 +1,184 @@
+/********************************************************************
+ * This file includes the functions which read a fabric key
+ * in binary format (see binary_fabric_key_format.h)
+ * to the associated data structures
+ *******************************************************************/
+#include <string>
+#include <vector>
+#include <fstream>
+
+/* Headers from vtr util library */
+#include "vtr_assert.h"
+#include "vtr_time.h"
+
+/* Headers from libarchfpga */
+#include "arch_error.h"
+
+#include "read_binary_fabric_key.h"
+
+/********************************************************************
+ * Read a given number of bytes from the file,
+ * errors out if the file ends too early
+ *******************************************************************/
+static 
+void read_binary_fabric_key_bytes(std::ifstream& fp,
+                                  const char* key_fname,
+                                  unsigned char* buffer,
+                                  const size_t& num_bytes) {
+  fp.read(reinterpret_cast<char*>(buffer), num_bytes);
+  if (size_t(fp.gcount()) != num_bytes) {
+    archfpga_throw(key_fname, 0,
+                   "Unexpected end of binary fabric key file\n");
+  }
+}
+
+/********************************************************************
+ * Find the number of bytes left in the file after the current position
+ *******************************************************************/
+static 
+size_t find_binary_fabric_key_remaining_bytes(std::ifstream& fp,
+                                              const size_t& file_size) {
+  std::streamoff pos = fp.tellg();
+  if ((0 > pos) || (file_size < size_t(pos))) {
+    return 0;
+  }
+  return file_size - size_t(pos);
+}
+
+/********************************************************************
+ * Check if the rest of the file is large enough for
+ * a given number of entries, each of which takes at least
+ * a given number of bytes.
+ * This is called before reserving memory for the entries,
+ * so that a corrupted count errors out as a truncated file
+ * rather than a failed allocation
+ *******************************************************************/
+static 
+void check_binary_fabric_key_remaining_bytes(std::ifstream& fp,
+                                             const char* key_fname,
+                                             const size_t& file_size,
+                                             const size_t& num_entries,
+                                             const size_t& min_entry_size) {
+  if (num_entries > find_binary_fabric_key_remaining_bytes(fp, file_size) / min_entry_size) {
+    archfpga_throw(key_fname, 0,
+                   "Unexpected end of binary fabric key file\n");
+  }
+}
+
+/********************************************************************
+ * Read a string in a given length from the file
+ *******************************************************************/
+static 
+void read_binary_fabric_key_string(std::ifstream& fp,
+                                   const char* key_fname,
+                                   const size_t& file_size,
+                                   const size_t& length,
+                                   std::string& str) {
+  check_binary_fabric_key_remaining_bytes(fp, key_fname, file_size, length, 1);
+  str.resize(length);
+  if (0 < length) {
+    read_binary_fabric_key_bytes(fp, key_fname, reinterpret_cast<unsigned char*>(&str[0]), length);
+  }
+}
+
+/********************************************************************
+ * Check if a file is a fabric key in binary format by its magic number
+ *******************************************************************/
+bool is_binary_fabric_key_file(const char* key_fname) {
+  std::ifstream fp(key_fname, std::ifstream::in | std::ifstream::binary);
+  if (false == fp.is_open()) {
+    return false;
+  }
+
+  char magic[BINARY_FABRIC_KEY_MAGIC_SIZE];
+  fp.read(magic, BINARY_FABRIC_KEY_MAGIC_SIZE);
+  if (size_t(fp.gcount()) != BINARY_FABRIC_KEY_MAGIC_SIZE) {
+    return false;
+  }
+  return std::string(magic, BINARY_FABRIC_KEY_MAGIC_SIZE) == std::string(BINARY_FABRIC_KEY_MAGIC);
+}
+
+/********************************************************************
+ * Read a fabric key in binary format to an object of FabricKey
+ * The file is read key by key, so that only the fabric key itself
+ * is held in memory
+ *******************************************************************/
+FabricKey read_binary_fabric_key(const char* key_fname) {
+
+  vtr::ScopedStartFinishTimer timer("Read Fabric Key");
+
+  FabricKey fabric_key;
+
+  std::ifstream fp(key_fname, std::ifstream::in | std::ifstream::binary);
+  if (false == fp.is_open()) {
+    archfpga_throw(key_fname, 0,
+                   "Unable to open binary fabric key file\n");
+  }
+
+  /* The size of file bounds the counts in the header */
+  fp.seekg(0, std::ifstream::end);
+  size_t file_size = size_t(fp.tellg());
+  fp.seekg(0, std::ifstream::beg);
+
+  /* Check the header */
+  unsigned char header[BINARY_FABRIC_KEY_HEADER_SIZE];
+  read_binary_fabric_key_bytes(fp, key_fname, header, BINARY_FABRIC_KEY_HEADER_SIZE);
+
+  if (std::string(reinterpret_cast<const char*>(header), BINARY_FABRIC_KEY_MAGIC_SIZE) != std::string(BINARY_FABRIC_KEY_MAGIC)) {
+    archfpga_throw(key_fname, 0,
+                   "Invalid magic number of binary fabric key file\n");
+  }
+
+  size_t version = decode_binary_fabric_key_uint(&header[BINARY_FABRIC_KEY_VERSION_OFFSET], 4);
+  if (BINARY_FABRIC_KEY_VERSION != version) {
+    archfpga_throw(key_fname, 0,
+                   "Unsupported version '%lu' of binary fabric key file (expect '%u')\n",
+                   version, BINARY_FABRIC_KEY_VERSION);
+  }
+
+  size_t num_modules = decode_binary_fabric_key_uint(&header[BINARY_FABRIC_KEY_NUM_MODULES_OFFSET], 8);
+  size_t num_keys = decode_binary_fabric_key_uint(&header[BINARY_FABRIC_KEY_NUM_KEYS_OFFSET], 8);
+
+  /* Module table: the indices in the file are mapped to the modules of fabric key */
+  std::vector<FabricKeyModuleId> modules;
+  check_binary_fabric_key_remaining_bytes(fp, key_fname, file_size, num_modules, 4);
+  modules.reserve(num_modules);
+  std::string name;
+  for (size_t imodule = 0; imodule < num_modules; ++imodule) {
+    unsigned char name_size[4];
+    read_binary_fabric_key_bytes(fp, key_fname, name_size, 4);
+    read_binary_fabric_key_string(fp, key_fname, file_size, decode_binary_fabric_key_uint(name_size, 4), name);
+    modules.push_back(fabric_key.add_module(name));
+  }
+
+  /* Key records */
+  check_binary_fabric_key_remaining_bytes(fp, key_fname, file_size, num_keys, BINARY_FABRIC_KEY_RECORD_SIZE);
+  fabric_key.reserve_keys(num_keys);
+  std::string alias;
+  for (size_t ikey = 0; ikey < num_keys; ++ikey) {
+    unsigned char record[BINARY_FABRIC_KEY_RECORD_SIZE];
+    read_binary_fabric_key_bytes(fp, key_fname, record, BINARY_FABRIC_KEY_RECORD_SIZE);
+
+    FabricKeyId key = fabric_key.create_key();
+
+    size_t module = decode_binary_fabric_key_uint(&record[BINARY_FABRIC_KEY_RECORD_MODULE_OFFSET], 4);
+    if (BINARY_FABRIC_KEY_NO_MODULE != module) {
+      if (module >= modules.size()) {
+        archfpga_throw(key_fname, 0,
+                       "Invalid module '%lu' of key '%lu'\n",
+                       module, ikey);
+      }
+      fabric_key.set_key_module(key, modules[module]);
+    }
+
+    fabric_key.set_key_value(key, decode_binary_fabric_key_uint(&record[BINARY_FABRIC_KEY_RECORD_VALUE_OFFSET], 8));
+
+    size_t alias_size = decode_binary_fabric_key_uint(&record[BINARY_FABRIC_KEY_RECORD_ALIAS_SIZE_OFFSET], 4);
+    if (0 < alias_size) {
+      read_binary_fabric_key_string(fp, key_fname, file_size, alias_size, alias);
+      fabric_key.set_key_alias(key, alias);
+    }
+  }
+
+  return fabric_key; 
+}
@@ -0,0 +1,17 @@
+#ifndef READ_BINARY_FABRIC_KEY_H
+#define READ_BINARY_FABRIC_KEY_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "fabric_key.h"
+#include "binary_fabric_key_format.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+bool is_binary_fabric_key_file(const char* key_fname);
+
+FabricKey read_binary_fabric_key(const char* key_fname);
+
+#endif
@@ -0,0 +1,106 @@
+/********************************************************************
+ * This file includes functions that output a fabric key 
+ * in binary format (see binary_fabric_key_format.h)
+ *******************************************************************/
+/* Headers from system goes first */
+#include <cstdint>
+#include <string>
+#include <fstream>
+#include <algorithm>
+
+/* Headers from vtr util library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+#include "openfpga_digest.h"
+
+/* Headers from fabrickey library */
+#include "write_binary_fabric_key.h"
+
+/********************************************************************
+ * A writer to output a fabric key to binary format
+ * Keys are written one by one, without duplicating the fabric key in memory
+ *
+ * Return 0 if successful
+ * Return 1 if there are more serious bugs in the architecture 
+ * Return 2 if fail when creating files
+ *******************************************************************/
+int write_binary_fabric_key(const char* fname,
+                            const FabricKey& fabric_key) {
+
+  vtr::ScopedStartFinishTimer timer("Write Fabric Key");
+
+  /* Module indices should fit in the records */
+  if (BINARY_FABRIC_KEY_NO_MODULE <= fabric_key.num_modules()) {
+    VTR_LOG_ERROR("Too many modules (%lu) in the fabric key for binary format!\n",
+                  fabric_key.num_modules());
+    return 1;
+  }
+
+  /* Sizes of module names and aliases should fit in their 4-byte fields */
+  for (const FabricKeyModuleId& module : fabric_key.modules()) {
+    if (UINT32_MAX < fabric_key.module_name(module).size()) {
+      VTR_LOG_ERROR("Module name (%lu characters) is too long in the fabric key for binary format!\n",
+                    fabric_key.module_name(module).size());
+      return 1;
+    }
+  }
+  for (const FabricKeyId& key : fabric_key.keys()) {
+    if (UINT32_MAX < fabric_key.key_alias(key).size()) {
+      VTR_LOG_ERROR("Alias (%lu characters) is too long in the fabric key for binary format!\n",
+                    fabric_key.key_alias(key).size());
+      return 1;
+    }
+  }
+
+  /* Create a file handler */
+  std::fstream fp;
+  /* Open the file stream */
+  fp.open(std::string(fname), std::fstream::out | std::fstream::trunc | std::fstream::binary);
+
+  /* Validate the file stream */
+  openfpga::check_file_stream(fname, fp);
+
+  /* Write the header */
+  unsigned char header[BINARY_FABRIC_KEY_HEADER_SIZE] = {0};
+  std::copy(BINARY_FABRIC_KEY_MAGIC, BINARY_FABRIC_KEY_MAGIC + BINARY_FABRIC_KEY_MAGIC_SIZE, header);
+  encode_binary_fabric_key_uint(BINARY_FABRIC_KEY_VERSION, 4, &header[BINARY_FABRIC_KEY_VERSION_OFFSET]);
+  encode_binary_fabric_key_uint(fabric_key.num_modules(), 8, &header[BINARY_FABRIC_KEY_NUM_MODULES_OFFSET]);
+  encode_binary_fabric_key_uint(fabric_key.num_keys(), 8, &header[BINARY_FABRIC_KEY_NUM_KEYS_OFFSET]);
+  fp.write(reinterpret_cast<const char*>(header), BINARY_FABRIC_KEY_HEADER_SIZE);
+
+  /* Write the module table */
+  for (const FabricKeyModuleId& module : fabric_key.modules()) {
+    const std::string& name = fabric_key.module_name(module);
+    unsigned char name_size[4];
+    encode_binary_fabric_key_uint(name.size(), 4, name_size);
+    fp.write(reinterpret_cast<const char*>(name_size), 4);
+    fp.write(name.data(), name.size());
+  }
+
+  /* Write key by key */ 
+  for (const FabricKeyId& key : fabric_key.keys()) {
+    unsigned char record[BINARY_FABRIC_KEY_RECORD_SIZE];
+    uint32_t module = BINARY_FABRIC_KEY_NO_MODULE;
+    if (FabricKeyModuleId::INVALID() != fabric_key.key_module(key)) {
+      module = size_t(fabric_key.key_module(key));
+    }
+    const std::string& alias = fabric_key.key_alias(key);
+    encode_binary_fabric_key_uint(module, 4, &record[BINARY_FABRIC_KEY_RECORD_MODULE_OFFSET]);
+    encode_binary_fabric_key_uint(fabric_key.key_value(key), 8, &record[BINARY_FABRIC_KEY_RECORD_VALUE_OFFSET]);
+    encode_binary_fabric_key_uint(alias.size(), 4, &record[BINARY_FABRIC_KEY_RECORD_ALIAS_SIZE_OFFSET]);
+    fp.write(reinterpret_cast<const char*>(record), BINARY_FABRIC_KEY_RECORD_SIZE);
+    fp.write(alias.data(), alias.size());
+  }
+
+  /* Close the file stream */
+  fp.close();
+
+  if (true == fp.fail()) {
+    VTR_LOG_ERROR("Failed to write binary fabric key '%s'!\n",
+                  fname);
+    return 2;
+  }
+
+  return 0;
+}
@@ -0,0 +1,16 @@
+#ifndef WRITE_BINARY_FABRIC_KEY_H
+#define WRITE_BINARY_FABRIC_KEY_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "fabric_key.h"
+#include "binary_fabric_key_format.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+int write_binary_fabric_key(const char* fname,
+                            const FabricKey& fabric_key);
+
+#endif
@@ -0,0 +1,95 @@
+/********************************************************************
+ * Benchmark on the readers and writers of fabric key in XML and binary formats
+ * The time and the peak memory usage (RSS) of the process are reported.
+ * As the peak memory usage only grows during a process,
+ * the reader and the writer should be benchmarked in separated runs.
+ *
+ * Usage:
+ * 1. Build a synthetic fabric key with a given number of keys and write it to a file
+ *   benchmark_fabric_key write <xml|binary> <num_keys> <key_file>
+ * 2. Read a file, whose format is detected by its content
+ *   benchmark_fabric_key read <key_file>
+ * For example, a top-level fabric key of a 256x256 device has about 265000 keys
+ *   benchmark_fabric_key write binary 265000 fabric_key.bin
+ *   benchmark_fabric_key read fabric_key.bin
+ *******************************************************************/
+#include <cstdlib>
+#include <chrono>
+#include <fstream>
+#include <string>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_rusage.h"
+
+/* Headers from fabric key */
+#include "read_xml_fabric_key.h"
+#include "write_xml_fabric_key.h"
+#include "read_binary_fabric_key.h"
+#include "write_binary_fabric_key.h"
+
+/* Number of modules of the synthetic fabric key,
+ * which is close to the number of unique grid and routing modules
+ * of a top-level fabric key when routing modules are compressed
+ */
+constexpr size_t NUM_SYNTHETIC_FABRIC_KEY_MODULES = 32;
+
+static
+void report_fabric_key_benchmark(const char* action,
+                                 const std::string& fname,
+                                 const std::chrono::duration<double>& runtime) {
+  std::fstream fp(fname, std::fstream::in | std::fstream::ate);
+  VTR_LOG("%s '%s' (%lu bytes) took %g seconds, peak memory usage %lu bytes\n",
+          action, fname.c_str(), size_t(fp.tellg()), runtime.count(), vtr::get_max_rss());
+}
+
+int main(int argc, const char** argv) {
+  VTR_ASSERT(3 <= argc);
+
+  if (std::string("write") == std::string(argv[1])) {
+    VTR_ASSERT(5 == argc);
+    std::string format(argv[2]);
+    VTR_ASSERT((std::string("xml") == format) || (std::string("binary") == format));
+    size_t num_keys = std::atoi(argv[3]);
+
+    /* Keys are named after modules and aliased after instances, as the fabric key of a top module */
+    FabricKey fabric_key;
+    fabric_key.reserve_keys(num_keys);
+    for (size_t ikey = 0; ikey < num_keys; ++ikey) {
+      std::string module_name = std::string("module_") + std::to_string(ikey % NUM_SYNTHETIC_FABRIC_KEY_MODULES);
+      size_t instance = ikey / NUM_SYNTHETIC_FABRIC_KEY_MODULES;
+      FabricKeyId key = fabric_key.create_key();
+      fabric_key.set_key_name(key, module_name);
+      fabric_key.set_key_value(key, instance);
+      fabric_key.set_key_alias(key, module_name + std::string("_") + std::to_string(instance) + std::string("_"));
+    }
+    VTR_LOG("Built %lu keys of %lu modules\n",
+            fabric_key.num_keys(), fabric_key.num_modules());
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    int status = 0;
+    if (std::string("xml") == format) {
+      status = write_xml_fabric_key(argv[4], fabric_key);
+    } else {
+      status = write_binary_fabric_key(argv[4], fabric_key);
+    }
+    report_fabric_key_benchmark("Write", std::string(argv[4]), std::chrono::steady_clock::now() - start);
+    return status;
+  }
+
+  VTR_ASSERT(std::string("read") == std::string(argv[1]));
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  FabricKey fabric_key;
+  if (true == is_binary_fabric_key_file(argv[2])) {
+    fabric_key = read_binary_fabric_key(argv[2]);
+  } else {
+    fabric_key = read_xml_fabric_key(argv[2]);
+  }
+  report_fabric_key_benchmark("Read", std::string(argv[2]), std::chrono::steady_clock::now() - start);
+  VTR_LOG("Read %lu keys of %lu modules\n",
+          fabric_key.num_keys(), fabric_key.num_modules());
+
+  return 0;
+}
@@ -0,0 +1,64 @@
+/********************************************************************
+ * Unit test functions to validate the correctness of 
+ * 1. writer of fabric key in binary format
+ * 2. reader of fabric key in binary format
+ *
+ * Usage: test_binary_fabric_key <xml_file> <binary_file>
+ *
+ * The fabric key in XML format is converted to the binary file,
+ * which is then read back. The two fabric keys should be the same.
+ *******************************************************************/
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from fabric key */
+#include "read_xml_fabric_key.h"
+#include "read_binary_fabric_key.h"
+#include "write_binary_fabric_key.h"
+
+int main(int argc, const char** argv) {
+  /* Ensure we have two arguments */
+  VTR_ASSERT(3 == argc);
+
+  /* Parse the fabric key from an XML file */
+  FabricKey xml_key = read_xml_fabric_key(argv[1]);
+  VTR_LOG("Read the fabric key from an XML file: %s.\n",
+          argv[1]);
+  VTR_ASSERT(false == is_binary_fabric_key_file(argv[1]));
+
+  /* Output the fabric key to a binary file */
+  if (0 != write_binary_fabric_key(argv[2], xml_key)) {
+    return 1;
+  }
+  VTR_LOG("Write the fabric key to a binary file: %s.\n",
+          argv[2]);
+  VTR_ASSERT(true == is_binary_fabric_key_file(argv[2]));
+
+  /* Read back the binary file and compare */
+  FabricKey binary_key = read_binary_fabric_key(argv[2]);
+  VTR_LOG("Read the fabric key from a binary file: %s.\n",
+          argv[2]);
+
+  if ( (xml_key.num_keys() != binary_key.num_keys())
+    || (xml_key.num_modules() != binary_key.num_modules()) ) {
+    VTR_LOG_ERROR("Fabric key read from binary file '%s' has %lu keys and %lu modules, while XML file '%s' has %lu keys and %lu modules!\n",
+                  argv[2], binary_key.num_keys(), binary_key.num_modules(),
+                  argv[1], xml_key.num_keys(), xml_key.num_modules());
+    return 1;
+  }
+
+  for (const FabricKeyId& key : xml_key.keys()) {
+    if ( (xml_key.key_name(key) != binary_key.key_name(key))
+      || (xml_key.key_value(key) != binary_key.key_value(key))
+      || (xml_key.key_alias(key) != binary_key.key_alias(key)) ) {
+      VTR_LOG_ERROR("Key '%lu' read from binary file '%s' is different from XML file '%s'!\n",
+                    size_t(key), argv[2], argv[1]);
+      return 1;
+    }
+  }
+
+  VTR_LOG("Fabric key read from binary file is the same as XML file.\n");
+
+  return 0;
+}
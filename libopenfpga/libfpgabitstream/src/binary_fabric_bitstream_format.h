@@ -0,0 +1,101 @@
+#ifndef BINARY_FABRIC_BITSTREAM_FORMAT_H
+#define BINARY_FABRIC_BITSTREAM_FORMAT_H
+
+/********************************************************************
+ * This file defines the binary container of fabric bitstream
+ *
+ * It is much more compact than the plain text format, which uses
+ * one character per bit and per address bit, and it can be
+ * memory-mapped by programming tools without any parsing.
+ *
+ * All the integers are stored in little-endian.
+ *
+ * File layout
+ * -----------
+ *
+ *   +-------------------------------------------------------+ 0
+ *   | Header                                                |
+ *   |   magic number (8 bytes)     : "OFPGAFBS"             |
+ *   |   version (uint32)                                    |
+ *   |   configuration protocol type (uint32)                |
+ *   |   number of bits (uint64)                             |
+ *   |   address length (uint64)                             |
+ *   |   WL address length (uint64)                          |
+ *   |   number of regions (uint64)                          |
+ *   |   offset of the address payload (uint64)              |
+ *   |   offset of the bit value payload (uint64)            |
+ *   +-------------------------------------------------------+ 64
+ *   | Region table                                          |
+ *   |   For each region: first bit (uint64),                |
+ *   |                    number of bits (uint64)            |
+ *   +-------------------------------------------------------+ address offset
+ *   | Address payload                                       |
+ *   |   For each bit: address, followed by WL address       |
+ *   +-------------------------------------------------------+ value offset
+ *   | Bit value payload                                     |
+ *   +-------------------------------------------------------+
+ *
+ * Bits are stored in the same sequence as the plain text format.
+ *
+ * Bit values are packed by 8 bits per byte: the value of bit i is
+ * the (i % 8)-th bit of the (i / 8)-th byte.
+ *
+ * Each address occupies (length + 7) / 8 bytes. The n-th character
+ * of the address in the plain text format is
+ * the (n % 8)-th bit of the (n / 8)-th byte.
+ * WL addresses are only used by the memory bank protocol,
+ * while (BL) addresses are used by both memory bank and frame-based protocols.
+ * For the other protocols, the address payload is empty.
+ *******************************************************************/
+#include <cstddef>
+#include <cstdint>
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+constexpr char BINARY_FABRIC_BITSTREAM_MAGIC[] = "OFPGAFBS";
+constexpr size_t BINARY_FABRIC_BITSTREAM_MAGIC_SIZE = 8;
+constexpr uint32_t BINARY_FABRIC_BITSTREAM_VERSION = 1;
+
+/* Byte offsets of the fields in the header */
+constexpr size_t BINARY_FABRIC_BITSTREAM_VERSION_OFFSET = 8;
+constexpr size_t BINARY_FABRIC_BITSTREAM_PROTOCOL_OFFSET = 12;
+constexpr size_t BINARY_FABRIC_BITSTREAM_NUM_BITS_OFFSET = 16;
+constexpr size_t BINARY_FABRIC_BITSTREAM_ADDRESS_LENGTH_OFFSET = 24;
+constexpr size_t BINARY_FABRIC_BITSTREAM_WL_ADDRESS_LENGTH_OFFSET = 32;
+constexpr size_t BINARY_FABRIC_BITSTREAM_NUM_REGIONS_OFFSET = 40;
+constexpr size_t BINARY_FABRIC_BITSTREAM_ADDRESS_PAYLOAD_OFFSET = 48;
+constexpr size_t BINARY_FABRIC_BITSTREAM_VALUE_PAYLOAD_OFFSET = 56;
+constexpr size_t BINARY_FABRIC_BITSTREAM_HEADER_SIZE = 64;
+
+/* Each entry of the region table contains the first bit and the number of bits */
+constexpr size_t BINARY_FABRIC_BITSTREAM_REGION_ENTRY_SIZE = 16;
+
+/* Number of bytes to store a given number of packed bits
+ * It never overflows, even for a number of bits read from a corrupted file
+ */
+inline size_t binary_fabric_bitstream_num_bytes(const size_t& num_bits) {
+  return num_bits / 8 + ((0 == num_bits % 8) ? 0 : 1);
+}
+
+/* Encode/decode integers in little-endian */
+inline void encode_binary_fabric_bitstream_uint(const uint64_t& value,
+                                                const size_t& num_bytes,
+                                                unsigned char* buffer) {
+  for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+    buffer[ibyte] = static_cast<unsigned char>((value >> (8 * ibyte)) & 0xff);
+  }
+}
+
+inline uint64_t decode_binary_fabric_bitstream_uint(const unsigned char* buffer,
+                                                    const size_t& num_bytes) {
+  uint64_t value = 0;
+  for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+    value |= static_cast<uint64_t>(buffer[ibyte]) << (8 * ibyte);
+  }
+  return value;
+}
+
+} /* end namespace openfpga */
+
+#endif
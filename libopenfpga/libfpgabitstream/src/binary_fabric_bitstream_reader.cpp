@@ -0,0 +1,241 @@
+/********************************************************************
+ * This file includes member functions of the reader of
+ * fabric bitstream in binary format
+ *******************************************************************/
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Headers from vtr util library */
+#include "vtr_assert.h"
+
+/* Headers from libarchfpga */
+#include "arch_error.h"
+
+#include "binary_fabric_bitstream_reader.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Overflow-checked arithmetic on the sizes decoded from the header,
+ * which may come from a corrupted file.
+ * Return false if the result does not fit in size_t
+ *******************************************************************/
+static 
+bool add_binary_fabric_bitstream_sizes(const size_t& a, const size_t& b, size_t& sum) {
+  if (a > std::numeric_limits<size_t>::max() - b) {
+    return false;
+  }
+  sum = a + b;
+  return true;
+}
+
+static 
+bool multiply_binary_fabric_bitstream_sizes(const size_t& a, const size_t& b, size_t& product) {
+  if ((0 != b) && (a > std::numeric_limits<size_t>::max() / b)) {
+    return false;
+  }
+  product = a * b;
+  return true;
+}
+
+/**************************************************
+ * Public Constructors
+ *************************************************/
+BinaryFabricBitstreamReader::BinaryFabricBitstreamReader(const std::string& fname) {
+  fname_ = fname;
+  data_ = nullptr;
+  file_size_ = 0;
+
+  /* Map the whole file */
+  int fd = open(fname_.c_str(), O_RDONLY);
+  if (-1 == fd) {
+    archfpga_throw(fname_.c_str(), 0,
+                   "Unable to open binary fabric bitstream file: %s\n",
+                   std::strerror(errno));
+  }
+
+  struct stat file_stat;
+  if (-1 == fstat(fd, &file_stat)) {
+    close(fd);
+    archfpga_throw(fname_.c_str(), 0,
+                   "Unable to find the size of binary fabric bitstream file: %s\n",
+                   std::strerror(errno));
+  }
+  file_size_ = file_stat.st_size;
+
+  if (file_size_ < BINARY_FABRIC_BITSTREAM_HEADER_SIZE) {
+    close(fd);
+    archfpga_throw(fname_.c_str(), 0,
+                   "Binary fabric bitstream file is too small (%lu bytes) to contain a header!\n",
+                   file_size_);
+  }
+
+  void* mapped_data = mmap(nullptr, file_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  /* The mapping remains valid after the file is closed */
+  close(fd);
+  if (MAP_FAILED == mapped_data) {
+    archfpga_throw(fname_.c_str(), 0,
+                   "Unable to map binary fabric bitstream file: %s\n",
+                   std::strerror(errno));
+  }
+  data_ = static_cast<const unsigned char*>(mapped_data);
+
+  /* Bits are mostly accessed in sequence, let the OS read ahead */
+  madvise(mapped_data, file_size_, MADV_SEQUENTIAL);
+
+  /* Check and decode the header. Unmap the file before reporting any error */
+  std::string error_message;
+  size_t protocol_type = 0;
+  size_t address_payload_offset = 0;
+  size_t value_payload_offset = 0;
+
+  if (0 != std::memcmp(data_, BINARY_FABRIC_BITSTREAM_MAGIC, BINARY_FABRIC_BITSTREAM_MAGIC_SIZE)) {
+    error_message = "Invalid magic number in binary fabric bitstream file!\n";
+  } else if (BINARY_FABRIC_BITSTREAM_VERSION != decode_binary_fabric_bitstream_uint(data_ + BINARY_FABRIC_BITSTREAM_VERSION_OFFSET, 4)) {
+    error_message = "Unsupported version of binary fabric bitstream file!\n";
+  } else {
+    protocol_type = decode_binary_fabric_bitstream_uint(data_ + BINARY_FABRIC_BITSTREAM_PROTOCOL_OFFSET, 4);
+    num_bits_ = read_header_field(BINARY_FABRIC_BITSTREAM_NUM_BITS_OFFSET);
+    address_length_ = read_header_field(BINARY_FABRIC_BITSTREAM_ADDRESS_LENGTH_OFFSET);
+    wl_address_length_ = read_header_field(BINARY_FABRIC_BITSTREAM_WL_ADDRESS_LENGTH_OFFSET);
+    num_regions_ = read_header_field(BINARY_FABRIC_BITSTREAM_NUM_REGIONS_OFFSET);
+    address_payload_offset = read_header_field(BINARY_FABRIC_BITSTREAM_ADDRESS_PAYLOAD_OFFSET);
+    value_payload_offset = read_header_field(BINARY_FABRIC_BITSTREAM_VALUE_PAYLOAD_OFFSET);
+
+    address_num_bytes_ = binary_fabric_bitstream_num_bytes(address_length_);
+    address_record_size_ = address_num_bytes_ + binary_fabric_bitstream_num_bytes(wl_address_length_);
+
+    /* Expected layout of the file. Any overflow means a corrupted header */
+    size_t region_table_size = 0;
+    size_t address_payload_size = 0;
+    size_t expected_address_payload_offset = 0;
+    size_t expected_value_payload_offset = 0;
+    size_t expected_file_size = 0;
+    bool valid_sizes = multiply_binary_fabric_bitstream_sizes(num_regions_, BINARY_FABRIC_BITSTREAM_REGION_ENTRY_SIZE, region_table_size)
+                    && add_binary_fabric_bitstream_sizes(BINARY_FABRIC_BITSTREAM_HEADER_SIZE, region_table_size, expected_address_payload_offset)
+                    && multiply_binary_fabric_bitstream_sizes(num_bits_, address_record_size_, address_payload_size)
+                    && add_binary_fabric_bitstream_sizes(address_payload_offset, address_payload_size, expected_value_payload_offset)
+                    && add_binary_fabric_bitstream_sizes(value_payload_offset, binary_fabric_bitstream_num_bytes(num_bits_), expected_file_size);
+
+    if (NUM_CONFIG_PROTOCOL_TYPES <= protocol_type) {
+      error_message = "Invalid configuration protocol type in binary fabric bitstream file!\n";
+    } else if ( (false == valid_sizes)
+             || (address_payload_offset != expected_address_payload_offset)
+             || (value_payload_offset != expected_value_payload_offset)
+             || (file_size_ != expected_file_size)) {
+      error_message = "Size of payloads in binary fabric bitstream file does not match its header!\n";
+    } else {
+      /* The regions should cover all the bits in sequence, without any gap or overlap */
+      const unsigned char* region_entry = data_ + BINARY_FABRIC_BITSTREAM_HEADER_SIZE;
+      size_t region_end = 0;
+      for (size_t iregion = 0; iregion < num_regions_; ++iregion) {
+        size_t first_bit = decode_binary_fabric_bitstream_uint(region_entry, 8);
+        size_t num_region_bits = decode_binary_fabric_bitstream_uint(region_entry + 8, 8);
+        if ( (first_bit != region_end)
+          || (false == add_binary_fabric_bitstream_sizes(first_bit, num_region_bits, region_end))
+          || (num_bits_ < region_end)) {
+          error_message = "Invalid region " + std::to_string(iregion) + " in binary fabric bitstream file!\n";
+          break;
+        }
+        region_entry += BINARY_FABRIC_BITSTREAM_REGION_ENTRY_SIZE;
+      }
+      if ((true == error_message.empty()) && (num_bits_ != region_end)) {
+        error_message = "Regions do not cover all the bits in binary fabric bitstream file!\n";
+      }
+    }
+  }
+
+  if (false == error_message.empty()) {
+    munmap(const_cast<unsigned char*>(data_), file_size_);
+    data_ = nullptr;
+    archfpga_throw(fname_.c_str(), 0, "%s", error_message.c_str());
+  }
+
+  config_protocol_type_ = static_cast<e_config_protocol_type>(protocol_type);
+  regions_ = data_ + BINARY_FABRIC_BITSTREAM_HEADER_SIZE;
+  addresses_ = data_ + address_payload_offset;
+  bit_values_ = data_ + value_payload_offset;
+}
+
+BinaryFabricBitstreamReader::~BinaryFabricBitstreamReader() {
+  if (nullptr != data_) {
+    munmap(const_cast<unsigned char*>(data_), file_size_);
+  }
+}
+
+/******************************************************************************
+ * Public Accessors: header
+ ******************************************************************************/
+e_config_protocol_type BinaryFabricBitstreamReader::config_protocol_type() const {
+  return config_protocol_type_;
+}
+
+size_t BinaryFabricBitstreamReader::num_bits() const {
+  return num_bits_;
+}
+
+size_t BinaryFabricBitstreamReader::address_length() const {
+  return address_length_;
+}
+
+size_t BinaryFabricBitstreamReader::wl_address_length() const {
+  return wl_address_length_;
+}
+
+size_t BinaryFabricBitstreamReader::num_regions() const {
+  return num_regions_;
+}
+
+size_t BinaryFabricBitstreamReader::region_first_bit(const size_t& region) const {
+  VTR_ASSERT(region < num_regions_);
+  return decode_binary_fabric_bitstream_uint(regions_ + region * BINARY_FABRIC_BITSTREAM_REGION_ENTRY_SIZE, 8);
+}
+
+size_t BinaryFabricBitstreamReader::region_num_bits(const size_t& region) const {
+  VTR_ASSERT(region < num_regions_);
+  return decode_binary_fabric_bitstream_uint(regions_ + region * BINARY_FABRIC_BITSTREAM_REGION_ENTRY_SIZE + 8, 8);
+}
+
+/******************************************************************************
+ * Public Accessors: bits
+ ******************************************************************************/
+bool BinaryFabricBitstreamReader::bit_value(const size_t& bit) const {
+  VTR_ASSERT(bit < num_bits_);
+  return 0 != ((bit_values_[bit / 8] >> (bit % 8)) & 1);
+}
+
+char* BinaryFabricBitstreamReader::emit_bit_address(const size_t& bit, char* buffer) const {
+  VTR_ASSERT(bit < num_bits_);
+  return emit_address(addresses_ + bit * address_record_size_, address_length_, buffer);
+}
+
+char* BinaryFabricBitstreamReader::emit_bit_wl_address(const size_t& bit, char* buffer) const {
+  VTR_ASSERT(bit < num_bits_);
+  return emit_address(addresses_ + bit * address_record_size_ + address_num_bytes_, wl_address_length_, buffer);
+}
+
+/******************************************************************************
+ * Private utilities
+ ******************************************************************************/
+uint64_t BinaryFabricBitstreamReader::read_header_field(const size_t& offset) const {
+  return decode_binary_fabric_bitstream_uint(data_ + offset, 8);
+}
+
+char* BinaryFabricBitstreamReader::emit_address(const unsigned char* address,
+                                                const size_t& length,
+                                                char* buffer) const {
+  for (size_t ibit = 0; ibit < length; ++ibit) {
+    *buffer = (1 == ((address[ibit / 8] >> (ibit % 8)) & 1)) ? '1' : '0';
+    ++buffer;
+  }
+  return buffer;
+}
+
+} /* end namespace openfpga */
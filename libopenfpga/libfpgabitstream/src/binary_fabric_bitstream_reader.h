@@ -0,0 +1,91 @@
+#ifndef BINARY_FABRIC_BITSTREAM_READER_H
+#define BINARY_FABRIC_BITSTREAM_READER_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "circuit_types.h"
+#include "binary_fabric_bitstream_format.h"
+
+/********************************************************************
+ * A reader of fabric bitstream in binary format
+ * (see binary_fabric_bitstream_format.h)
+ *
+ * The file is memory-mapped rather than loaded, so that
+ * programming tools can stream very large bitstreams:
+ * only the pages being accessed are brought into memory by the OS.
+ * Bits are expected to be accessed in sequence, but random accesses
+ * are also supported.
+ *
+ * Errors in the file are reported by archfpga_throw(),
+ * in the same way as other readers of this library.
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+class BinaryFabricBitstreamReader {
+  public: /* Public constructor */
+    /* Map the file and check its header */
+    explicit BinaryFabricBitstreamReader(const std::string& fname);
+    ~BinaryFabricBitstreamReader();
+
+    /* Not copyable */
+    BinaryFabricBitstreamReader(const BinaryFabricBitstreamReader&) = delete;
+    BinaryFabricBitstreamReader& operator=(const BinaryFabricBitstreamReader&) = delete;
+
+  public:  /* Public Accessors: header */
+    e_config_protocol_type config_protocol_type() const;
+    size_t num_bits() const;
+
+    /* Length of addresses, i.e., the number of characters in the plain text format */
+    size_t address_length() const;
+    size_t wl_address_length() const;
+
+    size_t num_regions() const;
+    size_t region_first_bit(const size_t& region) const;
+    size_t region_num_bits(const size_t& region) const;
+
+  public:  /* Public Accessors: bits */
+    bool bit_value(const size_t& bit) const;
+
+    /* Output the binary representation ('0' or '1') of the address of a bit
+     * to a buffer, which should be able to hold the length of the address.
+     * The sequence is the same as the plain text format.
+     * Return the position in the buffer just after the last character written.
+     */
+    char* emit_bit_address(const size_t& bit, char* buffer) const;
+    char* emit_bit_wl_address(const size_t& bit, char* buffer) const;
+
+  private: /* Internal utilities */
+    uint64_t read_header_field(const size_t& offset) const;
+    char* emit_address(const unsigned char* address, const size_t& length, char* buffer) const;
+
+  private: /* Internal data */
+    std::string fname_;
+
+    /* Memory-mapped file */
+    const unsigned char* data_;
+    size_t file_size_;
+
+    /* Header */
+    e_config_protocol_type config_protocol_type_;
+    size_t num_bits_;
+    size_t address_length_;
+    size_t wl_address_length_;
+    size_t num_regions_;
+
+    /* Number of bytes occupied by the addresses of a bit */
+    size_t address_num_bytes_;
+    size_t address_record_size_;
+
+    /* Payloads */
+    const unsigned char* regions_;
+    const unsigned char* addresses_;
+    const unsigned char* bit_values_;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,161 @@
+/********************************************************************
+ * This file includes member functions of the writer of
+ * fabric bitstream in binary format
+ *******************************************************************/
+#include <numeric>
+
+/* Headers from vtr util library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "binary_fabric_bitstream_writer.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/**************************************************
+ * Public Constructors
+ *************************************************/
+BinaryFabricBitstreamWriter::BinaryFabricBitstreamWriter(const std::string& fname,
+                                                         const e_config_protocol_type& config_protocol_type,
+                                                         const size_t& num_bits,
+                                                         const size_t& address_length,
+                                                         const size_t& wl_address_length)
+  : BinaryFabricBitstreamWriter(fname, config_protocol_type,
+                                num_bits, address_length, wl_address_length,
+                                std::vector<size_t>(1, num_bits)) {
+}
+
+BinaryFabricBitstreamWriter::BinaryFabricBitstreamWriter(const std::string& fname,
+                                                         const e_config_protocol_type& config_protocol_type,
+                                                         const size_t& num_bits,
+                                                         const size_t& address_length,
+                                                         const size_t& wl_address_length,
+                                                         const std::vector<size_t>& region_num_bits) {
+  /* Regions should cover all the bits */
+  VTR_ASSERT(num_bits == std::accumulate(region_num_bits.begin(), region_num_bits.end(), size_t(0)));
+
+  fname_ = fname;
+  num_bits_ = num_bits;
+  address_length_ = address_length;
+  wl_address_length_ = wl_address_length;
+  num_added_bits_ = 0;
+
+  bit_values_.resize(binary_fabric_bitstream_num_bytes(num_bits_), 0);
+  address_buffer_.resize(binary_fabric_bitstream_num_bytes(address_length_)
+                       + binary_fabric_bitstream_num_bytes(wl_address_length_));
+
+  /* Create the file stream */
+  fp_.open(fname_, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  check_file_stream(fname_.c_str(), fp_);
+
+  write_header(config_protocol_type, region_num_bits);
+}
+
+/******************************************************************************
+ * Public Mutators
+ ******************************************************************************/
+int BinaryFabricBitstreamWriter::add_bit(const bool& value,
+                                         const char* address,
+                                         const char* wl_address) {
+  if (false == valid_file_stream(fp_)) {
+    return 1;
+  }
+
+  if (num_added_bits_ == num_bits_) {
+    VTR_LOG_ERROR("Binary fabric bitstream '%s' expects only %lu bits!\n",
+                  fname_.c_str(), num_bits_);
+    return 1;
+  }
+
+  /* Pack the addresses and write them */
+  std::fill(address_buffer_.begin(), address_buffer_.end(), 0);
+  pack_address(address, address_length_, 0);
+  pack_address(wl_address, wl_address_length_, binary_fabric_bitstream_num_bytes(address_length_));
+  fp_.write(reinterpret_cast<const char*>(address_buffer_.data()), address_buffer_.size());
+
+  if (true == value) {
+    bit_values_[num_added_bits_ / 8] |= static_cast<unsigned char>(1 << (num_added_bits_ % 8));
+  }
+  num_added_bits_++;
+
+  return 0;
+}
+
+int BinaryFabricBitstreamWriter::close() {
+  if (false == valid_file_stream(fp_)) {
+    return 1;
+  }
+
+  int status = 0;
+  if (num_added_bits_ != num_bits_) {
+    VTR_LOG_ERROR("Binary fabric bitstream '%s' expects %lu bits but only %lu bits are added!\n",
+                  fname_.c_str(), num_bits_, num_added_bits_);
+    status = 1;
+  }
+
+  fp_.write(reinterpret_cast<const char*>(bit_values_.data()), bit_values_.size());
+  fp_.close();
+
+  if (true == fp_.fail()) {
+    VTR_LOG_ERROR("Failed to write binary fabric bitstream '%s'!\n",
+                  fname_.c_str());
+    status = 1;
+  }
+
+  return status;
+}
+
+/******************************************************************************
+ * Private utilities
+ ******************************************************************************/
+void BinaryFabricBitstreamWriter::write_header(const e_config_protocol_type& config_protocol_type,
+                                               const std::vector<size_t>& region_num_bits) {
+  size_t address_payload_offset = BINARY_FABRIC_BITSTREAM_HEADER_SIZE
+                                + region_num_bits.size() * BINARY_FABRIC_BITSTREAM_REGION_ENTRY_SIZE;
+  size_t value_payload_offset = address_payload_offset + num_bits_ * address_buffer_.size();
+
+  std::vector<unsigned char> header(BINARY_FABRIC_BITSTREAM_HEADER_SIZE, 0);
+  std::copy(BINARY_FABRIC_BITSTREAM_MAGIC, BINARY_FABRIC_BITSTREAM_MAGIC + BINARY_FABRIC_BITSTREAM_MAGIC_SIZE, header.begin());
+  encode_binary_fabric_bitstream_uint(BINARY_FABRIC_BITSTREAM_VERSION, 4, &header[BINARY_FABRIC_BITSTREAM_VERSION_OFFSET]);
+  encode_binary_fabric_bitstream_uint(size_t(config_protocol_type), 4, &header[BINARY_FABRIC_BITSTREAM_PROTOCOL_OFFSET]);
+  encode_binary_fabric_bitstream_uint(num_bits_, 8, &header[BINARY_FABRIC_BITSTREAM_NUM_BITS_OFFSET]);
+  encode_binary_fabric_bitstream_uint(address_length_, 8, &header[BINARY_FABRIC_BITSTREAM_ADDRESS_LENGTH_OFFSET]);
+  encode_binary_fabric_bitstream_uint(wl_address_length_, 8, &header[BINARY_FABRIC_BITSTREAM_WL_ADDRESS_LENGTH_OFFSET]);
+  encode_binary_fabric_bitstream_uint(region_num_bits.size(), 8, &header[BINARY_FABRIC_BITSTREAM_NUM_REGIONS_OFFSET]);
+  encode_binary_fabric_bitstream_uint(address_payload_offset, 8, &header[BINARY_FABRIC_BITSTREAM_ADDRESS_PAYLOAD_OFFSET]);
+  encode_binary_fabric_bitstream_uint(value_payload_offset, 8, &header[BINARY_FABRIC_BITSTREAM_VALUE_PAYLOAD_OFFSET]);
+
+  /* Region table */
+  size_t region_first_bit = 0;
+  for (const size_t& num_region_bits : region_num_bits) {
+    unsigned char region_entry[BINARY_FABRIC_BITSTREAM_REGION_ENTRY_SIZE];
+    encode_binary_fabric_bitstream_uint(region_first_bit, 8, region_entry);
+    encode_binary_fabric_bitstream_uint(num_region_bits, 8, region_entry + 8);
+    header.insert(header.end(), region_entry, region_entry + BINARY_FABRIC_BITSTREAM_REGION_ENTRY_SIZE);
+    region_first_bit += num_region_bits;
+  }
+
+  fp_.write(reinterpret_cast<const char*>(header.data()), header.size());
+}
+
+/* Pack an address into the address buffer from a given byte */
+void BinaryFabricBitstreamWriter::pack_address(const char* address,
+                                               const size_t& length,
+                                               const size_t& byte_offset) {
+  if (0 == length) {
+    return;
+  }
+  VTR_ASSERT(nullptr != address);
+
+  for (size_t ibit = 0; ibit < length; ++ibit) {
+    if ('1' == address[ibit]) {
+      address_buffer_[byte_offset + ibit / 8] |= static_cast<unsigned char>(1 << (ibit % 8));
+    }
+  }
+}
+
+} /* end namespace openfpga */
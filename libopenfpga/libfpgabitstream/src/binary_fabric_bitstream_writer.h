@@ -0,0 +1,101 @@
+#ifndef BINARY_FABRIC_BITSTREAM_WRITER_H
+#define BINARY_FABRIC_BITSTREAM_WRITER_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include <vector>
+#include <fstream>
+#include "circuit_types.h"
+#include "binary_fabric_bitstream_format.h"
+
+/********************************************************************
+ * A writer to output a fabric bitstream to the binary container
+ * (see binary_fabric_bitstream_format.h)
+ *
+ * Bits are added one by one, so that the fabric bitstream does not
+ * need to be duplicated in memory.
+ * Addresses are written to the file as soon as they are added,
+ * while the packed bit values are written when the writer is closed.
+ *
+ * Example:
+ *   BinaryFabricBitstreamWriter writer(fname, CONFIG_MEM_FRAME_BASED, num_bits, addr_length, 0);
+ *   for (each bit) {
+ *     writer.add_bit(value, address, nullptr);
+ *   }
+ *   int status = writer.close();
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+class BinaryFabricBitstreamWriter {
+  public: /* Public constructor */
+    /* Open the file and write the header.
+     * The bits belong to a single region
+     */
+    BinaryFabricBitstreamWriter(const std::string& fname,
+                                const e_config_protocol_type& config_protocol_type,
+                                const size_t& num_bits,
+                                const size_t& address_length,
+                                const size_t& wl_address_length);
+
+    /* Open the file and write the header.
+     * The bits are split into regions in sequence, each of which has the given number of bits
+     */
+    BinaryFabricBitstreamWriter(const std::string& fname,
+                                const e_config_protocol_type& config_protocol_type,
+                                const size_t& num_bits,
+                                const size_t& address_length,
+                                const size_t& wl_address_length,
+                                const std::vector<size_t>& region_num_bits);
+
+    /* Not copyable */
+    BinaryFabricBitstreamWriter(const BinaryFabricBitstreamWriter&) = delete;
+    BinaryFabricBitstreamWriter& operator=(const BinaryFabricBitstreamWriter&) = delete;
+
+  public:  /* Public Mutators */
+    /* Add a bit to the file
+     * Addresses are the binary representations ('0' or '1') in the same sequence
+     * as the plain text format, which are the output of FabricBitstream::emit_bit_address()
+     * An address can be nullptr only when its length is zero
+     * Return 0 if succeed, 1 if critical errors occured
+     */
+    int add_bit(const bool& value,
+                const char* address,
+                const char* wl_address);
+
+    /* Write the bit values and close the file
+     * Return 0 if succeed, 1 if critical errors occured
+     */
+    int close();
+
+  private: /* Internal utilities */
+    void write_header(const e_config_protocol_type& config_protocol_type,
+                      const std::vector<size_t>& region_num_bits);
+    void pack_address(const char* address,
+                      const size_t& length,
+                      const size_t& byte_offset);
+
+  private: /* Internal data */
+    std::string fname_;
+    std::fstream fp_;
+
+    size_t num_bits_;
+    size_t address_length_;
+    size_t wl_address_length_;
+
+    /* Number of bits which have been added */
+    size_t num_added_bits_;
+
+    /* Packed bit values, which are written when closing the file */
+    std::vector<unsigned char> bit_values_;
+
+    /* Buffer to pack the addresses of a bit */
+    std::vector<unsigned char> address_buffer_;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -2,6 +2,7 @@
  * This file includes member functions for data structure BitstreamManager 
  ******************************************************************************/
 #include <algorithm>
+#include <limits>
 
 #include "vtr_assert.h"
 #include "bitstream_manager.h"
@@ -16,7 +17,6 @@ BitstreamManager::BitstreamManager() {
   num_blocks_ = 0;
   num_bits_ = 0;
   invalid_block_ids_.clear();
-  invalid_bit_ids_.clear();
 }
 
 /**************************************************
@@ -28,8 +28,8 @@ size_t BitstreamManager::num_bits() const {
 }
 
 BitstreamManager::config_bit_range BitstreamManager::bits() const {
-  return vtr::make_range(config_bit_iterator(ConfigBitId(0), invalid_bit_ids_),
-                         config_bit_iterator(ConfigBitId(num_bits_), invalid_bit_ids_));
+  return vtr::make_range(config_bit_iterator(ConfigBitId(0)),
+                         config_bit_iterator(ConfigBitId(num_bits_)));
 }
 
 size_t BitstreamManager::num_blocks() const {
@@ -49,17 +49,29 @@ bool BitstreamManager::bit_value(const ConfigBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
-  return '1' == bit_values_[bit_id];
+  size_t bit_index = size_t(bit_id);
+  return 0 != ((bit_values_[bit_index / BIT_WORD_SIZE] >> (bit_index % BIT_WORD_SIZE)) & 1);
 }
 
 ConfigBlockId BitstreamManager::bit_parent_block(const ConfigBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
-  return bit_parent_blocks_[bit_id];
+  /* Find the first block whose lsb is beyond the bit,
+   * the parent block is the one just before it
+   */
+  std::vector<ConfigBlockId>::const_iterator it = std::upper_bound(bit_blocks_.begin(), bit_blocks_.end(), size_t(bit_id),
+                                                                   [&](const size_t& bit_index, const ConfigBlockId& block) {
+                                                                     return bit_index < block_bit_id_lsbs_[block];
+                                                                   });
+  VTR_ASSERT(it != bit_blocks_.begin());
+  const ConfigBlockId& parent_block = *(--it);
+  VTR_ASSERT(size_t(bit_id) < block_bit_id_lsbs_[parent_block] + block_bit_lengths_[parent_block]);
+
+  return parent_block;
 }
 
-std::string BitstreamManager::block_name(const ConfigBlockId& block_id) const {
+const std::string& BitstreamManager::block_name(const ConfigBlockId& block_id) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
@@ -73,7 +85,7 @@ ConfigBlockId BitstreamManager::block_parent(const ConfigBlockId& block_id) cons
   return parent_block_ids_[block_id];
 }
 
-std::vector<ConfigBlockId> BitstreamManager::block_children(const ConfigBlockId& block_id) const {
+const std::vector<ConfigBlockId>& BitstreamManager::block_children(const ConfigBlockId& block_id) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
@@ -100,6 +112,21 @@ std::vector<ConfigBitId> BitstreamManager::block_bits(const ConfigBlockId& block
   return bits;
 }
 
+BitstreamManager::config_bit_range BitstreamManager::block_bit_range(const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+
+  size_t length = block_bit_lengths_[block_id]; 
+  if (0 == length) {
+    return vtr::make_range(config_bit_iterator(ConfigBitId(0)),
+                           config_bit_iterator(ConfigBitId(0)));
+  }
+
+  size_t lsb = block_bit_id_lsbs_[block_id]; 
+  return vtr::make_range(config_bit_iterator(ConfigBitId(lsb)),
+                         config_bit_iterator(ConfigBitId(lsb + length)));
+}
+
 /* Find the child block in a bitstream manager with a given name */
 ConfigBlockId BitstreamManager::find_child_block(const ConfigBlockId& block_id, 
                                                  const std::string& child_block_name) const {
@@ -130,34 +157,87 @@ int BitstreamManager::block_path_id(const ConfigBlockId& block_id) const {
   return block_path_ids_[block_id];
 }
 
-std::string BitstreamManager::block_input_net_ids(const ConfigBlockId& block_id) const {
+const std::string& BitstreamManager::block_input_net_ids(const ConfigBlockId& block_id) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
   return block_input_net_ids_[block_id];
 }
 
-std::string BitstreamManager::block_output_net_ids(const ConfigBlockId& block_id) const {
+const std::string& BitstreamManager::block_output_net_ids(const ConfigBlockId& block_id) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
   return block_output_net_ids_[block_id];
 }
 
+size_t BitstreamManager::memory_usage() const {
+  size_t num_bytes = sizeof(BitstreamManager);
+
+  /* Bits */
+  num_bytes += bit_values_.capacity() * sizeof(uint64_t);
+  num_bytes += bit_blocks_.capacity() * sizeof(ConfigBlockId);
+
+  /* Blocks */
+  num_bytes += block_bit_id_lsbs_.capacity() * sizeof(size_t);
+  num_bytes += block_bit_lengths_.capacity() * sizeof(short);
+  num_bytes += block_path_ids_.capacity() * sizeof(short);
+  num_bytes += parent_block_ids_.capacity() * sizeof(ConfigBlockId);
+  num_bytes += block_names_.capacity() * sizeof(std::string);
+  num_bytes += block_input_net_ids_.capacity() * sizeof(std::string);
+  num_bytes += block_output_net_ids_.capacity() * sizeof(std::string);
+  num_bytes += child_block_ids_.capacity() * sizeof(std::vector<ConfigBlockId>);
+  const size_t& inline_string_capacity = std::string().capacity();
+  for (const ConfigBlockId& block : blocks()) {
+    /* Short strings are stored inside std::string itself, only count heap allocations */
+    if (block_names_[block].capacity() > inline_string_capacity) {
+      num_bytes += block_names_[block].capacity();
+    }
+    if (block_input_net_ids_[block].capacity() > inline_string_capacity) {
+      num_bytes += block_input_net_ids_[block].capacity();
+    }
+    if (block_output_net_ids_[block].capacity() > inline_string_capacity) {
+      num_bytes += block_output_net_ids_[block].capacity();
+    }
+    num_bytes += child_block_ids_[block].capacity() * sizeof(ConfigBlockId);
+  }
+
+  return num_bytes;
+}
+
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
 ConfigBitId BitstreamManager::add_bit(const ConfigBlockId& parent_block, const bool& bit_value) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(parent_block));
+
   ConfigBitId bit = ConfigBitId(num_bits_);
-  /* Add a new bit, and allocate associated data structures */
-  num_bits_++;
-  if (true == bit_value) {
-    bit_values_.push_back('1');
+
+  /* Register the bit in the range of its parent block.
+   * Bits of a block must be contiguous: the parent block is either 
+   * the last block which has been given bits, or a block without any bits
+   */
+  if ((false == bit_blocks_.empty()) && (parent_block == bit_blocks_.back())) {
+    VTR_ASSERT(block_bit_id_lsbs_[parent_block] + block_bit_lengths_[parent_block] == num_bits_);
+    VTR_ASSERT(block_bit_lengths_[parent_block] < std::numeric_limits<short>::max());
+    block_bit_lengths_[parent_block]++;
   } else {
-    bit_values_.push_back('0');
+    VTR_ASSERT_MSG(0 == block_bit_lengths_[parent_block],
+                   "Bits of a block must be added in a row");
+    block_bit_id_lsbs_[parent_block] = num_bits_;
+    block_bit_lengths_[parent_block] = 1;
+    bit_blocks_.push_back(parent_block);
   }
 
-  bit_parent_blocks_.push_back(parent_block);
+  /* Add a new bit, and allocate associated data structures */
+  if (0 == num_bits_ % BIT_WORD_SIZE) {
+    bit_values_.push_back(0);
+  }
+  if (true == bit_value) {
+    bit_values_.back() |= (uint64_t(1) << (num_bits_ % BIT_WORD_SIZE));
+  }
+  num_bits_++;
 
   return bit; 
 }
@@ -166,6 +246,7 @@ void BitstreamManager::reserve_blocks(const size_t& num_blocks) {
   block_names_.reserve(num_blocks);
   block_bit_id_lsbs_.reserve(num_blocks);
   block_bit_lengths_.reserve(num_blocks);
+  bit_blocks_.reserve(num_blocks);
   block_path_ids_.reserve(num_blocks);
   block_input_net_ids_.reserve(num_blocks);
   block_output_net_ids_.reserve(num_blocks);
@@ -174,7 +255,7 @@ void BitstreamManager::reserve_blocks(const size_t& num_blocks) {
 }
 
 void BitstreamManager::reserve_bits(const size_t& num_bits) {
-  bit_values_.reserve(num_bits);
+  bit_values_.reserve((num_bits + BIT_WORD_SIZE - 1) / BIT_WORD_SIZE);
 }
 
 ConfigBlockId BitstreamManager::create_block() {
@@ -221,13 +302,12 @@ void BitstreamManager::add_child_block(const ConfigBlockId& parent_block, const
   VTR_ASSERT(true == valid_block_id(parent_block));
   VTR_ASSERT(true == valid_block_id(child_block));
 
-  /* We should have only a parent block for each block! */
+  /* We should have only a parent block for each block! 
+   * This also ensures that the child block is not in the list of children of the parent block,
+   * which is not searched as a parent block may have tens of thousands of children
+   */
   VTR_ASSERT(ConfigBlockId::INVALID() == parent_block_ids_[child_block]);
 
-  /* Ensure the child block is not in the list of children of the parent block */
-  std::vector<ConfigBlockId>::iterator it = std::find(child_block_ids_[parent_block].begin(), child_block_ids_[parent_block].end(), child_block);
-  VTR_ASSERT(it == child_block_ids_[parent_block].end());
-
   /* Add the child_block to the parent_block */
   child_block_ids_[parent_block].push_back(child_block);
   /* Register the block in the parent of the block */
@@ -239,9 +319,9 @@ void BitstreamManager::add_block_bits(const ConfigBlockId& block,
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block));
 
-  /* Add the bit to the block, record anchors in bit indexing for block-level searching */
-  block_bit_id_lsbs_[block] = num_bits_;
-  block_bit_lengths_[block] = block_bitstream.size();
+  /* Add the bit to the block, the anchors in bit indexing for block-level searching
+   * are recorded by add_bit() 
+   */
   for (const bool& bit : block_bitstream) {
     add_bit(block, bit);
   }
@@ -273,6 +353,75 @@ void BitstreamManager::add_output_net_id_to_block(const ConfigBlockId& block,
   block_output_net_ids_[block] = output_net_id;
 }
 
+void BitstreamManager::add_fragment(const ConfigBlockId& parent_block,
+                                    const BitstreamManager& fragment) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(parent_block));
+  /* The first block of the fragment is the stand-in of the parent block, 
+   * which should not contain any bits
+   */
+  VTR_ASSERT(0 < fragment.num_blocks());
+  VTR_ASSERT(true == fragment.invalid_block_ids_.empty());
+  const ConfigBlockId fragment_root = ConfigBlockId(0);
+  VTR_ASSERT(0 == fragment.block_bit_lengths_[fragment_root]);
+  VTR_ASSERT(ConfigBlockId::INVALID() == fragment.parent_block_ids_[fragment_root]);
+
+  /* Block i (i > 0) of the fragment is mapped to block (num_blocks_ + i - 1) */
+  const size_t block_offset = num_blocks_ - 1;
+  const size_t bit_offset = num_bits_;
+
+  /* Append the bits, whose values are shifted when the last word is not full */
+  size_t bit_shift = num_bits_ % BIT_WORD_SIZE;
+  for (const uint64_t& word : fragment.bit_values_) {
+    if (0 == bit_shift) {
+      bit_values_.push_back(word);
+    } else {
+      bit_values_.back() |= (word << bit_shift);
+      bit_values_.push_back(word >> (BIT_WORD_SIZE - bit_shift));
+    }
+  }
+  num_bits_ += fragment.num_bits_;
+  /* Drop the word which only contains unused bits (always zeros) */
+  bit_values_.resize((num_bits_ + BIT_WORD_SIZE - 1) / BIT_WORD_SIZE);
+
+  /* Append the blocks except the root */
+  for (size_t iblk = 1; iblk < fragment.num_blocks_; ++iblk) {
+    ConfigBlockId fragment_block = ConfigBlockId(iblk);
+    ConfigBlockId block = create_block();
+    VTR_ASSERT(size_t(block) == block_offset + iblk);
+
+    block_names_[block] = fragment.block_names_[fragment_block];
+    block_bit_lengths_[block] = fragment.block_bit_lengths_[fragment_block];
+    if (0 < block_bit_lengths_[block]) {
+      block_bit_id_lsbs_[block] = bit_offset + fragment.block_bit_id_lsbs_[fragment_block];
+    }
+    block_path_ids_[block] = fragment.block_path_ids_[fragment_block];
+    block_input_net_ids_[block] = fragment.block_input_net_ids_[fragment_block];
+    block_output_net_ids_[block] = fragment.block_output_net_ids_[fragment_block];
+
+    child_block_ids_[block].reserve(fragment.child_block_ids_[fragment_block].size());
+    for (const ConfigBlockId& fragment_child : fragment.child_block_ids_[fragment_block]) {
+      child_block_ids_[block].push_back(ConfigBlockId(block_offset + size_t(fragment_child)));
+    }
+
+    const ConfigBlockId& fragment_parent = fragment.parent_block_ids_[fragment_block];
+    VTR_ASSERT(ConfigBlockId::INVALID() != fragment_parent);
+    if (fragment_root != fragment_parent) {
+      parent_block_ids_[block] = ConfigBlockId(block_offset + size_t(fragment_parent));
+    }
+  }
+
+  /* Children of the root are adopted by the parent block */
+  for (const ConfigBlockId& fragment_child : fragment.child_block_ids_[fragment_root]) {
+    add_child_block(parent_block, ConfigBlockId(block_offset + size_t(fragment_child)));
+  }
+
+  /* Bit blocks are in the same sequence as the fragment */
+  for (const ConfigBlockId& fragment_block : fragment.bit_blocks_) {
+    bit_blocks_.push_back(ConfigBlockId(block_offset + size_t(fragment_block)));
+  }
+}
+
 /******************************************************************************
  * Public Validators
  ******************************************************************************/
@@ -29,11 +29,21 @@
  * 1. Each block inside BitstreamManager should have only 1 parent block 
  *    and multiple child block
  * 2. Each bit inside BitstreamManager should have only 1 parent block 
+ * 3. The bits of a block should be added in a row, so that they occupy
+ *    a contiguous range of bit ids
+ *
+ * Memory efficiency
+ * -----------------
+ * Large devices may contain hundreds of millions of configuration bits.
+ * Therefore, no per-bit data is stored other than the bit value itself, 
+ * which is packed into 64-bit words. The parent block of a bit is derived 
+ * from the bit ranges of blocks (see restriction 3)
  * 
  ******************************************************************************/
 #ifndef BITSTREAM_MANAGER_H
 #define BITSTREAM_MANAGER_H
 
+#include <cstdint>
 #include <vector>
 #include <map>
 #include <unordered_set>
@@ -93,6 +103,42 @@ class BitstreamManager {
         const std::unordered_set<ID>& invalid_ids_;
     };
 
+    /*
+     * A lightweight version of the lazy_id_iterator for ID spaces 
+     * which never contain any invalid ID, e.g., the configuration bits.
+     * It avoids a look-up in an invalid ID set each time it is dereferenced.
+     */
+    template<class ID>
+    class dense_id_iterator : public std::iterator<std::bidirectional_iterator_tag, ID> {
+      public:
+        typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::value_type value_type;
+        typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::iterator iterator;
+
+        explicit dense_id_iterator(value_type init)
+            : value_(init) {}
+
+        //Advance to the next ID value
+        iterator operator++() {
+            value_ = ID(size_t(value_) + 1);
+            return *this;
+        }
+
+        //Advance to the previous ID value
+        iterator operator--() {
+            value_ = ID(size_t(value_) - 1);
+            return *this;
+        }
+
+        //Dereference the iterator
+        value_type operator*() const { return value_; }
+
+        friend bool operator==(const dense_id_iterator<ID> lhs, const dense_id_iterator<ID> rhs) { return lhs.value_ == rhs.value_; }
+        friend bool operator!=(const dense_id_iterator<ID> lhs, const dense_id_iterator<ID> rhs) { return !(lhs == rhs); }
+
+      private:
+        value_type value_;
+    };
+
   public: /* Public constructor */
     BitstreamManager();
 
@@ -101,7 +147,10 @@ class BitstreamManager {
     template<class ID>
     class lazy_id_iterator;
 
-    typedef lazy_id_iterator<ConfigBitId> config_bit_iterator;
+    template<class ID>
+    class dense_id_iterator;
+
+    typedef dense_id_iterator<ConfigBitId> config_bit_iterator;
     typedef lazy_id_iterator<ConfigBlockId> config_block_iterator;
 
     typedef vtr::Range<config_bit_iterator> config_bit_range;
@@ -123,17 +172,20 @@ class BitstreamManager {
     ConfigBlockId bit_parent_block(const ConfigBitId& bit_id) const;
 
     /* Find a name of a block */
-    std::string block_name(const ConfigBlockId& block_id) const;
+    const std::string& block_name(const ConfigBlockId& block_id) const;
 
     /* Find the parent of a block */
     ConfigBlockId block_parent(const ConfigBlockId& block_id) const;
 
     /* Find the children of a block */
-    std::vector<ConfigBlockId> block_children(const ConfigBlockId& block_id) const;
+    const std::vector<ConfigBlockId>& block_children(const ConfigBlockId& block_id) const;
 
     /* Find all the bits that belong to a block */
     std::vector<ConfigBitId> block_bits(const ConfigBlockId& block_id) const;
 
+    /* Find all the bits that belong to a block without creating a list */
+    config_bit_range block_bit_range(const ConfigBlockId& block_id) const;
+
     /* Find the child block in a bitstream manager with a given name */
     ConfigBlockId find_child_block(const ConfigBlockId& block_id, const std::string& child_block_name) const;
 
@@ -141,13 +193,19 @@ class BitstreamManager {
     int block_path_id(const ConfigBlockId& block_id) const;
 
     /* Find input net ids of a block */
-    std::string block_input_net_ids(const ConfigBlockId& block_id) const;
+    const std::string& block_input_net_ids(const ConfigBlockId& block_id) const;
 
     /* Find input net ids of a block */
-    std::string block_output_net_ids(const ConfigBlockId& block_id) const;
+    const std::string& block_output_net_ids(const ConfigBlockId& block_id) const;
+
+    /* Estimate the number of bytes occupied by the bitstream manager in memory */
+    size_t memory_usage() const;
 
   public:  /* Public Mutators */
-    /* Add a new configuration bit to the bitstream manager */
+    /* Add a new configuration bit to the bitstream manager
+     * Note that the parent block should be either the last block which 
+     * has been given any bits or a block without any bits 
+     */
     ConfigBitId add_bit(const ConfigBlockId& parent_block, const bool& bit_value);
 
     /* Reserve memory for a number of clocks */
@@ -186,6 +244,15 @@ class BitstreamManager {
     /* Add an output net id to a block */
     void add_output_net_id_to_block(const ConfigBlockId& block, const std::string& output_net_id);
 
+    /* Append the blocks and bits of another bitstream manager, 
+     * which is built separately (e.g., by another thread), as a fragment of this one
+     * The first block of the fragment stands for the parent block and is not copied,
+     * its child blocks become the child blocks of the parent block.
+     * The blocks and bits are appended in the sequence of the fragment, 
+     * so that the result is the same as building the fragment directly under the parent block
+     */
+    void add_fragment(const ConfigBlockId& parent_block, const BitstreamManager& fragment);
+
   public:  /* Public Validators */
     bool valid_bit_id(const ConfigBitId& bit_id) const;
 
@@ -193,6 +260,10 @@ class BitstreamManager {
 
     bool valid_block_path_id(const ConfigBlockId& block_id) const;
 
+  private: /* Internal utilities */
+    /* Number of bits that can be stored in a word of the packed bit values */
+    static constexpr size_t BIT_WORD_SIZE = 64;
+
   private: /* Internal data */
     /* Unique id of a block of bits in the Bitstream */
     size_t num_blocks_; 
@@ -233,12 +304,18 @@ class BitstreamManager {
     vtr::vector<ConfigBlockId, std::string> block_input_net_ids_; 
     vtr::vector<ConfigBlockId, std::string> block_output_net_ids_; 
 
-    /* Unique id of a bit in the Bitstream */
+    /* Unique id of a bit in the Bitstream
+     * Bit ids are always contiguous, there is no invalid bit id 
+     */
     size_t num_bits_; 
-    std::unordered_set<ConfigBitId> invalid_bit_ids_; 
-    /* value of a bit in the Bitstream */
-    vtr::vector<ConfigBitId, char> bit_values_;
-    vtr::vector<ConfigBitId, ConfigBlockId> bit_parent_blocks_;
+    /* Values of the bits in the Bitstream, packed by BIT_WORD_SIZE bits per word 
+     * The value of bit i is at position (i % BIT_WORD_SIZE) of word (i / BIT_WORD_SIZE)
+     */
+    std::vector<uint64_t> bit_values_;
+    /* Blocks which contain any bit, in the ascending order of their bit id lsbs 
+     * The parent block of a bit is found by a binary search on this list
+     */
+    std::vector<ConfigBlockId> bit_blocks_;
 };
 
 } /* end namespace openfpga */
@@ -71,5 +71,36 @@ size_t find_bitstream_manager_config_bit_index_in_parent_block(const BitstreamMa
   return curr_index;
 }
 
+/********************************************************************
+ * Recursively copy a block of a bitstream manager, including its bits
+ * and all its child blocks, to another bitstream manager
+ * under a given parent block 
+ * Return the id of the copied block in the destination bitstream manager
+ *******************************************************************/
+ConfigBlockId rec_copy_bitstream_manager_block(BitstreamManager& bitstream_manager,
+                                               const ConfigBlockId& parent_block,
+                                               const BitstreamManager& src_bitstream_manager,
+                                               const ConfigBlockId& src_block) {
+  ConfigBlockId block = bitstream_manager.add_block(src_bitstream_manager.block_name(src_block));
+  bitstream_manager.add_child_block(parent_block, block);
+
+  if (true == src_bitstream_manager.valid_block_path_id(src_block)) {
+    bitstream_manager.add_path_id_to_block(block, src_bitstream_manager.block_path_id(src_block));
+  }
+  bitstream_manager.add_input_net_id_to_block(block, src_bitstream_manager.block_input_net_ids(src_block));
+  bitstream_manager.add_output_net_id_to_block(block, src_bitstream_manager.block_output_net_ids(src_block));
+
+  for (const ConfigBitId& src_bit : src_bitstream_manager.block_bit_range(src_block)) {
+    bitstream_manager.add_bit(block, src_bitstream_manager.bit_value(src_bit));
+  }
+
+  bitstream_manager.reserve_child_blocks(block, src_bitstream_manager.block_children(src_block).size());
+  for (const ConfigBlockId& src_child : src_bitstream_manager.block_children(src_block)) {
+    rec_copy_bitstream_manager_block(bitstream_manager, block, src_bitstream_manager, src_child);
+  }
+
+  return block;
+}
+
 
 } /* end namespace openfpga */
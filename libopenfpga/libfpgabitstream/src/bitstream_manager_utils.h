@@ -22,6 +22,11 @@ std::vector<ConfigBlockId> find_bitstream_manager_top_blocks(const BitstreamMana
 size_t find_bitstream_manager_config_bit_index_in_parent_block(const BitstreamManager& bitstream_manager,
                                                                const ConfigBitId& bit_id);
 
+ConfigBlockId rec_copy_bitstream_manager_block(BitstreamManager& bitstream_manager,
+                                               const ConfigBlockId& parent_block,
+                                               const BitstreamManager& src_bitstream_manager,
+                                               const ConfigBlockId& src_block);
+
 } /* end namespace openfpga */
 
 #endif
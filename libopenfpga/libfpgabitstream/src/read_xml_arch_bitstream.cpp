@@ -1,13 +1,11 @@
 /********************************************************************
  * This file includes the top-level function of this library
- * which reads an XML of a fabric key to the associated
+ * which reads an XML of an architecture bitstream to the associated
  * data structures
  *******************************************************************/
+#include <cstdlib>
 #include <string>
-
-/* Headers from pugi XML library */
-#include "pugixml.hpp"
-#include "pugixml_util.hpp"
+#include <vector>
 
 /* Headers from vtr util library */
 #include "vtr_assert.h"
@@ -15,130 +13,107 @@
 
 /* Headers from libarchfpga */
 #include "arch_error.h"
-#include "read_xml_util.h"
 
 #include "openfpga_reserved_words.h"
 
+#include "xml_stream_reader.h"
 #include "read_xml_arch_bitstream.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Types of the XML nodes in an architecture bitstream file */
+enum e_xml_arch_bitstream_node {
+  XML_ARCH_BITSTREAM_BLOCK,
+  XML_ARCH_BITSTREAM_HIERARCHY,
+  XML_ARCH_BITSTREAM_INSTANCE,
+  XML_ARCH_BITSTREAM_INPUT_NETS,
+  XML_ARCH_BITSTREAM_OUTPUT_NETS,
+  XML_ARCH_BITSTREAM_PATH,
+  XML_ARCH_BITSTREAM_BITS,
+  XML_ARCH_BITSTREAM_BIT,
+  NUM_XML_ARCH_BITSTREAM_NODES
+};
+constexpr const char* XML_ARCH_BITSTREAM_NODE_NAMES[NUM_XML_ARCH_BITSTREAM_NODES] = {"bitstream_block", "hierarchy", "instance", "input_nets", "output_nets", "path", "bitstream", "bit"};
+
 /********************************************************************
- * Parse XML codes of a <bitstream_block> to an object of BitstreamManager
- * This function goes recursively until we reach the leaf node
+ * Find the type of a child node under a given parent node
+ * Error out if the child is not allowed in the parent 
  *******************************************************************/
 static 
-void rec_read_xml_bitstream_block(pugi::xml_node& xml_bitstream_block,
-                                  const pugiutil::loc_data& loc_data,
-                                  BitstreamManager& bitstream_manager,
-                                  const ConfigBlockId& parent_block) {
-
-  /* Find the name of this bitstream block */
-  const std::string& block_name = get_attribute(xml_bitstream_block, "name", loc_data).as_string();
-
-  /* Create the bitstream block */
-  ConfigBlockId curr_block = bitstream_manager.add_block(block_name);
-
-  /* Add it to parent block */
-  bitstream_manager.add_child_block(parent_block, curr_block);
-
-  /* Parse input nets if defined */
-  pugi::xml_node xml_input_nets = get_single_child(xml_bitstream_block, "input_nets", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_input_nets) {
-    std::vector<std::string> input_nets;
-    size_t num_input_nets = count_children(xml_input_nets, "path", loc_data, pugiutil::ReqOpt::OPTIONAL);
-    input_nets.resize(num_input_nets);
-
-    /* Find the child paths/nets */
-    for (pugi::xml_node xml_input_net : xml_input_nets.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_input_net.name() != std::string("path")) {
-        bad_tag(xml_input_net, loc_data, xml_input_nets, {"path"});
-      }
-      const int& id = get_attribute(xml_input_net, "id", loc_data).as_int();
-      const std::string& net_name = get_attribute(xml_input_net, "net_name", loc_data).as_string();
-      VTR_ASSERT((size_t)id < input_nets.size());
-      input_nets[id] = net_name; 
-    } 
-
-    std::string input_nets_str;
-    bool need_splitter = false;
-    for (const std::string& input_net : input_nets) {
-      if (true == need_splitter) {
-        input_nets_str += std::string(" ");
-      }
-      input_nets_str += input_net;
-      need_splitter = true;
+e_xml_arch_bitstream_node find_xml_arch_bitstream_child_node(const XmlStreamReader& reader,
+                                                             const e_xml_arch_bitstream_node& parent_node) {
+  /* Child nodes allowed under each type of parent node, 
+   * where the list ends with NUM_XML_ARCH_BITSTREAM_NODES.
+   * Leaf nodes have no child
+   */
+  static const e_xml_arch_bitstream_node child_nodes[NUM_XML_ARCH_BITSTREAM_NODES][6] = {
+    {XML_ARCH_BITSTREAM_BLOCK, XML_ARCH_BITSTREAM_HIERARCHY, XML_ARCH_BITSTREAM_INPUT_NETS, XML_ARCH_BITSTREAM_OUTPUT_NETS, XML_ARCH_BITSTREAM_BITS, NUM_XML_ARCH_BITSTREAM_NODES},
+    {XML_ARCH_BITSTREAM_INSTANCE, NUM_XML_ARCH_BITSTREAM_NODES},
+    {NUM_XML_ARCH_BITSTREAM_NODES},
+    {XML_ARCH_BITSTREAM_PATH, NUM_XML_ARCH_BITSTREAM_NODES},
+    {XML_ARCH_BITSTREAM_PATH, NUM_XML_ARCH_BITSTREAM_NODES},
+    {NUM_XML_ARCH_BITSTREAM_NODES},
+    {XML_ARCH_BITSTREAM_BIT, NUM_XML_ARCH_BITSTREAM_NODES},
+    {NUM_XML_ARCH_BITSTREAM_NODES}
+  };
+
+  for (const e_xml_arch_bitstream_node* child_node = child_nodes[parent_node];
+       NUM_XML_ARCH_BITSTREAM_NODES != *child_node; 
+       ++child_node) {
+    if (reader.name() == XML_ARCH_BITSTREAM_NODE_NAMES[*child_node]) {
+      return *child_node;
     }
-    bitstream_manager.add_input_net_id_to_block(curr_block, input_nets_str); 
   }
 
-  /* Parse output nets if defined */
-  pugi::xml_node xml_output_nets = get_single_child(xml_bitstream_block, "output_nets", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_output_nets) {
-    std::vector<std::string> output_nets;
-    size_t num_output_nets = count_children(xml_output_nets, "path", loc_data, pugiutil::ReqOpt::OPTIONAL);
-    output_nets.resize(num_output_nets);
-
-    /* Find the child paths/nets */
-    for (pugi::xml_node xml_output_net : xml_output_nets.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_output_net.name() != std::string("path")) {
-        bad_tag(xml_output_net, loc_data, xml_output_nets, {"path"});
-      }
-      const int& id = get_attribute(xml_output_net, "id", loc_data).as_int();
-      const std::string& net_name = get_attribute(xml_output_net, "net_name", loc_data).as_string();
-      VTR_ASSERT((size_t)id < output_nets.size());
-      output_nets[id] = net_name; 
-    } 
-
-    std::string output_nets_str;
-    bool need_splitter = false;
-    for (const std::string& output_net : output_nets) {
-      if (true == need_splitter) {
-        output_nets_str += std::string(" ");
-      }
-      output_nets_str += output_net;
-      need_splitter = true;
-    }
-    bitstream_manager.add_output_net_id_to_block(curr_block, output_nets_str); 
-  }
+  archfpga_throw(reader.filename().c_str(), reader.line(),
+                 "Unexpected child '%s' in node '%s'\n",
+                 reader.name().c_str(), XML_ARCH_BITSTREAM_NODE_NAMES[parent_node]);
+}
 
-  /* Parse configuration bits */
-  pugi::xml_node xml_bitstream = get_single_child(xml_bitstream_block, "bitstream", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_bitstream) {
-    /* Parse path_id: -2 is an invalid value defined in the bitstream manager internally */
-    const int& path_id = get_attribute(xml_bitstream, "path_id", loc_data, pugiutil::ReqOpt::OPTIONAL).as_int(-2);
-    if (-2 < path_id) {
-      bitstream_manager.add_path_id_to_block(curr_block, path_id); 
-    }
+/********************************************************************
+ * Parse an integer attribute of the current node
+ *******************************************************************/
+static 
+int read_xml_arch_bitstream_int_attribute(const XmlStreamReader& reader,
+                                          const std::string& value) {
+  char* end = nullptr;
+  long int_value = std::strtol(value.c_str(), &end, 10);
+  if ((true == value.empty()) || ('\0' != *end)) {
+    archfpga_throw(reader.filename().c_str(), reader.line(),
+                   "Invalid integer '%s' in node '%s'\n",
+                   value.c_str(), reader.name().c_str());
+  }
+  return int(int_value);
+}
 
-    /* Find the child paths/nets */
-    std::vector<bool> block_bits;
-    for (pugi::xml_node xml_bit : xml_bitstream.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_bit.name() != std::string("bit")) {
-        bad_tag(xml_bit, loc_data, xml_bitstream, {"bit"});
-      }
-      const int& bit_value = get_attribute(xml_bit, "value", loc_data).as_int();
-      block_bits.push_back(1 == bit_value);
+/********************************************************************
+ * Merge the nets of a block into a string, split by spaces,
+ * which is how the bitstream manager stores them
+ *******************************************************************/
+static 
+std::string merge_xml_arch_bitstream_nets(const std::vector<std::string>& nets) {
+  std::string nets_str;
+  bool need_splitter = false;
+  for (const std::string& net : nets) {
+    if (true == need_splitter) {
+      nets_str += std::string(" ");
     }
-    /* Link the bit to parent block */
-    bitstream_manager.add_block_bits(curr_block, block_bits);
+    nets_str += net;
+    need_splitter = true;
   }
-  
-  /* Go recursively: find all the child blocks and parse */
-  for (pugi::xml_node xml_child : xml_bitstream_block.children()) {
-    /* We only care child bitstream blocks here */
-    if (xml_child.name() == std::string("bitstream_block")) {
-      rec_read_xml_bitstream_block(xml_child, loc_data, bitstream_manager, curr_block);
-    }
-  } 
+  return nets_str;
 }
 
 /********************************************************************
  * Parse XML codes about <bitstream> to an object of Bitstream
+ *
+ * The file is parsed in a streaming way rather than being loaded 
+ * into a DOM, so that the memory usage only depends on the bitstream manager 
+ * rather than the file size.
+ * The blocks are created as soon as their <bitstream_block> is reached, 
+ * which is in the same order as a Depth-First Search on the XML tree.
+ * The configuration bits are added to their block one by one.
  *******************************************************************/
 BitstreamManager read_xml_architecture_bitstream(const char* fname) {
 
@@ -146,51 +121,146 @@ BitstreamManager read_xml_architecture_bitstream(const char* fname) {
 
   BitstreamManager bitstream_manager;
 
-  /* Parse the file */
-  pugi::xml_document doc;
-  pugiutil::loc_data loc_data;
+  XmlStreamReader reader(fname);
+
+  /* The nodes from the root to the current one, and the blocks they belong to */
+  std::vector<e_xml_arch_bitstream_node> node_stack;
+  std::vector<ConfigBlockId> block_stack;
+  bool root_parsed = false;
+
+  /* Nets of the current block, indexed by path ids */
+  std::vector<std::string> nets;
+
+  /* The block which receives the latest configuration bit.
+   * Bits of a block must be contiguous in the bitstream manager,
+   * so a block can only receive bits when it is this block or it has no bits yet
+   */
+  ConfigBlockId bit_block = ConfigBlockId::INVALID();
+
+  while (true == reader.next()) {
+    if (true == reader.is_end_element()) {
+      /* The end of a node must match the current one */
+      if (true == node_stack.empty()) {
+        archfpga_throw(fname, reader.line(),
+                       "Unexpected end of node '%s' outside the root node\n",
+                       reader.name().c_str());
+      }
+      const e_xml_arch_bitstream_node& curr_node = node_stack.back();
+      if (reader.name() != XML_ARCH_BITSTREAM_NODE_NAMES[curr_node]) {
+        archfpga_throw(fname, reader.line(),
+                       "Expect the end of node '%s' but found the end of node '%s'\n",
+                       XML_ARCH_BITSTREAM_NODE_NAMES[curr_node], reader.name().c_str());
+      }
 
-  try {
-    loc_data = pugiutil::load_xml(doc, fname);
+      if (XML_ARCH_BITSTREAM_BLOCK == curr_node) {
+        block_stack.pop_back();
+      } else if (XML_ARCH_BITSTREAM_INPUT_NETS == curr_node) {
+        bitstream_manager.add_input_net_id_to_block(block_stack.back(), merge_xml_arch_bitstream_nets(nets));
+      } else if (XML_ARCH_BITSTREAM_OUTPUT_NETS == curr_node) {
+        bitstream_manager.add_output_net_id_to_block(block_stack.back(), merge_xml_arch_bitstream_nets(nets));
+      }
+      node_stack.pop_back();
+      continue;
+    }
 
-    /* Count the child <bitstream_block> */
+    /* The root node is the top-level block */
+    if (true == node_stack.empty()) {
+      if (true == root_parsed) {
+        archfpga_throw(fname, reader.line(),
+                       "Multiple root nodes found (only one expected)\n");
+      }
+      if (reader.name() != XML_ARCH_BITSTREAM_NODE_NAMES[XML_ARCH_BITSTREAM_BLOCK]) {
+        archfpga_throw(fname, reader.line(),
+                       "Expect the root node '%s' but found '%s'\n",
+                       XML_ARCH_BITSTREAM_NODE_NAMES[XML_ARCH_BITSTREAM_BLOCK], reader.name().c_str());
+      }
 
-    pugi::xml_node xml_root = get_single_child(doc, "bitstream_block", loc_data);
+      /* Find the name of the top block*/
+      const std::string& top_block_name = reader.attribute("name");
+      if (top_block_name != std::string(FPGA_TOP_MODULE_NAME)) {
+        archfpga_throw(fname, reader.line(),
+                       "Top-level block must be named as '%s'!\n",
+                       FPGA_TOP_MODULE_NAME);
+      }
 
-    /* Find the name of the top block*/
-    const std::string& top_block_name = get_attribute(xml_root, "name", loc_data).as_string();
-    
-    if (top_block_name != std::string(FPGA_TOP_MODULE_NAME)) {
-      archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_root),
-                     "Top-level block must be named as '%s'!\n",
-                     FPGA_TOP_MODULE_NAME);
+      /* Create the top-level block */
+      block_stack.push_back(bitstream_manager.add_block(top_block_name));
+      node_stack.push_back(XML_ARCH_BITSTREAM_BLOCK);
+      root_parsed = true;
+      continue;
     }
 
-    /* Create the top-level block */
-    ConfigBlockId top_block = bitstream_manager.add_block(top_block_name);
-
-    size_t num_blks = count_children(xml_root, "bitstream_block", loc_data, pugiutil::ReqOpt::OPTIONAL);
-
-    /* Reserve bitstream blocks in the data base */
-    bitstream_manager.reserve_blocks(num_blks);
+    e_xml_arch_bitstream_node child_node = find_xml_arch_bitstream_child_node(reader, node_stack.back());
+    node_stack.push_back(child_node);
 
-    /* Iterate over the children under this node,
-     * each child should be named after circuit_model
-     */
-    for (pugi::xml_node xml_blk : xml_root.children()) {
-      /* Error out if the XML child has an invalid name! */
-      if (xml_blk.name() != std::string("bitstream_block")) {
-        bad_tag(xml_blk, loc_data, xml_root, {"bitstream_block"});
+    switch (child_node) {
+    case XML_ARCH_BITSTREAM_BLOCK: {
+      /* Create the bitstream block and add it to parent block */
+      ConfigBlockId curr_block = bitstream_manager.add_block(reader.attribute("name"));
+      bitstream_manager.add_child_block(block_stack.back(), curr_block);
+      block_stack.push_back(curr_block);
+      break;
+    }
+    case XML_ARCH_BITSTREAM_INPUT_NETS:
+    case XML_ARCH_BITSTREAM_OUTPUT_NETS:
+      nets.clear();
+      break;
+    case XML_ARCH_BITSTREAM_PATH: {
+      int id = read_xml_arch_bitstream_int_attribute(reader, reader.attribute("id"));
+      if (0 > id) {
+        archfpga_throw(fname, reader.line(),
+                       "Invalid path id '%d'\n",
+                       id);
+      }
+      if ((size_t)id >= nets.size()) {
+        nets.resize(id + 1);
       }
-      rec_read_xml_bitstream_block(xml_blk, loc_data, bitstream_manager, top_block);
-    } 
-  } catch (pugiutil::XmlError& e) {
-    archfpga_throw(fname, e.line(),
-                   "%s", e.what());
+      nets[id] = reader.attribute("net_name");
+      break;
+    }
+    case XML_ARCH_BITSTREAM_BITS: {
+      /* Parse path_id: -2 is an invalid value defined in the bitstream manager internally */
+      const std::string* path_id_str = reader.find_attribute("path_id");
+      if (nullptr != path_id_str) {
+        int path_id = read_xml_arch_bitstream_int_attribute(reader, *path_id_str);
+        if (-2 < path_id) {
+          bitstream_manager.add_path_id_to_block(block_stack.back(), path_id); 
+        }
+      }
+      break;
+    }
+    case XML_ARCH_BITSTREAM_BIT: {
+      /* Link the bit to parent block */
+      int bit_value = read_xml_arch_bitstream_int_attribute(reader, reader.attribute("value"));
+      if ((bit_block != block_stack.back())
+         && (false == bitstream_manager.block_bit_range(block_stack.back()).empty())) {
+        archfpga_throw(fname, reader.line(),
+                       "Bits of block '%s' are split by the bits of block '%s' (bits of a block must be contiguous)\n",
+                       bitstream_manager.block_name(block_stack.back()).c_str(),
+                       bitstream_manager.block_name(bit_block).c_str());
+      }
+      bitstream_manager.add_bit(block_stack.back(), 1 == bit_value);
+      bit_block = block_stack.back();
+      break;
+    }
+    default:
+      /* Other nodes carry no information for the bitstream manager */
+      break;
+    }
+  }
+
+  if (false == root_parsed) {
+    archfpga_throw(fname, reader.line(),
+                   "Missing required child node '%s'\n",
+                   XML_ARCH_BITSTREAM_NODE_NAMES[XML_ARCH_BITSTREAM_BLOCK]);
+  }
+  if (false == node_stack.empty()) {
+    archfpga_throw(fname, reader.line(),
+                   "Unexpected end of file in node '%s'\n",
+                   XML_ARCH_BITSTREAM_NODE_NAMES[node_stack.back()]);
   }
 
   return bitstream_manager; 
 }
 
 } /* end namespace openfpga */
-
@@ -5,6 +5,7 @@
 #include <chrono>
 #include <ctime>
 #include <fstream>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -13,7 +14,6 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
-#include "openfpga_tokenizer.h"
 
 #include "openfpga_reserved_words.h"
 
@@ -23,6 +23,9 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Size of the user-space buffer of the output file stream */
+constexpr size_t XML_ARCH_BITSTREAM_FILE_BUFFER_SIZE = 1 << 20;
+
 /********************************************************************
  * This function write header information to a bitstream file
  *******************************************************************/
@@ -33,13 +36,51 @@ void write_bitstream_xml_file_head(std::fstream& fp) {
   auto end = std::chrono::system_clock::now(); 
   std::time_t end_time = std::chrono::system_clock::to_time_t(end);
 
-  fp << "<!--" << std::endl;
-  fp << "\t- Architecture independent bitstream" << std::endl;
-  fp << "\t- Author: Xifan TANG" << std::endl;
-  fp << "\t- Organization: University of Utah" << std::endl;
+  fp << "<!--\n";
+  fp << "\t- Architecture independent bitstream\n";
+  fp << "\t- Author: Xifan TANG\n";
+  fp << "\t- Organization: University of Utah\n";
   fp << "\t- Date: " << std::ctime(&end_time) ;
-  fp << "-->" << std::endl;
-  fp << std::endl;
+  fp << "-->\n";
+  fp << "\n";
+}
+
+/********************************************************************
+ * Write the nets of a block, which are stored as a string 
+ * where the net names are split by spaces, to a xml file
+ * The net names are written directly from the string
+ * without splitting it into a list
+ *******************************************************************/
+static 
+void write_block_nets_to_xml_file(std::fstream& fp,
+                                  const std::string& nets,
+                                  const char* xml_tag,
+                                  const size_t& hierarchy_level) {
+  write_tab_to_file(fp, hierarchy_level);
+  fp << "<" << xml_tag << ">\n";
+  size_t path_counter = 0;
+  size_t net_start = 0;
+  while (net_start < nets.size()) {
+    /* Skip the splitters, as the tokenizer does */
+    if (' ' == nets[net_start]) {
+      net_start++;
+      continue;
+    }
+    size_t net_end = nets.find(' ', net_start);
+    if (std::string::npos == net_end) {
+      net_end = nets.size();
+    }
+    write_tab_to_file(fp, hierarchy_level + 1);
+    fp << "<path id=\"" << path_counter << "\"";
+    fp << " net_name=\"";
+    fp.write(nets.data() + net_start, net_end - net_start);
+    fp << "\"/>\n";
+
+    path_counter++;
+    net_start = net_end;
+  }
+  write_tab_to_file(fp, hierarchy_level);
+  fp << "</" << xml_tag << ">\n";
 }
 
 /********************************************************************
@@ -49,87 +90,64 @@ void write_bitstream_xml_file_head(std::fstream& fp) {
  * 1. For block with bits as children, we will output the XML lines
  * 2. For block without bits/child blocks, we can return 
  * 3. For block with child blocks, we visit each child recursively
+ *
+ * The hierarchy of the block, i.e., all the blocks from the top-level 
+ * block to this block, is kept in a stack during the search,
+ * so that it is not rebuilt for each block
  *******************************************************************/
 static 
 void rec_write_block_bitstream_to_xml_file(std::fstream& fp,
                                            const BitstreamManager& bitstream_manager, 
                                            const ConfigBlockId& block,
-                                           const size_t& hierarchy_level) {
+                                           std::vector<ConfigBlockId>& block_hierarchy) {
   valid_file_stream(fp);
 
+  const size_t hierarchy_level = block_hierarchy.size();
+  block_hierarchy.push_back(block);
+
   /* Write the bits of this block */
   write_tab_to_file(fp, hierarchy_level);
   fp << "<bitstream_block";
   fp << " name=\"" << bitstream_manager.block_name(block)<< "\"";
   fp << " hierarchy_level=\"" << hierarchy_level << "\"";
-  fp << ">" << std::endl;
+  fp << ">\n";
 
   /* Dive to child blocks if this block has any */
   for (const ConfigBlockId& child_block : bitstream_manager.block_children(block)) {
-    rec_write_block_bitstream_to_xml_file(fp, bitstream_manager, child_block, hierarchy_level + 1);
+    rec_write_block_bitstream_to_xml_file(fp, bitstream_manager, child_block, block_hierarchy);
   }
   
-  if (0 == bitstream_manager.block_bits(block).size()) {
+  BitstreamManager::config_bit_range block_bits = bitstream_manager.block_bit_range(block);
+  if (block_bits.begin() == block_bits.end()) {
     write_tab_to_file(fp, hierarchy_level);
-    fp << "</bitstream_block>" <<std::endl;
+    fp << "</bitstream_block>\n";
+    block_hierarchy.pop_back();
     return;
   }
 
-  std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, block); 
-  
   /* Output hierarchy of this parent*/
   write_tab_to_file(fp, hierarchy_level + 1);
-  fp << "<hierarchy>" << std::endl;
+  fp << "<hierarchy>\n";
   size_t hierarchy_counter = 0;
   for (const ConfigBlockId& temp_block : block_hierarchy) {
     write_tab_to_file(fp, hierarchy_level + 2);
     fp << "<instance level=\"" << hierarchy_counter << "\"";
     fp << " name=\"" << bitstream_manager.block_name(temp_block) << "\"";
-    fp << "/>" << std::endl;
+    fp << "/>\n";
     hierarchy_counter++;
   }
   write_tab_to_file(fp, hierarchy_level + 1);
-  fp << "</hierarchy>" << std::endl;
+  fp << "</hierarchy>\n";
 
   /* Output input/output nets if there are any */
-  if (false == bitstream_manager.block_input_net_ids(block).empty()) {
-    write_tab_to_file(fp, hierarchy_level + 1);
-    fp << "<input_nets>\n";
-    size_t path_counter = 0;
-    /* Split with space */
-    StringToken input_net_tokenizer(bitstream_manager.block_input_net_ids(block));
-    for (const std::string& net : input_net_tokenizer.split(std::string(" "))) {
-      write_tab_to_file(fp, hierarchy_level + 2);
-      fp << "<path id=\"" << path_counter << "\"";
-      fp << " net_name=\"";
-      fp << net;
-      fp << "\"/>";
-      fp << "\n";
-
-      path_counter++;
-    }
-    write_tab_to_file(fp, hierarchy_level + 1);
-    fp << "</input_nets>\n";
+  const std::string& input_nets = bitstream_manager.block_input_net_ids(block);
+  if (false == input_nets.empty()) {
+    write_block_nets_to_xml_file(fp, input_nets, "input_nets", hierarchy_level + 1);
   }
 
-  if (false == bitstream_manager.block_output_net_ids(block).empty()) {
-    write_tab_to_file(fp, hierarchy_level + 1);
-    fp << "<output_nets>\n";
-    size_t path_counter = 0;
-    /* Split with space */
-    StringToken output_net_tokenizer(bitstream_manager.block_output_net_ids(block));
-    for (const std::string& net : output_net_tokenizer.split(std::string(" "))) {
-      write_tab_to_file(fp, hierarchy_level + 2);
-      fp << "<path id=\"" << path_counter << "\"";
-      fp << " net_name=\"";
-      fp << net;
-      fp << "\"/>";
-      fp << "\n";
-
-      path_counter++;
-    }
-    write_tab_to_file(fp, hierarchy_level + 1);
-    fp << "</output_nets>\n";
+  const std::string& output_nets = bitstream_manager.block_output_net_ids(block);
+  if (false == output_nets.empty()) {
+    write_block_nets_to_xml_file(fp, output_nets, "output_nets", hierarchy_level + 1);
   }
 
   /* Output child bits under this block */
@@ -140,21 +158,23 @@ void rec_write_block_bitstream_to_xml_file(std::fstream& fp,
   if (true == bitstream_manager.valid_block_path_id(block)) {
     fp << " path_id=\"" << bitstream_manager.block_path_id(block) << "\"";
   }
-  fp << ">" << std::endl;
+  fp << ">\n";
 
-  for (const ConfigBitId& child_bit : bitstream_manager.block_bits(block)) {
+  for (const ConfigBitId& child_bit : block_bits) {
     write_tab_to_file(fp, hierarchy_level + 2);
     fp << "<bit";
     fp << " memory_port=\"" << CONFIGURABLE_MEMORY_DATA_OUT_NAME << "[" << bit_counter << "]" << "\"";
-    fp << " value=\"" << bitstream_manager.bit_value(child_bit) << "\"";
-    fp << "/>" << std::endl;
+    fp << " value=\"" << (true == bitstream_manager.bit_value(child_bit) ? '1' : '0') << "\"";
+    fp << "/>\n";
     bit_counter++;
   }
   write_tab_to_file(fp, hierarchy_level + 1);
-  fp << "</bitstream>" << std::endl;
+  fp << "</bitstream>\n";
 
   write_tab_to_file(fp, hierarchy_level);
-  fp << "</bitstream_block>" <<std::endl;
+  fp << "</bitstream_block>\n";
+
+  block_hierarchy.pop_back();
 }
 
 /********************************************************************
@@ -181,8 +201,13 @@ void write_xml_architecture_bitstream(const BitstreamManager& bitstream_manager,
   std::string timer_message = std::string("Write ") + std::to_string(bitstream_manager.bits().size()) + std::string(" architecture independent bitstream into XML file '") + fname + std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
 
-  /* Create the file stream */
+  /* Create the file stream with a large buffer,
+   * as the file may contain hundreds of millions of lines.
+   * The buffer must be set before the file is opened
+   */
+  std::vector<char> buffer(XML_ARCH_BITSTREAM_FILE_BUFFER_SIZE);
   std::fstream fp;
+  fp.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
   fp.open(fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(fname.c_str(), fp);
@@ -196,7 +221,8 @@ void write_xml_architecture_bitstream(const BitstreamManager& bitstream_manager,
   VTR_ASSERT(1 == top_block.size());
 
   /* Write bitstream, block by block, in a recursive way */
-  rec_write_block_bitstream_to_xml_file(fp, bitstream_manager, top_block[0], 0);
+  std::vector<ConfigBlockId> block_hierarchy;
+  rec_write_block_bitstream_to_xml_file(fp, bitstream_manager, top_block[0], block_hierarchy);
 
   /* Close file handler */
   fp.close();
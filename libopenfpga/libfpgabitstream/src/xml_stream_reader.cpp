@@ -0,0 +1,344 @@
+/********************************************************************
+ * This file includes member functions for the streaming XML reader
+ *******************************************************************/
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+/* Headers from vtr util library */
+#include "vtr_assert.h"
+
+/* Headers from libarchfpga */
+#include "arch_error.h"
+
+#include "xml_stream_reader.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Size of the chunks in which the file is read */
+constexpr size_t XML_STREAM_READER_BUFFER_SIZE = 1 << 20;
+
+/**************************************************
+ * Public Constructors
+ *************************************************/
+XmlStreamReader::XmlStreamReader(const std::string& fname) {
+  fname_ = fname;
+  fp_.open(fname_, std::ifstream::in | std::ifstream::binary);
+  if (false == fp_.is_open()) {
+    archfpga_throw(fname_.c_str(), 0,
+                   "Unable to open XML file '%s'!\n",
+                   fname_.c_str());
+  }
+
+  buffer_.resize(XML_STREAM_READER_BUFFER_SIZE);
+  buffer_pos_ = 0;
+  buffer_size_ = 0;
+  curr_line_ = 1;
+
+  start_element_ = false;
+  pending_end_element_ = false;
+  line_ = 0;
+  num_attributes_ = 0;
+}
+
+/**************************************************
+ * Public Accessors
+ *************************************************/
+const std::string& XmlStreamReader::filename() const {
+  return fname_;
+}
+
+size_t XmlStreamReader::line() const {
+  return line_;
+}
+
+bool XmlStreamReader::is_start_element() const {
+  return start_element_;
+}
+
+bool XmlStreamReader::is_end_element() const {
+  return !start_element_;
+}
+
+const std::string& XmlStreamReader::name() const {
+  return name_;
+}
+
+const std::string* XmlStreamReader::find_attribute(const char* attribute_name) const {
+  for (size_t iattr = 0; iattr < num_attributes_; ++iattr) {
+    if (attributes_[iattr].first == attribute_name) {
+      return &(attributes_[iattr].second);
+    }
+  }
+  return nullptr;
+}
+
+const std::string& XmlStreamReader::attribute(const char* attribute_name) const {
+  const std::string* value = find_attribute(attribute_name);
+  if (nullptr == value) {
+    archfpga_throw(fname_.c_str(), line_,
+                   "Required attribute '%s' not found in node '%s'\n",
+                   attribute_name, name_.c_str());
+  }
+  return *value;
+}
+
+/**************************************************
+ * Public Mutators
+ *************************************************/
+bool XmlStreamReader::next() {
+  /* An empty element ends right after it starts */
+  if (true == pending_end_element_) {
+    pending_end_element_ = false;
+    start_element_ = false;
+    num_attributes_ = 0;
+    return true;
+  }
+
+  while (true) {
+    /* Skip texts until the next tag */
+    if (false == skip_text()) {
+      return false;
+    }
+    line_ = curr_line_;
+
+    char tag_char = get_required_char();
+
+    /* Skip comments, processing instructions and declarations */
+    if ('?' == tag_char) {
+      skip_until("?>");
+      continue;
+    }
+    if ('!' == tag_char) {
+      if (('-' == get_required_char()) && ('-' == get_required_char())) {
+        skip_until("-->");
+      } else {
+        skip_until(">");
+      }
+      continue;
+    }
+
+    /* End of an element */
+    if ('/' == tag_char) {
+      tag_char = skip_spaces(read_name(get_required_char(), name_));
+      if ('>' != tag_char) {
+        archfpga_throw(fname_.c_str(), line_,
+                       "Invalid end of node '%s'\n",
+                       name_.c_str());
+      }
+      start_element_ = false;
+      num_attributes_ = 0;
+      return true;
+    }
+
+    /* Start of an element, parse its attributes */
+    start_element_ = true;
+    num_attributes_ = 0;
+    tag_char = read_name(tag_char, name_);
+    while (true) {
+      tag_char = skip_spaces(tag_char);
+      if ('>' == tag_char) {
+        break;
+      }
+      if ('/' == tag_char) {
+        if ('>' != get_required_char()) {
+          archfpga_throw(fname_.c_str(), line_,
+                         "Invalid end of node '%s'\n",
+                         name_.c_str());
+        }
+        pending_end_element_ = true;
+        break;
+      }
+
+      if (num_attributes_ == attributes_.size()) {
+        attributes_.emplace_back();
+      }
+      std::pair<std::string, std::string>& attr = attributes_[num_attributes_];
+      tag_char = skip_spaces(read_name(tag_char, attr.first));
+      if ('=' != tag_char) {
+        archfpga_throw(fname_.c_str(), line_,
+                       "Expect a value for attribute '%s' of node '%s'\n",
+                       attr.first.c_str(), name_.c_str());
+      }
+      tag_char = skip_spaces(get_required_char());
+      if (('"' != tag_char) && ('\'' != tag_char)) {
+        archfpga_throw(fname_.c_str(), line_,
+                       "Expect a quoted value for attribute '%s' of node '%s'\n",
+                       attr.first.c_str(), name_.c_str());
+      }
+      read_attribute_value(tag_char, attr.second);
+      num_attributes_++;
+
+      tag_char = get_required_char();
+    }
+    return true;
+  }
+}
+
+/**************************************************
+ * Internal utilities
+ *************************************************/
+/* Read the next chunk of the file if the current one is fully parsed,
+ * Return false if the end of file is reached
+ */
+bool XmlStreamReader::fill_buffer() {
+  if (buffer_pos_ == buffer_size_) {
+    fp_.read(buffer_.data(), buffer_.size());
+    buffer_size_ = fp_.gcount();
+    buffer_pos_ = 0;
+  }
+  return 0 < buffer_size_;
+}
+
+/* Skip texts until the start of a tag '<', which is consumed
+ * Texts are skipped in the buffer directly, as they are mostly indents
+ * Return false if the end of file is reached
+ */
+bool XmlStreamReader::skip_text() {
+  while (true == fill_buffer()) {
+    const char* begin = buffer_.data() + buffer_pos_;
+    const char* end = buffer_.data() + buffer_size_;
+    const char* tag = static_cast<const char*>(std::memchr(begin, '<', end - begin));
+    const char* text_end = (nullptr == tag) ? end : tag;
+    curr_line_ += std::count(begin, text_end, '\n');
+    buffer_pos_ = text_end - buffer_.data();
+    if (nullptr != tag) {
+      buffer_pos_++;
+      return true;
+    }
+  }
+  return false;
+}
+
+int XmlStreamReader::get_char() {
+  if (false == fill_buffer()) {
+    return EOF;
+  }
+  char c = buffer_[buffer_pos_++];
+  if ('\n' == c) {
+    curr_line_++;
+  }
+  return (unsigned char)c;
+}
+
+char XmlStreamReader::get_required_char() {
+  int c = get_char();
+  if (EOF == c) {
+    archfpga_throw(fname_.c_str(), curr_line_,
+                   "Unexpected end of file\n");
+  }
+  return char(c);
+}
+
+/* Skip all the characters until the end of a pattern */
+void XmlStreamReader::skip_until(const char* pattern) {
+  /* Keep the last characters which have been read, as many as the pattern */
+  std::string tail;
+  size_t pattern_length = std::strlen(pattern);
+  while (tail != pattern) {
+    if (tail.size() == pattern_length) {
+      tail.erase(tail.begin());
+    }
+    tail.push_back(get_required_char());
+  }
+}
+
+/* Skip spaces starting from a given character,
+ * Return the first character which is not a space
+ */
+char XmlStreamReader::skip_spaces(char c) {
+  while ((' ' == c) || ('\t' == c) || ('\n' == c) || ('\r' == c)) {
+    c = get_required_char();
+  }
+  return c;
+}
+
+/* Check if a character ends a name */
+static 
+bool is_xml_name_end(const char& c) {
+  return (' ' == c) || ('\t' == c) || ('\n' == c) || ('\r' == c)
+      || ('=' == c) || ('/' == c) || ('>' == c);
+}
+
+/* Read a name starting from a given character,
+ * Return the first character after the name
+ */
+char XmlStreamReader::read_name(char c, std::string& name) {
+  name.clear();
+  while (false == is_xml_name_end(c)) {
+    /* Copy the name in the current chunk at once, 
+     * where the given character is the last one which has been read
+     */
+    size_t name_start = buffer_pos_ - 1;
+    VTR_ASSERT_SAFE(c == buffer_[name_start]);
+    size_t name_end = buffer_pos_;
+    while ((name_end < buffer_size_) && (false == is_xml_name_end(buffer_[name_end]))) {
+      name_end++;
+    }
+    name.append(buffer_.data() + name_start, name_end - name_start);
+    buffer_pos_ = name_end;
+    c = get_required_char();
+  }
+  if (true == name.empty()) {
+    archfpga_throw(fname_.c_str(), line_,
+                   "Expect a name but found '%c'\n",
+                   c);
+  }
+  return c;
+}
+
+/* Read the value of an attribute until the closing quote,
+ * where the predefined entities are decoded
+ */
+void XmlStreamReader::read_attribute_value(const char& quote, std::string& value) {
+  value.clear();
+  char c = get_required_char();
+  while (quote != c) {
+    if ('&' == c) {
+      std::string entity;
+      c = get_required_char();
+      while ((';' != c) && (quote != c)) {
+        entity.push_back(c);
+        c = get_required_char();
+      }
+      if (';' != c) {
+        archfpga_throw(fname_.c_str(), line_,
+                       "Unterminated entity '&%s' in node '%s'\n",
+                       entity.c_str(), name_.c_str());
+      }
+      if (std::string("lt") == entity) {
+        value.push_back('<');
+      } else if (std::string("gt") == entity) {
+        value.push_back('>');
+      } else if (std::string("amp") == entity) {
+        value.push_back('&');
+      } else if (std::string("quot") == entity) {
+        value.push_back('"');
+      } else if (std::string("apos") == entity) {
+        value.push_back('\'');
+      } else {
+        archfpga_throw(fname_.c_str(), line_,
+                       "Unsupported entity '&%s;' in node '%s'\n",
+                       entity.c_str(), name_.c_str());
+      }
+    } else {
+      /* Copy the plain characters in the current chunk at once,
+       * where the given character is the last one which has been read.
+       * New lines are left to get_char() so that lines are counted
+       */
+      size_t value_start = buffer_pos_ - 1;
+      VTR_ASSERT_SAFE(c == buffer_[value_start]);
+      size_t value_end = buffer_pos_;
+      while ((value_end < buffer_size_) 
+          && (quote != buffer_[value_end]) && ('&' != buffer_[value_end]) && ('\n' != buffer_[value_end])) {
+        value_end++;
+      }
+      value.append(buffer_.data() + value_start, value_end - value_start);
+      buffer_pos_ = value_end;
+    }
+    c = get_required_char();
+  }
+}
+
+} /* end namespace openfpga */
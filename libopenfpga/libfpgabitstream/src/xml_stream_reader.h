@@ -0,0 +1,123 @@
+#ifndef XML_STREAM_READER_H
+#define XML_STREAM_READER_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include <vector>
+#include <fstream>
+
+/********************************************************************
+ * A streaming (SAX-style) reader of XML files
+ *
+ * Unlike pugixml, which loads the whole file into a DOM,
+ * the file is read in chunks of a fixed size and each element is
+ * reported as soon as its tag is parsed.
+ * Therefore, the memory usage does not depend on the size of the file,
+ * which is required by very large files, e.g., architecture bitstreams.
+ *
+ * Each call to next() reports one event:
+ * - the start of an element, whose name and attributes are available
+ * - the end of an element, whose name is available
+ * An empty element, e.g., <bit value="1"/>, is reported as a start
+ * followed by an end.
+ * Comments, processing instructions and texts are skipped.
+ *
+ * Restrictions:
+ * 1. It only supports the XML subset written by OpenFPGA:
+ *    no DTD, CDATA or namespaces.
+ * 2. The nesting of elements is not checked, which should be done by callers,
+ *    as they usually have to track the elements anyway.
+ *
+ * Errors in the file are reported by archfpga_throw(),
+ * in the same way as other readers of this library.
+ *
+ * Example:
+ *   XmlStreamReader reader(fname);
+ *   while (true == reader.next()) {
+ *     if (true == reader.is_start_element()) {
+ *       const std::string& value = reader.attribute("name");
+ *     }
+ *   }
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+class XmlStreamReader {
+  public: /* Public constructor */
+    /* Open the file, which is read only when next() is called */
+    explicit XmlStreamReader(const std::string& fname);
+
+    /* Not copyable */
+    XmlStreamReader(const XmlStreamReader&) = delete;
+    XmlStreamReader& operator=(const XmlStreamReader&) = delete;
+
+  public: /* Public Accessors */
+    const std::string& filename() const;
+
+    /* Line of the current element in the file */
+    size_t line() const;
+
+    /* Check if the current event is the start or the end of an element */
+    bool is_start_element() const;
+    bool is_end_element() const;
+
+    /* Name of the current element */
+    const std::string& name() const;
+
+    /* Find the value of an attribute of the current element,
+     * Return nullptr if the attribute is not defined
+     */
+    const std::string* find_attribute(const char* attribute_name) const;
+
+    /* Find the value of an attribute of the current element,
+     * Error out if the attribute is not defined
+     */
+    const std::string& attribute(const char* attribute_name) const;
+
+  public: /* Public Mutators */
+    /* Go to the next event,
+     * Return false if the end of file is reached
+     */
+    bool next();
+
+  private: /* Internal utilities */
+    bool fill_buffer();
+    bool skip_text();
+    /* Get the next character, return EOF at the end of file */
+    int get_char();
+    /* Get the next character, error out at the end of file */
+    char get_required_char();
+
+    void skip_until(const char* pattern);
+    char skip_spaces(char c);
+    char read_name(char c, std::string& name);
+    void read_attribute_value(const char& quote, std::string& value);
+
+  private: /* Internal data */
+    std::string fname_;
+    std::ifstream fp_;
+
+    /* Chunk of the file being parsed */
+    std::vector<char> buffer_;
+    size_t buffer_pos_;
+    size_t buffer_size_;
+    size_t curr_line_;
+
+    /* Current event */
+    bool start_element_;
+    bool pending_end_element_;
+    size_t line_;
+    std::string name_;
+    /* The strings are kept between elements to reuse their memory,
+     * only the first num_attributes_ are valid for the current element
+     */
+    std::vector<std::pair<std::string, std::string>> attributes_;
+    size_t num_attributes_;
+};
+
+} /* end namespace openfpga */
+
+#endif
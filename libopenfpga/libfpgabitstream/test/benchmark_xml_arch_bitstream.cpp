@@ -0,0 +1,106 @@
+/********************************************************************
+ * Benchmark on the reader and writer of architecture bitstream in XML format
+ * The time and the peak memory usage (RSS) of the process are reported.
+ * As the peak memory usage only grows during a process,
+ * the reader and the writer should be benchmarked in separated runs.
+ *
+ * Usage:
+ * 1. Build a synthetic bitstream with a given number of tiles and write it to an XML file
+ *   benchmark_xml_arch_bitstream write <num_tiles> <xml_file>
+ * 2. Read an XML file
+ *   benchmark_xml_arch_bitstream read <xml_file>
+ * For example, 40000 tiles result in a file of about 590MB
+ *   benchmark_xml_arch_bitstream write 40000 arch_bitstream.xml
+ *   benchmark_xml_arch_bitstream read arch_bitstream.xml
+ *******************************************************************/
+#include <cstdlib>
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <string>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_rusage.h"
+
+#include "openfpga_reserved_words.h"
+
+#include "read_xml_arch_bitstream.h"
+#include "write_xml_arch_bitstream.h"
+
+/********************************************************************
+ * Build the blocks of a tile in a similar way as grids and routing blocks:
+ * a few levels of blocks, where the leaf blocks contain configuration bits
+ *******************************************************************/
+static
+void rec_build_synthetic_tile_blocks(openfpga::BitstreamManager& bitstream_manager,
+                                     const openfpga::ConfigBlockId& parent_block,
+                                     std::mt19937& rng,
+                                     const size_t& level) {
+  size_t num_children = 1 + rng() % 4;
+  for (size_t ichild = 0; ichild < num_children; ++ichild) {
+    openfpga::ConfigBlockId block = bitstream_manager.add_block(std::string("mem_") + std::to_string(level) + std::string("_") + std::to_string(ichild));
+    bitstream_manager.add_child_block(parent_block, block);
+
+    if ((3 > level) && (0 == rng() % 2)) {
+      rec_build_synthetic_tile_blocks(bitstream_manager, block, rng, level + 1);
+      continue;
+    }
+
+    /* Leaf blocks: routing multiplexers have a path id and nets */
+    if (0 == rng() % 2) {
+      bitstream_manager.add_path_id_to_block(block, rng() % 8);
+      bitstream_manager.add_input_net_id_to_block(block, std::string("net_") + std::to_string(rng() % 1000) + std::string(" OPEN"));
+      bitstream_manager.add_output_net_id_to_block(block, std::string("net_") + std::to_string(rng() % 1000));
+    }
+    size_t num_bits = 1 + rng() % 40;
+    for (size_t ibit = 0; ibit < num_bits; ++ibit) {
+      bitstream_manager.add_bit(block, 0 == rng() % 2);
+    }
+  }
+}
+
+static
+void report_xml_arch_bitstream_benchmark(const char* action,
+                                         const std::string& fname,
+                                         const std::chrono::duration<double>& runtime) {
+  std::fstream fp(fname, std::fstream::in | std::fstream::ate);
+  VTR_LOG("%s '%s' (%lu bytes) took %g seconds, peak memory usage %lu bytes\n",
+          action, fname.c_str(), size_t(fp.tellg()), runtime.count(), vtr::get_max_rss());
+}
+
+int main(int argc, const char** argv) {
+  VTR_ASSERT(3 <= argc);
+
+  if (std::string("write") == std::string(argv[1])) {
+    VTR_ASSERT(4 == argc);
+    size_t num_tiles = std::atoi(argv[2]);
+
+    /* Use a fixed seed so that the bitstream is the same across runs */
+    std::mt19937 rng(1);
+    openfpga::BitstreamManager bitstream_manager;
+    openfpga::ConfigBlockId top_block = bitstream_manager.add_block(std::string(openfpga::FPGA_TOP_MODULE_NAME));
+    for (size_t itile = 0; itile < num_tiles; ++itile) {
+      openfpga::ConfigBlockId tile_block = bitstream_manager.add_block(std::string("tile_") + std::to_string(itile));
+      bitstream_manager.add_child_block(top_block, tile_block);
+      rec_build_synthetic_tile_blocks(bitstream_manager, tile_block, rng, 0);
+    }
+    VTR_LOG("Built %lu blocks and %lu bits, using %lu bytes of memory\n",
+            bitstream_manager.num_blocks(), bitstream_manager.num_bits(), bitstream_manager.memory_usage());
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    openfpga::write_xml_architecture_bitstream(bitstream_manager, std::string(argv[3]));
+    report_xml_arch_bitstream_benchmark("Write", std::string(argv[3]), std::chrono::steady_clock::now() - start);
+  } else {
+    VTR_ASSERT(std::string("read") == std::string(argv[1]));
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    openfpga::BitstreamManager bitstream_manager = openfpga::read_xml_architecture_bitstream(argv[2]);
+    report_xml_arch_bitstream_benchmark("Read", std::string(argv[2]), std::chrono::steady_clock::now() - start);
+    VTR_LOG("Read %lu blocks and %lu bits, using %lu bytes of memory\n",
+            bitstream_manager.num_blocks(), bitstream_manager.num_bits(), bitstream_manager.memory_usage());
+  }
+
+  return 0;
+}
@@ -0,0 +1,212 @@
+/********************************************************************
+ * Unit test functions to validate the correctness of 
+ * 1. writer of binary fabric bitstream
+ * 2. reader of binary fabric bitstream
+ *
+ * Usage: test_binary_fabric_bitstream <protocol> <plain_text_file> <binary_file>
+ *
+ * The fabric bitstream in plain text format (an output of write_fabric_bitstream)
+ * is converted to the binary file, which is then read back and
+ * converted to plain text again. The two plain texts should be the same.
+ *
+ * The conversion is done twice: first with a single region, and then
+ * with the bits split into regions of different sizes, whose table
+ * should be read back as it is written.
+ *******************************************************************/
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from fpgabitstream library */
+#include "binary_fabric_bitstream_writer.h"
+#include "binary_fabric_bitstream_reader.h"
+
+/* A bit parsed from the plain text file */
+struct t_text_fabric_bit {
+  std::string address;
+  std::string wl_address;
+  bool value;
+};
+
+static 
+e_config_protocol_type find_config_protocol_type(const std::string& type_name) {
+  for (size_t itype = 0; itype < NUM_CONFIG_PROTOCOL_TYPES; ++itype) {
+    if (type_name == std::string(CONFIG_PROTOCOL_TYPE_STRING[itype])) {
+      return static_cast<e_config_protocol_type>(itype);
+    }
+  }
+  VTR_LOG_ERROR("Invalid configuration protocol '%s'!\n", type_name.c_str());
+  exit(1);
+}
+
+/* Parse the plain text file, following the format of write_fabric_bitstream_to_text_file() */
+static 
+std::vector<t_text_fabric_bit> read_text_fabric_bitstream(const std::string& content,
+                                                          const e_config_protocol_type& protocol) {
+  std::vector<t_text_fabric_bit> bits;
+  std::istringstream is(content);
+
+  if ((CONFIG_MEM_STANDALONE == protocol) || (CONFIG_MEM_SCAN_CHAIN == protocol)) {
+    std::string values;
+    std::getline(is, values);
+    for (const char& value : values) {
+      bits.push_back({std::string(), std::string(), '1' == value});
+    }
+    return bits;
+  }
+
+  std::string line;
+  while (std::getline(is, line)) {
+    if (true == line.empty()) {
+      continue;
+    }
+    std::istringstream line_is(line);
+    t_text_fabric_bit bit;
+    std::string value;
+    line_is >> bit.address;
+    if (CONFIG_MEM_MEMORY_BANK == protocol) {
+      line_is >> bit.wl_address;
+    }
+    line_is >> value;
+    bit.value = ("1" == value);
+    bits.push_back(bit);
+  }
+  return bits;
+}
+
+/* Convert the binary file back to plain text */
+static 
+std::string write_text_fabric_bitstream(const openfpga::BinaryFabricBitstreamReader& reader) {
+  std::string content;
+  std::vector<char> addr_buffer(std::max(reader.address_length(), reader.wl_address_length()));
+
+  for (size_t ibit = 0; ibit < reader.num_bits(); ++ibit) {
+    switch (reader.config_protocol_type()) {
+    case CONFIG_MEM_STANDALONE: 
+    case CONFIG_MEM_SCAN_CHAIN:
+      content += reader.bit_value(ibit) ? '1' : '0';
+      break;
+    case CONFIG_MEM_MEMORY_BANK:
+      content.append(addr_buffer.data(), reader.emit_bit_address(ibit, addr_buffer.data()) - addr_buffer.data());
+      content += ' ';
+      content.append(addr_buffer.data(), reader.emit_bit_wl_address(ibit, addr_buffer.data()) - addr_buffer.data());
+      content += ' ';
+      content += reader.bit_value(ibit) ? "1\n" : "0\n";
+      break;
+    case CONFIG_MEM_FRAME_BASED:
+      content.append(addr_buffer.data(), reader.emit_bit_address(ibit, addr_buffer.data()) - addr_buffer.data());
+      content += ' ';
+      content += reader.bit_value(ibit) ? "1\n" : "0\n";
+      break;
+    default:
+      VTR_ASSERT_MSG(false, "Invalid configuration protocol type");
+    }
+  }
+  content += '\n';
+  return content;
+}
+
+/* Write the bits to a binary file with the given regions, read it back and compare
+ * Return 0 if the two are the same, 1 otherwise
+ */
+static 
+int test_binary_fabric_bitstream_round_trip(const std::vector<t_text_fabric_bit>& bits,
+                                            const e_config_protocol_type& protocol,
+                                            const std::vector<size_t>& region_num_bits,
+                                            const std::string& text_content,
+                                            const std::string& binary_fname) {
+  size_t address_length = bits.empty() ? 0 : bits[0].address.size();
+  size_t wl_address_length = bits.empty() ? 0 : bits[0].wl_address.size();
+  openfpga::BinaryFabricBitstreamWriter writer(binary_fname, protocol, bits.size(),
+                                               address_length, wl_address_length,
+                                               region_num_bits);
+  for (const t_text_fabric_bit& bit : bits) {
+    VTR_ASSERT(address_length == bit.address.size());
+    VTR_ASSERT(wl_address_length == bit.wl_address.size());
+    if (0 != writer.add_bit(bit.value, bit.address.c_str(), bit.wl_address.c_str())) {
+      return 1;
+    }
+  }
+  if (0 != writer.close()) {
+    return 1;
+  }
+  VTR_LOG("Write the fabric bitstream in %lu regions to a binary file: %s.\n",
+          region_num_bits.size(), binary_fname.c_str());
+
+  /* Read back the binary file and compare */
+  openfpga::BinaryFabricBitstreamReader reader(binary_fname);
+  VTR_LOG("Read the fabric bitstream from a binary file: %s.\n",
+          binary_fname.c_str());
+
+  if (region_num_bits.size() != reader.num_regions()) {
+    VTR_LOG_ERROR("Binary fabric bitstream '%s' has %lu regions while %lu regions are written!\n",
+                  binary_fname.c_str(), reader.num_regions(), region_num_bits.size());
+    return 1;
+  }
+
+  size_t region_first_bit = 0;
+  for (size_t iregion = 0; iregion < region_num_bits.size(); ++iregion) {
+    if ( (region_first_bit != reader.region_first_bit(iregion))
+      || (region_num_bits[iregion] != reader.region_num_bits(iregion)) ) {
+      VTR_LOG_ERROR("Region %lu of binary fabric bitstream '%s' starts from bit %lu with %lu bits, while it is written from bit %lu with %lu bits!\n",
+                    iregion, binary_fname.c_str(),
+                    reader.region_first_bit(iregion), reader.region_num_bits(iregion),
+                    region_first_bit, region_num_bits[iregion]);
+      return 1;
+    }
+    region_first_bit += region_num_bits[iregion];
+  }
+
+  if (text_content != write_text_fabric_bitstream(reader)) {
+    VTR_LOG_ERROR("Fabric bitstream read from binary file '%s' is different from plain text!\n",
+                  binary_fname.c_str());
+    return 1;
+  }
+
+  return 0;
+}
+
+int main(int argc, const char** argv) {
+  /* Ensure we have three arguments */
+  VTR_ASSERT(4 == argc);
+
+  e_config_protocol_type protocol = find_config_protocol_type(argv[1]);
+
+  /* Parse the fabric bitstream from a plain text file */
+  std::ifstream text_fp(argv[2]);
+  VTR_ASSERT(true == text_fp.is_open());
+  std::stringstream text_buffer;
+  text_buffer << text_fp.rdbuf();
+  std::string text_content = text_buffer.str();
+
+  std::vector<t_text_fabric_bit> bits = read_text_fabric_bitstream(text_content, protocol);
+  VTR_LOG("Read %lu bits of fabric bitstream from a plain text file: %s.\n",
+          bits.size(), argv[2]);
+
+  /* Output the fabric bitstream to a binary file in a single region */
+  if (0 != test_binary_fabric_bitstream_round_trip(bits, protocol,
+                                                   std::vector<size_t>(1, bits.size()),
+                                                   text_content, std::string(argv[3]))) {
+    return 1;
+  }
+
+  /* Output the fabric bitstream to a binary file in three regions of different sizes */
+  size_t num_bits = bits.size();
+  std::vector<size_t> region_num_bits = {num_bits / 2, num_bits / 3, num_bits - num_bits / 2 - num_bits / 3};
+  if (0 != test_binary_fabric_bitstream_round_trip(bits, protocol,
+                                                   region_num_bits,
+                                                   text_content, std::string(argv[3]))) {
+    return 1;
+  }
+
+  VTR_LOG("Fabric bitstream read from binary file is the same as plain text file.\n");
+
+  return 0;
+}
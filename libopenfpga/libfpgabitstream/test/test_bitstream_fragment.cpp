@@ -0,0 +1,213 @@
+/********************************************************************
+ * Unit test functions to validate the correctness of
+ * merging bitstream fragments by BitstreamManager::add_fragment()
+ *
+ * Usage: test_bitstream_fragment [<seed>]
+ *
+ * The same random tree of blocks and bits is built twice:
+ * directly in a bitstream manager, as a single thread does, and
+ * fragment by fragment in private bitstream managers which are then
+ * merged, as multiple threads do. The two bitstream managers should be the same.
+ *
+ * The numbers of bits in the fragments are chosen so that the fragments
+ * start both at and in the middle of the 64-bit words of the packed bit values.
+ *******************************************************************/
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from fpgabitstream library */
+#include "bitstream_manager.h"
+
+/* Maximum depth of the blocks of a fragment under the parent block */
+constexpr size_t MAX_FRAGMENT_BLOCK_DEPTH = 3;
+
+/* Maximum number of child blocks of a block */
+constexpr size_t MAX_FRAGMENT_BLOCK_CHILDREN = 3;
+
+/********************************************************************
+ * Build a random tree of blocks under a block, which has a given
+ * number of bits in total. The bits are given to the leaf blocks
+ * or, when a block has no children, to the block itself.
+ * The tree only depends on the random engine,
+ * so that the same tree is built in any bitstream manager
+ *******************************************************************/
+static
+void build_random_block_tree(openfpga::BitstreamManager& bitstream_manager,
+                             const openfpga::ConfigBlockId& parent_block,
+                             const size_t& num_bits,
+                             const size_t& depth,
+                             std::mt19937& rng) {
+  size_t num_children = 0;
+  if (MAX_FRAGMENT_BLOCK_DEPTH > depth) {
+    num_children = std::uniform_int_distribution<size_t>(0, MAX_FRAGMENT_BLOCK_CHILDREN)(rng);
+  }
+
+  if (0 == num_children) {
+    for (size_t ibit = 0; ibit < num_bits; ++ibit) {
+      bitstream_manager.add_bit(parent_block, 1 == std::uniform_int_distribution<int>(0, 1)(rng));
+    }
+    return;
+  }
+
+  /* Split the bits among the children, the last child takes the rest */
+  size_t remaining_bits = num_bits;
+  for (size_t ichild = 0; ichild < num_children; ++ichild) {
+    openfpga::ConfigBlockId child_block = bitstream_manager.add_block(bitstream_manager.block_name(parent_block) + std::string("_") + std::to_string(ichild));
+    bitstream_manager.add_child_block(parent_block, child_block);
+
+    /* Fill the optional attributes of some blocks */
+    if (0 == std::uniform_int_distribution<int>(0, 2)(rng)) {
+      bitstream_manager.add_path_id_to_block(child_block, std::uniform_int_distribution<int>(-1, 7)(rng));
+      bitstream_manager.add_input_net_id_to_block(child_block, std::string("in_") + std::to_string(ichild));
+      bitstream_manager.add_output_net_id_to_block(child_block, std::string("out_") + std::to_string(ichild));
+    }
+
+    size_t child_num_bits = remaining_bits;
+    if (ichild + 1 < num_children) {
+      child_num_bits = std::uniform_int_distribution<size_t>(0, remaining_bits)(rng);
+    }
+    build_random_block_tree(bitstream_manager, child_block, child_num_bits, depth + 1, rng);
+    remaining_bits -= child_num_bits;
+  }
+}
+
+/********************************************************************
+ * Build the i-th fragment under a parent block
+ *******************************************************************/
+static
+void build_random_fragment(openfpga::BitstreamManager& bitstream_manager,
+                           const openfpga::ConfigBlockId& parent_block,
+                           const size_t& ifragment,
+                           const size_t& num_bits,
+                           const unsigned& seed) {
+  std::mt19937 rng(seed + ifragment);
+
+  openfpga::ConfigBlockId tile_block = bitstream_manager.add_block(std::string("tile_") + std::to_string(ifragment));
+  bitstream_manager.add_child_block(parent_block, tile_block);
+  build_random_block_tree(bitstream_manager, tile_block, num_bits, 0, rng);
+}
+
+/********************************************************************
+ * Compare every block and bit of two bitstream managers
+ * Return 0 if the two are the same, 1 otherwise
+ *******************************************************************/
+static
+int compare_bitstream_managers(const openfpga::BitstreamManager& ref_bitstream,
+                               const openfpga::BitstreamManager& test_bitstream) {
+  if ( (ref_bitstream.num_blocks() != test_bitstream.num_blocks())
+    || (ref_bitstream.num_bits() != test_bitstream.num_bits()) ) {
+    VTR_LOG_ERROR("Merged bitstream has %lu blocks and %lu bits, while the bitstream built directly has %lu blocks and %lu bits!\n",
+                  test_bitstream.num_blocks(), test_bitstream.num_bits(),
+                  ref_bitstream.num_blocks(), ref_bitstream.num_bits());
+    return 1;
+  }
+
+  for (const openfpga::ConfigBlockId& block : ref_bitstream.blocks()) {
+    if ( (ref_bitstream.block_name(block) != test_bitstream.block_name(block))
+      || (ref_bitstream.block_parent(block) != test_bitstream.block_parent(block))
+      || (ref_bitstream.block_children(block) != test_bitstream.block_children(block))
+      || (ref_bitstream.block_bits(block) != test_bitstream.block_bits(block))
+      || (ref_bitstream.block_path_id(block) != test_bitstream.block_path_id(block))
+      || (ref_bitstream.block_input_net_ids(block) != test_bitstream.block_input_net_ids(block))
+      || (ref_bitstream.block_output_net_ids(block) != test_bitstream.block_output_net_ids(block)) ) {
+      VTR_LOG_ERROR("Block '%s' (id=%lu) of the merged bitstream is different from the bitstream built directly!\n",
+                    ref_bitstream.block_name(block).c_str(), size_t(block));
+      return 1;
+    }
+  }
+
+  for (const openfpga::ConfigBitId& bit : ref_bitstream.bits()) {
+    if ( (ref_bitstream.bit_value(bit) != test_bitstream.bit_value(bit))
+      || (ref_bitstream.bit_parent_block(bit) != test_bitstream.bit_parent_block(bit)) ) {
+      VTR_LOG_ERROR("Bit %lu of the merged bitstream is different from the bitstream built directly!\n",
+                    size_t(bit));
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/********************************************************************
+ * Build the fragments with the given numbers of bits in both ways,
+ * after a block with a given number of bits, and compare the results
+ * Return 0 if the two are the same, 1 otherwise
+ *******************************************************************/
+static
+int test_bitstream_fragments(const size_t& num_leading_bits,
+                             const std::vector<size_t>& fragment_num_bits,
+                             const unsigned& seed) {
+  openfpga::BitstreamManager ref_bitstream;
+  openfpga::BitstreamManager test_bitstream;
+
+  for (openfpga::BitstreamManager* bitstream_manager : {&ref_bitstream, &test_bitstream}) {
+    openfpga::ConfigBlockId top_block = bitstream_manager->add_block(std::string("fpga_top"));
+    openfpga::ConfigBlockId leading_block = bitstream_manager->add_block(std::string("leading_block"));
+    bitstream_manager->add_child_block(top_block, leading_block);
+    for (size_t ibit = 0; ibit < num_leading_bits; ++ibit) {
+      bitstream_manager->add_bit(leading_block, 0 == ibit % 3);
+    }
+  }
+
+  const openfpga::ConfigBlockId top_block = openfpga::ConfigBlockId(0);
+  for (size_t ifragment = 0; ifragment < fragment_num_bits.size(); ++ifragment) {
+    build_random_fragment(ref_bitstream, top_block, ifragment, fragment_num_bits[ifragment], seed);
+
+    /* The root block of a fragment stands for the parent block */
+    openfpga::BitstreamManager fragment;
+    openfpga::ConfigBlockId fragment_root = fragment.add_block(test_bitstream.block_name(top_block));
+    build_random_fragment(fragment, fragment_root, ifragment, fragment_num_bits[ifragment], seed);
+    test_bitstream.add_fragment(top_block, fragment);
+  }
+
+  if (0 != compare_bitstream_managers(ref_bitstream, test_bitstream)) {
+    VTR_LOG_ERROR("Merging %lu fragments after %lu bits failed (seed=%u)!\n",
+                  fragment_num_bits.size(), num_leading_bits, seed);
+    return 1;
+  }
+
+  VTR_LOG("Merged %lu fragments with %lu bits after %lu bits: same as the bitstream built directly.\n",
+          fragment_num_bits.size(), ref_bitstream.num_bits() - num_leading_bits, num_leading_bits);
+  return 0;
+}
+
+int main(int argc, const char** argv) {
+  /* Ensure we have at most one argument */
+  VTR_ASSERT((1 == argc) || (2 == argc));
+
+  unsigned seed = 1;
+  if (2 == argc) {
+    seed = std::atoi(argv[1]);
+  }
+
+  /* Fragments whose numbers of bits are multiples of 64, so that all of them are word-aligned */
+  const std::vector<size_t> aligned_num_bits = {64, 128, 0, 64, 192, 64};
+  /* Fragments whose numbers of bits are not multiples of 64, including empty ones */
+  const std::vector<size_t> unaligned_num_bits = {1, 63, 0, 65, 127, 129, 0, 200, 3, 64, 1000};
+
+  int status = 0;
+  for (const size_t& num_leading_bits : {size_t(0), size_t(64), size_t(37)}) {
+    status |= test_bitstream_fragments(num_leading_bits, aligned_num_bits, seed);
+    status |= test_bitstream_fragments(num_leading_bits, unaligned_num_bits, seed);
+  }
+
+  /* Fragments of random numbers of bits */
+  std::mt19937 rng(seed);
+  std::vector<size_t> random_num_bits(100);
+  for (size_t& num_bits : random_num_bits) {
+    num_bits = std::uniform_int_distribution<size_t>(0, 300)(rng);
+  }
+  status |= test_bitstream_fragments(std::uniform_int_distribution<size_t>(0, 300)(rng), random_num_bits, seed);
+
+  if (0 == status) {
+    VTR_LOG("Bitstream merged from fragments is the same as the bitstream built directly.\n");
+  }
+
+  return status;
+}
@@ -6,6 +6,7 @@
 #include <vector>
 #include <functional>
 #include <ctime>
+#include <chrono>
 
 #include "vtr_vector.h"
 #include "vtr_range.h"
@@ -135,7 +136,18 @@ class Shell {
 
     void set_command_dependency(const ShellCommandId& cmd_id,
                                 const std::vector<ShellCommandId>& cmd_dependency);
+    /* Declare a command which can be executed instead of another command
+     * to meet the dependency of other commands,
+     * e.g., a command loading results from a file instead of building them
+     */
+    void add_command_alternative(const ShellCommandId& cmd_id,
+                                 const ShellCommandId& alternative_cmd_id);
     ShellCommandClassId add_command_class(const char* name);
+    /* Enable the profiling of commands:
+     * the wall time, CPU time and peak memory of each executed command
+     * will be reported to the given file in the CSV format
+     */
+    void set_profile_file(const std::string& profile_file);
   public: /* Public validators */
     bool valid_command_id(const ShellCommandId& cmd_id) const;
     bool valid_command_class_id(const ShellCommandClassId& cmd_class_id) const;
@@ -153,6 +165,20 @@ class Shell {
      * The common_context is the data structure to exchange data between commands
      */
     int execute_command(const char* cmd_line, T& common_context);
+    /* Parse the options of a command and call its execute function */
+    int dispatch_command(const ShellCommandId& cmd_id,
+                         const std::vector<std::string>& tokens,
+                         T& common_context);
+    /* Append the runtime and memory usage of an executed command to the profile file */
+    void write_command_profile(const ShellCommandId& cmd_id,
+                               const char* cmd_line,
+                               const int& status,
+                               const float& wall_time,
+                               const float& cpu_time,
+                               const float& max_rss,
+                               const float& delta_max_rss) const;
+    /* Check if a command or any of its alternatives has been executed without fatal errors */
+    bool command_executed(const ShellCommandId& cmd_id) const;
   private: /* Internal data */ 
     /* Name of the shell, this will appear in the interactive mode */
     std::string name_;
@@ -208,6 +234,9 @@ class Shell {
      */
     vtr::vector<ShellCommandId, std::vector<ShellCommandId>> command_dependencies_;  
 
+    /* Commands which can be executed instead of each command to meet dependencies */
+    vtr::vector<ShellCommandId, std::vector<ShellCommandId>> command_alternatives_;  
+
     /* Fast name look-up */
     std::map<std::string, ShellCommandId> command_name2ids_;
     std::map<std::string, ShellCommandClassId> command_class2ids_;
@@ -215,6 +244,10 @@ class Shell {
 
     /* Timer */
     std::clock_t time_start_;
+    std::chrono::steady_clock::time_point wall_time_start_;
+
+    /* File to report the profiling results of each command, empty if profiling is disabled */
+    std::string profile_file_;
 };
 
 } /* End namespace openfpga */
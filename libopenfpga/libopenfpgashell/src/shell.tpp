@@ -1,12 +1,15 @@
 /*********************************************************************
  * Member functions for class Shell
  ********************************************************************/
+#include <cstdio>
 #include <fstream>
 #include <algorithm>
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "vtr_time.h"
+#include "vtr_rusage.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_tokenizer.h"
@@ -29,6 +32,7 @@ template<class T>
 Shell<T>::Shell(const char* name) {
   name_ = std::string(name);
   time_start_ = 0;
+  wall_time_start_ = std::chrono::steady_clock::now();
 }
 
 /************************************************************************
@@ -134,6 +138,7 @@ ShellCommandId Shell<T>::add_command(const Command& cmd, const char* descr) {
   command_macro_execute_functions_.emplace_back();
   command_status_.push_back(CMD_EXEC_NONE); /* By default, the command should be marked as fatal error as it has been never executed */
   command_dependencies_.emplace_back();
+  command_alternatives_.emplace_back();
 
   /* Register the name in the name2id map */
   command_name2ids_[cmd.name()] = shell_cmd;
@@ -213,6 +218,14 @@ void Shell<T>::set_command_dependency(const ShellCommandId& cmd_id,
   command_dependencies_[cmd_id] = dependent_cmds;
 }
 
+template<class T>
+void Shell<T>::add_command_alternative(const ShellCommandId& cmd_id,
+                                       const ShellCommandId& alternative_cmd_id) {
+  VTR_ASSERT(true == valid_command_id(cmd_id));
+  VTR_ASSERT(true == valid_command_id(alternative_cmd_id));
+  command_alternatives_[cmd_id].push_back(alternative_cmd_id);
+}
+
 /* Add a command with it description */
 template<class T>
 ShellCommandClassId Shell<T>::add_command_class(const char* name) {
@@ -236,6 +249,23 @@ ShellCommandClassId Shell<T>::add_command_class(const char* name) {
   return cmd_class;
 } 
 
+template<class T>
+void Shell<T>::set_profile_file(const std::string& profile_file) {
+  /* Create the file with a header line, each executed command will append a line to it */
+  std::ofstream fp(profile_file.c_str(), std::ios::out | std::ios::trunc);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open the profile file: %s! Profiling is disabled\n",
+                  profile_file.c_str());
+    profile_file_.clear();
+    return;
+  }
+
+  fp << "command,status,wall_time_sec,cpu_time_sec,max_rss_mib,delta_max_rss_mib,command_line" << "\n";
+  fp.close();
+
+  profile_file_ = profile_file;
+}
+
 /************************************************************************
  * Public executors
  ***********************************************************************/
@@ -244,6 +274,7 @@ void Shell<T>::run_interactive_mode(T& context, const bool& quiet_mode) {
   if (false == quiet_mode) {
     /* Reset timer since it does not come from another mode */
     time_start_ = std::clock();
+    wall_time_start_ = std::chrono::steady_clock::now();
 
     VTR_LOG("Start interactive mode of %s...\n",
             name().c_str());
@@ -275,6 +306,7 @@ template <class T>
 void Shell<T>::run_script_mode(const char* script_file_name, T& context) {
 
   time_start_ = std::clock();
+  wall_time_start_ = std::chrono::steady_clock::now();
 
   VTR_LOG("Reading script file %s...\n", script_file_name);
 
@@ -425,8 +457,10 @@ void Shell<T>::exit() const {
   VTR_LOG("\nFinish execution with %d errors\n",
             num_err);
 
-  VTR_LOG("\nThe entire OpenFPGA flow took %g seconds\n",
-          (double)(std::clock() - time_start_) / (double)CLOCKS_PER_SEC);
+  VTR_LOG("\nThe entire OpenFPGA flow took %g seconds (CPU time %g seconds, max_rss %.1f MiB)\n",
+          std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_time_start_).count(),
+          (double)(std::clock() - time_start_) / (double)CLOCKS_PER_SEC,
+          (double)vtr::get_max_rss() / (1024. * 1024.));
 
   VTR_LOG("\nThank you for using %s!\n",
           name().c_str());
@@ -454,8 +488,7 @@ int Shell<T>::execute_command(const char* cmd_line,
 
   /* Check the dependency graph to see if all the prequistics have been met */
   for (const ShellCommandId& dep_cmd : command_dependencies_[cmd_id]) {
-    if ( (CMD_EXEC_NONE == command_status_[dep_cmd])
-      || (CMD_EXEC_FATAL_ERROR == command_status_[dep_cmd]) ) {
+    if (false == command_executed(dep_cmd)) {
       VTR_LOG("Command '%s' is required to be executed before command '%s'!\n",
               commands_[dep_cmd].name().c_str(), commands_[cmd_id].name().c_str());
       /* Echo the command help desk */
@@ -464,6 +497,29 @@ int Shell<T>::execute_command(const char* cmd_line,
     } 
   }
 
+  /* Profile the command only when required, as the options are parsed and the command is executed */
+  if (true == profile_file_.empty()) {
+    return dispatch_command(cmd_id, tokens, common_context);
+  }
+
+  vtr::Timer cmd_timer;
+  std::clock_t cmd_cpu_start = std::clock();
+
+  int status = dispatch_command(cmd_id, tokens, common_context);
+
+  write_command_profile(cmd_id, cmd_line, status,
+                        cmd_timer.elapsed_sec(),
+                        (float)(std::clock() - cmd_cpu_start) / (float)CLOCKS_PER_SEC,
+                        cmd_timer.max_rss_mib(),
+                        cmd_timer.delta_max_rss_mib());
+
+  return status;
+}
+
+template <class T>
+int Shell<T>::dispatch_command(const ShellCommandId& cmd_id,
+                               const std::vector<std::string>& tokens,
+                               T& common_context) {
   /* Find the command! Parse the options 
    * Note:
    * Macro command will not be parsed! It will be directly executed
@@ -537,6 +593,76 @@ int Shell<T>::execute_command(const char* cmd_line,
   return command_status_[cmd_id];
 }
 
+template <class T>
+void Shell<T>::write_command_profile(const ShellCommandId& cmd_id,
+                                     const char* cmd_line,
+                                     const int& status,
+                                     const float& wall_time,
+                                     const float& cpu_time,
+                                     const float& max_rss,
+                                     const float& delta_max_rss) const {
+  /* Append to the file, so that the profiles of finished commands are kept
+   * even if the shell is aborted
+   */
+  std::ofstream fp(profile_file_.c_str(), std::ios::out | std::ios::app);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open the profile file: %s!\n",
+                  profile_file_.c_str());
+    return;
+  }
+
+  std::string status_name;
+  switch (status) {
+  case CMD_EXEC_SUCCESS:
+    status_name = "success";
+    break;
+  case CMD_EXEC_FATAL_ERROR:
+    status_name = "fatal_error";
+    break;
+  case CMD_EXEC_MINOR_ERROR:
+    status_name = "minor_error";
+    break;
+  default:
+    status_name = "unknown";
+    break;
+  }
+
+  /* The command line is quoted as it may contain commas */
+  std::string quoted_cmd_line("\"");
+  for (const char* c = cmd_line; *c != '\0'; ++c) {
+    if ('"' == *c) {
+      quoted_cmd_line += '"';
+    }
+    quoted_cmd_line += *c;
+  }
+  quoted_cmd_line += '"';
+
+  char buffer[128];
+  snprintf(buffer, sizeof(buffer), "%.6f,%.6f,%.1f,%.1f",
+           wall_time, cpu_time, max_rss, delta_max_rss);
+
+  fp << commands_[cmd_id].name() << ","
+     << status_name << ","
+     << buffer << ","
+     << quoted_cmd_line << "\n";
+  fp.close();
+}
+
+template <class T>
+bool Shell<T>::command_executed(const ShellCommandId& cmd_id) const {
+  if ( (CMD_EXEC_NONE != command_status_[cmd_id])
+    && (CMD_EXEC_FATAL_ERROR != command_status_[cmd_id]) ) {
+    return true;
+  }
+  for (const ShellCommandId& alternative_cmd : command_alternatives_[cmd_id]) {
+    if ( (CMD_EXEC_NONE != command_status_[alternative_cmd])
+      && (CMD_EXEC_FATAL_ERROR != command_status_[alternative_cmd]) ) {
+      return true;
+    }
+  }
+  return false;
+}
+
 /************************************************************************
  * Public invalidators/validators 
  ***********************************************************************/
@@ -14,6 +14,7 @@
 #include "rr_graph_obj_util.h"
 #include "openfpga_rr_graph_utils.h"
 
+#include "openfpga_parallel_utils.h"
 #include "annotate_rr_graph.h"
 
 /* begin namespace openfpga */
@@ -400,9 +401,15 @@ RRGSB build_rr_gsb(const DeviceContext& vpr_device_ctx,
 /********************************************************************
  * Build the annotation for the routing resource graph
  * by collecting the nodes to the General Switch Block context
+ *
+ * Each GSB only depends on the routing resource graph and the grid,
+ * so the columns of GSBs can be built by multiple threads.
+ * Each GSB is stored at its own coordinate of the pre-allocated array,
+ * so the results are the same regardless of the number of threads
  *******************************************************************/
 void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx, 
                             DeviceRRGSB& device_rr_gsb,
+                            const size_t& num_threads,
                             const bool& verbose_output) {
 
   vtr::ScopedStartFinishTimer timer("Build General Switch Block(GSB) annotation on top of routing resource graph");
@@ -412,30 +419,34 @@ void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx,
   device_rr_gsb.reserve(gsb_range);
 
   VTR_LOGV(verbose_output, 
-           "Start annotation GSB up to [%lu][%lu]\n",
-           gsb_range.x(), gsb_range.y());
+           "Start annotation GSB up to [%lu][%lu] with %lu threads\n",
+           gsb_range.x(), gsb_range.y(), num_threads);
+
+  /* Build the fast look-up of the routing resource graph before it is shared by threads */
+  vpr_device_ctx.rr_graph.initialize_fast_node_lookup();
 
-  size_t gsb_cnt = 0;
   /* For each switch block, determine the size of array */
-  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+  parallel_for(gsb_range.x(), num_threads, 
+               [&](const size_t& ix) {
     for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
       /* Here we give the builder the fringe coordinates so that it can handle the GSBs at the borderside correctly
        * sort drive_rr_nodes should be called if required by users
        */
-      const RRGSB& rr_gsb = build_rr_gsb(vpr_device_ctx, 
-                                         vtr::Point<size_t>(vpr_device_ctx.grid.width() - 2, vpr_device_ctx.grid.height() - 2), 
-                                         vtr::Point<size_t>(ix, iy));
+      vtr::Point<size_t> gsb_coordinate(ix, iy);
+      device_rr_gsb.get_mutable_gsb(gsb_coordinate) = build_rr_gsb(vpr_device_ctx, 
+                                                                   vtr::Point<size_t>(vpr_device_ctx.grid.width() - 2, vpr_device_ctx.grid.height() - 2), 
+                                                                   gsb_coordinate);
+      VTR_ASSERT(gsb_coordinate == device_rr_gsb.get_gsb(gsb_coordinate).get_sb_coordinate());
  
-      /* Add to device_rr_gsb */
-      vtr::Point<size_t> gsb_coordinate = rr_gsb.get_sb_coordinate();
-      device_rr_gsb.add_rr_gsb(gsb_coordinate, rr_gsb);
-      gsb_cnt++; /* Update counter */
-      /* Print info */
-      VTR_LOG("[%lu%] Backannotated GSB[%lu][%lu]\r",
-              100 * gsb_cnt / (gsb_range.x() * gsb_range.y()), 
-              ix, iy);
+      /* Print info, which is only readable when a single thread is used */
+      if (1 == num_threads) {
+        VTR_LOG("[%lu%] Backannotated GSB[%lu][%lu]\r",
+                100 * (ix * gsb_range.y() + iy + 1) / (gsb_range.x() * gsb_range.y()), 
+                ix, iy);
+      }
     }
-  }
+  });
+
   /* Report number of unique mirrors */
   VTR_LOG("Backannotated %d General Switch Blocks (GSBs).\n",
           gsb_range.x() * gsb_range.y());
@@ -444,9 +455,12 @@ void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx,
 /********************************************************************
  * Sort all the incoming edges for each channel node which are
  * output ports of the GSB
+ * Each GSB is sorted independently, so the columns of GSBs can be 
+ * sorted by multiple threads
  *******************************************************************/
 void sort_device_rr_gsb_chan_node_in_edges(const RRGraph& rr_graph,
                                            DeviceRRGSB& device_rr_gsb,
+                                           const size_t& num_threads,
                                            const bool& verbose_output) {
   vtr::ScopedStartFinishTimer timer("Sort incoming edges for each routing track output node of General Switch Block(GSB)");
 
@@ -454,26 +468,28 @@ void sort_device_rr_gsb_chan_node_in_edges(const RRGraph& rr_graph,
   vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
 
   VTR_LOGV(verbose_output, 
-           "Start sorting edges for GSBs up to [%lu][%lu]\n",
-           gsb_range.x(), gsb_range.y());
+           "Start sorting edges for GSBs up to [%lu][%lu] with %lu threads\n",
+           gsb_range.x(), gsb_range.y(), num_threads);
 
-  size_t gsb_cnt = 0;
+  /* Build the fast look-up of the routing resource graph before it is shared by threads */
+  rr_graph.initialize_fast_node_lookup();
 
   /* For each switch block, determine the size of array */
-  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+  parallel_for(gsb_range.x(), num_threads, 
+               [&](const size_t& ix) {
     for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
       vtr::Point<size_t> gsb_coordinate(ix, iy);
       RRGSB& rr_gsb = device_rr_gsb.get_mutable_gsb(gsb_coordinate);
       rr_gsb.sort_chan_node_in_edges(rr_graph);
 
-      gsb_cnt++; /* Update counter */
-
-      /* Print info */
-      VTR_LOG("[%lu%] Sorted edges for GSB[%lu][%lu]\r",
-              100 * gsb_cnt / (gsb_range.x() * gsb_range.y()), 
-              ix, iy);
+      /* Print info, which is only readable when a single thread is used */
+      if (1 == num_threads) {
+        VTR_LOG("[%lu%] Sorted edges for GSB[%lu][%lu]\r",
+                100 * (ix * gsb_range.y() + iy + 1) / (gsb_range.x() * gsb_range.y()), 
+                ix, iy);
+      }
     } 
-  }
+  });
 
   /* Report number of unique mirrors */
   VTR_LOG("Sorted edges for %d General Switch Blocks (GSBs).\n",
@@ -1,8 +1,15 @@
 /************************************************************************
  * Member functions for class DeviceRRGSB
  ***********************************************************************/
+#include <algorithm>
+#include <array>
+#include <map>
+#include <unordered_map>
+
 #include "vtr_log.h"
 #include "vtr_assert.h"
+
+#include "openfpga_parallel_utils.h"
 #include "device_rr_gsb.h"
 
 /* namespace openfpga begins */
@@ -136,6 +143,28 @@ const RRGSB& DeviceRRGSB::get_sb_unique_module(const vtr::Point<size_t>& coordin
   return get_sb_unique_module(sb_unique_module_id);
 } 
 
+/* Give a coordinate of a rr switch block, and return the index of its unique mirror */ 
+size_t DeviceRRGSB::get_sb_unique_module_index(const vtr::Point<size_t>& coordinate) const {
+  VTR_ASSERT(validate_coordinate(coordinate));
+  return sb_unique_module_id_[coordinate.x()][coordinate.y()];  
+} 
+
+/* Give a coordinate of a connection block, and return the index of its unique mirror */ 
+size_t DeviceRRGSB::get_cb_unique_module_index(const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate) const {
+  VTR_ASSERT(validate_cb_type(cb_type));
+  VTR_ASSERT(validate_coordinate(coordinate));
+
+  switch(cb_type) {
+  case CHANX:
+    return cbx_unique_module_id_[coordinate.x()][coordinate.y()];  
+  case CHANY:
+    return cby_unique_module_id_[coordinate.x()][coordinate.y()];  
+  default: 
+    VTR_LOG_ERROR("Invalid type of connection block!\n");
+    exit(1);
+  }  
+} 
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
@@ -205,11 +234,32 @@ RRGSB& DeviceRRGSB::get_mutable_gsb(const size_t& x, const size_t& y) {
   return get_mutable_gsb(coordinate);
 }
 
-/* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
-void DeviceRRGSB::build_cb_unique_module(const RRGraph& rr_graph, const t_rr_type& cb_type) {
+/* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors 
+ * Connection blocks are bucketed by their fingerprints, 
+ * so that a connection block is only compared to the unique modules in the same bucket.
+ * Mirrors always have the same fingerprint and the unique modules in a bucket are visited 
+ * in the order they are found, so the unique module ids are the same as comparing
+ * to all the unique modules
+ */
+void DeviceRRGSB::build_cb_unique_module(const RRGraph& rr_graph, const t_rr_type& cb_type, const size_t& num_threads) {
   /* Make sure a clean start */
   clear_cb_unique_module(cb_type);
 
+  /* Fingerprints of each GSB are independent and can be computed by multiple threads */
+  std::vector<std::vector<size_t>> fingerprints(rr_gsb_.size());
+  parallel_for(rr_gsb_.size(), num_threads, 
+               [&](const size_t& ix) {
+    fingerprints[ix].resize(rr_gsb_[ix].size(), 0);
+    for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
+      if (true == rr_gsb_[ix][iy].is_cb_exist(cb_type)) {
+        fingerprints[ix][iy] = rr_gsb_[ix][iy].get_cb_fingerprint(rr_graph, cb_type);
+      }
+    }
+  });
+
+  /* Unique module ids grouped by fingerprints */
+  std::unordered_map<size_t, std::vector<size_t>> unique_module_buckets;
+
   for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
     for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
       bool is_unique_module = true;
@@ -220,8 +270,10 @@ void DeviceRRGSB::build_cb_unique_module(const RRGraph& rr_graph, const t_rr_typ
         continue;
       }
 
+      std::vector<size_t>& unique_module_bucket = unique_module_buckets[fingerprints[ix][iy]];
+
       /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_cb_unique_module(cb_type); ++id) {
+      for (const size_t& id : unique_module_bucket) {
         const RRGSB& unique_module = get_cb_unique_module(cb_type, id);
         if (true == rr_gsb_[ix][iy].is_cb_mirror(rr_graph, unique_module, cb_type)) {
           /* This is a mirror, raise the flag and we finish */
@@ -236,24 +288,42 @@ void DeviceRRGSB::build_cb_unique_module(const RRGraph& rr_graph, const t_rr_typ
         add_cb_unique_module(cb_type, gsb_coordinate);
         /* Record the id of unique mirror */
         set_cb_unique_module_id(cb_type, gsb_coordinate, get_num_cb_unique_module(cb_type) - 1); 
+        unique_module_bucket.push_back(get_num_cb_unique_module(cb_type) - 1);
       }
     }
   } 
 }
 
-/* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
-void DeviceRRGSB::build_sb_unique_module(const RRGraph& rr_graph) {
+/* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors 
+ * Switch blocks are bucketed by their fingerprints in the same way as connection blocks
+ */
+void DeviceRRGSB::build_sb_unique_module(const RRGraph& rr_graph, const size_t& num_threads) {
   /* Make sure a clean start */
   clear_sb_unique_module();
 
+  /* Fingerprints of each GSB are independent and can be computed by multiple threads */
+  std::vector<std::vector<size_t>> fingerprints(rr_gsb_.size());
+  parallel_for(rr_gsb_.size(), num_threads, 
+               [&](const size_t& ix) {
+    fingerprints[ix].resize(rr_gsb_[ix].size(), 0);
+    for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
+      fingerprints[ix][iy] = rr_gsb_[ix][iy].get_sb_fingerprint(rr_graph);
+    }
+  });
+
+  /* Unique module ids grouped by fingerprints */
+  std::unordered_map<size_t, std::vector<size_t>> unique_module_buckets;
+
   /* Build the unique module */
   for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
     for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
       bool is_unique_module = true;
       vtr::Point<size_t> sb_coordinate(ix, iy);
 
+      std::vector<size_t>& unique_module_bucket = unique_module_buckets[fingerprints[ix][iy]];
+
       /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_sb_unique_module(); ++id) {
+      for (const size_t& id : unique_module_bucket) {
         /* Check if the two modules have the same submodules,
          * if so, these two modules are the same, indicating the sb is not unique.
          * else the sb is unique 
@@ -273,6 +343,7 @@ void DeviceRRGSB::build_sb_unique_module(const RRGraph& rr_graph) {
         sb_unique_module_.push_back(sb_coordinate);
         /* Record the id of unique mirror */
         sb_unique_module_id_[ix][iy] = sb_unique_module_.size() - 1; 
+        unique_module_bucket.push_back(sb_unique_module_.size() - 1);
       }
     }
   } 
@@ -280,49 +351,141 @@ void DeviceRRGSB::build_sb_unique_module(const RRGraph& rr_graph) {
 
 /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
 
-/* Find repeatable GSB block in the array */
+/* Find repeatable GSB block in the array 
+ * We have alreay built sb and cb unique module list 
+ * We just need to check if the unique module id of SBs, CBX and CBY are the same or not,
+ * which can be found by a fast look-up 
+ */
 void DeviceRRGSB::build_gsb_unique_module() {
   /* Make sure a clean start */
   clear_gsb_unique_module();
 
+  /* Fast look-up from the unique module ids of [SB, CBX, CBY] to the unique GSB id */
+  std::map<std::array<size_t, 3>, size_t> unique_module_lookup;
+
   for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
     for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
-      bool is_unique_module = true;
       vtr::Point<size_t> gsb_coordinate(ix, iy);
 
-      /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_gsb_unique_module(); ++id) {
-        /* We have alreay built sb and cb unique module list 
-         * We just need to check if the unique module id of SBs, CBX and CBY are the same or not 
-         */
-        const vtr::Point<size_t>& gsb_unique_module_coordinate = gsb_unique_module_[id];
-        if ((sb_unique_module_id_[ix][iy] == sb_unique_module_id_[gsb_unique_module_coordinate.x()][gsb_unique_module_coordinate.y()])
-         && (cbx_unique_module_id_[ix][iy] == cbx_unique_module_id_[gsb_unique_module_coordinate.x()][gsb_unique_module_coordinate.y()])
-         && (cby_unique_module_id_[ix][iy] == cby_unique_module_id_[gsb_unique_module_coordinate.x()][gsb_unique_module_coordinate.y()])) {
-          /* This is a mirror, raise the flag and we finish */
-          is_unique_module = false;
-          /* Record the id of unique mirror */
-          gsb_unique_module_id_[ix][iy] = id; 
-          break;
-        }
+      std::array<size_t, 3> submodule_ids = {{sb_unique_module_id_[ix][iy],
+                                              cbx_unique_module_id_[ix][iy],
+                                              cby_unique_module_id_[ix][iy]}};
+      auto result = unique_module_lookup.find(submodule_ids);
+      if (unique_module_lookup.end() != result) {
+        /* This is a mirror, record the id of unique mirror */
+        gsb_unique_module_id_[ix][iy] = result->second; 
+        continue;
       }
+
       /* Add to list if this is a unique mirror*/
-      if (true == is_unique_module) {
-        add_gsb_unique_module(gsb_coordinate);
-        /* Record the id of unique mirror */
-        gsb_unique_module_id_[ix][iy] = get_num_gsb_unique_module() - 1;
-      }
+      add_gsb_unique_module(gsb_coordinate);
+      /* Record the id of unique mirror */
+      gsb_unique_module_id_[ix][iy] = get_num_gsb_unique_module() - 1;
+      unique_module_lookup[submodule_ids] = get_num_gsb_unique_module() - 1;
     }
   } 
 }
 
-void DeviceRRGSB::build_unique_module(const RRGraph& rr_graph) {
-  build_sb_unique_module(rr_graph);
+/* Find the unique modules of SBs, CBXs and CBYs, which are independent from each other.
+ * They can be built by multiple threads, and the threads are shared between them. 
+ * Unique modules are always numbered in the order of coordinates,
+ * so the results are the same regardless of the number of threads
+ */
+void DeviceRRGSB::build_unique_module(const RRGraph& rr_graph, const size_t& num_threads) {
+  /* Build the fast look-up of the routing resource graph before it is shared by threads */
+  rr_graph.initialize_fast_node_lookup();
+
+  const size_t num_module_types = 3;
+  size_t num_threads_per_module_type = std::max(num_threads / num_module_types, size_t(1));
+
+  parallel_for(num_module_types, num_threads, 
+               [&](const size_t& imodule_type) {
+    switch (imodule_type) {
+    case 0:
+      build_sb_unique_module(rr_graph, num_threads_per_module_type);
+      break;
+    case 1:
+      build_cb_unique_module(rr_graph, CHANX, num_threads_per_module_type);
+      break;
+    case 2:
+      build_cb_unique_module(rr_graph, CHANY, num_threads_per_module_type);
+      break;
+    default:
+      VTR_ASSERT_MSG(false, "Invalid type of unique module!");
+    }
+  });
+
+  build_gsb_unique_module();
+}
+
+/* Restore the unique modules of SBs, CBXs and CBYs from the indices of their unique mirrors,
+ * which are found by build_unique_module() in a previous run, e.g., loaded from a fabric snapshot.
+ * As unique modules are always numbered in the order of coordinates,
+ * a GSB is a unique module if its index is the number of unique modules found before it.
+ * The indices of non-exist CBs are ignored.
+ * Return false if the indices do not match the GSB array, where nothing is changed
+ */
+bool DeviceRRGSB::load_unique_module(const std::vector<std::vector<size_t>>& sb_unique_module_ids,
+                                     const std::vector<std::vector<size_t>>& cbx_unique_module_ids,
+                                     const std::vector<std::vector<size_t>>& cby_unique_module_ids) {
+  if ( (sb_unique_module_ids.size() != rr_gsb_.size())
+    || (cbx_unique_module_ids.size() != rr_gsb_.size())
+    || (cby_unique_module_ids.size() != rr_gsb_.size()) ) {
+    return false;
+  }
 
-  build_cb_unique_module(rr_graph, CHANX);
-  build_cb_unique_module(rr_graph, CHANY);
+  std::vector<vtr::Point<size_t>> sb_unique_module;
+  std::vector<vtr::Point<size_t>> cbx_unique_module;
+  std::vector<vtr::Point<size_t>> cby_unique_module;
 
+  for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
+    if ( (sb_unique_module_ids[ix].size() != rr_gsb_[ix].size())
+      || (cbx_unique_module_ids[ix].size() != rr_gsb_[ix].size())
+      || (cby_unique_module_ids[ix].size() != rr_gsb_[ix].size()) ) {
+      return false;
+    }
+    for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
+      vtr::Point<size_t> gsb_coordinate(ix, iy);
+
+      /* An index can only refer to a unique module found before, or be the next one */
+      if (sb_unique_module_ids[ix][iy] > sb_unique_module.size()) {
+        return false;
+      }
+      if (sb_unique_module_ids[ix][iy] == sb_unique_module.size()) {
+        sb_unique_module.push_back(gsb_coordinate);
+      }
+
+      if (true == rr_gsb_[ix][iy].is_cb_exist(CHANX)) {
+        if (cbx_unique_module_ids[ix][iy] > cbx_unique_module.size()) {
+          return false;
+        }
+        if (cbx_unique_module_ids[ix][iy] == cbx_unique_module.size()) {
+          cbx_unique_module.push_back(gsb_coordinate);
+        }
+      }
+
+      if (true == rr_gsb_[ix][iy].is_cb_exist(CHANY)) {
+        if (cby_unique_module_ids[ix][iy] > cby_unique_module.size()) {
+          return false;
+        }
+        if (cby_unique_module_ids[ix][iy] == cby_unique_module.size()) {
+          cby_unique_module.push_back(gsb_coordinate);
+        }
+      }
+    }
+  }
+
+  sb_unique_module_ = sb_unique_module;
+  sb_unique_module_id_ = sb_unique_module_ids;
+  cbx_unique_module_ = cbx_unique_module;
+  cbx_unique_module_id_ = cbx_unique_module_ids;
+  cby_unique_module_ = cby_unique_module;
+  cby_unique_module_id_ = cby_unique_module_ids;
+
+  /* GSBs are found from the unique modules of SBs and CBs in a fast way */
   build_gsb_unique_module();
+
+  return true;
 }
 
 void DeviceRRGSB::add_gsb_unique_module(const vtr::Point<size_t>& coordinate) {
@@ -37,6 +37,8 @@ class DeviceRRGSB {
     const RRGSB& get_cb_unique_module(const t_rr_type& cb_type, const size_t& index) const; /* Get a rr switch block which a unique mirror */ 
     const RRGSB& get_cb_unique_module(const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate) const;
     size_t get_num_cb_unique_module(const t_rr_type& cb_type) const; /* get the number of unique mirrors of CBs */
+    size_t get_sb_unique_module_index(const vtr::Point<size_t>& coordinate) const; /* Get the index of the unique mirror of a switch block */
+    size_t get_cb_unique_module_index(const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate) const; /* Get the index of the unique mirror of a connection block */
     bool is_gsb_exist(const vtr::Point<size_t> coord) const;
   public: /* Mutators */ 
     void reserve(const vtr::Point<size_t>& coordinate); /* Pre-allocate the rr_switch_block array that the device requires */ 
@@ -45,7 +47,10 @@ class DeviceRRGSB {
     void add_rr_gsb(const vtr::Point<size_t>& coordinate, const RRGSB& rr_gsb); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
     RRGSB& get_mutable_gsb(const vtr::Point<size_t>& coordinate); /* Get a rr switch block in the array with a coordinate */
     RRGSB& get_mutable_gsb(const size_t& x, const size_t& y); /* Get a rr switch block in the array with a coordinate */
-    void build_unique_module(const RRGraph& rr_graph); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
+    void build_unique_module(const RRGraph& rr_graph, const size_t& num_threads); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
+    bool load_unique_module(const std::vector<std::vector<size_t>>& sb_unique_module_ids,
+                            const std::vector<std::vector<size_t>>& cbx_unique_module_ids,
+                            const std::vector<std::vector<size_t>>& cby_unique_module_ids); /* Restore the unique mirrors from the indices found by build_unique_module(), e.g., loaded from a file */
     void clear(); /* clean the content */
   private: /* Internal cleaners */
     void clear_gsb(); /* clean the content */
@@ -65,8 +70,8 @@ class DeviceRRGSB {
     void add_gsb_unique_module(const vtr::Point<size_t>& coordinate);
     void add_cb_unique_module(const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate);
     void set_cb_unique_module_id(const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate, size_t id);
-    void build_sb_unique_module(const RRGraph& rr_graph); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
-    void build_cb_unique_module(const RRGraph& rr_graph, const t_rr_type& cb_type); /* Add a switch block to the array, which will automatically identify and update the lists of unique side module */
+    void build_sb_unique_module(const RRGraph& rr_graph, const size_t& num_threads); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
+    void build_cb_unique_module(const RRGraph& rr_graph, const t_rr_type& cb_type, const size_t& num_threads); /* Add a switch block to the array, which will automatically identify and update the lists of unique side module */
     void build_gsb_unique_module(); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
   private: /* Internal Data */
     std::vector<std::vector<RRGSB>> rr_gsb_;
@@ -1,8 +1,6 @@
 /************************************************************************
  * Member functions for class VprDeviceAnnotation
  ***********************************************************************/
-#include <algorithm>
-
 #include "vtr_log.h"
 #include "vtr_assert.h"
 #include "vpr_device_annotation.h"
@@ -22,126 +20,118 @@ VprDeviceAnnotation::VprDeviceAnnotation() {
  ***********************************************************************/
 bool VprDeviceAnnotation::is_physical_pb_type(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, t_pb_type*>::const_iterator it = physical_pb_types_.find(pb_type);
-  if (it == physical_pb_types_.end()) {
+  VprPbTypeId pb_type_id = pb_type_index(pb_type);
+  if (VprPbTypeId::INVALID() == pb_type_id) {
     return false;
   }
   /* A physical pb_type should be mapped to itself! Otherwise, it is an operating pb_type */
-  return pb_type == physical_pb_types_.at(pb_type);
+  return pb_type == physical_pb_types_[pb_type_id];
 }
 
 t_mode* VprDeviceAnnotation::physical_mode(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, t_mode*>::const_iterator it = physical_pb_modes_.find(pb_type);
-  if (it == physical_pb_modes_.end()) {
+  VprPbTypeId pb_type_id = pb_type_index(pb_type);
+  if (VprPbTypeId::INVALID() == pb_type_id) {
     return nullptr;
   }
-  return physical_pb_modes_.at(pb_type);
+  return physical_pb_modes_[pb_type_id];
 }
 
 t_pb_type* VprDeviceAnnotation::physical_pb_type(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, t_pb_type*>::const_iterator it = physical_pb_types_.find(pb_type);
-  if (it == physical_pb_types_.end()) {
+  VprPbTypeId pb_type_id = pb_type_index(pb_type);
+  if (VprPbTypeId::INVALID() == pb_type_id) {
     return nullptr;
   }
-  return physical_pb_types_.at(pb_type);
+  return physical_pb_types_[pb_type_id];
 }
 
 t_port* VprDeviceAnnotation::physical_pb_port(t_port* pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, t_port*>::const_iterator it = physical_pb_ports_.find(pb_port);
-  if (it == physical_pb_ports_.end()) {
+  /* Ensure that the pb_port is in the list */
+  VprPbPortId pb_port_id = pb_port_index(pb_port);
+  if (VprPbPortId::INVALID() == pb_port_id) {
     return nullptr;
   }
-  return physical_pb_ports_.at(pb_port);
+  return physical_pb_ports_[pb_port_id];
 }
 
 BasicPort VprDeviceAnnotation::physical_pb_port_range(t_port* pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, BasicPort>::const_iterator it = physical_pb_port_ranges_.find(pb_port);
-  if (it == physical_pb_port_ranges_.end()) {
+  /* Ensure that the pb_port is in the list */
+  VprPbPortId pb_port_id = pb_port_index(pb_port);
+  if (VprPbPortId::INVALID() == pb_port_id) {
     /* Return an invalid port. As such the port width will be 0, which is an invalid value */
     return BasicPort();
   }
-  return physical_pb_port_ranges_.at(pb_port);
+  return physical_pb_port_ranges_[pb_port_id];
 }
 
 CircuitModelId VprDeviceAnnotation::pb_type_circuit_model(t_pb_type* physical_pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, CircuitModelId>::const_iterator it = pb_type_circuit_models_.find(physical_pb_type);
-  if (it == pb_type_circuit_models_.end()) {
+  VprPbTypeId pb_type_id = pb_type_index(physical_pb_type);
+  if (VprPbTypeId::INVALID() == pb_type_id) {
     /* Return an invalid circuit model id */
     return CircuitModelId::INVALID();
   }
-  return pb_type_circuit_models_.at(physical_pb_type);
+  return pb_type_circuit_models_[pb_type_id];
 }
 
 CircuitModelId VprDeviceAnnotation::interconnect_circuit_model(t_interconnect* pb_interconnect) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_interconnect*, CircuitModelId>::const_iterator it = interconnect_circuit_models_.find(pb_interconnect);
-  if (it == interconnect_circuit_models_.end()) {
+  /* Ensure that the interconnect is in the list */
+  VprInterconnectId interc_id = interconnect_index(pb_interconnect);
+  if (VprInterconnectId::INVALID() == interc_id) {
     /* Return an invalid circuit model id */
     return CircuitModelId::INVALID();
   }
-  return interconnect_circuit_models_.at(pb_interconnect);
+  return interconnect_circuit_models_[interc_id];
 }
 
 e_interconnect VprDeviceAnnotation::interconnect_physical_type(t_interconnect* pb_interconnect) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_interconnect*, e_interconnect>::const_iterator it = interconnect_physical_types_.find(pb_interconnect);
-  if (it == interconnect_physical_types_.end()) {
+  /* Ensure that the interconnect is in the list */
+  VprInterconnectId interc_id = interconnect_index(pb_interconnect);
+  if (VprInterconnectId::INVALID() == interc_id) {
     /* Return an invalid interconnect type */
     return NUM_INTERC_TYPES;
   }
-  return interconnect_physical_types_.at(pb_interconnect);
+  return interconnect_physical_types_[interc_id];
 }
 
 CircuitPortId VprDeviceAnnotation::pb_circuit_port(t_port* pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, CircuitPortId>::const_iterator it = pb_circuit_ports_.find(pb_port);
-  if (it == pb_circuit_ports_.end()) {
+  /* Ensure that the pb_port is in the list */
+  VprPbPortId pb_port_id = pb_port_index(pb_port);
+  if (VprPbPortId::INVALID() == pb_port_id) {
     /* Return an invalid circuit port id */
     return CircuitPortId::INVALID();
   }
-  return pb_circuit_ports_.at(pb_port);
+  return pb_circuit_ports_[pb_port_id];
 }
 
-std::vector<size_t> VprDeviceAnnotation::pb_type_mode_bits(t_pb_type* pb_type) const {
+const std::vector<size_t>& VprDeviceAnnotation::pb_type_mode_bits(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, std::vector<size_t>>::const_iterator it = pb_type_mode_bits_.find(pb_type);
-  if (it == pb_type_mode_bits_.end()) {
+  VprPbTypeId pb_type_id = pb_type_index(pb_type);
+  if (VprPbTypeId::INVALID() == pb_type_id) {
     /* Return an empty vector */
-    return std::vector<size_t>();
+    static const std::vector<size_t> empty_mode_bits;
+    return empty_mode_bits;
   }
-  return pb_type_mode_bits_.at(pb_type);
+  return pb_type_mode_bits_[pb_type_id];
 }
 
 PbGraphNodeId VprDeviceAnnotation::pb_graph_node_unique_index(t_pb_graph_node* pb_graph_node) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, std::vector<t_pb_graph_node*>>::const_iterator it = pb_graph_node_unique_index_.find(pb_graph_node->pb_type);
-  if (it == pb_graph_node_unique_index_.end()) {
-    /* Invalid pb_type, return a null pointer */
-    return PbGraphNodeId::INVALID();
-  }
-
-  /* Try to find the pb_graph_node in the vector */
-  std::vector<t_pb_graph_node*>::const_iterator it_node = std::find(pb_graph_node_unique_index_.at(pb_graph_node->pb_type).begin(),
-                                                                    pb_graph_node_unique_index_.at(pb_graph_node->pb_type).end(),
-                                                                    pb_graph_node);
-  /* If it exists, return the index
+  /* Ensure that the pb_graph_node is in the list
+   * If it has an unique index, return the index
    * Otherwise, return an invalid id
    */
-  if (it_node == pb_graph_node_unique_index_.at(pb_graph_node->pb_type).end()) {
+  VprPbGraphNodeId node_id = pb_graph_node_index(pb_graph_node);
+  if (VprPbGraphNodeId::INVALID() == node_id) {
     return PbGraphNodeId::INVALID();
   }
-  return PbGraphNodeId(it_node - pb_graph_node_unique_index_.at(pb_graph_node->pb_type).begin());
+  return pb_graph_node_unique_ids_[node_id];
 }
 
 t_pb_graph_node* VprDeviceAnnotation::pb_graph_node(t_pb_type* pb_type, const PbGraphNodeId& unique_index) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, std::vector<t_pb_graph_node*>>::const_iterator it = pb_graph_node_unique_index_.find(pb_type);
-  if (it == pb_graph_node_unique_index_.end()) {
+  VprPbTypeId pb_type_id = pb_type_index(pb_type);
+  if (VprPbTypeId::INVALID() == pb_type_id) {
     /* Invalid pb_type, return a null pointer */
     return nullptr;
   }
@@ -149,221 +139,296 @@ t_pb_graph_node* VprDeviceAnnotation::pb_graph_node(t_pb_type* pb_type, const Pb
    *  - Out of range: return a null pointer
    *  - In range: return the pointer
    */
-  if ((size_t)unique_index > pb_graph_node_unique_index_.at(pb_type).size() - 1) {
+  if ((size_t)unique_index >= pb_graph_node_unique_index_[pb_type_id].size()) {
     return nullptr;
   }
 
-  return pb_graph_node_unique_index_.at(pb_type)[size_t(unique_index)];
+  return pb_graph_node_unique_index_[pb_type_id][size_t(unique_index)];
 }
 
 t_pb_graph_node* VprDeviceAnnotation::physical_pb_graph_node(t_pb_graph_node* pb_graph_node) const {
   /* Ensure that the pb_graph_node is in the list */
-  std::map<t_pb_graph_node*, t_pb_graph_node*>::const_iterator it = physical_pb_graph_nodes_.find(pb_graph_node);
-  if (it == physical_pb_graph_nodes_.end()) {
+  VprPbGraphNodeId node_id = pb_graph_node_index(pb_graph_node);
+  if (VprPbGraphNodeId::INVALID() == node_id) {
     return nullptr;
   }
-  return physical_pb_graph_nodes_.at(pb_graph_node);
+  return physical_pb_graph_nodes_[node_id];
 }
 
 float VprDeviceAnnotation::physical_pb_type_index_factor(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, float>::const_iterator it = physical_pb_type_index_factors_.find(pb_type);
-  if (it == physical_pb_type_index_factors_.end()) {
+  VprPbTypeId pb_type_id = pb_type_index(pb_type);
+  if (VprPbTypeId::INVALID() == pb_type_id) {
     /* Default value is 1 */
     return 1.;
   }
-  return physical_pb_type_index_factors_.at(pb_type);
+  return physical_pb_type_index_factors_[pb_type_id];
 }
 
 int VprDeviceAnnotation::physical_pb_type_index_offset(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, int>::const_iterator it = physical_pb_type_index_offsets_.find(pb_type);
-  if (it == physical_pb_type_index_offsets_.end()) {
+  VprPbTypeId pb_type_id = pb_type_index(pb_type);
+  if (VprPbTypeId::INVALID() == pb_type_id) {
     /* Default value is 0 */
     return 0;
   }
-  return physical_pb_type_index_offsets_.at(pb_type);
+  return physical_pb_type_index_offsets_[pb_type_id];
 }
 
 int VprDeviceAnnotation::physical_pb_pin_rotate_offset(t_port* pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, int>::const_iterator it = physical_pb_pin_rotate_offsets_.find(pb_port);
-  if (it == physical_pb_pin_rotate_offsets_.end()) {
+  /* Ensure that the pb_port is in the list */
+  VprPbPortId pb_port_id = pb_port_index(pb_port);
+  if (VprPbPortId::INVALID() == pb_port_id) {
     /* Default value is 0 */
     return 0;
   }
-  return physical_pb_pin_rotate_offsets_.at(pb_port);
+  return physical_pb_pin_rotate_offsets_[pb_port_id];
 }
 
 int VprDeviceAnnotation::physical_pb_pin_offset(t_port* pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, int>::const_iterator it = physical_pb_pin_offsets_.find(pb_port);
-  if (it == physical_pb_pin_offsets_.end()) {
+  /* Ensure that the pb_port is in the list */
+  VprPbPortId pb_port_id = pb_port_index(pb_port);
+  if (VprPbPortId::INVALID() == pb_port_id) {
     /* Default value is 0 */
     return 0;
   }
-  return physical_pb_pin_offsets_.at(pb_port);
+  return physical_pb_pin_offsets_[pb_port_id];
 }
 
 
 t_pb_graph_pin* VprDeviceAnnotation::physical_pb_graph_pin(const t_pb_graph_pin* pb_graph_pin) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<const t_pb_graph_pin*, t_pb_graph_pin*>::const_iterator it = physical_pb_graph_pins_.find(pb_graph_pin);
-  if (it == physical_pb_graph_pins_.end()) {
+  /* Ensure that the pb_graph_pin is in the list */
+  VprPbGraphPinId pin_id = pb_graph_pin_index(pb_graph_pin);
+  if (VprPbGraphPinId::INVALID() == pin_id) {
     return nullptr;
   }
-  return physical_pb_graph_pins_.at(pb_graph_pin);
+  return physical_pb_graph_pins_[pin_id];
 }
 
 CircuitModelId VprDeviceAnnotation::rr_switch_circuit_model(const RRSwitchId& rr_switch) const {
   /* Ensure that the rr_switch is in the list */
-  std::map<RRSwitchId, CircuitModelId>::const_iterator it = rr_switch_circuit_models_.find(rr_switch);
-  if (it == rr_switch_circuit_models_.end()) {
+  if (size_t(rr_switch) >= rr_switch_circuit_models_.size()) {
     return CircuitModelId::INVALID();
   }
-  return rr_switch_circuit_models_.at(rr_switch);
+  return rr_switch_circuit_models_[rr_switch];
 }
 
 CircuitModelId VprDeviceAnnotation::rr_segment_circuit_model(const RRSegmentId& rr_segment) const {
-  /* Ensure that the rr_switch is in the list */
-  std::map<RRSegmentId, CircuitModelId>::const_iterator it = rr_segment_circuit_models_.find(rr_segment);
-  if (it == rr_segment_circuit_models_.end()) {
+  /* Ensure that the rr_segment is in the list */
+  if (size_t(rr_segment) >= rr_segment_circuit_models_.size()) {
     return CircuitModelId::INVALID();
   }
-  return rr_segment_circuit_models_.at(rr_segment);
+  return rr_segment_circuit_models_[rr_segment];
 }
 
 ArchDirectId VprDeviceAnnotation::direct_annotation(const size_t& direct) const {
-  /* Ensure that the rr_switch is in the list */
-  if (0 == direct_annotations_.count(direct)) {
+  /* Ensure that the direct is in the list */
+  if (direct >= direct_annotations_.size()) {
     return ArchDirectId::INVALID();
   }
-  return direct_annotations_.at(direct);
+  return direct_annotations_[direct];
 }
 
-LbRRGraph VprDeviceAnnotation::physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const {
-  /* Ensure that the rr_switch is in the list */
-  if (0 == physical_lb_rr_graphs_.count(pb_graph_head)) {
-    return LbRRGraph();
+const LbRRGraph& VprDeviceAnnotation::physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const {
+  /* Ensure that the pb_graph_head is in the list */
+  std::map<t_pb_graph_node*, LbRRGraph>::const_iterator it = physical_lb_rr_graphs_.find(pb_graph_head);
+  if (it == physical_lb_rr_graphs_.end()) {
+    static const LbRRGraph empty_lb_rr_graph;
+    return empty_lb_rr_graph;
   }
-  return physical_lb_rr_graphs_.at(pb_graph_head);
+  return it->second;
 }
 
 /************************************************************************
  * Public mutators
  ***********************************************************************/
+void VprDeviceAnnotation::build_indices(const std::vector<t_logical_block_type>& logical_block_types) {
+  /* Clear all the indices and annotations */
+  pb_type_indices_.clear();
+  pb_port_indices_.clear();
+  interconnect_indices_.clear();
+  pb_graph_node_indices_.clear();
+  pb_graph_pin_indices_.clear();
+
+  rr_switch_circuit_models_.clear();
+  rr_segment_circuit_models_.clear();
+  direct_annotations_.clear();
+  physical_lb_rr_graphs_.clear();
+
+  for (const t_logical_block_type& lb_type : logical_block_types) {
+    /* Bypass empty pb_type */
+    if (nullptr == lb_type.pb_type) {
+      continue;
+    }
+    rec_build_pb_type_indices(lb_type.pb_type);
+    rec_build_pb_graph_indices(lb_type.pb_graph_head);
+  }
+
+  /* Each annotation starts with the default value which is returned for an unannotated object */
+  physical_pb_types_.assign(pb_type_indices_.size(), nullptr);
+  physical_pb_type_index_factors_.assign(pb_type_indices_.size(), 1.);
+  physical_pb_type_index_offsets_.assign(pb_type_indices_.size(), 0);
+  physical_pb_modes_.assign(pb_type_indices_.size(), nullptr);
+  pb_type_circuit_models_.assign(pb_type_indices_.size(), CircuitModelId::INVALID());
+  pb_type_mode_bits_.assign(pb_type_indices_.size(), std::vector<size_t>());
+  pb_graph_node_unique_index_.assign(pb_type_indices_.size(), std::vector<t_pb_graph_node*>());
+
+  interconnect_circuit_models_.assign(interconnect_indices_.size(), CircuitModelId::INVALID());
+  interconnect_physical_types_.assign(interconnect_indices_.size(), NUM_INTERC_TYPES);
+
+  physical_pb_ports_.assign(pb_port_indices_.size(), nullptr);
+  physical_pb_pin_rotate_offsets_.assign(pb_port_indices_.size(), 0);
+  physical_pb_pin_offsets_.assign(pb_port_indices_.size(), 0);
+  physical_pb_port_ranges_.assign(pb_port_indices_.size(), BasicPort());
+  pb_circuit_ports_.assign(pb_port_indices_.size(), CircuitPortId::INVALID());
+
+  pb_graph_node_unique_ids_.assign(pb_graph_node_indices_.size(), PbGraphNodeId::INVALID());
+  physical_pb_graph_nodes_.assign(pb_graph_node_indices_.size(), nullptr);
+
+  physical_pb_graph_pins_.assign(pb_graph_pin_indices_.size(), nullptr);
+}
+
 void VprDeviceAnnotation::add_pb_type_physical_mode(t_pb_type* pb_type, t_mode* physical_mode) {
+  VprPbTypeId pb_type_id = pb_type_index(pb_type);
+  VTR_ASSERT(VprPbTypeId::INVALID() != pb_type_id);
+
   /* Warn any override attempt */
-  std::map<t_pb_type*, t_mode*>::const_iterator it = physical_pb_modes_.find(pb_type);
-  if (it != physical_pb_modes_.end()) {
+  if (nullptr != physical_pb_modes_[pb_type_id]) {
     VTR_LOG_WARN("Override the annotation between pb_type '%s' and it physical mode '%s'!\n",
                  pb_type->name, physical_mode->name);
   }
 
-  physical_pb_modes_[pb_type] = physical_mode;
+  physical_pb_modes_[pb_type_id] = physical_mode;
 }
 
 void VprDeviceAnnotation::add_physical_pb_type(t_pb_type* operating_pb_type, t_pb_type* physical_pb_type) {
+  VprPbTypeId pb_type_id = pb_type_index(operating_pb_type);
+  VTR_ASSERT(VprPbTypeId::INVALID() != pb_type_id);
+
   /* Warn any override attempt */
-  std::map<t_pb_type*, t_pb_type*>::const_iterator it = physical_pb_types_.find(operating_pb_type);
-  if (it != physical_pb_types_.end()) {
+  if (nullptr != physical_pb_types_[pb_type_id]) {
     VTR_LOG_WARN("Override the annotation between operating pb_type '%s' and it physical pb_type '%s'!\n",
                  operating_pb_type->name, physical_pb_type->name);
   }
 
-  physical_pb_types_[operating_pb_type] = physical_pb_type;
+  physical_pb_types_[pb_type_id] = physical_pb_type;
 }
 
 void VprDeviceAnnotation::add_physical_pb_port(t_port* operating_pb_port, t_port* physical_pb_port) {
+  VprPbPortId pb_port_id = pb_port_index(operating_pb_port);
+  VTR_ASSERT(VprPbPortId::INVALID() != pb_port_id);
+
   /* Warn any override attempt */
-  std::map<t_port*, t_port*>::const_iterator it = physical_pb_ports_.find(operating_pb_port);
-  if (it != physical_pb_ports_.end()) {
+  if (nullptr != physical_pb_ports_[pb_port_id]) {
     VTR_LOG_WARN("Override the annotation between operating pb_port '%s' and it physical pb_port '%s'!\n",
                  operating_pb_port->name, physical_pb_port->name);
   }
 
-  physical_pb_ports_[operating_pb_port] = physical_pb_port;
+  physical_pb_ports_[pb_port_id] = physical_pb_port;
 }
 
 void VprDeviceAnnotation::add_physical_pb_port_range(t_port* operating_pb_port, const BasicPort& port_range) {
   /* The port range must satify the port width*/
   VTR_ASSERT((size_t)operating_pb_port->num_pins == port_range.get_width());
 
+  VprPbPortId pb_port_id = pb_port_index(operating_pb_port);
+  VTR_ASSERT(VprPbPortId::INVALID() != pb_port_id);
+
   /* Warn any override attempt */
-  std::map<t_port*, BasicPort>::const_iterator it = physical_pb_port_ranges_.find(operating_pb_port);
-  if (it != physical_pb_port_ranges_.end()) {
+  if (0 < physical_pb_port_ranges_[pb_port_id].get_width()) {
     VTR_LOG_WARN("Override the annotation between operating pb_port '%s' and it physical pb_port range '[%ld:%ld]'!\n",
                  operating_pb_port->name, port_range.get_lsb(), port_range.get_msb());
   }
 
-  physical_pb_port_ranges_[operating_pb_port] = port_range;
+  physical_pb_port_ranges_[pb_port_id] = port_range;
 }
 
 void VprDeviceAnnotation::add_pb_type_circuit_model(t_pb_type* physical_pb_type, const CircuitModelId& circuit_model) {
+  VprPbTypeId pb_type_id = pb_type_index(physical_pb_type);
+  VTR_ASSERT(VprPbTypeId::INVALID() != pb_type_id);
+
   /* Warn any override attempt */
-  std::map<t_pb_type*, CircuitModelId>::const_iterator it = pb_type_circuit_models_.find(physical_pb_type);
-  if (it != pb_type_circuit_models_.end()) {
+  if (CircuitModelId::INVALID() != pb_type_circuit_models_[pb_type_id]) {
     VTR_LOG_WARN("Override the circuit model for physical pb_type '%s'!\n",
                  physical_pb_type->name);
   }
 
-  pb_type_circuit_models_[physical_pb_type] = circuit_model;
+  pb_type_circuit_models_[pb_type_id] = circuit_model;
 }
 
 void VprDeviceAnnotation::add_interconnect_circuit_model(t_interconnect* pb_interconnect, const CircuitModelId& circuit_model) {
+  VprInterconnectId interc_id = interconnect_index(pb_interconnect);
+  VTR_ASSERT(VprInterconnectId::INVALID() != interc_id);
+
   /* Warn any override attempt */
-  std::map<t_interconnect*, CircuitModelId>::const_iterator it = interconnect_circuit_models_.find(pb_interconnect);
-  if (it != interconnect_circuit_models_.end()) {
+  if (CircuitModelId::INVALID() != interconnect_circuit_models_[interc_id]) {
     VTR_LOG_WARN("Override the circuit model for interconnect '%s'!\n",
                  pb_interconnect->name);
   }
 
-  interconnect_circuit_models_[pb_interconnect] = circuit_model;
+  interconnect_circuit_models_[interc_id] = circuit_model;
 }
 
 void VprDeviceAnnotation::add_interconnect_physical_type(t_interconnect* pb_interconnect,
                                                          const e_interconnect& physical_type) {
+  VprInterconnectId interc_id = interconnect_index(pb_interconnect);
+  VTR_ASSERT(VprInterconnectId::INVALID() != interc_id);
+
   /* Warn any override attempt */
-  std::map<t_interconnect*, e_interconnect>::const_iterator it = interconnect_physical_types_.find(pb_interconnect);
-  if (it != interconnect_physical_types_.end()) {
+  if (NUM_INTERC_TYPES != interconnect_physical_types_[interc_id]) {
     VTR_LOG_WARN("Override the physical interconnect for interconnect '%s'!\n",
                  pb_interconnect->name);
   }
 
-  interconnect_physical_types_[pb_interconnect] = physical_type;
+  interconnect_physical_types_[interc_id] = physical_type;
 }
 
 void VprDeviceAnnotation::add_pb_circuit_port(t_port* pb_port, const CircuitPortId& circuit_port) {
+  VprPbPortId pb_port_id = pb_port_index(pb_port);
+  VTR_ASSERT(VprPbPortId::INVALID() != pb_port_id);
+
   /* Warn any override attempt */
-  std::map<t_port*, CircuitPortId>::const_iterator it = pb_circuit_ports_.find(pb_port);
-  if (it != pb_circuit_ports_.end()) {
+  if (CircuitPortId::INVALID() != pb_circuit_ports_[pb_port_id]) {
     VTR_LOG_WARN("Override the circuit port mapping for pb_type port '%s'!\n",
                  pb_port->name);
   }
 
-  pb_circuit_ports_[pb_port] = circuit_port;
+  pb_circuit_ports_[pb_port_id] = circuit_port;
 }
 
 void VprDeviceAnnotation::add_pb_type_mode_bits(t_pb_type* pb_type, const std::vector<size_t>& mode_bits) {
+  VprPbTypeId pb_type_id = pb_type_index(pb_type);
+  VTR_ASSERT(VprPbTypeId::INVALID() != pb_type_id);
+
   /* Warn any override attempt */
-  std::map<t_pb_type*, std::vector<size_t>>::const_iterator it = pb_type_mode_bits_.find(pb_type);
-  if (it != pb_type_mode_bits_.end()) {
+  if (false == pb_type_mode_bits_[pb_type_id].empty()) {
     VTR_LOG_WARN("Override the mode bits mapping for pb_type '%s'!\n",
                  pb_type->name);
   }
 
-  pb_type_mode_bits_[pb_type] = mode_bits;
+  pb_type_mode_bits_[pb_type_id] = mode_bits;
 }
 
 void VprDeviceAnnotation::add_pb_graph_node_unique_index(t_pb_graph_node* pb_graph_node) {
-  pb_graph_node_unique_index_[pb_graph_node->pb_type].push_back(pb_graph_node);
+  VprPbTypeId pb_type_id = pb_type_index(pb_graph_node->pb_type);
+  VprPbGraphNodeId node_id = pb_graph_node_index(pb_graph_node);
+  VTR_ASSERT(VprPbTypeId::INVALID() != pb_type_id);
+  VTR_ASSERT(VprPbGraphNodeId::INVALID() != node_id);
+
+  /* The unique index of a pb_graph_node is the first position where it is added */
+  if (PbGraphNodeId::INVALID() == pb_graph_node_unique_ids_[node_id]) {
+    pb_graph_node_unique_ids_[node_id] = PbGraphNodeId(pb_graph_node_unique_index_[pb_type_id].size());
+  }
+  pb_graph_node_unique_index_[pb_type_id].push_back(pb_graph_node);
 }
 
 void VprDeviceAnnotation::add_physical_pb_graph_node(t_pb_graph_node* operating_pb_graph_node, 
                                                      t_pb_graph_node* physical_pb_graph_node) {
+  VprPbGraphNodeId node_id = pb_graph_node_index(operating_pb_graph_node);
+  VTR_ASSERT(VprPbGraphNodeId::INVALID() != node_id);
+
   /* Warn any override attempt */
-  std::map<t_pb_graph_node*, t_pb_graph_node*>::const_iterator it = physical_pb_graph_nodes_.find(operating_pb_graph_node);
-  if (it != physical_pb_graph_nodes_.end()) {
+  if (nullptr != physical_pb_graph_nodes_[node_id]) {
     VTR_LOG_WARN("Override the annotation between operating pb_graph_node '%s[%d]' and it physical pb_graph_node '%s[%d]'!\n",
                  operating_pb_graph_node->pb_type->name, 
                  operating_pb_graph_node->placement_index,
@@ -371,54 +436,62 @@ void VprDeviceAnnotation::add_physical_pb_graph_node(t_pb_graph_node* operating_
                  physical_pb_graph_node->placement_index);
   }
 
-  physical_pb_graph_nodes_[operating_pb_graph_node] = physical_pb_graph_node;
+  physical_pb_graph_nodes_[node_id] = physical_pb_graph_node;
 }
 
 void VprDeviceAnnotation::add_physical_pb_type_index_factor(t_pb_type* pb_type, const float& factor) {
+  VprPbTypeId pb_type_id = pb_type_index(pb_type);
+  VTR_ASSERT(VprPbTypeId::INVALID() != pb_type_id);
+
   /* Warn any override attempt */
-  std::map<t_pb_type*, float>::const_iterator it = physical_pb_type_index_factors_.find(pb_type);
-  if (it != physical_pb_type_index_factors_.end()) {
+  if (1. != physical_pb_type_index_factors_[pb_type_id]) {
     VTR_LOG_WARN("Override the annotation between operating pb_type '%s' and it physical pb_type index factor '%f'!\n",
                  pb_type->name, factor);
   }
 
-  physical_pb_type_index_factors_[pb_type] = factor;
+  physical_pb_type_index_factors_[pb_type_id] = factor;
 }
 
 void VprDeviceAnnotation::add_physical_pb_type_index_offset(t_pb_type* pb_type, const int& offset) {
+  VprPbTypeId pb_type_id = pb_type_index(pb_type);
+  VTR_ASSERT(VprPbTypeId::INVALID() != pb_type_id);
+
   /* Warn any override attempt */
-  std::map<t_pb_type*, int>::const_iterator it = physical_pb_type_index_offsets_.find(pb_type);
-  if (it != physical_pb_type_index_offsets_.end()) {
+  if (0 != physical_pb_type_index_offsets_[pb_type_id]) {
     VTR_LOG_WARN("Override the annotation between operating pb_type '%s' and it physical pb_type index offset '%d'!\n",
                  pb_type->name, offset);
   }
 
-  physical_pb_type_index_offsets_[pb_type] = offset;
+  physical_pb_type_index_offsets_[pb_type_id] = offset;
 }
 
 void VprDeviceAnnotation::add_physical_pb_pin_rotate_offset(t_port* pb_port, const int& offset) {
+  VprPbPortId pb_port_id = pb_port_index(pb_port);
+  VTR_ASSERT(VprPbPortId::INVALID() != pb_port_id);
+
   /* Warn any override attempt */
-  std::map<t_port*, int>::const_iterator it = physical_pb_pin_rotate_offsets_.find(pb_port);
-  if (it != physical_pb_pin_rotate_offsets_.end()) {
+  if (0 != physical_pb_pin_rotate_offsets_[pb_port_id]) {
     VTR_LOG_WARN("Override the annotation between operating pb_port '%s' and it physical pb_port pin rotate offset '%d'!\n",
                  pb_port->name, offset);
   }
 
-  physical_pb_pin_rotate_offsets_[pb_port] = offset;
+  physical_pb_pin_rotate_offsets_[pb_port_id] = offset;
   /* We initialize the accumulated offset to 0 */
-  physical_pb_pin_offsets_[pb_port] = 0;
+  physical_pb_pin_offsets_[pb_port_id] = 0;
 }
 
 void VprDeviceAnnotation::add_physical_pb_graph_pin(const t_pb_graph_pin* operating_pb_graph_pin, 
                                                     t_pb_graph_pin* physical_pb_graph_pin) {
+  VprPbGraphPinId pin_id = pb_graph_pin_index(operating_pb_graph_pin);
+  VTR_ASSERT(VprPbGraphPinId::INVALID() != pin_id);
+
   /* Warn any override attempt */
-  std::map<const t_pb_graph_pin*, t_pb_graph_pin*>::const_iterator it = physical_pb_graph_pins_.find(operating_pb_graph_pin);
-  if (it != physical_pb_graph_pins_.end()) {
+  if (nullptr != physical_pb_graph_pins_[pin_id]) {
     VTR_LOG_WARN("Override the annotation between operating pb_graph_pin '%s' and it physical pb_graph_pin '%s'!\n",
                  operating_pb_graph_pin->port->name, physical_pb_graph_pin->port->name);
   }
 
-  physical_pb_graph_pins_[operating_pb_graph_pin] = physical_pb_graph_pin;
+  physical_pb_graph_pins_[pin_id] = physical_pb_graph_pin;
 
   /* Update the accumulated offsets for the operating port 
    * Each time we pair two pins, we update the offset by the pin rotate offset
@@ -432,24 +505,30 @@ void VprDeviceAnnotation::add_physical_pb_graph_pin(const t_pb_graph_pin* operat
    *    Physical port      |         +                        +               +
    *
    */
-  if (0 == physical_pb_pin_rotate_offset(operating_pb_graph_pin->port)) {
+  VprPbPortId pb_port_id = pb_port_index(operating_pb_graph_pin->port);
+  if ( (VprPbPortId::INVALID() == pb_port_id)
+    || (0 == physical_pb_pin_rotate_offsets_[pb_port_id]) ) {
     return;
   }
 
-  physical_pb_pin_offsets_[operating_pb_graph_pin->port] += physical_pb_pin_rotate_offset(operating_pb_graph_pin->port);
+  physical_pb_pin_offsets_[pb_port_id] += physical_pb_pin_rotate_offsets_[pb_port_id];
 
-  if ((size_t)physical_pb_port(operating_pb_graph_pin->port)->num_pins - 1 
+  if ((size_t)physical_pb_ports_[pb_port_id]->num_pins - 1 
     < operating_pb_graph_pin->pin_number
-    + physical_pb_port_range(operating_pb_graph_pin->port).get_lsb() 
-    + physical_pb_pin_offsets_[operating_pb_graph_pin->port]) {
-    physical_pb_pin_offsets_[operating_pb_graph_pin->port] = 0;
+    + physical_pb_port_ranges_[pb_port_id].get_lsb() 
+    + physical_pb_pin_offsets_[pb_port_id]) {
+    physical_pb_pin_offsets_[pb_port_id] = 0;
   }
 }
 
 void VprDeviceAnnotation::add_rr_switch_circuit_model(const RRSwitchId& rr_switch, const CircuitModelId& circuit_model) {
+  VTR_ASSERT(RRSwitchId::INVALID() != rr_switch);
+  if (size_t(rr_switch) >= rr_switch_circuit_models_.size()) {
+    rr_switch_circuit_models_.resize(size_t(rr_switch) + 1, CircuitModelId::INVALID());
+  }
+
   /* Warn any override attempt */
-  std::map<RRSwitchId, CircuitModelId>::const_iterator it = rr_switch_circuit_models_.find(rr_switch);
-  if (it != rr_switch_circuit_models_.end()) {
+  if (CircuitModelId::INVALID() != rr_switch_circuit_models_[rr_switch]) {
     VTR_LOG_WARN("Override the annotation between rr_switch '%ld' and its circuit_model '%ld'!\n",
                  size_t(rr_switch), size_t(circuit_model));
   }
@@ -458,9 +537,13 @@ void VprDeviceAnnotation::add_rr_switch_circuit_model(const RRSwitchId& rr_switc
 }
 
 void VprDeviceAnnotation::add_rr_segment_circuit_model(const RRSegmentId& rr_segment, const CircuitModelId& circuit_model) {
+  VTR_ASSERT(RRSegmentId::INVALID() != rr_segment);
+  if (size_t(rr_segment) >= rr_segment_circuit_models_.size()) {
+    rr_segment_circuit_models_.resize(size_t(rr_segment) + 1, CircuitModelId::INVALID());
+  }
+
   /* Warn any override attempt */
-  std::map<RRSegmentId, CircuitModelId>::const_iterator it = rr_segment_circuit_models_.find(rr_segment);
-  if (it != rr_segment_circuit_models_.end()) {
+  if (CircuitModelId::INVALID() != rr_segment_circuit_models_[rr_segment]) {
     VTR_LOG_WARN("Override the annotation between rr_segment '%ld' and its circuit_model '%ld'!\n",
                  size_t(rr_segment), size_t(circuit_model));
   }
@@ -469,8 +552,12 @@ void VprDeviceAnnotation::add_rr_segment_circuit_model(const RRSegmentId& rr_seg
 }
 
 void VprDeviceAnnotation::add_direct_annotation(const size_t& direct, const ArchDirectId& arch_direct_id) {
+  if (direct >= direct_annotations_.size()) {
+    direct_annotations_.resize(direct + 1, ArchDirectId::INVALID());
+  }
+
   /* Warn any override attempt */
-  if (0 < direct_annotations_.count(direct)) {
+  if (ArchDirectId::INVALID() != direct_annotations_[direct]) {
     VTR_LOG_WARN("Override the annotation between direct '%ld' and its annotation '%ld'!\n",
                  size_t(direct), size_t(arch_direct_id));
   }
@@ -488,4 +575,113 @@ void VprDeviceAnnotation::add_physical_lb_rr_graph(t_pb_graph_node* pb_graph_hea
   physical_lb_rr_graphs_[pb_graph_head] = lb_rr_graph;
 }
 
+/************************************************************************
+ * Internal index builders
+ ***********************************************************************/
+/* Give an index to a pb_type, its ports and the interconnects of its modes,
+ * and then visit its child pb_types
+ */
+void VprDeviceAnnotation::rec_build_pb_type_indices(t_pb_type* pb_type) {
+  VprPbTypeId pb_type_id = VprPbTypeId(pb_type_indices_.size());
+  pb_type_indices_[pb_type] = pb_type_id;
+
+  for (int iport = 0; iport < pb_type->num_ports; ++iport) {
+    VprPbPortId pb_port_id = VprPbPortId(pb_port_indices_.size());
+    pb_port_indices_[&(pb_type->ports[iport])] = pb_port_id;
+  }
+
+  for (int imode = 0; imode < pb_type->num_modes; ++imode) {
+    t_mode* mode = &(pb_type->modes[imode]);
+    for (int interc = 0; interc < mode->num_interconnect; ++interc) {
+      VprInterconnectId interc_id = VprInterconnectId(interconnect_indices_.size());
+      interconnect_indices_[&(mode->interconnect[interc])] = interc_id;
+    }
+    for (int ichild = 0; ichild < mode->num_pb_type_children; ++ichild) {
+      rec_build_pb_type_indices(&(mode->pb_type_children[ichild]));
+    }
+  }
+}
+
+/* Give an index to a pb_graph_node and its pins,
+ * and then visit its child pb_graph_nodes
+ */
+void VprDeviceAnnotation::rec_build_pb_graph_indices(t_pb_graph_node* pb_graph_node) {
+  VprPbGraphNodeId node_id = VprPbGraphNodeId(pb_graph_node_indices_.size());
+  pb_graph_node_indices_[pb_graph_node] = node_id;
+
+  for (int iport = 0; iport < pb_graph_node->num_input_ports; ++iport) {
+    for (int ipin = 0; ipin < pb_graph_node->num_input_pins[iport]; ++ipin) {
+      VprPbGraphPinId pin_id = VprPbGraphPinId(pb_graph_pin_indices_.size());
+      pb_graph_pin_indices_[&(pb_graph_node->input_pins[iport][ipin])] = pin_id;
+    }
+  }
+
+  for (int iport = 0; iport < pb_graph_node->num_output_ports; ++iport) {
+    for (int ipin = 0; ipin < pb_graph_node->num_output_pins[iport]; ++ipin) {
+      VprPbGraphPinId pin_id = VprPbGraphPinId(pb_graph_pin_indices_.size());
+      pb_graph_pin_indices_[&(pb_graph_node->output_pins[iport][ipin])] = pin_id;
+    }
+  }
+
+  for (int iport = 0; iport < pb_graph_node->num_clock_ports; ++iport) {
+    for (int ipin = 0; ipin < pb_graph_node->num_clock_pins[iport]; ++ipin) {
+      VprPbGraphPinId pin_id = VprPbGraphPinId(pb_graph_pin_indices_.size());
+      pb_graph_pin_indices_[&(pb_graph_node->clock_pins[iport][ipin])] = pin_id;
+    }
+  }
+
+  for (int imode = 0; imode < pb_graph_node->pb_type->num_modes; ++imode) {
+    for (int ipb = 0; ipb < pb_graph_node->pb_type->modes[imode].num_pb_type_children; ++ipb) {
+      /* Each child may exist multiple times in the hierarchy*/
+      for (int jpb = 0; jpb < pb_graph_node->pb_type->modes[imode].pb_type_children[ipb].num_pb; ++jpb) {
+        rec_build_pb_graph_indices(&(pb_graph_node->child_pb_graph_nodes[imode][ipb][jpb]));
+      }
+    }
+  }
+}
+
+/************************************************************************
+ * Internal index lookups
+ * An invalid index is returned for any object out of the VPR device 
+ ***********************************************************************/
+VprPbTypeId VprDeviceAnnotation::pb_type_index(const t_pb_type* pb_type) const {
+  std::unordered_map<const t_pb_type*, VprPbTypeId>::const_iterator it = pb_type_indices_.find(pb_type);
+  if (it == pb_type_indices_.end()) {
+    return VprPbTypeId::INVALID();
+  }
+  return it->second;
+}
+
+VprPbPortId VprDeviceAnnotation::pb_port_index(const t_port* pb_port) const {
+  std::unordered_map<const t_port*, VprPbPortId>::const_iterator it = pb_port_indices_.find(pb_port);
+  if (it == pb_port_indices_.end()) {
+    return VprPbPortId::INVALID();
+  }
+  return it->second;
+}
+
+VprInterconnectId VprDeviceAnnotation::interconnect_index(const t_interconnect* pb_interconnect) const {
+  std::unordered_map<const t_interconnect*, VprInterconnectId>::const_iterator it = interconnect_indices_.find(pb_interconnect);
+  if (it == interconnect_indices_.end()) {
+    return VprInterconnectId::INVALID();
+  }
+  return it->second;
+}
+
+VprPbGraphNodeId VprDeviceAnnotation::pb_graph_node_index(const t_pb_graph_node* pb_graph_node) const {
+  std::unordered_map<const t_pb_graph_node*, VprPbGraphNodeId>::const_iterator it = pb_graph_node_indices_.find(pb_graph_node);
+  if (it == pb_graph_node_indices_.end()) {
+    return VprPbGraphNodeId::INVALID();
+  }
+  return it->second;
+}
+
+VprPbGraphPinId VprDeviceAnnotation::pb_graph_pin_index(const t_pb_graph_pin* pb_graph_pin) const {
+  std::unordered_map<const t_pb_graph_pin*, VprPbGraphPinId>::const_iterator it = pb_graph_pin_indices_.find(pb_graph_pin);
+  if (it == pb_graph_pin_indices_.end()) {
+    return VprPbGraphPinId::INVALID();
+  }
+  return it->second;
+}
+
 } /* End namespace openfpga*/
@@ -5,8 +5,11 @@
  * Include header files required by the data structure definition
  *******************************************************************/
 #include <map> 
+#include <vector> 
+#include <unordered_map> 
 
 /* Header from vtrutil library */
+#include "vtr_vector.h"
 #include "vtr_strong_id.h"
 
 /* Header from archfpga library */
@@ -29,6 +32,19 @@ struct pb_graph_node_id_tag;
 
 typedef vtr::StrongId<pb_graph_node_id_tag> PbGraphNodeId;
 
+/* Dense indices of the objects in the pb_type hierarchy and the pb_graph of a VPR device */
+struct vpr_pb_type_id_tag;
+struct vpr_pb_port_id_tag;
+struct vpr_interconnect_id_tag;
+struct vpr_pb_graph_node_id_tag;
+struct vpr_pb_graph_pin_id_tag;
+
+typedef vtr::StrongId<vpr_pb_type_id_tag> VprPbTypeId;
+typedef vtr::StrongId<vpr_pb_port_id_tag> VprPbPortId;
+typedef vtr::StrongId<vpr_interconnect_id_tag> VprInterconnectId;
+typedef vtr::StrongId<vpr_pb_graph_node_id_tag> VprPbGraphNodeId;
+typedef vtr::StrongId<vpr_pb_graph_pin_id_tag> VprPbGraphPinId;
+
 /********************************************************************
  * This is the critical data structure to link the pb_type in VPR
  * to openfpga annotations
@@ -37,6 +53,15 @@ typedef vtr::StrongId<pb_graph_node_id_tag> PbGraphNodeId;
  * 2. what is the circuit model id linked to a physical pb_type
  * 3. what is the physical pb_type for an operating pb_type
  * 4. what is the mode pointer that represents the physical mode for a pb_type
+ *
+ * Each pb_type, port, interconnect, pb_graph_node and pb_graph_pin
+ * of the VPR device is given a dense index by build_indices()
+ * All the annotations are stored in flat vectors addressed by these indices,
+ * so that a query costs a single hash lookup, no matter how many
+ * annotations are requested for the same object
+ * Note:
+ * - build_indices() MUST be called before adding any annotation
+ *   on the pb_type hierarchy and the pb_graph
  *******************************************************************/
 class VprDeviceAnnotation {
   public:  /* Constructor */
@@ -51,7 +76,7 @@ class VprDeviceAnnotation {
     CircuitModelId interconnect_circuit_model(t_interconnect* pb_interconnect) const;
     e_interconnect interconnect_physical_type(t_interconnect* pb_interconnect) const;
     CircuitPortId pb_circuit_port(t_port* pb_port) const;
-    std::vector<size_t> pb_type_mode_bits(t_pb_type* pb_type) const;
+    const std::vector<size_t>& pb_type_mode_bits(t_pb_type* pb_type) const;
     /* Get the unique index of a pb_graph_node */
     PbGraphNodeId pb_graph_node_unique_index(t_pb_graph_node* pb_graph_node) const;
     /* Get the pointer to a pb_graph node using an unique index */
@@ -74,8 +99,12 @@ class VprDeviceAnnotation {
     CircuitModelId rr_switch_circuit_model(const RRSwitchId& rr_switch) const;
     CircuitModelId rr_segment_circuit_model(const RRSegmentId& rr_segment) const;
     ArchDirectId direct_annotation(const size_t& direct) const;
-    LbRRGraph physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const;
+    const LbRRGraph& physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const;
   public:  /* Public mutators */
+    /* Assign dense indices to the pb_type hierarchy and the pb_graph of all the logical blocks
+     * Any existing annotation will be cleared
+     */
+    void build_indices(const std::vector<t_logical_block_type>& logical_block_types);
     void add_pb_type_physical_mode(t_pb_type* pb_type, t_mode* physical_mode);
     void add_physical_pb_type(t_pb_type* operating_pb_type, t_pb_type* physical_pb_type);
     void add_physical_pb_port(t_port* operating_pb_port, t_port* physical_pb_port);
@@ -96,36 +125,51 @@ class VprDeviceAnnotation {
     void add_rr_segment_circuit_model(const RRSegmentId& rr_segment, const CircuitModelId& circuit_model);
     void add_direct_annotation(const size_t& direct, const ArchDirectId& arch_direct_id);
     void add_physical_lb_rr_graph(t_pb_graph_node* pb_graph_head, const LbRRGraph& lb_rr_graph);
+  private: /* Internal index builders and lookups */
+    void rec_build_pb_type_indices(t_pb_type* pb_type);
+    void rec_build_pb_graph_indices(t_pb_graph_node* pb_graph_node);
+    VprPbTypeId pb_type_index(const t_pb_type* pb_type) const;
+    VprPbPortId pb_port_index(const t_port* pb_port) const;
+    VprInterconnectId interconnect_index(const t_interconnect* pb_interconnect) const;
+    VprPbGraphNodeId pb_graph_node_index(const t_pb_graph_node* pb_graph_node) const;
+    VprPbGraphPinId pb_graph_pin_index(const t_pb_graph_pin* pb_graph_pin) const;
   private: /* Internal data */
+    /* Dense indices of the pb_type hierarchy and the pb_graph */
+    std::unordered_map<const t_pb_type*, VprPbTypeId> pb_type_indices_;
+    std::unordered_map<const t_port*, VprPbPortId> pb_port_indices_;
+    std::unordered_map<const t_interconnect*, VprInterconnectId> interconnect_indices_;
+    std::unordered_map<const t_pb_graph_node*, VprPbGraphNodeId> pb_graph_node_indices_;
+    std::unordered_map<const t_pb_graph_pin*, VprPbGraphPinId> pb_graph_pin_indices_;
+
     /* Pair a regular pb_type to its physical pb_type */
-    std::map<t_pb_type*, t_pb_type*> physical_pb_types_;
-    std::map<t_pb_type*, float> physical_pb_type_index_factors_;
-    std::map<t_pb_type*, int> physical_pb_type_index_offsets_;
+    vtr::vector<VprPbTypeId, t_pb_type*> physical_pb_types_;
+    vtr::vector<VprPbTypeId, float> physical_pb_type_index_factors_;
+    vtr::vector<VprPbTypeId, int> physical_pb_type_index_offsets_;
 
     /* Pair a physical mode for a pb_type
      * Note:
      * - the physical mode MUST be a child mode of the pb_type
      * - the pb_type MUST be a physical pb_type itself
      */
-    std::map<t_pb_type*, t_mode*> physical_pb_modes_;
+    vtr::vector<VprPbTypeId, t_mode*> physical_pb_modes_;
 
     /* Pair a physical pb_type to its circuit model
      * Note:
      * - the pb_type MUST be a physical pb_type itself
      */
-    std::map<t_pb_type*, CircuitModelId> pb_type_circuit_models_;
+    vtr::vector<VprPbTypeId, CircuitModelId> pb_type_circuit_models_;
 
     /* Pair a interconnect of a physical pb_type to its circuit model
      * Note:
      * - the pb_type MUST be a physical pb_type itself
      */
-    std::map<t_interconnect*, CircuitModelId> interconnect_circuit_models_;
+    vtr::vector<VprInterconnectId, CircuitModelId> interconnect_circuit_models_;
 
     /* Physical type of interconnect 
      * Note:
      * - only applicable to an interconnect belongs to physical mode
      */
-    std::map<t_interconnect*, e_interconnect> interconnect_physical_types_;
+    vtr::vector<VprInterconnectId, e_interconnect> interconnect_physical_types_;
 
     /* Pair a pb_type to its mode selection bits
      * - if the pb_type is a physical pb_type, the mode bits are the default mode 
@@ -133,52 +177,53 @@ class VprDeviceAnnotation {
      * - if the pb_type is an operating pb_type, the mode bits will be applied
      *   when the operating pb_type is used by packer
      */
-    std::map<t_pb_type*, std::vector<size_t>> pb_type_mode_bits_;
+    vtr::vector<VprPbTypeId, std::vector<size_t>> pb_type_mode_bits_;
 
     /* Pair a pb_port to its physical pb_port 
      * Note:
      * - the parent of physical pb_port MUST be a physical pb_type
      */
-    std::map<t_port*, t_port*> physical_pb_ports_;
-    std::map<t_port*, int> physical_pb_pin_rotate_offsets_;
+    vtr::vector<VprPbPortId, t_port*> physical_pb_ports_;
+    vtr::vector<VprPbPortId, int> physical_pb_pin_rotate_offsets_;
 
     /* Accumulated offsets for a physical pb_type port, just for internal usage */
-    std::map<t_port*, int> physical_pb_pin_offsets_;
+    vtr::vector<VprPbPortId, int> physical_pb_pin_offsets_;
 
     /* Pair a pb_port to its LSB and MSB of a physical pb_port 
      * Note:
      * - the LSB and MSB MUST be in range of the physical pb_port
      */
-    std::map<t_port*, BasicPort> physical_pb_port_ranges_;
+    vtr::vector<VprPbPortId, BasicPort> physical_pb_port_ranges_;
 
     /* Pair a pb_port to a circuit port in circuit model
      * Note:
      * - the parent of physical pb_port MUST be a physical pb_type
      */
-    std::map<t_port*, CircuitPortId> pb_circuit_ports_;
+    vtr::vector<VprPbPortId, CircuitPortId> pb_circuit_ports_;
 
     /* Pair each pb_graph_node to an unique index in the graph
      * The unique index if the index in the array of t_pb_graph_node*
      */ 
-    std::map<t_pb_type*, std::vector<t_pb_graph_node*>> pb_graph_node_unique_index_;
+    vtr::vector<VprPbTypeId, std::vector<t_pb_graph_node*>> pb_graph_node_unique_index_;
+    vtr::vector<VprPbGraphNodeId, PbGraphNodeId> pb_graph_node_unique_ids_;
 
     /* Pair a pb_graph_node to a physical pb_graph_node
      * Note:
      * - the pb_type of physical pb_graph_node must be a physical pb_type
      */
-    std::map<t_pb_graph_node*, t_pb_graph_node*> physical_pb_graph_nodes_;
+    vtr::vector<VprPbGraphNodeId, t_pb_graph_node*> physical_pb_graph_nodes_;
 
     /* Pair a pb_graph_pin to a physical pb_graph_pin */
-    std::map<const t_pb_graph_pin*, t_pb_graph_pin*> physical_pb_graph_pins_;
+    vtr::vector<VprPbGraphPinId, t_pb_graph_pin*> physical_pb_graph_pins_;
 
     /* Pair a Routing Resource Switch (rr_switch) to a circuit model */
-    std::map<RRSwitchId, CircuitModelId> rr_switch_circuit_models_;
+    vtr::vector<RRSwitchId, CircuitModelId> rr_switch_circuit_models_;
 
     /* Pair a Routing Segment (rr_segment) to a circuit model */
-    std::map<RRSegmentId, CircuitModelId> rr_segment_circuit_models_;
+    vtr::vector<RRSegmentId, CircuitModelId> rr_segment_circuit_models_;
 
     /* Pair a direct connection (direct) to a annotation which contains circuit model id */
-    std::map<size_t, ArchDirectId> direct_annotations_;
+    std::vector<ArchDirectId> direct_annotations_;
 
     /* Logical type routing resource graphs built from physical modes */
     std::map<t_pb_graph_node*, LbRRGraph> physical_lb_rr_graphs_;
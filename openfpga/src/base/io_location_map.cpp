@@ -27,6 +27,23 @@ size_t IoLocationMap::io_index(const size_t& x, const size_t& y, const size_t& z
   return io_indices_[x][y][z];
 }
 
+size_t IoLocationMap::x_size() const {
+  return io_indices_.size();
+}
+
+size_t IoLocationMap::y_size(const size_t& x) const {
+  VTR_ASSERT(x < io_indices_.size());
+  return io_indices_[x].size();
+}
+
+size_t IoLocationMap::z_size(const size_t& x, const size_t& y) const {
+  VTR_ASSERT(y < y_size(x));
+  return io_indices_[x][y].size();
+}
+
+/**************************************************
+ * Public Mutators
+ *************************************************/
 void IoLocationMap::set_io_index(const size_t& x, const size_t& y, const size_t& z, const size_t& io_index) {
   if (x >= io_indices_.size()) {
     io_indices_.resize(x + 1);
@@ -27,6 +27,10 @@ namespace openfpga {
 class IoLocationMap {
   public: /* Public aggregators */
     size_t io_index(const size_t& x, const size_t& y, const size_t& z) const;
+    /* Size of the fast lookup in each dimension, which is used to walk through all the I/O locations */
+    size_t x_size() const;
+    size_t y_size(const size_t& x) const;
+    size_t z_size(const size_t& x, const size_t& y) const;
   public: /* Public mutators */
     void set_io_index(const size_t& x, const size_t& y, const size_t& z, const size_t& io_index);
   private: /* Internal Data */
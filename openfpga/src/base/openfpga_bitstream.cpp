@@ -1,6 +1,8 @@
 /********************************************************************
  * This file includes functions to build bitstream database
  *******************************************************************/
+#include <fstream>
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_log.h"
@@ -15,9 +17,12 @@
 #include "read_xml_arch_bitstream.h"
 #include "write_xml_arch_bitstream.h"
 
+#include "openfpga_parallel_utils.h"
+#include "incremental_bitstream.h"
 #include "build_device_bitstream.h"
 #include "write_text_fabric_bitstream.h"
 #include "write_xml_fabric_bitstream.h"
+#include "write_binary_fabric_bitstream.h"
 #include "build_fabric_bitstream.h"
 #include "openfpga_bitstream.h"
 
@@ -36,12 +41,62 @@ int fpga_bitstream(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_verbose = cmd.option("verbose");
   CommandOptionId opt_write_file = cmd.option("write_file");
   CommandOptionId opt_read_file = cmd.option("read_file");
+  CommandOptionId opt_threads = cmd.option("threads");
+  CommandOptionId opt_incremental = cmd.option("incremental");
+  CommandOptionId opt_previous_file = cmd.option("previous_file");
+
+  /* Build bitstream in a single thread unless specified */
+  size_t num_threads = 1;
+  if (true == cmd_context.option_enable(cmd, opt_threads)) {
+    num_threads = find_num_parallel_threads(std::atoi(cmd_context.option_value(cmd, opt_threads).c_str()));
+  }
+
+  if ( (true == cmd_context.option_enable(cmd, opt_previous_file))
+    && (false == cmd_context.option_enable(cmd, opt_incremental)) ) {
+    VTR_LOG_ERROR("Option '--previous_file' requires option '--incremental'!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Incremental build requires a bitstream file, next to which the fingerprints are stored */
+  IncrementalBitstream incremental_bitstream;
+  std::string fingerprint_fname;
+  if (true == cmd_context.option_enable(cmd, opt_incremental)) {
+    if ( (false == cmd_context.option_enable(cmd, opt_write_file))
+      || (true == cmd_context.option_enable(cmd, opt_read_file)) ) {
+      VTR_LOG_ERROR("Option '--incremental' requires option '--write_file' and cannot be used with option '--read_file'!\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    incremental_bitstream.enable();
+    fingerprint_fname = cmd_context.option_value(cmd, opt_write_file) + std::string(".fingerprint");
+
+    /* Load the bitstream of the previous run if both the bitstream and the fingerprints exist
+     * The previous run is the file of '--write_file' unless '--previous_file' is specified
+     */
+    std::string prev_bitstream_fname = cmd_context.option_value(cmd, opt_write_file);
+    if (true == cmd_context.option_enable(cmd, opt_previous_file)) {
+      prev_bitstream_fname = cmd_context.option_value(cmd, opt_previous_file);
+    }
+    std::map<std::string, std::string> prev_fingerprints = read_bitstream_fingerprints(prev_bitstream_fname + std::string(".fingerprint"));
+    std::fstream bitstream_fp(prev_bitstream_fname, std::fstream::in);
+    bool bitstream_exist = bitstream_fp.is_open();
+    bitstream_fp.close();
+    if ( (true == prev_fingerprints.empty())
+      || (false == bitstream_exist) ) {
+      VTR_LOG("No previous bitstream or fingerprints found for '%s', build the bitstream of all the tiles\n",
+              prev_bitstream_fname.c_str());
+    } else {
+      incremental_bitstream.set_previous_bitstream(read_xml_architecture_bitstream(prev_bitstream_fname.c_str()),
+                                                   std::move(prev_fingerprints));
+    }
+  }
 
   if (true == cmd_context.option_enable(cmd, opt_read_file)) {
     openfpga_ctx.mutable_bitstream_manager() = read_xml_architecture_bitstream(cmd_context.option_value(cmd, opt_read_file).c_str());
   } else {
     openfpga_ctx.mutable_bitstream_manager() = build_device_bitstream(g_vpr_ctx,
                                                                       openfpga_ctx,
+                                                                      incremental_bitstream,
+                                                                      num_threads,
                                                                       cmd_context.option_enable(cmd, opt_verbose));
   }
 
@@ -55,6 +110,13 @@ int fpga_bitstream(OpenfpgaContext& openfpga_ctx,
                                      cmd_context.option_value(cmd, opt_write_file));
   }
 
+  /* Write the fingerprints after the bitstream, so that they are consistent */
+  if (true == incremental_bitstream.enabled()) {
+    if (0 != write_bitstream_fingerprints(incremental_bitstream.fingerprints(), fingerprint_fname)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
   /* TODO: should identify the error code from internal function execution */
   return CMD_EXEC_SUCCESS;
 }
@@ -109,6 +171,12 @@ int write_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
                                                 openfpga_ctx.arch().config_protocol,
                                                 cmd_context.option_value(cmd, opt_file),
                                                 cmd_context.option_enable(cmd, opt_verbose));
+  } else if (std::string("binary") == file_format) {
+    status = write_fabric_bitstream_to_binary_file(openfpga_ctx.bitstream_manager(),
+                                                   openfpga_ctx.fabric_bitstream(),
+                                                   openfpga_ctx.arch().config_protocol,
+                                                   cmd_context.option_value(cmd, opt_file),
+                                                   cmd_context.option_enable(cmd, opt_verbose));
   } else {
     /* By default, output in plain text format */
     status = write_fabric_bitstream_to_text_file(openfpga_ctx.bitstream_manager(),
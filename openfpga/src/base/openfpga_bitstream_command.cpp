@@ -21,6 +21,11 @@ ShellCommandId add_openfpga_repack_command(openfpga::Shell<OpenfpgaContext>& she
                                            const ShellCommandClassId& cmd_class_id,
                                            const std::vector<ShellCommandId>& dependent_cmds) {
   Command shell_cmd("repack");
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of threads to repack clustered blocks. Use 0 to run with all the available hardware threads. By default, run with 1 thread");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -54,6 +59,16 @@ ShellCommandId add_openfpga_build_arch_bitstream_command(openfpga::Shell<Openfpg
   CommandOptionId opt_read_file = shell_cmd.add_option("read_file", false, "file path to read the bitstream database");
   shell_cmd.set_option_require_value(opt_read_file, openfpga::OPT_STRING);
 
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of threads to build the bitstream of grids and routing blocks. Use 0 to run with all the available hardware threads. By default, run with 1 thread");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
+  /* Add an option '--incremental' */
+  shell_cmd.add_option("incremental", false, "Reuse the bitstream in the file of '--write_file' for grids and routing blocks whose inputs are unchanged, based on the fingerprints stored next to the file");
+
+  /* Add an option '--previous_file' */
+  CommandOptionId opt_previous_file = shell_cmd.add_option("previous_file", false, "file path to read the bitstream of the previous run for '--incremental', instead of the file of '--write_file'");
+  shell_cmd.set_option_require_value(opt_previous_file, openfpga::OPT_STRING);
 
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
@@ -111,7 +126,7 @@ ShellCommandId add_openfpga_write_fabric_bitstream_command(openfpga::Shell<Openf
   shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
 
   /* Add an option '--file_format'*/
-  CommandOptionId opt_file_format = shell_cmd.add_option("format", false, "file format of fabric bitstream [plain_text|xml]. Default: plain_text");
+  CommandOptionId opt_file_format = shell_cmd.add_option("format", false, "file format of fabric bitstream [plain_text|xml|binary]. Default: plain_text");
   shell_cmd.set_option_require_value(opt_file_format, openfpga::OPT_STRING);
 
   /* Add an option '--verbose' */
@@ -10,12 +10,16 @@
 
 /* Headers from fabrickey library */
 #include "read_xml_fabric_key.h"
+#include "read_binary_fabric_key.h"
 
 #include "device_rr_gsb.h"
 #include "device_rr_gsb_utils.h"
 #include "build_device_module.h"
 #include "fabric_hierarchy_writer.h"
 #include "fabric_key_writer.h"
+#include "fabric_snapshot_reader.h"
+#include "fabric_snapshot_writer.h"
+#include "openfpga_parallel_utils.h"
 #include "openfpga_build_fabric.h"
 
 /* Include global variables of VPR */
@@ -30,11 +34,12 @@ namespace openfpga {
  *******************************************************************/
 static 
 void compress_routing_hierarchy(OpenfpgaContext& openfpga_ctx,
+                                const size_t& num_threads,
                                 const bool& verbose_output) {
   vtr::ScopedStartFinishTimer timer("Identify unique General Switch Blocks (GSBs)");
 
   /* Build unique module lists */
-  openfpga_ctx.mutable_device_rr_gsb().build_unique_module(g_vpr_ctx.device().rr_graph);
+  openfpga_ctx.mutable_device_rr_gsb().build_unique_module(g_vpr_ctx.device().rr_graph, num_threads);
 
   /* Report the stats */
   VTR_LOGV(verbose_output, 
@@ -69,14 +74,34 @@ int build_fabric(OpenfpgaContext& openfpga_ctx,
 
   CommandOptionId opt_frame_view = cmd.option("frame_view");
   CommandOptionId opt_compress_routing = cmd.option("compress_routing");
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_duplicate_grid_pin = cmd.option("duplicate_grid_pin");
   CommandOptionId opt_gen_random_fabric_key = cmd.option("generate_random_fabric_key");
   CommandOptionId opt_write_fabric_key = cmd.option("write_fabric_key");
   CommandOptionId opt_load_fabric_key = cmd.option("load_fabric_key");
+  CommandOptionId opt_fabric_key_format = cmd.option("fabric_key_format");
   CommandOptionId opt_verbose = cmd.option("verbose");
+
+  /* Fabric keys are written in XML format unless specified */
+  bool binary_fabric_key = false;
+  if (true == cmd_context.option_enable(cmd, opt_fabric_key_format)) {
+    std::string fkey_format = cmd_context.option_value(cmd, opt_fabric_key_format);
+    if (std::string("binary") == fkey_format) {
+      binary_fabric_key = true;
+    } else if (std::string("xml") != fkey_format) {
+      VTR_LOG_ERROR("Invalid file format '%s' of fabric key! Expect [xml|binary]\n",
+                    fkey_format.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
   
   if (true == cmd_context.option_enable(cmd, opt_compress_routing)) {
-    compress_routing_hierarchy(openfpga_ctx, cmd_context.option_enable(cmd, opt_verbose));
+    /* Identify unique GSBs in a single thread unless specified */
+    size_t num_threads = 1;
+    if (true == cmd_context.option_enable(cmd, opt_threads)) {
+      num_threads = find_num_parallel_threads(std::atoi(cmd_context.option_value(cmd, opt_threads).c_str()));
+    }
+    compress_routing_hierarchy(openfpga_ctx, num_threads, cmd_context.option_enable(cmd, opt_verbose));
     /* Update flow manager to enable compress routing */
     openfpga_ctx.mutable_flow_manager().set_compress_routing(true);
   }
@@ -89,12 +114,16 @@ int build_fabric(OpenfpgaContext& openfpga_ctx,
   int curr_status = CMD_EXEC_SUCCESS;
   int final_status = CMD_EXEC_SUCCESS;
 
-  /* Load fabric key from file */
+  /* Load fabric key from file, whose format is detected by its content */
   FabricKey predefined_fabric_key;
   if (true == cmd_context.option_enable(cmd, opt_load_fabric_key)) {
     std::string fkey_fname = cmd_context.option_value(cmd, opt_load_fabric_key);
     VTR_ASSERT(false == fkey_fname.empty());
-    predefined_fabric_key = read_xml_fabric_key(fkey_fname.c_str());
+    if (true == is_binary_fabric_key_file(fkey_fname.c_str())) {
+      predefined_fabric_key = read_binary_fabric_key(fkey_fname.c_str());
+    } else {
+      predefined_fabric_key = read_xml_fabric_key(fkey_fname.c_str());
+    }
   }
 
   VTR_LOG("\n");
@@ -116,14 +145,21 @@ int build_fabric(OpenfpgaContext& openfpga_ctx,
     final_status = curr_status;
   }
 
+  /* The module graph is complete, compact the nets for the downstream writers */
+  if (CMD_EXEC_FATAL_ERROR != curr_status) {
+    vtr::ScopedStartFinishTimer timer("Freeze nets of fabric module graph");
+    openfpga_ctx.mutable_module_graph().freeze_module_nets();
+  }
+
   /* Output fabric key if user requested */
   if (true == cmd_context.option_enable(cmd, opt_write_fabric_key)) {
     std::string fkey_fname = cmd_context.option_value(cmd, opt_write_fabric_key);
     VTR_ASSERT(false == fkey_fname.empty());
-    curr_status = write_fabric_key_to_xml_file(openfpga_ctx.module_graph(),
-                                               fkey_fname,
-                                               openfpga_ctx.arch().config_protocol.type(),
-                                               cmd_context.option_enable(cmd, opt_verbose));
+    curr_status = write_fabric_key_to_file(openfpga_ctx.module_graph(),
+                                           fkey_fname,
+                                           openfpga_ctx.arch().config_protocol.type(),
+                                           binary_fabric_key,
+                                           cmd_context.option_enable(cmd, opt_verbose));
     /* If there is any error, final status cannot be overwritten by a success flag */
     if (CMD_EXEC_SUCCESS != curr_status) {
       final_status = curr_status;
@@ -133,6 +169,46 @@ int build_fabric(OpenfpgaContext& openfpga_ctx,
   return final_status;
 } 
 
+/********************************************************************
+ * Write the fabric built by 'build_fabric' to a binary snapshot,
+ * which can be loaded by 'read_fabric_snapshot' in another run
+ *******************************************************************/
+int write_fabric_snapshot(const OpenfpgaContext& openfpga_ctx,
+                          const Command& cmd, const CommandContext& cmd_context) { 
+
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  /* The option '--file' must be enabled as the shell interface checks it */
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+  VTR_ASSERT(false == cmd_context.option_value(cmd, opt_file).empty());
+
+  return write_fabric_snapshot_to_binary_file(openfpga_ctx,
+                                              g_vpr_ctx.device(),
+                                              cmd_context.option_value(cmd, opt_file),
+                                              cmd_context.option_enable(cmd, opt_verbose));
+}
+
+/********************************************************************
+ * Load the fabric from a binary snapshot instead of building it
+ * The snapshot must be written on the same device and architecture 
+ *******************************************************************/
+int read_fabric_snapshot(OpenfpgaContext& openfpga_ctx,
+                         const Command& cmd, const CommandContext& cmd_context) { 
+
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  /* The option '--file' must be enabled as the shell interface checks it */
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+  VTR_ASSERT(false == cmd_context.option_value(cmd, opt_file).empty());
+
+  return read_fabric_snapshot_from_binary_file(openfpga_ctx,
+                                               g_vpr_ctx.device(),
+                                               cmd_context.option_value(cmd, opt_file),
+                                               cmd_context.option_enable(cmd, opt_verbose));
+}
+
 /********************************************************************
  * Build the module graph for FPGA device
  *******************************************************************/
@@ -18,6 +18,12 @@ namespace openfpga {
 int build_fabric(OpenfpgaContext& openfpga_ctx,
                  const Command& cmd, const CommandContext& cmd_context); 
 
+int write_fabric_snapshot(const OpenfpgaContext& openfpga_ctx,
+                          const Command& cmd, const CommandContext& cmd_context); 
+
+int read_fabric_snapshot(OpenfpgaContext& openfpga_ctx,
+                         const Command& cmd, const CommandContext& cmd_context); 
+
 int write_fabric_hierarchy(const OpenfpgaContext& openfpga_ctx,
                            const Command& cmd, const CommandContext& cmd_context); 
 
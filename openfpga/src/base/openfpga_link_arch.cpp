@@ -24,6 +24,7 @@
 #include "mux_library_builder.h"
 #include "build_tile_direct.h"
 #include "annotate_placement.h"
+#include "openfpga_parallel_utils.h"
 #include "openfpga_link_arch.h"
 
 /* Include global variables of VPR */
@@ -69,8 +70,20 @@ int link_arch(OpenfpgaContext& openfpga_ctx,
 
   CommandOptionId opt_activity_file = cmd.option("activity_file");
   CommandOptionId opt_sort_edge = cmd.option("sort_gsb_chan_node_in_edges");
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Build GSBs in a single thread unless specified */
+  size_t num_threads = 1;
+  if (true == cmd_context.option_enable(cmd, opt_threads)) {
+    num_threads = find_num_parallel_threads(std::atoi(cmd_context.option_value(cmd, opt_threads).c_str()));
+  }
+
+  /* Give dense indices to the pb_type hierarchy and pb_graph of VPR device,
+   * on which the following annotations are stored
+   */
+  openfpga_ctx.mutable_vpr_device_annotation().build_indices(g_vpr_ctx.device().logical_block_types);
+
   /* Annotate pb_type graphs
    * - physical pb_type
    * - mode selection bits for pb_type and pb interconnect
@@ -120,11 +133,13 @@ int link_arch(OpenfpgaContext& openfpga_ctx,
 
   annotate_device_rr_gsb(g_vpr_ctx.device(),
                          openfpga_ctx.mutable_device_rr_gsb(),
+                         num_threads,
                          cmd_context.option_enable(cmd, opt_verbose));
 
   if (true == cmd_context.option_enable(cmd, opt_sort_edge)) {
     sort_device_rr_gsb_chan_node_in_edges(g_vpr_ctx.device().rr_graph,
                                           openfpga_ctx.mutable_device_rr_gsb(),
+                                          num_threads,
                                           cmd_context.option_enable(cmd, opt_verbose));
   } 
 
@@ -8,6 +8,7 @@
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
 
+#include "openfpga_parallel_utils.h"
 #include "build_physical_truth_table.h"
 #include "repack.h"
 #include "openfpga_repack.h"
@@ -24,13 +25,21 @@ namespace openfpga {
 int repack(OpenfpgaContext& openfpga_ctx,
            const Command& cmd, const CommandContext& cmd_context) {
 
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Repack in a single thread unless specified */
+  size_t num_threads = 1;
+  if (true == cmd_context.option_enable(cmd, opt_threads)) {
+    num_threads = find_num_parallel_threads(std::atoi(cmd_context.option_value(cmd, opt_threads).c_str()));
+  }
+
   pack_physical_pbs(g_vpr_ctx.device(),
                     g_vpr_ctx.atom(),
                     g_vpr_ctx.clustering(),
                     openfpga_ctx.mutable_vpr_device_annotation(),
                     openfpga_ctx.mutable_vpr_clustering_annotation(),
+                    num_threads,
                     cmd_context.option_enable(cmd, opt_verbose));
 
   build_physical_lut_truth_tables(openfpga_ctx.mutable_vpr_clustering_annotation(),
@@ -131,6 +131,10 @@ ShellCommandId add_openfpga_link_arch_command(openfpga::Shell<OpenfpgaContext>&
   /* Add an option '--sort_gsb_chan_node_in_edges'*/
   shell_cmd.add_option("sort_gsb_chan_node_in_edges", false, "Sort all the incoming edges for each routing track output node in General Switch Blocks (GSBs)");
 
+  /* Add an option '--threads'*/
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of threads to build General Switch Blocks (GSBs). Use 0 to run with all the available hardware threads. By default, run with 1 thread");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
   
@@ -273,6 +277,10 @@ ShellCommandId add_openfpga_build_fabric_command(openfpga::Shell<OpenfpgaContext
   /* Add an option '--compress_routing' */
   shell_cmd.add_option("compress_routing", false, "Compress the number of unique routing modules by identifying the unique GSBs");
 
+  /* Add an option '--threads'*/
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of threads to identify the unique GSBs when routing compression is enabled. Use 0 to run with all the available hardware threads. By default, run with 1 thread");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--duplicate_grid_pin' */
   shell_cmd.add_option("duplicate_grid_pin", false, "Duplicate the pins on the same side of a grid");
 
@@ -284,6 +292,10 @@ ShellCommandId add_openfpga_build_fabric_command(openfpga::Shell<OpenfpgaContext
   CommandOptionId opt_write_fkey = shell_cmd.add_option("write_fabric_key", false, "output current fabric key to a file");
   shell_cmd.set_option_require_value(opt_write_fkey, openfpga::OPT_STRING);
 
+  /* Add an option '--fabric_key_format' */
+  CommandOptionId opt_fkey_format = shell_cmd.add_option("fabric_key_format", false, "file format of the fabric key to be written [xml|binary]. Default: xml");
+  shell_cmd.set_option_require_value(opt_fkey_format, openfpga::OPT_STRING);
+
   /* Add an option '--generate_random_fabric_key' */
   shell_cmd.add_option("generate_random_fabric_key", false, "Create a random fabric key which will shuffle the memory address for encryption purpose");
 
@@ -336,6 +348,68 @@ ShellCommandId add_openfpga_write_fabric_hierarchy_command(openfpga::Shell<Openf
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: write_fabric_snapshot
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_write_fabric_snapshot_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                          const ShellCommandClassId& cmd_class_id,
+                                                          const std::vector<ShellCommandId>& dependent_cmds) {
+
+  Command shell_cmd("write_fabric_snapshot");
+
+  /* Add an option '--file' */
+  CommandOptionId opt_file = shell_cmd.add_option("file", true, "Specify the file name to write the snapshot to");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Show verbose outputs");
+
+  /* Add command 'write_fabric_snapshot' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Write the FPGA fabric graph to a binary snapshot file");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(shell_cmd_id, write_fabric_snapshot);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: read_fabric_snapshot
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_read_fabric_snapshot_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                         const ShellCommandClassId& cmd_class_id,
+                                                         const std::vector<ShellCommandId>& dependent_cmds) {
+
+  Command shell_cmd("read_fabric_snapshot");
+
+  /* Add an option '--file' */
+  CommandOptionId opt_file = shell_cmd.add_option("file", true, "Specify the file name to read the snapshot from");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Show verbose outputs");
+
+  /* Add command 'read_fabric_snapshot' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Load the FPGA fabric graph from a binary snapshot file instead of building it");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, read_fabric_snapshot);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 void add_openfpga_setup_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   /* Get the unique id of 'vpr' command which is to be used in creating the dependency graph */
   const ShellCommandId& vpr_cmd_id = shell.command(std::string("vpr"));
@@ -438,6 +512,28 @@ void add_openfpga_setup_commands(openfpga::Shell<OpenfpgaContext>& shell) {
                                                                          openfpga_setup_cmd_class,
                                                                          build_fabric_dependent_cmds);
 
+  /******************************** 
+   * Command 'read_fabric_snapshot' 
+   */
+  /* The 'read_fabric_snapshot' command should NOT be executed before 'link_openfpga_arch' */
+  std::vector<ShellCommandId> read_fabric_snapshot_dependent_cmds;
+  read_fabric_snapshot_dependent_cmds.push_back(link_arch_cmd_id);
+  ShellCommandId read_fabric_snapshot_cmd_id = add_openfpga_read_fabric_snapshot_command(shell,
+                                                                                         openfpga_setup_cmd_class,
+                                                                                         read_fabric_snapshot_dependent_cmds);
+  /* Loading a snapshot meets the dependency on 'build_fabric' of any command */
+  shell.add_command_alternative(build_fabric_cmd_id, read_fabric_snapshot_cmd_id);
+
+  /******************************** 
+   * Command 'write_fabric_snapshot' 
+   */
+  /* The 'write_fabric_snapshot' command should NOT be executed before 'build_fabric' */
+  std::vector<ShellCommandId> write_fabric_snapshot_dependent_cmds;
+  write_fabric_snapshot_dependent_cmds.push_back(build_fabric_cmd_id);
+  add_openfpga_write_fabric_snapshot_command(shell,
+                                             openfpga_setup_cmd_class,
+                                             write_fabric_snapshot_dependent_cmds);
+
   /******************************** 
    * Command 'write_fabric_hierarchy' 
    */
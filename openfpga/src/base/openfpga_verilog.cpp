@@ -8,6 +8,8 @@
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
 
+#include "openfpga_parallel_utils.h"
+
 #include "verilog_api.h"
 #include "openfpga_verilog.h"
 
@@ -29,6 +31,7 @@ int write_fabric_verilog(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_include_signal_init = cmd.option("include_signal_init");
   CommandOptionId opt_support_icarus_simulator = cmd.option("support_icarus_simulator");
   CommandOptionId opt_print_user_defined_template = cmd.option("print_user_defined_template");
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
   /* This is an intermediate data structure which is designed to modularize the FPGA-Verilog
@@ -43,6 +46,10 @@ int write_fabric_verilog(OpenfpgaContext& openfpga_ctx,
   options.set_print_user_defined_template(cmd_context.option_enable(cmd, opt_print_user_defined_template));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_compress_routing(openfpga_ctx.flow_manager().compress_routing());
+  /* Write netlists in a single thread unless specified */
+  if (true == cmd_context.option_enable(cmd, opt_threads)) {
+    options.set_num_threads(find_num_parallel_threads(std::atoi(cmd_context.option_value(cmd, opt_threads).c_str())));
+  }
   
   fpga_fabric_verilog(openfpga_ctx.mutable_module_graph(),
                       openfpga_ctx.mutable_verilog_netlists(),
@@ -68,6 +75,7 @@ int write_verilog_testbench(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_reference_benchmark = cmd.option("reference_benchmark_file_path");
   CommandOptionId opt_print_top_testbench = cmd.option("print_top_testbench");
   CommandOptionId opt_fast_configuration = cmd.option("fast_configuration");
+  CommandOptionId opt_load_bitstream_image = cmd.option("load_bitstream_image");
   CommandOptionId opt_print_formal_verification_top_netlist = cmd.option("print_formal_verification_top_netlist");
   CommandOptionId opt_print_preconfig_top_testbench = cmd.option("print_preconfig_top_testbench");
   CommandOptionId opt_print_simulation_ini = cmd.option("print_simulation_ini");
@@ -83,6 +91,7 @@ int write_verilog_testbench(OpenfpgaContext& openfpga_ctx,
   options.set_print_formal_verification_top_netlist(cmd_context.option_enable(cmd, opt_print_formal_verification_top_netlist));
   options.set_print_preconfig_top_testbench(cmd_context.option_enable(cmd, opt_print_preconfig_top_testbench));
   options.set_fast_configuration(cmd_context.option_enable(cmd, opt_fast_configuration));
+  options.set_load_bitstream_image(cmd_context.option_enable(cmd, opt_load_bitstream_image));
   options.set_print_top_testbench(cmd_context.option_enable(cmd, opt_print_top_testbench));
   options.set_print_simulation_ini(cmd_context.option_value(cmd, opt_print_simulation_ini));
   options.set_explicit_port_mapping(cmd_context.option_enable(cmd, opt_explicit_port_mapping));
@@ -42,6 +42,10 @@ ShellCommandId add_openfpga_write_fabric_verilog_command(openfpga::Shell<Openfpg
   /* Add an option '--print_user_defined_template' */
   shell_cmd.add_option("print_user_defined_template", false, "Generate a template Verilog files for user-defined circuit models");
 
+  /* Add an option '--threads'*/
+  CommandOptionId opt_threads = shell_cmd.add_option("threads", false, "Specify the number of threads to write Verilog netlists. Use 0 to run with all the available hardware threads. By default, run with 1 thread");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -82,6 +86,9 @@ ShellCommandId add_openfpga_write_verilog_testbench_command(openfpga::Shell<Open
   /* Add an option '--fast_configuration' */
   shell_cmd.add_option("fast_configuration", false, "Reduce the period of configuration by skip zero data points");
 
+  /* Add an option '--load_bitstream_image' */
+  shell_cmd.add_option("load_bitstream_image", false, "Write the bitstream to memory image files, which are loaded by the full testbench and the pre-configured top module");
+
   /* Add an option '--print_formal_verification_top_netlist' */
   shell_cmd.add_option("print_formal_verification_top_netlist", false, "Generate a top-level module which can be used in formal verification");
 
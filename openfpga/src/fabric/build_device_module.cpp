@@ -122,6 +122,7 @@ int build_device_module_graph(ModuleManager& module_manager,
                             openfpga_ctx.arch().arch_direct, 
                             openfpga_ctx.arch().config_protocol.type(),
                             sram_model,
+                            openfpga_ctx.arch().config_protocol.num_regions(),
                             frame_view, compress_routing, duplicate_grid_pin,
                             fabric_key, generate_random_fabric_key);
 
@@ -332,6 +332,7 @@ int build_top_module(ModuleManager& module_manager,
                      const ArchDirect& arch_direct,
                      const e_config_protocol_type& sram_orgz_type,
                      const CircuitModelId& sram_model,
+                     const size_t& num_config_regions,
                      const bool& frame_view,
                      const bool& compact_routing_hierarchy,
                      const bool& duplicate_grid_pin,
@@ -423,15 +424,24 @@ int build_top_module(ModuleManager& module_manager,
     add_reserved_sram_ports_to_module_manager(module_manager, top_module, module_num_shared_config_bits);
   }
 
+  /* Split the configurable children into configuration regions,
+   * which will be configured in parallel
+   */
+  status = build_top_module_config_regions(module_manager, top_module,
+                                           sram_orgz_type, num_config_regions);
+  if (CMD_EXEC_FATAL_ERROR == status) {
+    return status;
+  }
+
   /* Add SRAM ports from the sub-modules under this Verilog module
    * This is a much easier job after adding sub modules (instances), 
    * we just need to find all the I/O ports from the child modules and build a list of it
    */
-  size_t module_num_config_bits = find_module_num_config_bits_from_child_modules(module_manager, top_module, circuit_lib, sram_model, sram_orgz_type); 
-  if (0 < module_num_config_bits) {
+  vtr::vector<ConfigRegionId, size_t> top_module_num_config_bits = find_top_module_regional_num_config_bits(module_manager, top_module, circuit_lib, sram_model, sram_orgz_type); 
+  if (0 < top_module_num_config_bits.size()) {
     add_top_module_sram_ports(module_manager, top_module,
                               circuit_lib, sram_model,
-                              sram_orgz_type, module_num_config_bits);
+                              sram_orgz_type, top_module_num_config_bits);
   }
 
   /* Add module nets to connect memory cells inside
@@ -441,7 +451,7 @@ int build_top_module(ModuleManager& module_manager,
     add_top_module_nets_memory_config_bus(module_manager, decoder_lib,
                                           top_module, 
                                           sram_orgz_type, circuit_lib.design_tech_type(sram_model),
-                                          module_num_config_bits);
+                                          top_module_num_config_bits);
   }
 
   return status;
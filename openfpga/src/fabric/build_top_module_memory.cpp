@@ -3,6 +3,7 @@
  * in the top module of FPGA fabric
  *******************************************************************/
 #include <cmath>
+#include <algorithm>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -408,6 +409,11 @@ void shuffle_top_module_configurable_children(ModuleManager& module_manager,
 /********************************************************************
  * Load configurable children from a fabric key to top-level module
  *
+ * The modules of the fabric key, i.e., the distinct names of keys,
+ * are resolved to the modules of the module graph once,
+ * so that a key with a name and a value is mapped to a child instance
+ * without any look-up on strings
+ *
  * Note: 
  *   - This function will overwrite any exisiting configurable children
  *     under the top module
@@ -420,6 +426,13 @@ int load_top_module_memory_modules_from_fabric_key(ModuleManager& module_manager
                                                    const FabricKey& fabric_key) {
   /* Ensure a clean start */
   module_manager.clear_configurable_children(top_module);
+  module_manager.reserve_configurable_child(top_module, fabric_key.num_keys());
+
+  /* Resolve the modules of the fabric key */
+  vtr::vector<FabricKeyModuleId, ModuleId> key_modules(fabric_key.num_modules(), ModuleId::INVALID());
+  for (const FabricKeyModuleId& key_module : fabric_key.modules()) {
+    key_modules[key_module] = module_manager.find_module(fabric_key.module_name(key_module));
+  }
 
   for (const FabricKeyId& key : fabric_key.keys()) {
     /* Find if instance id is valid */
@@ -429,15 +442,19 @@ int load_top_module_memory_modules_from_fabric_key(ModuleManager& module_manager
       /* If we have the key, we can quickly spot instance id.
        * Otherwise, we have to exhaustively find the module id and instance id
        */
-      if (!fabric_key.key_name(key).empty()) {
-        instance_info.first = module_manager.find_module(fabric_key.key_name(key));
-        instance_info.second = module_manager.instance_id(top_module, instance_info.first, fabric_key.key_alias(key));
+      if (FabricKeyModuleId::INVALID() != fabric_key.key_module(key)) {
+        instance_info.first = key_modules[fabric_key.key_module(key)];
+        if (true == module_manager.valid_module_id(instance_info.first)) {
+          instance_info.second = module_manager.instance_id(top_module, instance_info.first, fabric_key.key_alias(key));
+        }
       } else {
         instance_info = find_module_manager_instance_module_info(module_manager, top_module, fabric_key.key_alias(key)); 
       }
     } else { 
       /* If we do not have an alias, we use the name and value to build the info deck */
-      instance_info.first = module_manager.find_module(fabric_key.key_name(key));
+      if (FabricKeyModuleId::INVALID() != fabric_key.key_module(key)) {
+        instance_info.first = key_modules[fabric_key.key_module(key)];
+      }
       instance_info.second = fabric_key.key_value(key);
     }
 
@@ -472,6 +489,218 @@ int load_top_module_memory_modules_from_fabric_key(ModuleManager& module_manager
   return CMD_EXEC_SUCCESS;
 } 
 
+/********************************************************************
+ * Count the number of configuration bits under a module,
+ * which are the leaf configurable children in the module graph
+ * Note that the frame decoder, i.e., the last configurable child 
+ * of a frame-based module with 2+ configurable children, is not counted
+ *
+ * The results are cached by modules, as most modules are 
+ * instanciated many times across the fabric
+ ********************************************************************/
+static 
+size_t rec_find_module_num_config_bits(const ModuleManager& module_manager,
+                                       const ModuleId& module,
+                                       const e_config_protocol_type& sram_orgz_type,
+                                       std::map<ModuleId, size_t>& num_config_bits_cache) {
+  /* A module without configurable children is a memory cell */
+  if (0 == module_manager.configurable_children(module).size()) {
+    return 1;
+  }
+
+  auto result = num_config_bits_cache.find(module);
+  if (result != num_config_bits_cache.end()) {
+    return result->second;
+  }
+
+  size_t num_configurable_children = module_manager.configurable_children(module).size();
+  if ( (CONFIG_MEM_FRAME_BASED == sram_orgz_type)
+    && (2 <= num_configurable_children)) {
+    num_configurable_children--;
+  }
+
+  size_t num_config_bits = 0;
+  for (size_t ichild = 0; ichild < num_configurable_children; ++ichild) {
+    num_config_bits += rec_find_module_num_config_bits(module_manager,
+                                                       module_manager.configurable_children(module)[ichild],
+                                                       sram_orgz_type,
+                                                       num_config_bits_cache);
+  }
+
+  num_config_bits_cache[module] = num_config_bits;
+
+  return num_config_bits;
+}
+
+/********************************************************************
+ * Split the configurable children of the top-level module into
+ * a number of configuration regions.
+ * Each region is a contiguous range of the configurable children,
+ * which will be driven by its own configuration ports.
+ * The regions are balanced by the number of configuration bits,
+ * so that they take similar clock cycles to be configured in parallel 
+ *
+ *  Configurable children  
+ *  +-------+-------+-------+-------+-------+-------+-------+
+ *  |  [0]  |  [1]  |  [2]  |  [3]  |  [4]  |  ...  | [N-1] |
+ *  +-------+-------+-------+-------+-------+-------+-------+
+ *  |<--- Region [0] ------>|<--- Region [1] ...  ->|  ...  
+ *
+ * Note: 
+ *   - This function should be called after all the configurable children
+ *     are organized, and before adding any configuration ports
+ *
+ * Return 0 - Success
+ * Return 1 - Fatal errors
+ ********************************************************************/
+int build_top_module_config_regions(ModuleManager& module_manager,
+                                    const ModuleId& top_module,
+                                    const e_config_protocol_type& sram_orgz_type,
+                                    const size_t& num_regions) {
+  VTR_ASSERT(0 < num_regions);
+
+  size_t num_configurable_children = module_manager.configurable_children(top_module).size();
+  /* Nothing to configure, no regions are needed */
+  if (0 == num_configurable_children) {
+    return CMD_EXEC_SUCCESS;
+  }
+
+  if (num_regions > num_configurable_children) {
+    VTR_LOG_ERROR("Unable to split %lu configurable children of the top module into %lu configuration regions!\n",
+                  num_configurable_children, num_regions);
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Find the number of configuration bits of each configurable child */
+  std::map<ModuleId, size_t> num_config_bits_cache;
+  std::vector<size_t> child_num_config_bits;
+  child_num_config_bits.reserve(num_configurable_children);
+  size_t total_num_config_bits = 0;
+  for (const ModuleId& child_module : module_manager.configurable_children(top_module)) {
+    child_num_config_bits.push_back(rec_find_module_num_config_bits(module_manager, child_module,
+                                                                    sram_orgz_type, num_config_bits_cache));
+    total_num_config_bits += child_num_config_bits.back();
+  }
+
+  /* Close a region once it reaches its share of configuration bits,
+   * while leaving at least one configurable child to each of the remaining regions
+   */
+  size_t first_child = 0;
+  size_t cur_num_config_bits = 0;
+  for (size_t iregion = 0; iregion < num_regions; ++iregion) {
+    size_t last_child = num_configurable_children;
+    if (iregion < num_regions - 1) {
+      size_t region_num_config_bits = total_num_config_bits * (iregion + 1) / num_regions; 
+      size_t max_last_child = num_configurable_children - (num_regions - iregion - 1);
+      last_child = first_child + 1;
+      cur_num_config_bits += child_num_config_bits[first_child];
+      while ( (last_child < max_last_child)
+           && (cur_num_config_bits < region_num_config_bits) ) {
+        cur_num_config_bits += child_num_config_bits[last_child];
+        last_child++;
+      }
+    }
+    module_manager.add_config_region(top_module, last_child - first_child);
+    first_child = last_child;
+  }
+
+  VTR_ASSERT(num_configurable_children == first_child);
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Find the number of configuration bits of each configuration region
+ * in the top-level module
+ * - For standalone, scan-chain and memory bank configuration protocol,
+ *   this is the sum of configuration bits of the configurable children
+ *   in the region
+ * - For frame-based configuration protocol, this is the size of the address
+ *   which is required by the region, including
+ *   the maximum size of address ports of the configurable children and
+ *   the address of the frame decoder, if there are 2+ configurable children 
+ *
+ * Note: 
+ *   - This function should be called before adding any decoders 
+ *     to the configuration regions
+ ********************************************************************/
+vtr::vector<ConfigRegionId, size_t> find_top_module_regional_num_config_bits(const ModuleManager& module_manager,
+                                                                             const ModuleId& top_module,
+                                                                             const CircuitLibrary& circuit_lib,
+                                                                             const CircuitModelId& sram_model,
+                                                                             const e_config_protocol_type& sram_orgz_type) {
+  vtr::vector<ConfigRegionId, size_t> num_config_bits(module_manager.regions(top_module).size(), 0);
+
+  for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+    size_t first_child = module_manager.region_first_configurable_child(top_module, config_region);
+    size_t num_children = module_manager.region_num_configurable_children(top_module, config_region);
+    for (size_t ichild = first_child; ichild < first_child + num_children; ++ichild) {
+      ModuleId child_module = module_manager.configurable_children(top_module)[ichild];
+      size_t child_num_config_bits = find_module_num_config_bits(module_manager, child_module, circuit_lib, sram_model, sram_orgz_type);
+      if (CONFIG_MEM_FRAME_BASED == sram_orgz_type) {
+        num_config_bits[config_region] = std::max(num_config_bits[config_region], child_num_config_bits);
+      } else {
+        num_config_bits[config_region] += child_num_config_bits;
+      }
+    }
+
+    /* For frame-based configuration protocol, a decoder is required for 2+ children */
+    if ( (CONFIG_MEM_FRAME_BASED == sram_orgz_type)
+      && (1 < num_children) ) {
+      num_config_bits[config_region] += find_mux_local_decoder_addr_size(num_children);
+    }
+  }
+
+  return num_config_bits;
+}
+
+/********************************************************************
+ * Append decoders to the end of each configuration region in the top-level module
+ * The configurable children are rebuilt so that each region includes its decoders
+ *
+ *  +-------+-------+-------+---------+-------+-------+---------+
+ *  |  [0]  |  [1]  |  [2]  | decoder |  [3]  |  ...  | decoder |
+ *  +-------+-------+-------+---------+-------+-------+---------+
+ *  |<--- Region [0] ---------------->|<--- Region [1] ...  
+ *
+ * Note: 
+ *   - This function MUST be called after adding all the module nets 
+ *     to other regular configurable children
+ ********************************************************************/
+static 
+void add_top_module_config_region_decoders(ModuleManager& module_manager,
+                                           const ModuleId& top_module,
+                                           const vtr::vector<ConfigRegionId, std::vector<std::pair<ModuleId, size_t>>>& region_decoders) {
+  /* Cache the configurable children and the regions */
+  std::vector<ModuleId> orig_configurable_children = module_manager.configurable_children(top_module);
+  std::vector<size_t> orig_configurable_child_instances = module_manager.configurable_child_instances(top_module);
+  vtr::vector<ConfigRegionId, size_t> orig_region_first_children;
+  vtr::vector<ConfigRegionId, size_t> orig_region_num_children;
+  for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+    orig_region_first_children.push_back(module_manager.region_first_configurable_child(top_module, config_region));
+    orig_region_num_children.push_back(module_manager.region_num_configurable_children(top_module, config_region));
+  }
+  VTR_ASSERT(region_decoders.size() == orig_region_first_children.size());
+
+  /* Reorganize the configurable children */
+  module_manager.clear_configurable_children(top_module);
+
+  for (size_t iregion = 0; iregion < region_decoders.size(); ++iregion) {
+    ConfigRegionId config_region = ConfigRegionId(iregion);
+    size_t first_child = orig_region_first_children[config_region];
+    size_t num_children = orig_region_num_children[config_region];
+    for (size_t ichild = first_child; ichild < first_child + num_children; ++ichild) {
+      module_manager.add_configurable_child(top_module,
+                                            orig_configurable_children[ichild],
+                                            orig_configurable_child_instances[ichild]);
+    }
+    for (const std::pair<ModuleId, size_t>& decoder : region_decoders[config_region]) {
+      module_manager.add_configurable_child(top_module, decoder.first, decoder.second);
+    }
+    module_manager.add_config_region(top_module, num_children + region_decoders[config_region].size());
+  }
+}
+
 /********************************************************************
  * Add a list of ports that are used for SRAM configuration to the FPGA 
  * top-level module
@@ -494,19 +723,37 @@ int load_top_module_memory_modules_from_fabric_key(ModuleManager& module_manager
  *    - An address port, whose size depends on the number of config bits 
  *      and the maximum size of address ports of configurable children
  *    - An data_in port (single-bit)
+ *
+ * When there are multiple configuration regions, each region has
+ * its own slice of the ports, i.e., the head/tail of scan-chain,
+ * the address and the data_in ports, while the enable signal is shared.
+ * The slices are sized by the largest region, so that
+ * the pin [i] of head/tail and data_in ports belongs to region [i]
+ * and the address pins [i * W : (i + 1) * W - 1] belong to region [i],
+ * where W is the size of the address of a region 
  ********************************************************************/
 void add_top_module_sram_ports(ModuleManager& module_manager, 
                                const ModuleId& module_id,
                                const CircuitLibrary& circuit_lib,
                                const CircuitModelId& sram_model,
                                const e_config_protocol_type sram_orgz_type,
-                               const size_t& num_config_bits) {
+                               const vtr::vector<ConfigRegionId, size_t>& num_config_bits) {
+  size_t num_regions = num_config_bits.size();
+  size_t total_num_config_bits = 0;
+  size_t max_num_config_bits = 0;
+  for (const size_t& region_num_config_bits : num_config_bits) {
+    total_num_config_bits += region_num_config_bits;
+    max_num_config_bits = std::max(max_num_config_bits, region_num_config_bits);
+  }
+
   std::vector<std::string> sram_port_names = generate_sram_port_names(circuit_lib, sram_model, sram_orgz_type);
-  size_t sram_port_size = generate_sram_port_size(sram_orgz_type, num_config_bits); 
+  size_t sram_port_size = generate_sram_port_size(sram_orgz_type, total_num_config_bits); 
 
   /* Add ports to the module manager */
   switch (sram_orgz_type) {
   case CONFIG_MEM_STANDALONE: { 
+    /* Standalone memories are always in one region */
+    VTR_ASSERT(1 == num_regions);
     for (const std::string& sram_port_name : sram_port_names) {
       /* Add generated ports to the ModuleManager */
       BasicPort sram_port(sram_port_name, sram_port_size);
@@ -518,15 +765,15 @@ void add_top_module_sram_ports(ModuleManager& module_manager,
     BasicPort en_port(std::string(DECODER_ENABLE_PORT_NAME), 1);
     module_manager.add_port(module_id, en_port, ModuleManager::MODULE_INPUT_PORT);
 
-    size_t bl_addr_size = find_memory_decoder_addr_size(num_config_bits);
-    BasicPort bl_addr_port(std::string(DECODER_BL_ADDRESS_PORT_NAME), bl_addr_size);
+    size_t bl_addr_size = find_memory_decoder_addr_size(max_num_config_bits);
+    BasicPort bl_addr_port(std::string(DECODER_BL_ADDRESS_PORT_NAME), num_regions * bl_addr_size);
     module_manager.add_port(module_id, bl_addr_port, ModuleManager::MODULE_INPUT_PORT);
 
-    size_t wl_addr_size = find_memory_decoder_addr_size(num_config_bits);
-    BasicPort wl_addr_port(std::string(DECODER_WL_ADDRESS_PORT_NAME), wl_addr_size);
+    size_t wl_addr_size = find_memory_decoder_addr_size(max_num_config_bits);
+    BasicPort wl_addr_port(std::string(DECODER_WL_ADDRESS_PORT_NAME), num_regions * wl_addr_size);
     module_manager.add_port(module_id, wl_addr_port, ModuleManager::MODULE_INPUT_PORT);
 
-    BasicPort din_port(std::string(DECODER_DATA_IN_PORT_NAME), 1);
+    BasicPort din_port(std::string(DECODER_DATA_IN_PORT_NAME), num_regions);
     module_manager.add_port(module_id, din_port, ModuleManager::MODULE_INPUT_PORT);
 
     break;
@@ -540,7 +787,7 @@ void add_top_module_sram_ports(ModuleManager& module_manager,
     size_t port_counter = 0;
     for (const std::string& sram_port_name : sram_port_names) {
       /* Add generated ports to the ModuleManager */
-      BasicPort sram_port(sram_port_name, sram_port_size);
+      BasicPort sram_port(sram_port_name, num_regions * sram_port_size);
       if (0 == port_counter) { 
         module_manager.add_port(module_id, sram_port, ModuleManager::MODULE_INPUT_PORT);
       } else {
@@ -555,10 +802,10 @@ void add_top_module_sram_ports(ModuleManager& module_manager,
     BasicPort en_port(std::string(DECODER_ENABLE_PORT_NAME), 1);
     module_manager.add_port(module_id, en_port, ModuleManager::MODULE_INPUT_PORT);
 
-    BasicPort addr_port(std::string(DECODER_ADDRESS_PORT_NAME), num_config_bits);
+    BasicPort addr_port(std::string(DECODER_ADDRESS_PORT_NAME), num_regions * max_num_config_bits);
     module_manager.add_port(module_id, addr_port, ModuleManager::MODULE_INPUT_PORT);
 
-    BasicPort din_port(std::string(DECODER_DATA_IN_PORT_NAME), 1);
+    BasicPort din_port(std::string(DECODER_DATA_IN_PORT_NAME), num_regions);
     module_manager.add_port(module_id, din_port, ModuleManager::MODULE_INPUT_PORT);
 
     break;
@@ -614,12 +861,18 @@ void add_top_module_sram_ports(ModuleManager& module_manager,
  *  data_in ---->|         |  WL[0]          WL[1]              WL[i]
  *               +---------+
  *
+ * Each configuration region has its own BL and WL decoders,
+ * which are driven by its own slices of the address and data_in ports
+ * while the enable signal is shared by all the regions.
+ * The decoders are sized by the largest region, so that
+ * all the regions share the same decoder modules
+ *
  **********************************************************************/
 static 
 void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manager,
                                                      DecoderLibrary& decoder_lib,
                                                      const ModuleId& top_module,
-                                                     const size_t& num_config_bits) {
+                                                     const vtr::vector<ConfigRegionId, size_t>& num_config_bits) {
   /* Find Enable port from the top-level module */ 
   ModulePortId en_port = module_manager.find_module_port(top_module, std::string(DECODER_ENABLE_PORT_NAME));
   BasicPort en_port_info = module_manager.module_port(top_module, en_port);
@@ -635,11 +888,19 @@ void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manag
   ModulePortId wl_addr_port = module_manager.find_module_port(top_module, std::string(DECODER_WL_ADDRESS_PORT_NAME));
   BasicPort wl_addr_port_info = module_manager.module_port(top_module, wl_addr_port);
 
-  /* Find the number of BLs and WLs required to access each memory bit */
-  size_t bl_addr_size = bl_addr_port_info.get_width();
-  size_t wl_addr_size = wl_addr_port_info.get_width();
-  size_t num_bls = find_memory_decoder_data_size(num_config_bits);
-  size_t num_wls = find_memory_decoder_data_size(num_config_bits);
+  /* Find the number of BLs and WLs required to access each memory bit
+   * All the regions share the same decoders, which are sized by the largest region
+   */
+  size_t num_regions = num_config_bits.size();
+  VTR_ASSERT(num_regions == din_port_info.get_width());
+  size_t max_num_config_bits = 0;
+  for (const size_t& region_num_config_bits : num_config_bits) {
+    max_num_config_bits = std::max(max_num_config_bits, region_num_config_bits);
+  }
+  size_t bl_addr_size = bl_addr_port_info.get_width() / num_regions;
+  size_t wl_addr_size = wl_addr_port_info.get_width() / num_regions;
+  size_t num_bls = find_memory_decoder_data_size(max_num_config_bits);
+  size_t num_wls = find_memory_decoder_data_size(max_num_config_bits);
   
   /* Add the BL decoder module 
    * Search the decoder library
@@ -666,7 +927,6 @@ void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manag
   }
   VTR_ASSERT(ModuleId::INVALID() != bl_decoder_module);
   VTR_ASSERT(0 == module_manager.num_instance(top_module, bl_decoder_module));
-  module_manager.add_child_module(top_module, bl_decoder_module);
 
   /* Add the WL decoder module 
    * Search the decoder library
@@ -693,132 +953,425 @@ void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manag
   }
   VTR_ASSERT(ModuleId::INVALID() != wl_decoder_module);
   VTR_ASSERT(0 == module_manager.num_instance(top_module, wl_decoder_module));
-  module_manager.add_child_module(top_module, wl_decoder_module);
 
-  /* Add module nets from the top module to BL decoder's inputs */
   ModulePortId bl_decoder_en_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_ENABLE_PORT_NAME));
-  BasicPort bl_decoder_en_port_info = module_manager.module_port(bl_decoder_module, bl_decoder_en_port);
-
   ModulePortId bl_decoder_addr_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
   BasicPort bl_decoder_addr_port_info = module_manager.module_port(bl_decoder_module, bl_decoder_addr_port);
-
   ModulePortId bl_decoder_din_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_DATA_IN_PORT_NAME));
   BasicPort bl_decoder_din_port_info = module_manager.module_port(bl_decoder_module, bl_decoder_din_port);
+  ModulePortId bl_decoder_dout_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
+  BasicPort bl_decoder_dout_port_info = module_manager.module_port(bl_decoder_module, bl_decoder_dout_port);
 
-  /* Top module Enable port -> BL Decoder Enable port */
-  add_module_bus_nets(module_manager,
-                      top_module,
-                      top_module, 0, en_port,
-                      bl_decoder_module, 0, bl_decoder_en_port);
-
-  /* Top module Address port -> BL Decoder Address port */
-  add_module_bus_nets(module_manager,
-                      top_module,
-                      top_module, 0, bl_addr_port,
-                      bl_decoder_module, 0, bl_decoder_addr_port);
-
-  /* Top module data_in port -> BL Decoder data_in port */
-  add_module_bus_nets(module_manager,
-                      top_module,
-                      top_module, 0, din_port,
-                      bl_decoder_module, 0, bl_decoder_din_port);
-
-  /* Add module nets from the top module to WL decoder's inputs */
   ModulePortId wl_decoder_en_port = module_manager.find_module_port(wl_decoder_module, std::string(DECODER_ENABLE_PORT_NAME));
-  BasicPort wl_decoder_en_port_info = module_manager.module_port(wl_decoder_module, wl_decoder_en_port);
-
   ModulePortId wl_decoder_addr_port = module_manager.find_module_port(wl_decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
-  BasicPort wl_decoder_addr_port_info = module_manager.module_port(wl_decoder_module, bl_decoder_addr_port);
+  BasicPort wl_decoder_addr_port_info = module_manager.module_port(wl_decoder_module, wl_decoder_addr_port);
+  ModulePortId wl_decoder_dout_port = module_manager.find_module_port(wl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
+  BasicPort wl_decoder_dout_port_info = module_manager.module_port(wl_decoder_module, wl_decoder_dout_port);
 
-  /* Top module Enable port -> WL Decoder Enable port */
-  add_module_bus_nets(module_manager,
-                      top_module,
-                      top_module, 0, en_port,
-                      wl_decoder_module, 0, wl_decoder_en_port);
+  /* Build a pair of BL and WL decoders for each region */
+  vtr::vector<ConfigRegionId, std::vector<std::pair<ModuleId, size_t>>> region_decoders(num_regions);
 
-  /* Top module Address port -> WL Decoder Address port */
-  add_module_bus_nets(module_manager,
-                      top_module,
-                      top_module, 0, wl_addr_port,
-                      wl_decoder_module, 0, wl_decoder_addr_port);
+  for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+    /* Instanciate the decoders for the region */
+    size_t bl_decoder_instance = module_manager.num_instance(top_module, bl_decoder_module);
+    module_manager.add_child_module(top_module, bl_decoder_module);
 
-  /* Add nets from BL data out to each configurable child */
-  size_t cur_bl_index = 0;
+    size_t wl_decoder_instance = module_manager.num_instance(top_module, wl_decoder_module);
+    module_manager.add_child_module(top_module, wl_decoder_module);
 
-  ModulePortId bl_decoder_dout_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
-  BasicPort bl_decoder_dout_port_info = module_manager.module_port(bl_decoder_module, bl_decoder_dout_port);
+    /* Top module Enable port -> BL Decoder Enable port */
+    add_module_bus_nets(module_manager,
+                        top_module,
+                        top_module, 0, en_port,
+                        bl_decoder_module, bl_decoder_instance, bl_decoder_en_port);
 
-  for (size_t child_id = 0; child_id < module_manager.configurable_children(top_module).size(); ++child_id) {
-    ModuleId child_module = module_manager.configurable_children(top_module)[child_id];
-    size_t child_instance = module_manager.configurable_child_instances(top_module)[child_id];
+    /* Top module Address port -> BL Decoder Address port */
+    for (size_t ipin = 0; ipin < bl_decoder_addr_port_info.get_width(); ++ipin) {
+      ModuleNetId net = create_module_source_pin_net(module_manager, top_module,
+                                                     top_module, 0,
+                                                     bl_addr_port,
+                                                     bl_addr_port_info.pins()[size_t(config_region) * bl_addr_size + ipin]);
+      module_manager.add_module_net_sink(top_module, net,
+                                         bl_decoder_module, bl_decoder_instance,
+                                         bl_decoder_addr_port, bl_decoder_addr_port_info.pins()[ipin]);
+    }
 
-    /* Find the BL port */
-    ModulePortId child_bl_port = module_manager.find_module_port(child_module, std::string(MEMORY_BL_PORT_NAME));
-    BasicPort child_bl_port_info = module_manager.module_port(child_module, child_bl_port);
+    /* Top module data_in port -> BL Decoder data_in port */
+    VTR_ASSERT(1 == bl_decoder_din_port_info.get_width());
+    ModuleNetId din_net = create_module_source_pin_net(module_manager, top_module,
+                                                       top_module, 0,
+                                                       din_port,
+                                                       din_port_info.pins()[size_t(config_region)]);
+    module_manager.add_module_net_sink(top_module, din_net,
+                                       bl_decoder_module, bl_decoder_instance,
+                                       bl_decoder_din_port, bl_decoder_din_port_info.pins()[0]);
+
+    /* Top module Enable port -> WL Decoder Enable port */
+    add_module_bus_nets(module_manager,
+                        top_module,
+                        top_module, 0, en_port,
+                        wl_decoder_module, wl_decoder_instance, wl_decoder_en_port);
+
+    /* Top module Address port -> WL Decoder Address port */
+    for (size_t ipin = 0; ipin < wl_decoder_addr_port_info.get_width(); ++ipin) {
+      ModuleNetId net = create_module_source_pin_net(module_manager, top_module,
+                                                     top_module, 0,
+                                                     wl_addr_port,
+                                                     wl_addr_port_info.pins()[size_t(config_region) * wl_addr_size + ipin]);
+      module_manager.add_module_net_sink(top_module, net,
+                                         wl_decoder_module, wl_decoder_instance,
+                                         wl_decoder_addr_port, wl_decoder_addr_port_info.pins()[ipin]);
+    }
 
-    for (const size_t& sink_bl_pin : child_bl_port_info.pins()) {
-      /* Find the BL decoder data index: 
-       * It should be the residual when divided by the number of BLs
-       */
-      size_t bl_pin_id = std::floor(cur_bl_index / num_bls);
+    size_t first_child = module_manager.region_first_configurable_child(top_module, config_region);
+    size_t num_children = module_manager.region_num_configurable_children(top_module, config_region);
 
-      /* Create net */
-      ModuleNetId net = create_module_source_pin_net(module_manager, top_module,
-                                                     bl_decoder_module, 0,
-                                                     bl_decoder_dout_port,
-                                                     bl_decoder_dout_port_info.pins()[bl_pin_id]);
-      VTR_ASSERT(ModuleNetId::INVALID() != net);
+    /* Add nets from BL data out to each configurable child */
+    size_t cur_bl_index = 0;
 
-      /* Add net sink */
-      module_manager.add_module_net_sink(top_module, net,
-                                         child_module, child_instance, child_bl_port, sink_bl_pin);
+    for (size_t child_id = first_child; child_id < first_child + num_children; ++child_id) {
+      ModuleId child_module = module_manager.configurable_children(top_module)[child_id];
+      size_t child_instance = module_manager.configurable_child_instances(top_module)[child_id];
 
-      /* Increment the BL index */
-      cur_bl_index++;
+      /* Find the BL port */
+      ModulePortId child_bl_port = module_manager.find_module_port(child_module, std::string(MEMORY_BL_PORT_NAME));
+      BasicPort child_bl_port_info = module_manager.module_port(child_module, child_bl_port);
+
+      for (const size_t& sink_bl_pin : child_bl_port_info.pins()) {
+        /* Find the BL decoder data index: 
+         * It should be the residual when divided by the number of BLs
+         */
+        size_t bl_pin_id = std::floor(cur_bl_index / num_bls);
+
+        /* Create net */
+        ModuleNetId net = create_module_source_pin_net(module_manager, top_module,
+                                                       bl_decoder_module, bl_decoder_instance,
+                                                       bl_decoder_dout_port,
+                                                       bl_decoder_dout_port_info.pins()[bl_pin_id]);
+        VTR_ASSERT(ModuleNetId::INVALID() != net);
+
+        /* Add net sink */
+        module_manager.add_module_net_sink(top_module, net,
+                                           child_module, child_instance, child_bl_port, sink_bl_pin);
+
+        /* Increment the BL index */
+        cur_bl_index++;
+      }
     }
+
+    /* Add nets from WL data out to each configurable child */
+    size_t cur_wl_index = 0;
+
+    for (size_t child_id = first_child; child_id < first_child + num_children; ++child_id) {
+      ModuleId child_module = module_manager.configurable_children(top_module)[child_id];
+      size_t child_instance = module_manager.configurable_child_instances(top_module)[child_id];
+
+      /* Find the WL port */
+      ModulePortId child_wl_port = module_manager.find_module_port(child_module, std::string(MEMORY_WL_PORT_NAME));
+      BasicPort child_wl_port_info = module_manager.module_port(child_module, child_wl_port);
+
+      for (const size_t& sink_wl_pin : child_wl_port_info.pins()) {
+        /* Find the BL decoder data index: 
+         * It should be the residual when divided by the number of BLs
+         */
+        size_t wl_pin_id = cur_wl_index % num_wls;
+
+        /* Create net */
+        ModuleNetId net = create_module_source_pin_net(module_manager, top_module,
+                                                       wl_decoder_module, wl_decoder_instance,
+                                                       wl_decoder_dout_port,
+                                                       wl_decoder_dout_port_info.pins()[wl_pin_id]);
+        VTR_ASSERT(ModuleNetId::INVALID() != net);
+
+        /* Add net sink */
+        module_manager.add_module_net_sink(top_module, net,
+                                           child_module, child_instance, child_wl_port, sink_wl_pin);
+
+        /* Increment the WL index */
+        cur_wl_index++;
+      }
+    }
+
+    region_decoders[config_region].push_back(std::make_pair(bl_decoder_module, bl_decoder_instance));
+    region_decoders[config_region].push_back(std::make_pair(wl_decoder_module, wl_decoder_instance));
   }
 
-  /* Add nets from WL data out to each configurable child */
-  size_t cur_wl_index = 0;
+  /* Add the BL and WL decoders to the end of each region in the configurable children list
+   * Note: this MUST be done after adding all the module nets to other regular configurable children
+   */
+  add_top_module_config_region_decoders(module_manager, top_module, region_decoders);
+}
 
-  ModulePortId wl_decoder_dout_port = module_manager.find_module_port(wl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
-  BasicPort wl_decoder_dout_port_info = module_manager.module_port(wl_decoder_module, wl_decoder_dout_port);
+/********************************************************************
+ * Connect all the memory modules of each configuration region 
+ * in the top-level module into a chain
+ *
+ *                   +--------+    +--------+            +--------+
+ *  ccff_head[0] --->| Memory |--->| Memory |--->... --->| Memory |----> ccff_tail[0]
+ *                   | Module |    | Module |            | Module |
+ *                   |   [0]  |    |   [1]  |            |  [i]   |             
+ *                   +--------+    +--------+            +--------+
+ *
+ *                   +--------+    +--------+            +--------+
+ *  ccff_head[1] --->| Memory |--->| Memory |--->... --->| Memory |----> ccff_tail[1]
+ *                   | Module |    | Module |            | Module |
+ *                   |  [i+1] |    |  [i+2] |            |  [j]   |             
+ *                   +--------+    +--------+            +--------+
+ *
+ *  ...
+ *
+ *  The pin [r] of the head and tail ports of the top-level module 
+ *  belongs to the region [r]
+ *********************************************************************/
+static 
+void add_top_module_nets_cmos_memory_chain_config_bus(ModuleManager& module_manager,
+                                                      const ModuleId& top_module,
+                                                      const e_config_protocol_type& sram_orgz_type) {
+  ModulePortId top_head_port = module_manager.find_module_port(top_module, generate_sram_port_name(sram_orgz_type, CIRCUIT_MODEL_PORT_INPUT));
+  BasicPort top_head_port_info = module_manager.module_port(top_module, top_head_port);
+  ModulePortId top_tail_port = module_manager.find_module_port(top_module, generate_sram_port_name(sram_orgz_type, CIRCUIT_MODEL_PORT_OUTPUT));
+  BasicPort top_tail_port_info = module_manager.module_port(top_module, top_tail_port);
+
+  for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+    size_t first_child = module_manager.region_first_configurable_child(top_module, config_region);
+    size_t num_children = module_manager.region_num_configurable_children(top_module, config_region);
+    VTR_ASSERT(0 < num_children);
+
+    for (size_t mem_index = first_child; mem_index < first_child + num_children; ++mem_index) {
+      /* Find the port name of next memory module */
+      ModuleId net_sink_module_id = module_manager.configurable_children(top_module)[mem_index]; 
+      size_t net_sink_instance_id = module_manager.configurable_child_instances(top_module)[mem_index];
+      ModulePortId net_sink_port_id = module_manager.find_module_port(net_sink_module_id, generate_configuration_chain_head_name()); 
+      BasicPort net_sink_port = module_manager.module_port(net_sink_module_id, net_sink_port_id); 
+
+      if (first_child == mem_index) {
+        /* The 1st memory module is driven by the head of the region */
+        VTR_ASSERT(1 == net_sink_port.get_width());
+        ModuleNetId net = create_module_source_pin_net(module_manager, top_module,
+                                                       top_module, 0,
+                                                       top_head_port, top_head_port_info.pins()[size_t(config_region)]);
+        module_manager.add_module_net_sink(top_module, net, net_sink_module_id, net_sink_instance_id, net_sink_port_id, net_sink_port.pins()[0]);
+        continue;
+      }
 
-  for (size_t child_id = 0; child_id < module_manager.configurable_children(top_module).size(); ++child_id) {
-    ModuleId child_module = module_manager.configurable_children(top_module)[child_id];
-    size_t child_instance = module_manager.configurable_child_instances(top_module)[child_id];
+      /* Find the port name of previous memory module */
+      ModuleId net_src_module_id = module_manager.configurable_children(top_module)[mem_index - 1]; 
+      size_t net_src_instance_id = module_manager.configurable_child_instances(top_module)[mem_index - 1];
+      ModulePortId net_src_port_id = module_manager.find_module_port(net_src_module_id, generate_configuration_chain_tail_name()); 
+      BasicPort net_src_port = module_manager.module_port(net_src_module_id, net_src_port_id); 
+      /* Port sizes of source and sink should match */
+      VTR_ASSERT(net_src_port.get_width() == net_sink_port.get_width());
+
+      /* Create a net for each pin */
+      for (size_t pin_id = 0; pin_id < net_src_port.pins().size(); ++pin_id) {
+        ModuleNetId net = create_module_source_pin_net(module_manager, top_module, net_src_module_id, net_src_instance_id, net_src_port_id, net_src_port.pins()[pin_id]);
+        module_manager.add_module_net_sink(top_module, net, net_sink_module_id, net_sink_instance_id, net_sink_port_id, net_sink_port.pins()[pin_id]);
+      }
+    }
 
-    /* Find the WL port */
-    ModulePortId child_wl_port = module_manager.find_module_port(child_module, std::string(MEMORY_WL_PORT_NAME));
-    BasicPort child_wl_port_info = module_manager.module_port(child_module, child_wl_port);
+    /* The last memory module drives the tail of the region */
+    ModuleId net_src_module_id = module_manager.configurable_children(top_module)[first_child + num_children - 1]; 
+    size_t net_src_instance_id = module_manager.configurable_child_instances(top_module)[first_child + num_children - 1];
+    ModulePortId net_src_port_id = module_manager.find_module_port(net_src_module_id, generate_configuration_chain_tail_name()); 
+    BasicPort net_src_port = module_manager.module_port(net_src_module_id, net_src_port_id); 
+    VTR_ASSERT(1 == net_src_port.get_width());
 
-    for (const size_t& sink_wl_pin : child_wl_port_info.pins()) {
-      /* Find the BL decoder data index: 
-       * It should be the residual when divided by the number of BLs
-       */
-      size_t wl_pin_id = cur_wl_index % num_wls;
+    ModuleNetId net = create_module_source_pin_net(module_manager, top_module, net_src_module_id, net_src_instance_id, net_src_port_id, net_src_port.pins()[0]);
+    module_manager.add_module_net_sink(top_module, net, top_module, 0, top_tail_port, top_tail_port_info.pins()[size_t(config_region)]);
+  }
+}
 
-      /* Create net */
+/********************************************************************
+ * Build the frame-based configuration bus for each configuration region
+ * in the top-level module 
+ *
+ * Each region uses a slice of the address port and a pin of the data_in port 
+ * of the top-level module, while the enable signal is shared by all the regions.
+ * Inside a region, the connections are the same as a frame-based module
+ * (see add_module_nets_cmos_memory_frame_config_bus() for details)
+ * - If there is only one configurable child, short wire the EN, ADDR and DATA_IN to it
+ * - If there are more than two configurable childern, add a decoder,
+ *   which is driven by the MSBs of the address slice, while
+ *   the configurable children are driven by the LSBs of the address slice
+ *
+ * Unlike the memory bank, the regions do not share the same decoder module.
+ * The decoder of each region is sized by its own number of configurable children,
+ * while the address slices of all the regions are sized by the largest region.
+ * The decoder is always aligned to the MSBs of its address slice
+ *
+ *   EN   ADDR[W - 1:0]   DATA_IN[0]       EN   ADDR[2W - 1:W]   DATA_IN[1]  
+ *    |     |               |               |     |                |
+ *    v     v               v               v     v                v
+ *  +---------------------------+         +---------------------------+
+ *  |         Region [0]        |         |         Region [1]        |  ...
+ *  +---------------------------+         +---------------------------+
+ *
+ **********************************************************************/
+static 
+void add_top_module_nets_cmos_memory_frame_config_bus(ModuleManager& module_manager,
+                                                      DecoderLibrary& decoder_lib,
+                                                      const ModuleId& top_module) {
+  ModulePortId top_en_port = module_manager.find_module_port(top_module, std::string(DECODER_ENABLE_PORT_NAME));
+  ModulePortId top_addr_port = module_manager.find_module_port(top_module, std::string(DECODER_ADDRESS_PORT_NAME));
+  BasicPort top_addr_port_info = module_manager.module_port(top_module, top_addr_port);
+  ModulePortId top_din_port = module_manager.find_module_port(top_module, std::string(DECODER_DATA_IN_PORT_NAME));
+  BasicPort top_din_port_info = module_manager.module_port(top_module, top_din_port);
+
+  size_t num_regions = module_manager.regions(top_module).size();
+  VTR_ASSERT(num_regions == top_din_port_info.get_width());
+  size_t region_addr_size = top_addr_port_info.get_width() / num_regions;
+
+  vtr::vector<ConfigRegionId, std::vector<std::pair<ModuleId, size_t>>> region_decoders(num_regions);
+
+  for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+    size_t first_child = module_manager.region_first_configurable_child(top_module, config_region);
+    size_t num_children = module_manager.region_num_configurable_children(top_module, config_region);
+    VTR_ASSERT(0 < num_children);
+
+    /* The address pins of the region are [addr_lsb : addr_lsb + region_addr_size - 1] */
+    size_t addr_lsb = size_t(config_region) * region_addr_size;
+
+    if (1 == num_children) {
+      ModuleId child_module = module_manager.configurable_children(top_module)[first_child]; 
+      size_t child_instance = module_manager.configurable_child_instances(top_module)[first_child];
+
+      /* Connect the enable (EN) port of the top module to the EN port of memory module */
+      ModulePortId child_en_port = module_manager.find_module_port(child_module, std::string(DECODER_ENABLE_PORT_NAME));
+      add_module_bus_nets(module_manager, top_module,
+                          top_module, 0, top_en_port,
+                          child_module, child_instance, child_en_port);
+
+      /* Connect the address slice to the child module address port */
+      ModulePortId child_addr_port = module_manager.find_module_port(child_module, std::string(DECODER_ADDRESS_PORT_NAME));
+      BasicPort child_addr_port_info = module_manager.module_port(child_module, child_addr_port);
+      VTR_ASSERT(child_addr_port_info.get_width() <= region_addr_size);
+      for (size_t ipin = 0; ipin < child_addr_port_info.get_width(); ++ipin) {
+        ModuleNetId net = create_module_source_pin_net(module_manager, top_module,
+                                                       top_module, 0,
+                                                       top_addr_port, top_addr_port_info.pins()[addr_lsb + ipin]);
+        module_manager.add_module_net_sink(top_module, net,
+                                           child_module, child_instance,
+                                           child_addr_port, child_addr_port_info.pins()[ipin]);
+      }
+
+      /* Connect the data_in (Din) of the region to the data_in of the memory module */
+      ModulePortId child_din_port = module_manager.find_module_port(child_module, std::string(DECODER_DATA_IN_PORT_NAME));
+      BasicPort child_din_port_info = module_manager.module_port(child_module, child_din_port);
+      VTR_ASSERT(1 == child_din_port_info.get_width());
+      ModuleNetId din_net = create_module_source_pin_net(module_manager, top_module,
+                                                         top_module, 0,
+                                                         top_din_port, top_din_port_info.pins()[size_t(config_region)]);
+      module_manager.add_module_net_sink(top_module, din_net,
+                                         child_module, child_instance,
+                                         child_din_port, child_din_port_info.pins()[0]);
+      continue;
+    }
+
+    /* Find the decoder specification */
+    size_t decoder_addr_size = find_mux_local_decoder_addr_size(num_children);
+    /* Data input should match the WL (data_in) of a SRAM */
+    size_t decoder_data_size = num_children; 
+
+    /* Search the decoder library and try to find one 
+     * If not found, create a new module and add it to the module manager 
+     */
+    DecoderId decoder_id = decoder_lib.find_decoder(decoder_addr_size, decoder_data_size, true, false, false);
+    if (DecoderId::INVALID() == decoder_id) {
+      decoder_id = decoder_lib.add_decoder(decoder_addr_size, decoder_data_size, true, false, false);
+    }
+    VTR_ASSERT(DecoderId::INVALID() != decoder_id);
+
+    /* Create a module if not existed yet */
+    std::string decoder_module_name = generate_memory_decoder_subckt_name(decoder_addr_size, decoder_data_size);
+    ModuleId decoder_module = module_manager.find_module(decoder_module_name);
+    if (ModuleId::INVALID() == decoder_module) {
+      decoder_module = build_frame_memory_decoder_module(module_manager,
+                                                         decoder_lib,
+                                                         decoder_id);
+    }
+    VTR_ASSERT(ModuleId::INVALID() != decoder_module);
+
+    /* Instanciate the decoder module here */
+    size_t decoder_instance = module_manager.num_instance(top_module, decoder_module);
+    module_manager.add_child_module(top_module, decoder_module);
+
+    /* Connect the enable (EN) port of the top module to the frame decoder */
+    ModulePortId decoder_en_port = module_manager.find_module_port(decoder_module, std::string(DECODER_ENABLE_PORT_NAME));
+    add_module_bus_nets(module_manager, top_module,
+                        top_module, 0, top_en_port,
+                        decoder_module, decoder_instance, decoder_en_port);
+
+    /* Connect the MSBs of the address slice to the frame decoder address port */
+    ModulePortId decoder_addr_port = module_manager.find_module_port(decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
+    BasicPort decoder_addr_port_info = module_manager.module_port(decoder_module, decoder_addr_port);
+    for (size_t ipin = 0; ipin < decoder_addr_port_info.get_width(); ++ipin) {
       ModuleNetId net = create_module_source_pin_net(module_manager, top_module,
-                                                     wl_decoder_module, 0,
-                                                     wl_decoder_dout_port,
-                                                     wl_decoder_dout_port_info.pins()[wl_pin_id]);
-      VTR_ASSERT(ModuleNetId::INVALID() != net);
+                                                     top_module, 0,
+                                                     top_addr_port, top_addr_port_info.pins()[addr_lsb + region_addr_size - 1 - ipin]);
+      module_manager.add_module_net_sink(top_module, net,
+                                         decoder_module, decoder_instance,
+                                         decoder_addr_port,
+                                         decoder_addr_port_info.get_msb() - ipin);
+    } 
 
-      /* Add net sink */
+    /* Connect the LSBs of the address slice to the address port of configurable children */
+    for (size_t mem_index = first_child; mem_index < first_child + num_children; ++mem_index) {
+      ModuleId child_module = module_manager.configurable_children(top_module)[mem_index]; 
+      size_t child_instance = module_manager.configurable_child_instances(top_module)[mem_index];
+      ModulePortId child_addr_port = module_manager.find_module_port(child_module, std::string(DECODER_ADDRESS_PORT_NAME));
+      BasicPort child_addr_port_info = module_manager.module_port(child_module, child_addr_port);
+      for (size_t ipin = 0; ipin < child_addr_port_info.get_width(); ++ipin) {
+        ModuleNetId net = create_module_source_pin_net(module_manager, top_module,
+                                                       top_module, 0,
+                                                       top_addr_port, top_addr_port_info.pins()[addr_lsb + ipin]);
+        module_manager.add_module_net_sink(top_module, net,
+                                           child_module, child_instance,
+                                           child_addr_port,
+                                           child_addr_port_info.get_lsb() + ipin);
+      }
+    }
+
+    /* Connect the data_in (Din) of the region to the data_in of the all the memory modules */
+    for (size_t mem_index = first_child; mem_index < first_child + num_children; ++mem_index) {
+      ModuleId child_module = module_manager.configurable_children(top_module)[mem_index]; 
+      size_t child_instance = module_manager.configurable_child_instances(top_module)[mem_index];
+      ModulePortId child_din_port = module_manager.find_module_port(child_module, std::string(DECODER_DATA_IN_PORT_NAME));
+      BasicPort child_din_port_info = module_manager.module_port(child_module, child_din_port);
+      VTR_ASSERT(1 == child_din_port_info.get_width());
+      ModuleNetId net = create_module_source_pin_net(module_manager, top_module,
+                                                     top_module, 0,
+                                                     top_din_port, top_din_port_info.pins()[size_t(config_region)]);
       module_manager.add_module_net_sink(top_module, net,
-                                         child_module, child_instance, child_wl_port, sink_wl_pin);
+                                         child_module, child_instance,
+                                         child_din_port, child_din_port_info.pins()[0]);
+    }
 
-      /* Increment the WL index */
-      cur_wl_index++;
+    /* Connect the data_out port of the decoder module to the enable port of configurable children */
+    ModulePortId decoder_dout_port = module_manager.find_module_port(decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
+    BasicPort decoder_dout_port_info = module_manager.module_port(decoder_module, decoder_dout_port);
+    VTR_ASSERT(decoder_dout_port_info.get_width() == num_children);
+    for (size_t mem_index = first_child; mem_index < first_child + num_children; ++mem_index) {
+      ModuleId child_module = module_manager.configurable_children(top_module)[mem_index]; 
+      size_t child_instance = module_manager.configurable_child_instances(top_module)[mem_index];
+      ModulePortId child_en_port = module_manager.find_module_port(child_module, std::string(DECODER_ENABLE_PORT_NAME));
+      BasicPort child_en_port_info = module_manager.module_port(child_module, child_en_port);
+      for (size_t ipin = 0; ipin < child_en_port_info.get_width(); ++ipin) {
+        ModuleNetId net = create_module_source_pin_net(module_manager, top_module,
+                                                       decoder_module, decoder_instance,
+                                                       decoder_dout_port,
+                                                       decoder_dout_port_info.pins()[mem_index - first_child]);
+        module_manager.add_module_net_sink(top_module, net,
+                                           child_module, child_instance,
+                                           child_en_port,
+                                           child_en_port_info.pins()[ipin]);
+      }
     }
+
+    region_decoders[config_region].push_back(std::make_pair(decoder_module, decoder_instance));
   }
 
-  /* Add the BL and WL decoders to the end of configurable children list
-   * Note: this MUST be done after adding all the module nets to other regular configurable children
-   */
-  module_manager.add_configurable_child(top_module, bl_decoder_module, 0);
-  module_manager.add_configurable_child(top_module, wl_decoder_module, 0);
+  /* Add the decoders to the end of each region in the configurable children list */
+  add_top_module_config_region_decoders(module_manager, top_module, region_decoders);
 }
 
 /*********************************************************************
@@ -870,7 +1423,7 @@ void add_top_module_nets_cmos_memory_config_bus(ModuleManager& module_manager,
                                                 DecoderLibrary& decoder_lib,
                                                 const ModuleId& parent_module,
                                                 const e_config_protocol_type& sram_orgz_type,
-                                                const size_t& num_config_bits) {
+                                                const vtr::vector<ConfigRegionId, size_t>& num_config_bits) {
   switch (sram_orgz_type) {
   case CONFIG_MEM_STANDALONE:
     add_module_nets_cmos_flatten_memory_config_bus(module_manager, parent_module,
@@ -879,14 +1432,14 @@ void add_top_module_nets_cmos_memory_config_bus(ModuleManager& module_manager,
                                                    sram_orgz_type, CIRCUIT_MODEL_PORT_WL);
     break;
   case CONFIG_MEM_SCAN_CHAIN: {
-    add_module_nets_cmos_memory_chain_config_bus(module_manager, parent_module, CONFIG_MEM_SCAN_CHAIN);
+    add_top_module_nets_cmos_memory_chain_config_bus(module_manager, parent_module, CONFIG_MEM_SCAN_CHAIN);
     break;
   }
   case CONFIG_MEM_MEMORY_BANK:
     add_top_module_nets_cmos_memory_bank_config_bus(module_manager, decoder_lib, parent_module, num_config_bits);
     break;
   case CONFIG_MEM_FRAME_BASED:
-    add_module_nets_cmos_memory_frame_config_bus(module_manager, decoder_lib, parent_module);
+    add_top_module_nets_cmos_memory_frame_config_bus(module_manager, decoder_lib, parent_module);
     break;
   default:
     VTR_LOGF_ERROR(__FILE__, __LINE__,
@@ -932,7 +1485,7 @@ void add_top_module_nets_memory_config_bus(ModuleManager& module_manager,
                                            const ModuleId& parent_module,
                                            const e_config_protocol_type& sram_orgz_type, 
                                            const e_circuit_model_design_tech& mem_tech,
-                                           const size_t& num_config_bits) {
+                                           const vtr::vector<ConfigRegionId, size_t>& num_config_bits) {
 
   vtr::ScopedStartFinishTimer timer("Add module nets for configuration buses");
 
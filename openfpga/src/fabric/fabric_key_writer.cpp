@@ -11,8 +11,10 @@
 
 /* Headers from archopenfpga library */
 #include "write_xml_fabric_key.h"
+#include "write_binary_fabric_key.h"
 
 #include "openfpga_naming.h"
+#include "module_manager_utils.h"
 
 #include "fabric_key_writer.h"
 
@@ -20,18 +22,68 @@
 namespace openfpga {
 
 /***************************************************************************************
- * Write the fabric key of top module to an XML file
+ * Build the fabric key of top module by visiting all the configurable children
+ * Exclude configuration-related modules, i.e., the decoders 
+ * at the end of each configuration region, in the keys
+ * When required, the instance names are added to the keys as aliases
+ ***************************************************************************************/
+static 
+FabricKey build_top_module_fabric_key(const ModuleManager& module_manager,
+                                      const ModuleId& top_module,
+                                      const e_config_protocol_type& config_protocol_type,
+                                      const bool& include_alias,
+                                      const bool& verbose) {
+  FabricKey fabric_key;
+  size_t num_keys = 0; 
+  for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+    num_keys += find_top_module_region_num_memory_children(module_manager, top_module, config_region, config_protocol_type);
+  }
+
+  fabric_key.reserve_keys(num_keys);
+
+  for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+    size_t first_child = module_manager.region_first_configurable_child(top_module, config_region);
+    size_t num_memory_children = find_top_module_region_num_memory_children(module_manager, top_module, config_region, config_protocol_type);
+    for (size_t ichild = first_child; ichild < first_child + num_memory_children; ++ichild) {
+      ModuleId child_module = module_manager.configurable_children(top_module)[ichild];
+      size_t child_instance = module_manager.configurable_child_instances(top_module)[ichild];
+
+      FabricKeyId key = fabric_key.create_key();
+      fabric_key.set_key_name(key, module_manager.module_name(child_module));
+      fabric_key.set_key_value(key, child_instance);
+
+      if ( (true == include_alias)
+        && (false == module_manager.instance_name(top_module, child_module, child_instance).empty()) ) {
+        fabric_key.set_key_alias(key, module_manager.instance_name(top_module, child_module, child_instance));
+      }
+    }
+  }
+
+  VTR_LOGV(verbose,
+           "Created %lu keys for the top module %s.\n",
+           num_keys, module_manager.module_name(top_module).c_str());
+
+  return fabric_key;
+}
+
+/***************************************************************************************
+ * Write the fabric key of top module to a file
  * We will use the writer API in libfabrickey
  *
+ * In binary format, the keys are not aliased by instance names:
+ * a key is mapped to an instance by its name and value, without any look-up on strings,
+ * when it is loaded by build_fabric
+ *
  * Return 0 if successful
  * Return 1 if there are more serious bugs in the architecture 
  * Return 2 if fail when creating files
  ***************************************************************************************/
-int write_fabric_key_to_xml_file(const ModuleManager& module_manager,
-                                 const std::string& fname,
-                                 const e_config_protocol_type& config_protocol_type,
-                                 const bool& verbose) {
-  std::string timer_message = std::string("Write fabric key to XML file '") + fname + std::string("'");
+int write_fabric_key_to_file(const ModuleManager& module_manager,
+                             const std::string& fname,
+                             const e_config_protocol_type& config_protocol_type,
+                             const bool& binary_format,
+                             const bool& verbose) {
+  std::string timer_message = std::string("Write fabric key to ") + std::string(binary_format ? "binary" : "XML") + std::string(" file '") + fname + std::string("'");
 
   std::string dir_path = format_dir_path(find_path_dir_name(fname));
 
@@ -53,40 +105,20 @@ int write_fabric_key_to_xml_file(const ModuleManager& module_manager,
                    top_module_name.c_str());
     return 1;
   }
-  
-  /* Build a fabric key database by visiting all the configurable children */
-  FabricKey fabric_key;
-  size_t num_keys = module_manager.configurable_children(top_module).size(); 
-
-  /* Exclude configuration-related modules in the keys */
-  if (CONFIG_MEM_MEMORY_BANK == config_protocol_type) {
-    num_keys -= 2;
-  } else if (CONFIG_MEM_FRAME_BASED == config_protocol_type) {
-    num_keys -= 1;
-  }
-
-  fabric_key.reserve_keys(num_keys);
 
-  for (size_t ichild = 0; ichild < num_keys; ++ichild) {
-    ModuleId child_module = module_manager.configurable_children(top_module)[ichild];
-    size_t child_instance = module_manager.configurable_child_instances(top_module)[ichild];
-
-    FabricKeyId key = fabric_key.create_key();
-    fabric_key.set_key_name(key, module_manager.module_name(child_module));
-    fabric_key.set_key_value(key, child_instance);
-
-    if (false == module_manager.instance_name(top_module, child_module, child_instance).empty()) {
-      fabric_key.set_key_alias(key, module_manager.instance_name(top_module, child_module, child_instance));
-    }
+  FabricKey fabric_key = build_top_module_fabric_key(module_manager, top_module,
+                                                     config_protocol_type,
+                                                     false == binary_format,
+                                                     verbose);
+
+  /* Call the writer for fabric key */
+  int err_code = 0;
+  if (true == binary_format) {
+    err_code = write_binary_fabric_key(fname.c_str(), fabric_key);
+  } else {
+    err_code = write_xml_fabric_key(fname.c_str(), fabric_key);
   }
 
-  VTR_LOGV(verbose,
-           "Created %lu keys for the top module %s.\n",
-           num_keys, top_module_name.c_str());
-
-  /* Call the XML writer for fabric key */
-  int err_code = write_xml_fabric_key(fname.c_str(), fabric_key);
-
   return err_code;
 }
 
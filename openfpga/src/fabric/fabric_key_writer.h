@@ -14,10 +14,11 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
-int write_fabric_key_to_xml_file(const ModuleManager& module_manager,
-                                 const std::string& fname,
-                                 const e_config_protocol_type& config_protocol_type,
-                                 const bool& verbose);
+int write_fabric_key_to_file(const ModuleManager& module_manager,
+                             const std::string& fname,
+                             const e_config_protocol_type& config_protocol_type,
+                             const bool& binary_format,
+                             const bool& verbose);
 
 } /* end namespace openfpga */
 
@@ -0,0 +1,175 @@
+#ifndef FABRIC_SNAPSHOT_FORMAT_H
+#define FABRIC_SNAPSHOT_FORMAT_H
+
+/********************************************************************
+ * This file defines the binary snapshot of the FPGA fabric,
+ * which includes the data structures built by the command 'build_fabric':
+ * - the module graph
+ * - the I/O location map
+ * - the decoder library
+ * - the unique modules of General Switch Blocks (GSBs),
+ *   when the routing hierarchy is compressed
+ *
+ * The snapshot is loaded by memory-mapping the file,
+ * so that the fabric can be restored without building it again.
+ *
+ * All the integers are stored in little-endian.
+ *
+ * File layout
+ * -----------
+ *
+ *   +-------------------------------------------------------+ 0
+ *   | Header                                                |
+ *   |   magic number (8 bytes)     : "OFPGAFSN"             |
+ *   |   version (uint32)                                    |
+ *   |   flags (uint32)                                      |
+ *   |   width of device grid (uint64)                       |
+ *   |   height of device grid (uint64)                      |
+ *   |   number of routing resource nodes (uint64)           |
+ *   |   number of routing resource edges (uint64)           |
+ *   |   number of circuit models (uint64)                   |
+ *   |   size of the payload (uint64)                        |
+ *   |   checksum of the payload (uint64)                    |
+ *   |   configuration protocol type (uint64)                |
+ *   |   number of configuration regions (uint64)            |
+ *   |   digest of the architectures (uint64)                |
+ *   +-------------------------------------------------------+ 96
+ *   | Payload                                               |
+ *   |   Decoder library                                     |
+ *   |   I/O location map                                    |
+ *   |   Unique modules of GSBs                              |
+ *   |   Module graph                                        |
+ *   +-------------------------------------------------------+
+ *
+ * The device grid, the routing resource graph, the circuit models,
+ * the configuration protocol and the architectures in the header 
+ * are used to reject a snapshot of another device or architecture.
+ * The digest of the architectures is the 64-bit FNV-1a hash of
+ * the digests of the VPR and OpenFPGA architecture files,
+ * so that any edit on the architecture files is detected.
+ * They are built by the commands 'vpr' and 'link_openfpga_arch' in each run,
+ * as well as the multiplexer library and the GSBs themselves,
+ * which are therefore not included in the snapshot.
+ *
+ * The checksum is the 64-bit FNV-1a hash of the payload,
+ * so that a corrupted file is rejected before any record is read.
+ *
+ * The payload is a sequence of records, where
+ * - each integer is a uint64
+ * - each string is its length (uint64) followed by its characters
+ * - each list is its size (uint64) followed by its elements
+ *
+ * Decoder library: a list of decoders, each of which is
+ *   address size, data size, flags of optional ports (see below)
+ *
+ * I/O location map: a list of x, each of which is a list of y,
+ *   each of which is a list of I/O indices in z
+ *
+ * Unique modules of GSBs: the range of GSB array (x, y), which is (0, 0)
+ *   if the routing hierarchy is not compressed, followed by
+ *   the indices of unique SB, CBX and CBY modules for each GSB in [x][y]
+ *
+ * Module graph:
+ *   a list of modules: name, usage
+ *   for each module, a list of ports: name, LSB, MSB, type, flags (see below),
+ *                                     pre-processing flag
+ *   for each module, a list of child modules: child module,
+ *                                             a list of instance names
+ *   for each module, a list of configurable children: child module, instance
+ *                    a list of configuration regions: number of configurable children
+ *   for each module, a list of nets: name,
+ *                                    a list of sources: module, instance, port, pin
+ *                                    a list of sinks: module, instance, port, pin
+ *******************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+constexpr char FABRIC_SNAPSHOT_MAGIC[] = "OFPGAFSN";
+constexpr size_t FABRIC_SNAPSHOT_MAGIC_SIZE = 8;
+constexpr uint32_t FABRIC_SNAPSHOT_VERSION = 3;
+
+/* Byte offsets of the fields in the header */
+constexpr size_t FABRIC_SNAPSHOT_VERSION_OFFSET = 8;
+constexpr size_t FABRIC_SNAPSHOT_FLAGS_OFFSET = 12;
+constexpr size_t FABRIC_SNAPSHOT_GRID_WIDTH_OFFSET = 16;
+constexpr size_t FABRIC_SNAPSHOT_GRID_HEIGHT_OFFSET = 24;
+constexpr size_t FABRIC_SNAPSHOT_NUM_RR_NODES_OFFSET = 32;
+constexpr size_t FABRIC_SNAPSHOT_NUM_RR_EDGES_OFFSET = 40;
+constexpr size_t FABRIC_SNAPSHOT_NUM_CIRCUIT_MODELS_OFFSET = 48;
+constexpr size_t FABRIC_SNAPSHOT_PAYLOAD_SIZE_OFFSET = 56;
+constexpr size_t FABRIC_SNAPSHOT_CHECKSUM_OFFSET = 64;
+constexpr size_t FABRIC_SNAPSHOT_CONFIG_PROTOCOL_OFFSET = 72;
+constexpr size_t FABRIC_SNAPSHOT_NUM_CONFIG_REGIONS_OFFSET = 80;
+constexpr size_t FABRIC_SNAPSHOT_ARCH_DIGEST_OFFSET = 88;
+constexpr size_t FABRIC_SNAPSHOT_HEADER_SIZE = 96;
+
+/* Flags in the header */
+constexpr uint32_t FABRIC_SNAPSHOT_COMPRESS_ROUTING_FLAG = 0x1;
+
+/* Flags of decoders */
+constexpr uint64_t FABRIC_SNAPSHOT_DECODER_ENABLE_FLAG = 0x1;
+constexpr uint64_t FABRIC_SNAPSHOT_DECODER_DATA_IN_FLAG = 0x2;
+constexpr uint64_t FABRIC_SNAPSHOT_DECODER_DATA_INV_FLAG = 0x4;
+
+/* Flags of module ports */
+constexpr uint64_t FABRIC_SNAPSHOT_PORT_WIRE_FLAG = 0x1;
+constexpr uint64_t FABRIC_SNAPSHOT_PORT_REGISTER_FLAG = 0x2;
+
+/* Encode/decode integers in little-endian */
+inline void encode_fabric_snapshot_uint(const uint64_t& value,
+                                        const size_t& num_bytes,
+                                        unsigned char* buffer) {
+  for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+    buffer[ibyte] = static_cast<unsigned char>((value >> (8 * ibyte)) & 0xff);
+  }
+}
+
+inline uint64_t decode_fabric_snapshot_uint(const unsigned char* buffer,
+                                            const size_t& num_bytes) {
+  uint64_t value = 0;
+  for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+    value |= static_cast<uint64_t>(buffer[ibyte]) << (8 * ibyte);
+  }
+  return value;
+}
+
+/* 64-bit FNV-1a hash of the payload,
+ * which starts from FABRIC_SNAPSHOT_CHECKSUM_BASIS and is updated chunk by chunk
+ */
+constexpr uint64_t FABRIC_SNAPSHOT_CHECKSUM_BASIS = 14695981039346656037ULL;
+
+inline uint64_t update_fabric_snapshot_checksum(const uint64_t& checksum,
+                                                const unsigned char* data,
+                                                const size_t& num_bytes) {
+  uint64_t hash = checksum;
+  for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+    hash ^= data[ibyte];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/* Digest of the architectures, which is built from the digests of
+ * the VPR and OpenFPGA architecture files
+ * The digest of VPR architecture may be a null pointer, e.g., when no VPR architecture is read
+ */
+inline uint64_t find_fabric_snapshot_architecture_digest(const char* vpr_arch_id,
+                                                         const std::string& openfpga_arch_id) {
+  std::string vpr_arch_id_str = (nullptr == vpr_arch_id) ? std::string() : std::string(vpr_arch_id);
+
+  /* Separate the two digests, so that they cannot be shifted into each other */
+  const unsigned char separator = 0;
+  uint64_t digest = FABRIC_SNAPSHOT_CHECKSUM_BASIS;
+  digest = update_fabric_snapshot_checksum(digest, reinterpret_cast<const unsigned char*>(vpr_arch_id_str.data()), vpr_arch_id_str.size());
+  digest = update_fabric_snapshot_checksum(digest, &separator, 1);
+  digest = update_fabric_snapshot_checksum(digest, reinterpret_cast<const unsigned char*>(openfpga_arch_id.data()), openfpga_arch_id.size());
+  return digest;
+}
+
+} /* end namespace openfpga */
+
+#endif
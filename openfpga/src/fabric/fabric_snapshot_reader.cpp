@@ -0,0 +1,509 @@
+/********************************************************************
+ * This file includes functions to read a snapshot of the FPGA fabric
+ * from a binary file, whose format is defined in fabric_snapshot_format.h
+ *
+ * The file is memory-mapped. Its checksum and all the records are validated
+ * before being used, so that a corrupted or incompatible snapshot is reported
+ * as an error rather than creating an invalid fabric.
+ * The fabric is built in separated data structures, which replace
+ * the ones in the OpenFPGA context only when the whole file is read.
+ *******************************************************************/
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+#include "vtr_assert.h"
+#include "vtr_time.h"
+
+#include "fabric_snapshot_format.h"
+#include "fabric_snapshot_reader.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Sequential reader of the records in the payload
+ * Any read beyond the end of payload raises the error flag,
+ * and all the following reads return zeros
+ *******************************************************************/
+class FabricSnapshotPayload {
+  public: /* Public constructor */
+    FabricSnapshotPayload(const unsigned char* data, const size_t& size) {
+      data_ = data;
+      size_ = size;
+      pos_ = 0;
+      error_ = false;
+    }
+
+  public: /* Public accessors */
+    bool error() const {
+      return error_;
+    }
+
+    bool end() const {
+      return pos_ == size_;
+    }
+
+  public: /* Public mutators */
+    uint64_t read_uint() {
+      if ((true == error_) || (8 > size_ - pos_)) {
+        error_ = true;
+        return 0;
+      }
+      uint64_t value = decode_fabric_snapshot_uint(data_ + pos_, 8);
+      pos_ += 8;
+      return value;
+    }
+
+    /* The size of a list, whose elements take at least 8 bytes each,
+     * so that a corrupted size never leads to a huge loop
+     */
+    size_t read_list_size() {
+      uint64_t list_size = read_uint();
+      if (list_size > (size_ - pos_) / 8) {
+        error_ = true;
+        return 0;
+      }
+      return list_size;
+    }
+
+    std::string read_string() {
+      uint64_t string_size = read_uint();
+      if ((true == error_) || (string_size > size_ - pos_)) {
+        error_ = true;
+        return std::string();
+      }
+      std::string value(reinterpret_cast<const char*>(data_ + pos_), string_size);
+      pos_ += string_size;
+      return value;
+    }
+
+    /* Raise the error flag, when a record is found invalid by the caller */
+    void set_error() {
+      error_ = true;
+    }
+
+  private: /* Internal data */
+    const unsigned char* data_;
+    size_t size_;
+    size_t pos_;
+    bool error_;
+};
+
+/********************************************************************
+ * Read the decoders, which are added in the order of their ids
+ *******************************************************************/
+static
+void read_fabric_snapshot_decoder_library(FabricSnapshotPayload& payload,
+                                          DecoderLibrary& decoder_lib) {
+  size_t num_decoders = payload.read_list_size();
+  for (size_t idecoder = 0; idecoder < num_decoders; ++idecoder) {
+    size_t addr_size = payload.read_uint();
+    size_t data_size = payload.read_uint();
+    uint64_t flags = payload.read_uint();
+    if (true == payload.error()) {
+      return;
+    }
+    decoder_lib.add_decoder(addr_size, data_size,
+                            0 != (flags & FABRIC_SNAPSHOT_DECODER_ENABLE_FLAG),
+                            0 != (flags & FABRIC_SNAPSHOT_DECODER_DATA_IN_FLAG),
+                            0 != (flags & FABRIC_SNAPSHOT_DECODER_DATA_INV_FLAG));
+  }
+}
+
+static
+void read_fabric_snapshot_io_location_map(FabricSnapshotPayload& payload,
+                                          IoLocationMap& io_location_map) {
+  size_t x_size = payload.read_list_size();
+  for (size_t x = 0; x < x_size; ++x) {
+    size_t y_size = payload.read_list_size();
+    for (size_t y = 0; y < y_size; ++y) {
+      size_t z_size = payload.read_list_size();
+      for (size_t z = 0; z < z_size; ++z) {
+        size_t io_index = payload.read_uint();
+        if (true == payload.error()) {
+          return;
+        }
+        io_location_map.set_io_index(x, y, z, io_index);
+      }
+    }
+  }
+}
+
+/********************************************************************
+ * Read the indices of unique modules of each GSB
+ * They are loaded to the GSB array only when the whole file is read
+ *******************************************************************/
+static
+void read_fabric_snapshot_device_rr_gsb(FabricSnapshotPayload& payload,
+                                        std::vector<std::vector<size_t>>& sb_unique_module_ids,
+                                        std::vector<std::vector<size_t>>& cbx_unique_module_ids,
+                                        std::vector<std::vector<size_t>>& cby_unique_module_ids) {
+  size_t gsb_range_x = payload.read_list_size();
+  size_t gsb_range_y = payload.read_list_size();
+  for (size_t ix = 0; ix < gsb_range_x; ++ix) {
+    if (true == payload.error()) {
+      return;
+    }
+    sb_unique_module_ids.emplace_back(gsb_range_y);
+    cbx_unique_module_ids.emplace_back(gsb_range_y);
+    cby_unique_module_ids.emplace_back(gsb_range_y);
+    for (size_t iy = 0; iy < gsb_range_y; ++iy) {
+      sb_unique_module_ids[ix][iy] = payload.read_uint();
+      cbx_unique_module_ids[ix][iy] = payload.read_uint();
+      cby_unique_module_ids[ix][iy] = payload.read_uint();
+    }
+  }
+}
+
+/********************************************************************
+ * Check if a terminal of a net in a module is valid,
+ * i.e., a pin of the module itself or of an instance of its child module
+ *******************************************************************/
+static
+bool valid_fabric_snapshot_net_terminal(const ModuleManager& module_manager,
+                                        const ModuleId& module,
+                                        const size_t& terminal_module,
+                                        const size_t& terminal_instance,
+                                        const size_t& terminal_port,
+                                        const size_t& terminal_pin) {
+  ModuleId terminal_module_id = ModuleId(terminal_module);
+  ModulePortId terminal_port_id = ModulePortId(terminal_port);
+  if (false == module_manager.valid_module_port_id(terminal_module_id, terminal_port_id)) {
+    return false;
+  }
+  if (terminal_pin >= module_manager.module_port(terminal_module_id, terminal_port_id).get_width()) {
+    return false;
+  }
+  return (module == terminal_module_id)
+      || (terminal_instance < module_manager.num_instance(module, terminal_module_id));
+}
+
+/********************************************************************
+ * Read the module graph, in the same order as it is written
+ *******************************************************************/
+static
+void read_fabric_snapshot_module_graph(FabricSnapshotPayload& payload,
+                                       ModuleManager& module_manager) {
+  size_t num_modules = payload.read_list_size();
+  for (size_t imodule = 0; imodule < num_modules; ++imodule) {
+    std::string module_name = payload.read_string();
+    size_t usage = payload.read_uint();
+    if (true == payload.error()) {
+      return;
+    }
+    /* Module names should be unique */
+    ModuleId module = module_manager.add_module(module_name);
+    if ( (false == module_manager.valid_module_id(module))
+      || (ModuleManager::NUM_MODULE_USAGE_TYPES < usage) ) {
+      payload.set_error();
+      return;
+    }
+    /* Usage may not be specified for some modules */
+    if (ModuleManager::NUM_MODULE_USAGE_TYPES != usage) {
+      module_manager.set_module_usage(module, ModuleManager::e_module_usage_type(usage));
+    }
+  }
+
+  /* Ports */
+  for (const ModuleId& module : module_manager.modules()) {
+    size_t num_ports = payload.read_list_size();
+    for (size_t iport = 0; iport < num_ports; ++iport) {
+      std::string port_name = payload.read_string();
+      size_t lsb = payload.read_uint();
+      size_t msb = payload.read_uint();
+      size_t port_type = payload.read_uint();
+      uint64_t flags = payload.read_uint();
+      std::string preproc_flag = payload.read_string();
+      if ( (true == payload.error())
+        || (ModuleManager::NUM_MODULE_PORT_TYPES <= port_type) ) {
+        payload.set_error();
+        return;
+      }
+      ModulePortId port = module_manager.add_port(module, BasicPort(port_name, lsb, msb),
+                                                  ModuleManager::e_module_port_type(port_type));
+      if (0 != (flags & FABRIC_SNAPSHOT_PORT_WIRE_FLAG)) {
+        module_manager.set_port_is_wire(module, port_name, true);
+      }
+      if (0 != (flags & FABRIC_SNAPSHOT_PORT_REGISTER_FLAG)) {
+        module_manager.set_port_is_register(module, port_name, true);
+      }
+      if (false == preproc_flag.empty()) {
+        module_manager.set_port_preproc_flag(module, port, preproc_flag);
+      }
+    }
+  }
+
+  /* Child modules and their instances */
+  for (const ModuleId& module : module_manager.modules()) {
+    size_t num_children = payload.read_list_size();
+    for (size_t ichild = 0; ichild < num_children; ++ichild) {
+      ModuleId child = ModuleId(payload.read_uint());
+      size_t num_instances = payload.read_list_size();
+      if ( (true == payload.error())
+        || (false == module_manager.valid_module_id(child))
+        || (module == child)) {
+        payload.set_error();
+        return;
+      }
+      for (size_t instance = 0; instance < num_instances; ++instance) {
+        std::string instance_name = payload.read_string();
+        if (true == payload.error()) {
+          return;
+        }
+        module_manager.add_child_module(module, child);
+        if (false == instance_name.empty()) {
+          module_manager.set_child_instance_name(module, child, instance, instance_name);
+        }
+      }
+    }
+  }
+
+  /* Configurable children */
+  for (const ModuleId& module : module_manager.modules()) {
+    size_t num_configurable_children = payload.read_list_size();
+    module_manager.reserve_configurable_child(module, num_configurable_children);
+    for (size_t ichild = 0; ichild < num_configurable_children; ++ichild) {
+      ModuleId child = ModuleId(payload.read_uint());
+      size_t instance = payload.read_uint();
+      if ( (true == payload.error())
+        || (false == module_manager.valid_module_id(child))
+        || (instance >= module_manager.num_instance(module, child)) ) {
+        payload.set_error();
+        return;
+      }
+      module_manager.add_configurable_child(module, child, instance);
+    }
+    size_t num_regions = payload.read_list_size();
+    size_t num_region_children = 0;
+    for (size_t iregion = 0; iregion < num_regions; ++iregion) {
+      size_t num_children = payload.read_uint();
+      num_region_children += num_children;
+      if ( (true == payload.error())
+        || (num_region_children > num_configurable_children) ) {
+        payload.set_error();
+        return;
+      }
+      module_manager.add_config_region(module, num_children);
+    }
+  }
+
+  /* Nets */
+  for (const ModuleId& module : module_manager.modules()) {
+    size_t num_nets = payload.read_list_size();
+    module_manager.reserve_module_nets(module, num_nets);
+    for (size_t inet = 0; inet < num_nets; ++inet) {
+      ModuleNetId net = module_manager.create_module_net(module);
+      module_manager.set_net_name(module, net, payload.read_string());
+
+      size_t num_sources = payload.read_list_size();
+      module_manager.reserve_module_net_sources(module, net, num_sources);
+      for (size_t isrc = 0; isrc < num_sources; ++isrc) {
+        size_t src_module = payload.read_uint();
+        size_t src_instance = payload.read_uint();
+        size_t src_port = payload.read_uint();
+        size_t src_pin = payload.read_uint();
+        if ( (true == payload.error())
+          || (false == valid_fabric_snapshot_net_terminal(module_manager, module, src_module, src_instance, src_port, src_pin)) ) {
+          payload.set_error();
+          return;
+        }
+        module_manager.add_module_net_source(module, net,
+                                             ModuleId(src_module), src_instance,
+                                             ModulePortId(src_port), src_pin);
+      }
+
+      size_t num_sinks = payload.read_list_size();
+      module_manager.reserve_module_net_sinks(module, net, num_sinks);
+      for (size_t isink = 0; isink < num_sinks; ++isink) {
+        size_t sink_module = payload.read_uint();
+        size_t sink_instance = payload.read_uint();
+        size_t sink_port = payload.read_uint();
+        size_t sink_pin = payload.read_uint();
+        if ( (true == payload.error())
+          || (false == valid_fabric_snapshot_net_terminal(module_manager, module, sink_module, sink_instance, sink_port, sink_pin)) ) {
+          payload.set_error();
+          return;
+        }
+        module_manager.add_module_net_sink(module, net,
+                                           ModuleId(sink_module), sink_instance,
+                                           ModulePortId(sink_port), sink_pin);
+      }
+    }
+  }
+}
+
+/********************************************************************
+ * Check the header and read the payload of a mapped snapshot file
+ * The fabric replaces the one in the OpenFPGA context only if no error is found
+ *
+ * Return 0 if successful
+ * Return 1 if there are critical errors
+ *******************************************************************/
+static
+int read_fabric_snapshot_from_mapped_data(OpenfpgaContext& openfpga_ctx,
+                                          const DeviceContext& vpr_device_ctx,
+                                          const std::string& fname,
+                                          const unsigned char* data,
+                                          const size_t& file_size,
+                                          const bool& verbose) {
+  if ( (file_size < FABRIC_SNAPSHOT_HEADER_SIZE)
+    || (0 != std::memcmp(data, FABRIC_SNAPSHOT_MAGIC, FABRIC_SNAPSHOT_MAGIC_SIZE)) ) {
+    VTR_LOG_ERROR("File '%s' is not a fabric snapshot!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  if (FABRIC_SNAPSHOT_VERSION != decode_fabric_snapshot_uint(data + FABRIC_SNAPSHOT_VERSION_OFFSET, 4)) {
+    VTR_LOG_ERROR("Unsupported version of fabric snapshot '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  if (file_size != FABRIC_SNAPSHOT_HEADER_SIZE + decode_fabric_snapshot_uint(data + FABRIC_SNAPSHOT_PAYLOAD_SIZE_OFFSET, 8)) {
+    VTR_LOG_ERROR("Size of fabric snapshot '%s' does not match its header!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  /* The snapshot must be built on the same device and architecture */
+  if ( (vpr_device_ctx.grid.width() != decode_fabric_snapshot_uint(data + FABRIC_SNAPSHOT_GRID_WIDTH_OFFSET, 8))
+    || (vpr_device_ctx.grid.height() != decode_fabric_snapshot_uint(data + FABRIC_SNAPSHOT_GRID_HEIGHT_OFFSET, 8))
+    || (vpr_device_ctx.rr_graph.nodes().size() != decode_fabric_snapshot_uint(data + FABRIC_SNAPSHOT_NUM_RR_NODES_OFFSET, 8))
+    || (vpr_device_ctx.rr_graph.edges().size() != decode_fabric_snapshot_uint(data + FABRIC_SNAPSHOT_NUM_RR_EDGES_OFFSET, 8))
+    || (openfpga_ctx.arch().circuit_lib.num_models() != decode_fabric_snapshot_uint(data + FABRIC_SNAPSHOT_NUM_CIRCUIT_MODELS_OFFSET, 8)) ) {
+    VTR_LOG_ERROR("Fabric snapshot '%s' was built on another device or architecture!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  if ( (size_t(openfpga_ctx.arch().config_protocol.type()) != decode_fabric_snapshot_uint(data + FABRIC_SNAPSHOT_CONFIG_PROTOCOL_OFFSET, 8))
+    || (openfpga_ctx.arch().config_protocol.num_regions() != decode_fabric_snapshot_uint(data + FABRIC_SNAPSHOT_NUM_CONFIG_REGIONS_OFFSET, 8)) ) {
+    VTR_LOG_ERROR("Fabric snapshot '%s' was built with another configuration protocol or number of configuration regions!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  /* Any edit on the architecture files may change the fabric, even if all the numbers above are the same */
+  if (find_fabric_snapshot_architecture_digest(vpr_device_ctx.arch->architecture_id, openfpga_ctx.arch().architecture_id)
+      != decode_fabric_snapshot_uint(data + FABRIC_SNAPSHOT_ARCH_DIGEST_OFFSET, 8)) {
+    VTR_LOG_ERROR("Fabric snapshot '%s' was built on another version of the VPR or OpenFPGA architecture files!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  if (decode_fabric_snapshot_uint(data + FABRIC_SNAPSHOT_CHECKSUM_OFFSET, 8)
+      != update_fabric_snapshot_checksum(FABRIC_SNAPSHOT_CHECKSUM_BASIS, data + FABRIC_SNAPSHOT_HEADER_SIZE, file_size - FABRIC_SNAPSHOT_HEADER_SIZE)) {
+    VTR_LOG_ERROR("Fabric snapshot '%s' is corrupted!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  bool compress_routing = 0 != (decode_fabric_snapshot_uint(data + FABRIC_SNAPSHOT_FLAGS_OFFSET, 4) & FABRIC_SNAPSHOT_COMPRESS_ROUTING_FLAG);
+
+  FabricSnapshotPayload payload(data + FABRIC_SNAPSHOT_HEADER_SIZE, file_size - FABRIC_SNAPSHOT_HEADER_SIZE);
+
+  DecoderLibrary decoder_lib;
+  read_fabric_snapshot_decoder_library(payload, decoder_lib);
+
+  IoLocationMap io_location_map;
+  read_fabric_snapshot_io_location_map(payload, io_location_map);
+
+  std::vector<std::vector<size_t>> sb_unique_module_ids;
+  std::vector<std::vector<size_t>> cbx_unique_module_ids;
+  std::vector<std::vector<size_t>> cby_unique_module_ids;
+  read_fabric_snapshot_device_rr_gsb(payload, sb_unique_module_ids, cbx_unique_module_ids, cby_unique_module_ids);
+
+  ModuleManager module_manager;
+  read_fabric_snapshot_module_graph(payload, module_manager);
+
+  if ( (true == payload.error()) || (false == payload.end()) ) {
+    VTR_LOG_ERROR("Invalid records in fabric snapshot '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  /* Unique modules of GSBs are restored on the GSB array built by 'link_openfpga_arch' */
+  if ( (true == compress_routing)
+    && (false == openfpga_ctx.mutable_device_rr_gsb().load_unique_module(sb_unique_module_ids, cbx_unique_module_ids, cby_unique_module_ids)) ) {
+    VTR_LOG_ERROR("Unique routing modules in fabric snapshot '%s' do not match the routing architecture!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  /* The module graph is complete, compact the nets as 'build_fabric' does */
+  module_manager.freeze_module_nets();
+
+  openfpga_ctx.mutable_decoder_lib() = std::move(decoder_lib);
+  openfpga_ctx.mutable_io_location_map() = std::move(io_location_map);
+  openfpga_ctx.mutable_module_graph() = std::move(module_manager);
+  openfpga_ctx.mutable_flow_manager().set_compress_routing(compress_routing);
+
+  VTR_LOGV(verbose,
+           "Read %lu modules and %lu decoders%s\n",
+           openfpga_ctx.module_graph().num_modules(),
+           openfpga_ctx.decoder_lib().decoders().size(),
+           compress_routing ? " with compressed routing hierarchy" : "");
+
+  return 0;
+}
+
+/********************************************************************
+ * Read a snapshot of the FPGA fabric from a binary file,
+ * which replaces the command 'build_fabric'
+ *
+ * Return 0 if successful
+ * Return 1 if there are critical errors
+ *******************************************************************/
+int read_fabric_snapshot_from_binary_file(OpenfpgaContext& openfpga_ctx,
+                                          const DeviceContext& vpr_device_ctx,
+                                          const std::string& fname,
+                                          const bool& verbose) {
+  std::string timer_message = std::string("Read fabric snapshot from binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Map the whole file */
+  int fd = open(fname.c_str(), O_RDONLY);
+  if (-1 == fd) {
+    VTR_LOG_ERROR("Unable to open fabric snapshot '%s': %s\n",
+                  fname.c_str(), std::strerror(errno));
+    return 1;
+  }
+
+  struct stat file_stat;
+  if ( (-1 == fstat(fd, &file_stat)) || (0 == file_stat.st_size) ) {
+    close(fd);
+    VTR_LOG_ERROR("Unable to find the size of fabric snapshot '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
+  size_t file_size = file_stat.st_size;
+
+  void* mapped_data = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  /* The mapping remains valid after the file is closed */
+  close(fd);
+  if (MAP_FAILED == mapped_data) {
+    VTR_LOG_ERROR("Unable to map fabric snapshot '%s': %s\n",
+                  fname.c_str(), std::strerror(errno));
+    return 1;
+  }
+
+  /* Records are read in sequence, let the OS read ahead */
+  madvise(mapped_data, file_size, MADV_SEQUENTIAL);
+
+  int status = read_fabric_snapshot_from_mapped_data(openfpga_ctx, vpr_device_ctx, fname,
+                                                     static_cast<const unsigned char*>(mapped_data), file_size,
+                                                     verbose);
+
+  munmap(mapped_data, file_size);
+
+  return status;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,25 @@
+#ifndef FABRIC_SNAPSHOT_READER_H
+#define FABRIC_SNAPSHOT_READER_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "vpr_context.h"
+#include "openfpga_context.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int read_fabric_snapshot_from_binary_file(OpenfpgaContext& openfpga_ctx,
+                                          const DeviceContext& vpr_device_ctx,
+                                          const std::string& fname,
+                                          const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,302 @@
+/********************************************************************
+ * This file includes functions to write a snapshot of the FPGA fabric
+ * into a binary file, whose format is defined in fabric_snapshot_format.h
+ *******************************************************************/
+#include <fstream>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+#include "vtr_assert.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "fabric_snapshot_format.h"
+#include "fabric_snapshot_writer.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Size of the buffer of file stream, so that records are written in large chunks */
+constexpr size_t FABRIC_SNAPSHOT_FILE_BUFFER_SIZE = 1 << 20;
+
+/********************************************************************
+ * Writer of the records in the payload,
+ * which computes the checksum of all the records being written
+ *******************************************************************/
+class FabricSnapshotPayloadWriter {
+  public: /* Public constructor */
+    explicit FabricSnapshotPayloadWriter(std::fstream& fp)
+      : fp_(fp) {
+      checksum_ = FABRIC_SNAPSHOT_CHECKSUM_BASIS;
+    }
+
+  public: /* Public accessors */
+    uint64_t checksum() const {
+      return checksum_;
+    }
+
+  public: /* Public mutators */
+    void write_uint(const uint64_t& value) {
+      unsigned char buffer[8];
+      encode_fabric_snapshot_uint(value, 8, buffer);
+      write_bytes(buffer, 8);
+    }
+
+    void write_string(const std::string& value) {
+      write_uint(value.size());
+      write_bytes(reinterpret_cast<const unsigned char*>(value.data()), value.size());
+    }
+
+  private: /* Internal utilities */
+    void write_bytes(const unsigned char* data, const size_t& num_bytes) {
+      checksum_ = update_fabric_snapshot_checksum(checksum_, data, num_bytes);
+      fp_.write(reinterpret_cast<const char*>(data), num_bytes);
+    }
+
+  private: /* Internal data */
+    std::fstream& fp_;
+    uint64_t checksum_;
+};
+
+/********************************************************************
+ * Write the decoders in the order of their ids
+ *******************************************************************/
+static
+void write_fabric_snapshot_decoder_library(FabricSnapshotPayloadWriter& payload,
+                                           const DecoderLibrary& decoder_lib) {
+  payload.write_uint(decoder_lib.decoders().size());
+  for (const DecoderId& decoder : decoder_lib.decoders()) {
+    uint64_t flags = 0;
+    if (true == decoder_lib.use_enable(decoder)) {
+      flags |= FABRIC_SNAPSHOT_DECODER_ENABLE_FLAG;
+    }
+    if (true == decoder_lib.use_data_in(decoder)) {
+      flags |= FABRIC_SNAPSHOT_DECODER_DATA_IN_FLAG;
+    }
+    if (true == decoder_lib.use_data_inv_port(decoder)) {
+      flags |= FABRIC_SNAPSHOT_DECODER_DATA_INV_FLAG;
+    }
+    payload.write_uint(decoder_lib.addr_size(decoder));
+    payload.write_uint(decoder_lib.data_size(decoder));
+    payload.write_uint(flags);
+  }
+}
+
+static
+void write_fabric_snapshot_io_location_map(FabricSnapshotPayloadWriter& payload,
+                                           const IoLocationMap& io_location_map) {
+  payload.write_uint(io_location_map.x_size());
+  for (size_t x = 0; x < io_location_map.x_size(); ++x) {
+    payload.write_uint(io_location_map.y_size(x));
+    for (size_t y = 0; y < io_location_map.y_size(x); ++y) {
+      payload.write_uint(io_location_map.z_size(x, y));
+      for (size_t z = 0; z < io_location_map.z_size(x, y); ++z) {
+        payload.write_uint(io_location_map.io_index(x, y, z));
+      }
+    }
+  }
+}
+
+/********************************************************************
+ * Write the indices of unique modules of each GSB,
+ * which are only available when the routing hierarchy is compressed
+ *******************************************************************/
+static
+void write_fabric_snapshot_device_rr_gsb(FabricSnapshotPayloadWriter& payload,
+                                         const DeviceRRGSB& device_rr_gsb,
+                                         const bool& compress_routing) {
+  if (false == compress_routing) {
+    payload.write_uint(0);
+    payload.write_uint(0);
+    return;
+  }
+
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  payload.write_uint(gsb_range.x());
+  payload.write_uint(gsb_range.y());
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      vtr::Point<size_t> gsb_coordinate(ix, iy);
+      payload.write_uint(device_rr_gsb.get_sb_unique_module_index(gsb_coordinate));
+      payload.write_uint(device_rr_gsb.get_cb_unique_module_index(CHANX, gsb_coordinate));
+      payload.write_uint(device_rr_gsb.get_cb_unique_module_index(CHANY, gsb_coordinate));
+    }
+  }
+}
+
+/********************************************************************
+ * Write the module graph
+ * All the modules are written before their ports, children and nets,
+ * so that the reader can create all of them before any reference
+ *******************************************************************/
+static
+void write_fabric_snapshot_module_graph(FabricSnapshotPayloadWriter& payload,
+                                        const ModuleManager& module_manager) {
+  payload.write_uint(module_manager.num_modules());
+  for (const ModuleId& module : module_manager.modules()) {
+    payload.write_string(module_manager.module_name(module));
+    payload.write_uint(module_manager.module_usage(module));
+  }
+
+  /* Ports */
+  for (const ModuleId& module : module_manager.modules()) {
+    payload.write_uint(module_manager.module_ports(module).size());
+    for (const ModulePortId& port : module_manager.module_ports(module)) {
+      BasicPort port_info = module_manager.module_port(module, port);
+      uint64_t flags = 0;
+      if (true == module_manager.port_is_wire(module, port)) {
+        flags |= FABRIC_SNAPSHOT_PORT_WIRE_FLAG;
+      }
+      if (true == module_manager.port_is_register(module, port)) {
+        flags |= FABRIC_SNAPSHOT_PORT_REGISTER_FLAG;
+      }
+      payload.write_string(port_info.get_name());
+      payload.write_uint(port_info.get_lsb());
+      payload.write_uint(port_info.get_msb());
+      payload.write_uint(module_manager.port_type(module, port));
+      payload.write_uint(flags);
+      payload.write_string(module_manager.port_preproc_flag(module, port));
+    }
+  }
+
+  /* Child modules and their instances */
+  for (const ModuleId& module : module_manager.modules()) {
+    std::vector<ModuleId> child_modules = module_manager.child_modules(module);
+    payload.write_uint(child_modules.size());
+    for (const ModuleId& child : child_modules) {
+      payload.write_uint(size_t(child));
+      payload.write_uint(module_manager.num_instance(module, child));
+      for (size_t instance = 0; instance < module_manager.num_instance(module, child); ++instance) {
+        payload.write_string(module_manager.instance_name(module, child, instance));
+      }
+    }
+  }
+
+  /* Configurable children */
+  for (const ModuleId& module : module_manager.modules()) {
+    const std::vector<ModuleId>& configurable_children = module_manager.configurable_children(module);
+    const std::vector<size_t>& configurable_child_instances = module_manager.configurable_child_instances(module);
+    payload.write_uint(configurable_children.size());
+    for (size_t ichild = 0; ichild < configurable_children.size(); ++ichild) {
+      payload.write_uint(size_t(configurable_children[ichild]));
+      payload.write_uint(configurable_child_instances[ichild]);
+    }
+    payload.write_uint(module_manager.regions(module).size());
+    for (const ConfigRegionId& config_region : module_manager.regions(module)) {
+      payload.write_uint(module_manager.region_num_configurable_children(module, config_region));
+    }
+  }
+
+  /* Nets */
+  for (const ModuleId& module : module_manager.modules()) {
+    payload.write_uint(module_manager.module_nets(module).size());
+    for (const ModuleNetId& net : module_manager.module_nets(module)) {
+      payload.write_string(module_manager.net_name(module, net));
+
+      payload.write_uint(module_manager.module_net_sources(module, net).size());
+      for (const ModuleNetSrcId& net_src : module_manager.module_net_sources(module, net)) {
+        payload.write_uint(size_t(module_manager.net_source_module(module, net, net_src)));
+        payload.write_uint(module_manager.net_source_instance(module, net, net_src));
+        payload.write_uint(size_t(module_manager.net_source_port(module, net, net_src)));
+        payload.write_uint(module_manager.net_source_pin(module, net, net_src));
+      }
+
+      payload.write_uint(module_manager.module_net_sinks(module, net).size());
+      for (const ModuleNetSinkId& net_sink : module_manager.module_net_sinks(module, net)) {
+        payload.write_uint(size_t(module_manager.net_sink_module(module, net, net_sink)));
+        payload.write_uint(module_manager.net_sink_instance(module, net, net_sink));
+        payload.write_uint(size_t(module_manager.net_sink_port(module, net, net_sink)));
+        payload.write_uint(module_manager.net_sink_pin(module, net, net_sink));
+      }
+    }
+  }
+}
+
+/********************************************************************
+ * Write a snapshot of the FPGA fabric built by 'build_fabric' to a binary file
+ * The header is written at last, when the size of payload is known
+ *
+ * Return 0 if successful
+ * Return 1 if there are critical errors
+ *******************************************************************/
+int write_fabric_snapshot_to_binary_file(const OpenfpgaContext& openfpga_ctx,
+                                         const DeviceContext& vpr_device_ctx,
+                                         const std::string& fname,
+                                         const bool& verbose) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output fabric snapshot!\n\tPlease specify a valid file name.\n");
+    return 1;
+  }
+
+  std::string timer_message = std::string("Write fabric snapshot to binary file '") + fname + std::string("'");
+
+  std::string dir_path = format_dir_path(find_path_dir_name(fname));
+
+  /* Create directories */
+  create_directory(dir_path);
+
+  /* Start time count */
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create the file stream with a large buffer */
+  std::vector<char> file_buffer(FABRIC_SNAPSHOT_FILE_BUFFER_SIZE);
+  std::fstream fp;
+  fp.rdbuf()->pubsetbuf(file_buffer.data(), file_buffer.size());
+  fp.open(fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  check_file_stream(fname.c_str(), fp);
+
+  /* Reserve the header */
+  std::vector<unsigned char> header(FABRIC_SNAPSHOT_HEADER_SIZE, 0);
+  fp.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+  bool compress_routing = openfpga_ctx.flow_manager().compress_routing();
+
+  FabricSnapshotPayloadWriter payload(fp);
+  write_fabric_snapshot_decoder_library(payload, openfpga_ctx.decoder_lib());
+  write_fabric_snapshot_io_location_map(payload, openfpga_ctx.io_location_map());
+  write_fabric_snapshot_device_rr_gsb(payload, openfpga_ctx.device_rr_gsb(), compress_routing);
+  write_fabric_snapshot_module_graph(payload, openfpga_ctx.module_graph());
+
+  size_t payload_size = size_t(fp.tellp()) - FABRIC_SNAPSHOT_HEADER_SIZE;
+
+  /* Fill the header */
+  std::copy(FABRIC_SNAPSHOT_MAGIC, FABRIC_SNAPSHOT_MAGIC + FABRIC_SNAPSHOT_MAGIC_SIZE, header.begin());
+  encode_fabric_snapshot_uint(FABRIC_SNAPSHOT_VERSION, 4, header.data() + FABRIC_SNAPSHOT_VERSION_OFFSET);
+  encode_fabric_snapshot_uint(compress_routing ? FABRIC_SNAPSHOT_COMPRESS_ROUTING_FLAG : 0, 4, header.data() + FABRIC_SNAPSHOT_FLAGS_OFFSET);
+  encode_fabric_snapshot_uint(vpr_device_ctx.grid.width(), 8, header.data() + FABRIC_SNAPSHOT_GRID_WIDTH_OFFSET);
+  encode_fabric_snapshot_uint(vpr_device_ctx.grid.height(), 8, header.data() + FABRIC_SNAPSHOT_GRID_HEIGHT_OFFSET);
+  encode_fabric_snapshot_uint(vpr_device_ctx.rr_graph.nodes().size(), 8, header.data() + FABRIC_SNAPSHOT_NUM_RR_NODES_OFFSET);
+  encode_fabric_snapshot_uint(vpr_device_ctx.rr_graph.edges().size(), 8, header.data() + FABRIC_SNAPSHOT_NUM_RR_EDGES_OFFSET);
+  encode_fabric_snapshot_uint(openfpga_ctx.arch().circuit_lib.num_models(), 8, header.data() + FABRIC_SNAPSHOT_NUM_CIRCUIT_MODELS_OFFSET);
+  encode_fabric_snapshot_uint(payload_size, 8, header.data() + FABRIC_SNAPSHOT_PAYLOAD_SIZE_OFFSET);
+  encode_fabric_snapshot_uint(payload.checksum(), 8, header.data() + FABRIC_SNAPSHOT_CHECKSUM_OFFSET);
+  encode_fabric_snapshot_uint(size_t(openfpga_ctx.arch().config_protocol.type()), 8, header.data() + FABRIC_SNAPSHOT_CONFIG_PROTOCOL_OFFSET);
+  encode_fabric_snapshot_uint(openfpga_ctx.arch().config_protocol.num_regions(), 8, header.data() + FABRIC_SNAPSHOT_NUM_CONFIG_REGIONS_OFFSET);
+  encode_fabric_snapshot_uint(find_fabric_snapshot_architecture_digest(vpr_device_ctx.arch->architecture_id,
+                                                                       openfpga_ctx.arch().architecture_id),
+                              8, header.data() + FABRIC_SNAPSHOT_ARCH_DIGEST_OFFSET);
+
+  fp.seekp(0);
+  fp.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+  if (false == valid_file_stream(fp)) {
+    VTR_LOG_ERROR("Failed to write fabric snapshot to file '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
+  fp.close();
+
+  VTR_LOGV(verbose,
+           "Wrote %lu modules and %lu decoders in %lu bytes\n",
+           openfpga_ctx.module_graph().num_modules(),
+           openfpga_ctx.decoder_lib().decoders().size(),
+           payload_size + FABRIC_SNAPSHOT_HEADER_SIZE);
+
+  return 0;
+}
+
+} /* end namespace openfpga */
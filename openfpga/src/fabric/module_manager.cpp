@@ -5,6 +5,7 @@
 #include <numeric>
 #include <algorithm>
 #include "vtr_assert.h"
+#include "vtr_hash.h"
 
 #include "circuit_library.h"
 #include "module_manager.h"
@@ -16,6 +17,32 @@ namespace openfpga {
  * Public Constructors
  ******************************************************************************/
 
+/******************************************************************************
+ * Hash functions for internal fast look-ups
+ ******************************************************************************/
+size_t ModuleManager::NetTerminalHash::operator()(const NetTerminal& terminal) const {
+  size_t seed = 0;
+  vtr::hash_combine(seed, terminal.first);
+  vtr::hash_combine(seed, terminal.second);
+  return seed;
+}
+
+size_t ModuleManager::NetTerminalPinHash::operator()(const NetTerminalPin& terminal_pin) const {
+  size_t seed = 0;
+  vtr::hash_combine(seed, std::get<0>(terminal_pin));
+  vtr::hash_combine(seed, std::get<1>(terminal_pin));
+  vtr::hash_combine(seed, std::get<2>(terminal_pin));
+  vtr::hash_combine(seed, std::get<3>(terminal_pin));
+  return seed;
+}
+
+size_t ModuleManager::ChildInstanceNameHash::operator()(const ChildInstanceName& instance_name) const {
+  size_t seed = 0;
+  vtr::hash_combine(seed, instance_name.first);
+  vtr::hash_combine(seed, instance_name.second);
+  return seed;
+}
+
 /**************************************************
  * Public Accessors : Aggregates
  *************************************************/
@@ -68,7 +95,7 @@ std::vector<size_t> ModuleManager::child_module_instances(const ModuleId& parent
 }
 
 /* Find all the configurable child modules under a parent module */
-std::vector<ModuleId> ModuleManager::configurable_children(const ModuleId& parent_module) const {
+const std::vector<ModuleId>& ModuleManager::configurable_children(const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
 
@@ -76,17 +103,30 @@ std::vector<ModuleId> ModuleManager::configurable_children(const ModuleId& paren
 }
 
 /* Find all the instances of configurable child modules under a parent module */
-std::vector<size_t> ModuleManager::configurable_child_instances(const ModuleId& parent_module) const {
+const std::vector<size_t>& ModuleManager::configurable_child_instances(const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
 
   return configurable_child_instances_[parent_module];
 }
 
+/* Find all the configuration regions under a parent module */
+ModuleManager::config_region_range ModuleManager::regions(const ModuleId& parent_module) const {
+  /* Validate the module_id */
+  VTR_ASSERT(valid_module_id(parent_module));
+
+  return vtr::make_range(config_region_ids_[parent_module].begin(), config_region_ids_[parent_module].end());
+}
+
 /* Find the source ids of modules */
 ModuleManager::module_net_src_range ModuleManager::module_net_sources(const ModuleId& module, const ModuleNetId& net) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_net_id(module, net));
+  if (true == nets_frozen_[module]) {
+    /* Source ids are always a sequence starting from 0, use the shared sequence */
+    size_t num_srcs = frozen_net_src_offsets_[module][size_t(net) + 1] - frozen_net_src_offsets_[module][size_t(net)];
+    return vtr::make_range(frozen_net_src_ids_.begin(), frozen_net_src_ids_.begin() + num_srcs);
+  }
   return vtr::make_range(net_src_ids_[module][net].begin(), net_src_ids_[module][net].end());
 }
 
@@ -94,6 +134,11 @@ ModuleManager::module_net_src_range ModuleManager::module_net_sources(const Modu
 ModuleManager::module_net_sink_range ModuleManager::module_net_sinks(const ModuleId& module, const ModuleNetId& net) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_net_id(module, net));
+  if (true == nets_frozen_[module]) {
+    /* Sink ids are always a sequence starting from 0, use the shared sequence */
+    size_t num_sinks = frozen_net_sink_offsets_[module][size_t(net) + 1] - frozen_net_sink_offsets_[module][size_t(net)];
+    return vtr::make_range(frozen_net_sink_ids_.begin(), frozen_net_sink_ids_.begin() + num_sinks);
+  }
   return vtr::make_range(net_sink_ids_[module][net].begin(), net_sink_ids_[module][net].end());
 }
 
@@ -112,6 +157,20 @@ size_t ModuleManager::num_nets(const ModuleId& module) const {
   return num_nets_[module];
 }
 
+/* Find the index of the first configurable child in a configuration region */
+size_t ModuleManager::region_first_configurable_child(const ModuleId& parent_module,
+                                                      const ConfigRegionId& region) const {
+  VTR_ASSERT(valid_region_id(parent_module, region));
+  return config_region_first_children_[parent_module][region];
+}
+
+/* Find the number of configurable children in a configuration region */
+size_t ModuleManager::region_num_configurable_children(const ModuleId& parent_module,
+                                                       const ConfigRegionId& region) const {
+  VTR_ASSERT(valid_region_id(parent_module, region));
+  return config_region_num_children_[parent_module][region];
+}
+
 /* Find the name of a module */
 std::string ModuleManager::module_name(const ModuleId& module_id) const {
   /* Validate the module_id */
@@ -171,12 +230,10 @@ ModulePortId ModuleManager::find_module_port(const ModuleId& module_id, const st
   /* Validate the module id */
   VTR_ASSERT(valid_module_id(module_id));
 
-  /* Iterate over the ports of the module */
-  for (const auto& port : port_ids_[module_id]) {
-    if (0 == port_name.compare(ports_[module_id][port].get_name())) {
-      /* Find it, return the id */
-      return port; 
-    }
+  auto result = port_name_lookup_[module_id].find(port_name);
+  if (result != port_name_lookup_[module_id].end()) {
+    /* Find it, return the id */
+    return result->second; 
   }
   /* Not found, return an invalid id */
   return ModulePortId::INVALID();
@@ -211,8 +268,8 @@ size_t ModuleManager::num_instance(const ModuleId& parent_module, const ModuleId
 }
 
 /* Find the instance name of a child module */
-std::string ModuleManager::instance_name(const ModuleId& parent_module, const ModuleId& child_module,
-                                         const size_t& instance_id) const {
+const std::string& ModuleManager::instance_name(const ModuleId& parent_module, const ModuleId& child_module,
+                                                const size_t& instance_id) const {
   /* Validate the id of both parent and child modules */
   VTR_ASSERT ( valid_module_id(parent_module) );
   VTR_ASSERT ( valid_module_id(child_module) );
@@ -236,6 +293,16 @@ size_t ModuleManager::instance_id(const ModuleId& parent_module, const ModuleId&
   size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
   VTR_ASSERT (child_index < children_[parent_module].size());
 
+  /* Named instances are indexed */
+  if (false == instance_name.empty()) {
+    auto result = instance_name_lookup_[parent_module].find(ChildInstanceName(child_module, instance_name));
+    if (result != instance_name_lookup_[parent_module].end()) {
+      return result->second;
+    }
+    /* Not found, return an invalid name */
+    return size_t(-1);
+  }
+
   /* Search the instance name list and try to find a match */
   for (size_t name_id = 0; name_id < child_instance_names_[parent_module][child_index].size(); ++name_id) {
     const std::string& name = child_instance_names_[parent_module][child_index][name_id];
@@ -269,6 +336,13 @@ std::string ModuleManager::port_preproc_flag(const ModuleId& module, const Modul
   return port_preproc_flags_[module][port];
 }
 
+/* Return the type of a port */
+ModuleManager::e_module_port_type ModuleManager::port_type(const ModuleId& module, const ModulePortId& port) const {
+  /* validate both module id and port id*/
+  VTR_ASSERT(valid_module_port_id(module, port));
+  return port_types_[module][port];
+}
+
 /* Find a net from an instance of a module */
 ModuleNetId ModuleManager::module_instance_port_net(const ModuleId& parent_module, 
                                                     const ModuleId& child_module, const size_t& child_instance,
@@ -292,8 +366,23 @@ ModuleNetId ModuleManager::module_instance_port_net(const ModuleId& parent_modul
 
   /* Validate child_pin */
   VTR_ASSERT(child_pin < module_port(child_module, child_port).get_width());
+
+  if (true == nets_frozen_[parent_module]) {
+    size_t child_index = 0;
+    if (child_module != parent_module) {
+      child_index = find_child_module_index_in_parent_module(parent_module, child_module) + 1;
+    }
+    size_t pin_index = frozen_child_pin_offsets_[parent_module][child_index]
+                     + child_instance * port_pin_offsets_[child_module].back()
+                     + port_pin_offsets_[child_module][size_t(child_port)]
+                     + child_pin;
+    return frozen_pin_nets_[parent_module][pin_index];
+  }
   
-  return net_lookup_[parent_module][child_module][child_instance][child_port][child_pin];
+  /* Use at() rather than operator[] on the maps, so that
+   * concurrent readers (e.g., netlist writers) never modify the look-up
+   */
+  return net_lookup_[parent_module].at(child_module)[child_instance].at(child_port)[child_pin];
 }
 
 /* Find the name of net */
@@ -310,6 +399,13 @@ vtr::vector<ModuleNetSrcId, ModuleId> ModuleManager::net_source_modules(const Mo
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSrcId, ModuleId> src_modules;
+  if (true == nets_frozen_[module]) {
+    for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
+      src_modules.push_back(net_source_module(module, net, net_src));
+    }
+    return src_modules;
+  }
+
   src_modules.reserve(net_src_terminal_ids_[module][net].size());
   for (const size_t& id : net_src_terminal_ids_[module][net]) {
     src_modules.push_back(net_terminal_storage_[id].first);
@@ -323,6 +419,14 @@ vtr::vector<ModuleNetSrcId, size_t> ModuleManager::net_source_instances(const Mo
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
+  if (true == nets_frozen_[module]) {
+    vtr::vector<ModuleNetSrcId, size_t> src_instances;
+    for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
+      src_instances.push_back(net_source_instance(module, net, net_src));
+    }
+    return src_instances;
+  }
+
   return net_src_instance_ids_[module][net];
 }
 
@@ -332,6 +436,13 @@ vtr::vector<ModuleNetSrcId, ModulePortId> ModuleManager::net_source_ports(const
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSrcId, ModulePortId> src_ports;
+  if (true == nets_frozen_[module]) {
+    for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
+      src_ports.push_back(net_source_port(module, net, net_src));
+    }
+    return src_ports;
+  }
+
   src_ports.reserve(net_src_terminal_ids_[module][net].size());
   for (const size_t& id : net_src_terminal_ids_[module][net]) {
     src_ports.push_back(net_terminal_storage_[id].second);
@@ -345,9 +456,53 @@ vtr::vector<ModuleNetSrcId, size_t> ModuleManager::net_source_pins(const ModuleI
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
+  if (true == nets_frozen_[module]) {
+    vtr::vector<ModuleNetSrcId, size_t> src_pins;
+    for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
+      src_pins.push_back(net_source_pin(module, net, net_src));
+    }
+    return src_pins;
+  }
+
   return net_src_pin_ids_[module][net];
 }
 
+/* Find the module of a given source of a net */
+ModuleId ModuleManager::net_source_module(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const {
+  if (true == nets_frozen_[module]) {
+    return frozen_net_srcs_[module][frozen_net_source_index(module, net, net_src)].module;
+  }
+  VTR_ASSERT(valid_module_net_id(module, net));
+  return net_terminal_storage_[net_src_terminal_ids_[module][net][net_src]].first;
+}
+
+/* Find the instance id of a given source of a net */
+size_t ModuleManager::net_source_instance(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const {
+  if (true == nets_frozen_[module]) {
+    return frozen_net_srcs_[module][frozen_net_source_index(module, net, net_src)].instance;
+  }
+  VTR_ASSERT(valid_module_net_id(module, net));
+  return net_src_instance_ids_[module][net][net_src];
+}
+
+/* Find the port of a given source of a net */
+ModulePortId ModuleManager::net_source_port(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const {
+  if (true == nets_frozen_[module]) {
+    return frozen_net_srcs_[module][frozen_net_source_index(module, net, net_src)].port;
+  }
+  VTR_ASSERT(valid_module_net_id(module, net));
+  return net_terminal_storage_[net_src_terminal_ids_[module][net][net_src]].second;
+}
+
+/* Find the pin index of a given source of a net */
+size_t ModuleManager::net_source_pin(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const {
+  if (true == nets_frozen_[module]) {
+    return frozen_net_srcs_[module][frozen_net_source_index(module, net, net_src)].pin;
+  }
+  VTR_ASSERT(valid_module_net_id(module, net));
+  return net_src_pin_ids_[module][net][net_src];
+}
+
 /* Identify if a pin of a port in a module already exists in the net source list*/
 bool ModuleManager::net_source_exist(const ModuleId& module, const ModuleNetId& net,
                                      const ModuleId& src_module, const size_t& instance_id,
@@ -355,21 +510,24 @@ bool ModuleManager::net_source_exist(const ModuleId& module, const ModuleNetId&
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  /* Iterate over each source of the net.
-   * If a net source has the same src_module, instance_id, src_port and src_pin,
-   * we can say that the source has already been added to this net!
-   */
-  for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
-    if ( (src_module == net_terminal_storage_[net_src_terminal_ids_[module][net][net_src]].first) 
-      && (instance_id == net_source_instances(module, net)[net_src])   
-      && (src_port == net_terminal_storage_[net_src_terminal_ids_[module][net][net_src]].second) 
-      && (src_pin == net_source_pins(module, net)[net_src]) ) {
-      return true;
-    }
+  /* Build the fast look-up if not yet */
+  if (false == net_terminal_pin_lookup_built_[module]) {
+    build_net_terminal_lookup(module);
   }
 
-  /* Reach here, it means nothing has been found. Return false */
-  return false;
+  /* If the pair of module and port has never been added to any net, it cannot be a source */
+  auto terminal_it = net_terminal_lookup_.find(NetTerminal(src_module, src_port));
+  if (terminal_it == net_terminal_lookup_.end()) {
+    return false;
+  }
+
+  /* if it has the same id as module, our instance id will be by default 0 */
+  size_t src_instance_id = (src_module == module) ? 0 : instance_id;
+
+  /* If a net source has the same src_module, instance_id, src_port and src_pin,
+   * we can say that the source has already been added to this net!
+   */
+  return 0 < net_src_terminal_pin_lookup_[module].count(NetTerminalPin(net, terminal_it->second, src_instance_id, src_pin));
 }
 
 /* Find the sink modules of a net */
@@ -378,6 +536,13 @@ vtr::vector<ModuleNetSinkId, ModuleId> ModuleManager::net_sink_modules(const Mod
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSinkId, ModuleId> sink_modules;
+  if (true == nets_frozen_[module]) {
+    for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
+      sink_modules.push_back(net_sink_module(module, net, net_sink));
+    }
+    return sink_modules;
+  }
+
   sink_modules.reserve(net_sink_terminal_ids_[module][net].size());
   for (const size_t& id : net_sink_terminal_ids_[module][net]) {
     sink_modules.push_back(net_terminal_storage_[id].first);
@@ -391,6 +556,14 @@ vtr::vector<ModuleNetSinkId, size_t> ModuleManager::net_sink_instances(const Mod
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
+  if (true == nets_frozen_[module]) {
+    vtr::vector<ModuleNetSinkId, size_t> sink_instances;
+    for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
+      sink_instances.push_back(net_sink_instance(module, net, net_sink));
+    }
+    return sink_instances;
+  }
+
   return net_sink_instance_ids_[module][net];
 }
 
@@ -400,6 +573,13 @@ vtr::vector<ModuleNetSinkId, ModulePortId> ModuleManager::net_sink_ports(const M
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSinkId, ModulePortId> sink_ports;
+  if (true == nets_frozen_[module]) {
+    for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
+      sink_ports.push_back(net_sink_port(module, net, net_sink));
+    }
+    return sink_ports;
+  }
+
   sink_ports.reserve(net_sink_terminal_ids_[module][net].size());
   for (const size_t& id : net_sink_terminal_ids_[module][net]) {
     sink_ports.push_back(net_terminal_storage_[id].second);
@@ -413,9 +593,53 @@ vtr::vector<ModuleNetSinkId, size_t> ModuleManager::net_sink_pins(const ModuleId
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
+  if (true == nets_frozen_[module]) {
+    vtr::vector<ModuleNetSinkId, size_t> sink_pins;
+    for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
+      sink_pins.push_back(net_sink_pin(module, net, net_sink));
+    }
+    return sink_pins;
+  }
+
   return net_sink_pin_ids_[module][net];
 }
 
+/* Find the module of a given sink of a net */
+ModuleId ModuleManager::net_sink_module(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const {
+  if (true == nets_frozen_[module]) {
+    return frozen_net_sinks_[module][frozen_net_sink_index(module, net, net_sink)].module;
+  }
+  VTR_ASSERT(valid_module_net_id(module, net));
+  return net_terminal_storage_[net_sink_terminal_ids_[module][net][net_sink]].first;
+}
+
+/* Find the instance id of a given sink of a net */
+size_t ModuleManager::net_sink_instance(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const {
+  if (true == nets_frozen_[module]) {
+    return frozen_net_sinks_[module][frozen_net_sink_index(module, net, net_sink)].instance;
+  }
+  VTR_ASSERT(valid_module_net_id(module, net));
+  return net_sink_instance_ids_[module][net][net_sink];
+}
+
+/* Find the port of a given sink of a net */
+ModulePortId ModuleManager::net_sink_port(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const {
+  if (true == nets_frozen_[module]) {
+    return frozen_net_sinks_[module][frozen_net_sink_index(module, net, net_sink)].port;
+  }
+  VTR_ASSERT(valid_module_net_id(module, net));
+  return net_terminal_storage_[net_sink_terminal_ids_[module][net][net_sink]].second;
+}
+
+/* Find the pin index of a given sink of a net */
+size_t ModuleManager::net_sink_pin(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const {
+  if (true == nets_frozen_[module]) {
+    return frozen_net_sinks_[module][frozen_net_sink_index(module, net, net_sink)].pin;
+  }
+  VTR_ASSERT(valid_module_net_id(module, net));
+  return net_sink_pin_ids_[module][net][net_sink];
+}
+
 /* Identify if a pin of a port in a module already exists in the net sink list*/
 bool ModuleManager::net_sink_exist(const ModuleId& module, const ModuleNetId& net,
                                      const ModuleId& sink_module, const size_t& instance_id,
@@ -423,21 +647,24 @@ bool ModuleManager::net_sink_exist(const ModuleId& module, const ModuleNetId& ne
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  /* Iterate over each sink of the net.
-   * If a net sink has the same sink_module, instance_id, sink_port and sink_pin,
-   * we can say that the sink has already been added to this net!
-   */
-  for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
-    if ( (sink_module == net_terminal_storage_[net_sink_terminal_ids_[module][net][net_sink]].first) 
-      && (instance_id == net_sink_instances(module, net)[net_sink])   
-      && (sink_port == net_terminal_storage_[net_sink_terminal_ids_[module][net][net_sink]].second) 
-      && (sink_pin == net_sink_pins(module, net)[net_sink]) ) {
-      return true;
-    }
+  /* Build the fast look-up if not yet */
+  if (false == net_terminal_pin_lookup_built_[module]) {
+    build_net_terminal_lookup(module);
   }
 
-  /* Reach here, it means nothing has been found. Return false */
-  return false;
+  /* If the pair of module and port has never been added to any net, it cannot be a sink */
+  auto terminal_it = net_terminal_lookup_.find(NetTerminal(sink_module, sink_port));
+  if (terminal_it == net_terminal_lookup_.end()) {
+    return false;
+  }
+
+  /* if it has the same id as module, our instance id will be by default 0 */
+  size_t sink_instance_id = (sink_module == module) ? 0 : instance_id;
+
+  /* If a net sink has the same sink_module, instance_id, sink_port and sink_pin,
+   * we can say that the sink has already been added to this net!
+   */
+  return 0 < net_sink_terminal_pin_lookup_[module].count(NetTerminalPin(net, terminal_it->second, sink_instance_id, sink_pin));
 }
 
 /******************************************************************************
@@ -448,16 +675,273 @@ size_t ModuleManager::find_child_module_index_in_parent_module(const ModuleId& p
   VTR_ASSERT(valid_module_id(parent_module));
   VTR_ASSERT(valid_module_id(child_module));
   /* Try to find the child_module in the children list of parent_module*/
-  for (size_t i = 0; i < children_[parent_module].size(); ++i) {
-    if (child_module == children_[parent_module][i]) {
-      /* Found, return the number of instances */
-      return i; 
-    }
+  auto result = child_index_lookup_[parent_module].find(child_module);
+  if (result != child_index_lookup_[parent_module].end()) {
+    /* Found, return the index */
+    return result->second; 
   }
   /* Not found: return an valid value */
   return size_t(-1);
 }
 
+/* Find the index of a source of a net in the frozen storage */
+size_t ModuleManager::frozen_net_source_index(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const {
+  VTR_ASSERT(valid_module_net_id(module, net));
+  VTR_ASSERT_SAFE(true == nets_frozen_[module]);
+  size_t index = frozen_net_src_offsets_[module][size_t(net)] + size_t(net_src);
+  VTR_ASSERT(index < frozen_net_src_offsets_[module][size_t(net) + 1]);
+  return index;
+}
+
+/* Find the index of a sink of a net in the frozen storage */
+size_t ModuleManager::frozen_net_sink_index(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const {
+  VTR_ASSERT(valid_module_net_id(module, net));
+  VTR_ASSERT_SAFE(true == nets_frozen_[module]);
+  size_t index = frozen_net_sink_offsets_[module][size_t(net)] + size_t(net_sink);
+  VTR_ASSERT(index < frozen_net_sink_offsets_[module][size_t(net) + 1]);
+  return index;
+}
+
+/******************************************************************************
+ * Private Mutators
+ ******************************************************************************/
+/* Find the index of a pair of module and port in the net terminal storage
+ * If not found, add the pair to the storage
+ */
+size_t ModuleManager::find_or_add_net_terminal(const ModuleId& terminal_module, const ModulePortId& terminal_port) {
+  NetTerminal terminal(terminal_module, terminal_port);
+  auto result = net_terminal_lookup_.insert(std::make_pair(terminal, net_terminal_storage_.size()));
+  if (true == result.second) {
+    /* A new pair, add it to the storage */
+    net_terminal_storage_.push_back(terminal);
+  }
+  return result.first->second;
+}
+
+/* Build the fast look-up on the terminal pins of all the nets in a module
+ * The look-up will be updated by add_module_net_source() and add_module_net_sink() afterwards
+ */
+void ModuleManager::build_net_terminal_lookup(const ModuleId& module) {
+  net_src_terminal_pin_lookup_[module].clear();
+  net_sink_terminal_pin_lookup_[module].clear();
+
+  for (size_t inet = 0; inet < num_nets_[module]; ++inet) {
+    ModuleNetId net = ModuleNetId(inet);
+    for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
+      size_t terminal_id = find_or_add_net_terminal(net_source_module(module, net, net_src),
+                                                    net_source_port(module, net, net_src));
+      net_src_terminal_pin_lookup_[module].insert(NetTerminalPin(net,
+                                                                 terminal_id,
+                                                                 net_source_instance(module, net, net_src),
+                                                                 net_source_pin(module, net, net_src)));
+    }
+    for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
+      size_t terminal_id = find_or_add_net_terminal(net_sink_module(module, net, net_sink),
+                                                    net_sink_port(module, net, net_sink));
+      net_sink_terminal_pin_lookup_[module].insert(NetTerminalPin(net,
+                                                                  terminal_id,
+                                                                  net_sink_instance(module, net, net_sink),
+                                                                  net_sink_pin(module, net, net_sink)));
+    }
+  }
+
+  net_terminal_pin_lookup_built_[module] = true;
+}
+
+/* Compact the nets of a module into the frozen storage
+ * Note that port_pin_offsets_ of the module and its children should be up-to-date
+ */
+void ModuleManager::freeze_nets(const ModuleId& module) {
+  VTR_ASSERT(valid_module_id(module));
+  if (true == nets_frozen_[module]) {
+    return;
+  }
+
+  /* Flatten the sources and sinks of nets */
+  frozen_net_src_offsets_[module].assign(1, 0);
+  frozen_net_src_offsets_[module].reserve(num_nets_[module] + 1);
+  frozen_net_sink_offsets_[module].assign(1, 0);
+  frozen_net_sink_offsets_[module].reserve(num_nets_[module] + 1);
+
+  size_t num_srcs = 0;
+  size_t num_sinks = 0;
+  for (size_t inet = 0; inet < num_nets_[module]; ++inet) {
+    num_srcs += net_src_ids_[module][ModuleNetId(inet)].size();
+    num_sinks += net_sink_ids_[module][ModuleNetId(inet)].size();
+  }
+  frozen_net_srcs_[module].clear();
+  frozen_net_srcs_[module].reserve(num_srcs);
+  frozen_net_sinks_[module].clear();
+  frozen_net_sinks_[module].reserve(num_sinks);
+
+  for (size_t inet = 0; inet < num_nets_[module]; ++inet) {
+    ModuleNetId net = ModuleNetId(inet);
+    for (const ModuleNetSrcId& net_src : net_src_ids_[module][net]) {
+      frozen_net_srcs_[module].push_back({net_source_module(module, net, net_src),
+                                          net_source_port(module, net, net_src),
+                                          net_source_instance(module, net, net_src),
+                                          net_source_pin(module, net, net_src)});
+    }
+    frozen_net_src_offsets_[module].push_back(frozen_net_srcs_[module].size());
+    if (net_src_ids_[module][net].size() > frozen_net_src_ids_.size()) {
+      for (size_t isrc = frozen_net_src_ids_.size(); isrc < net_src_ids_[module][net].size(); ++isrc) {
+        frozen_net_src_ids_.push_back(ModuleNetSrcId(isrc));
+      }
+    }
+
+    for (const ModuleNetSinkId& net_sink : net_sink_ids_[module][net]) {
+      frozen_net_sinks_[module].push_back({net_sink_module(module, net, net_sink),
+                                           net_sink_port(module, net, net_sink),
+                                           net_sink_instance(module, net, net_sink),
+                                           net_sink_pin(module, net, net_sink)});
+    }
+    frozen_net_sink_offsets_[module].push_back(frozen_net_sinks_[module].size());
+    if (net_sink_ids_[module][net].size() > frozen_net_sink_ids_.size()) {
+      for (size_t isink = frozen_net_sink_ids_.size(); isink < net_sink_ids_[module][net].size(); ++isink) {
+        frozen_net_sink_ids_.push_back(ModuleNetSinkId(isink));
+      }
+    }
+  }
+
+  /* Build the dense pin-to-net look-up: the module itself comes first and then the child modules */
+  frozen_child_pin_offsets_[module].clear();
+  frozen_child_pin_offsets_[module].reserve(children_[module].size() + 1);
+  size_t num_pins = port_pin_offsets_[module].back();
+  frozen_child_pin_offsets_[module].push_back(0);
+  for (size_t ichild = 0; ichild < children_[module].size(); ++ichild) {
+    frozen_child_pin_offsets_[module].push_back(num_pins);
+    num_pins += num_child_instances_[module][ichild] * port_pin_offsets_[children_[module][ichild]].back();
+  }
+  frozen_pin_nets_[module].assign(num_pins, ModuleNetId::INVALID());
+
+  for (const auto& child_lookup : net_lookup_[module]) {
+    const ModuleId& child_module = child_lookup.first;
+    size_t child_index = 0;
+    if (child_module != module) {
+      child_index = find_child_module_index_in_parent_module(module, child_module) + 1;
+    }
+    for (size_t instance = 0; instance < child_lookup.second.size(); ++instance) {
+      for (const auto& port_lookup : child_lookup.second[instance]) {
+        size_t port_pin_offset = frozen_child_pin_offsets_[module][child_index]
+                               + instance * port_pin_offsets_[child_module].back()
+                               + port_pin_offsets_[child_module][size_t(port_lookup.first)];
+        for (size_t pin = 0; pin < port_lookup.second.size(); ++pin) {
+          frozen_pin_nets_[module][port_pin_offset + pin] = port_lookup.second[pin];
+        }
+      }
+    }
+  }
+
+  /* Release the editable storage */
+  net_src_ids_[module].clear();
+  net_src_ids_[module].shrink_to_fit();
+  net_src_terminal_ids_[module].clear();
+  net_src_terminal_ids_[module].shrink_to_fit();
+  net_src_instance_ids_[module].clear();
+  net_src_instance_ids_[module].shrink_to_fit();
+  net_src_pin_ids_[module].clear();
+  net_src_pin_ids_[module].shrink_to_fit();
+  net_sink_ids_[module].clear();
+  net_sink_ids_[module].shrink_to_fit();
+  net_sink_terminal_ids_[module].clear();
+  net_sink_terminal_ids_[module].shrink_to_fit();
+  net_sink_instance_ids_[module].clear();
+  net_sink_instance_ids_[module].shrink_to_fit();
+  net_sink_pin_ids_[module].clear();
+  net_sink_pin_ids_[module].shrink_to_fit();
+  net_lookup_[module].clear();
+  std::unordered_set<NetTerminalPin, NetTerminalPinHash>().swap(net_src_terminal_pin_lookup_[module]);
+  std::unordered_set<NetTerminalPin, NetTerminalPinHash>().swap(net_sink_terminal_pin_lookup_[module]);
+  net_terminal_pin_lookup_built_[module] = false;
+
+  nets_frozen_[module] = true;
+}
+
+/* Restore the editable storage of nets from the frozen storage of a module
+ * This is required before any change on the nets of a frozen module
+ */
+void ModuleManager::thaw_nets(const ModuleId& module) {
+  VTR_ASSERT(valid_module_id(module));
+  if (false == nets_frozen_[module]) {
+    return;
+  }
+
+  /* Restore sources and sinks of nets */
+  net_src_ids_[module].resize(num_nets_[module]);
+  net_src_terminal_ids_[module].resize(num_nets_[module]);
+  net_src_instance_ids_[module].resize(num_nets_[module]);
+  net_src_pin_ids_[module].resize(num_nets_[module]);
+  net_sink_ids_[module].resize(num_nets_[module]);
+  net_sink_terminal_ids_[module].resize(num_nets_[module]);
+  net_sink_instance_ids_[module].resize(num_nets_[module]);
+  net_sink_pin_ids_[module].resize(num_nets_[module]);
+
+  for (size_t inet = 0; inet < num_nets_[module]; ++inet) {
+    ModuleNetId net = ModuleNetId(inet);
+    for (size_t isrc = frozen_net_src_offsets_[module][inet]; isrc < frozen_net_src_offsets_[module][inet + 1]; ++isrc) {
+      const FrozenNetTerminal& terminal = frozen_net_srcs_[module][isrc];
+      net_src_ids_[module][net].push_back(ModuleNetSrcId(net_src_ids_[module][net].size()));
+      net_src_terminal_ids_[module][net].push_back(find_or_add_net_terminal(terminal.module, terminal.port));
+      net_src_instance_ids_[module][net].push_back(terminal.instance);
+      net_src_pin_ids_[module][net].push_back(terminal.pin);
+    }
+    for (size_t isink = frozen_net_sink_offsets_[module][inet]; isink < frozen_net_sink_offsets_[module][inet + 1]; ++isink) {
+      const FrozenNetTerminal& terminal = frozen_net_sinks_[module][isink];
+      net_sink_ids_[module][net].push_back(ModuleNetSinkId(net_sink_ids_[module][net].size()));
+      net_sink_terminal_ids_[module][net].push_back(find_or_add_net_terminal(terminal.module, terminal.port));
+      net_sink_instance_ids_[module][net].push_back(terminal.instance);
+      net_sink_pin_ids_[module][net].push_back(terminal.pin);
+    }
+  }
+
+  /* Restore the fast look-up for nets */
+  net_lookup_[module].clear();
+  net_lookup_[module][module].emplace_back();
+  for (const ModulePortId& port : port_ids_[module]) {
+    net_lookup_[module][module][0][port].resize(ports_[module][port].get_width(), ModuleNetId::INVALID());
+    for (size_t pin = 0; pin < ports_[module][port].get_width(); ++pin) {
+      net_lookup_[module][module][0][port][pin] = frozen_pin_nets_[module][port_pin_offsets_[module][size_t(port)] + pin];
+    }
+  }
+  for (size_t ichild = 0; ichild < children_[module].size(); ++ichild) {
+    const ModuleId& child_module = children_[module][ichild];
+    size_t num_child_pins = port_pin_offsets_[child_module].back();
+    net_lookup_[module][child_module].resize(num_child_instances_[module][ichild]);
+    for (size_t instance = 0; instance < num_child_instances_[module][ichild]; ++instance) {
+      for (const ModulePortId& child_port : port_ids_[child_module]) {
+        size_t port_pin_offset = frozen_child_pin_offsets_[module][ichild + 1]
+                               + instance * num_child_pins
+                               + port_pin_offsets_[child_module][size_t(child_port)];
+        net_lookup_[module][child_module][instance][child_port].resize(ports_[child_module][child_port].get_width(), ModuleNetId::INVALID());
+        for (size_t pin = 0; pin < ports_[child_module][child_port].get_width(); ++pin) {
+          net_lookup_[module][child_module][instance][child_port][pin] = frozen_pin_nets_[module][port_pin_offset + pin];
+        }
+      }
+    }
+  }
+
+  /* Release the frozen storage */
+  std::vector<size_t>().swap(frozen_net_src_offsets_[module]);
+  std::vector<FrozenNetTerminal>().swap(frozen_net_srcs_[module]);
+  std::vector<size_t>().swap(frozen_net_sink_offsets_[module]);
+  std::vector<FrozenNetTerminal>().swap(frozen_net_sinks_[module]);
+  std::vector<size_t>().swap(frozen_child_pin_offsets_[module]);
+  std::vector<ModuleNetId>().swap(frozen_pin_nets_[module]);
+
+  nets_frozen_[module] = false;
+}
+
+/* Index the ports of a module by names,
+ * where a name used by multiple ports is mapped to the first one
+ */
+void ModuleManager::build_port_name_lookup(const ModuleId& module) {
+  port_name_lookup_[module].clear();
+  port_name_lookup_[module].reserve(port_ids_[module].size());
+  for (const ModulePortId& port : port_ids_[module]) {
+    port_name_lookup_[module].emplace(ports_[module][port].get_name(), port);
+  }
+}
+
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
@@ -480,8 +964,13 @@ ModuleId ModuleManager::add_module(const std::string& name) {
   children_.emplace_back();
   num_child_instances_.emplace_back();
   child_instance_names_.emplace_back();
+  child_index_lookup_.emplace_back();
+  instance_name_lookup_.emplace_back();
   configurable_children_.emplace_back();
   configurable_child_instances_.emplace_back();
+  config_region_ids_.emplace_back();
+  config_region_first_children_.emplace_back();
+  config_region_num_children_.emplace_back();
 
   port_ids_.emplace_back();
   ports_.emplace_back();
@@ -489,6 +978,7 @@ ModuleId ModuleManager::add_module(const std::string& name) {
   port_is_wire_.emplace_back();
   port_is_register_.emplace_back();
   port_preproc_flags_.emplace_back();
+  port_name_lookup_.emplace_back();
 
   num_nets_.emplace_back(0);
   invalid_net_ids_.emplace_back();
@@ -503,6 +993,19 @@ ModuleId ModuleManager::add_module(const std::string& name) {
   net_sink_instance_ids_.emplace_back();
   net_sink_pin_ids_.emplace_back();
 
+  net_terminal_pin_lookup_built_.push_back(false);
+  net_src_terminal_pin_lookup_.emplace_back();
+  net_sink_terminal_pin_lookup_.emplace_back();
+
+  nets_frozen_.push_back(false);
+  frozen_net_src_offsets_.emplace_back();
+  frozen_net_srcs_.emplace_back();
+  frozen_net_sink_offsets_.emplace_back();
+  frozen_net_sinks_.emplace_back();
+  frozen_child_pin_offsets_.emplace_back();
+  frozen_pin_nets_.emplace_back();
+  port_pin_offsets_.emplace_back();
+
   /* Register in the name-to-id map */
   name_id_map_[name] = module;
 
@@ -525,6 +1028,12 @@ ModulePortId ModuleManager::add_port(const ModuleId& module,
   /* Validate the id of module */
   VTR_ASSERT( valid_module_id(module) );
 
+  /* The dense pin look-up of frozen modules depends on the ports of the module, restore them */
+  thaw_nets(module);
+  for (const ModuleId& parent : parents_[module]) {
+    thaw_nets(parent);
+  }
+
   /* Add port and fill port attributes */
   ModulePortId port = ModulePortId(port_ids_[module].size());
   port_ids_[module].push_back(port);
@@ -536,6 +1045,8 @@ ModulePortId ModuleManager::add_port(const ModuleId& module,
 
   /* Update fast look-up for port */
   port_lookup_[module][port_type].push_back(port);
+  /* A port in an existing name is not indexed, as the first one is found by name */
+  port_name_lookup_[module].emplace(port_info.get_name(), port);
 
   /* Update fast look-up for nets */
   VTR_ASSERT_SAFE(1 == net_lookup_[module][module].size());
@@ -551,6 +1062,9 @@ void ModuleManager::set_module_port_name(const ModuleId& module, const ModulePor
   VTR_ASSERT( valid_module_port_id(module, module_port) );
   
   ports_[module][module_port].set_name(port_name);
+
+  /* Other ports may share the old or new name, rebuild the look-up of the module */
+  build_port_name_lookup(module);
 }
 
 /* Set a name for a module */
@@ -597,6 +1111,9 @@ void ModuleManager::add_child_module(const ModuleId& parent_module, const Module
   VTR_ASSERT ( valid_module_id(parent_module) );
   VTR_ASSERT ( valid_module_id(child_module) );
 
+  /* Changes on nets are only applicable to editable storage */
+  thaw_nets(parent_module);
+
   /* Try to find if the parent module is already in the list */
   std::vector<ModuleId>::iterator parent_it = std::find(parents_[child_module].begin(), parents_[child_module].end(), parent_module);
   if (parent_it == parents_[child_module].end()) {
@@ -607,6 +1124,7 @@ void ModuleManager::add_child_module(const ModuleId& parent_module, const Module
   std::vector<ModuleId>::iterator child_it = std::find(children_[parent_module].begin(), children_[parent_module].end(), child_module);
   if (child_it == children_[parent_module].end()) {
     /* Update the child module of parent module */
+    child_index_lookup_[parent_module][child_module] = children_[parent_module].size();
     children_[parent_module].push_back(child_module);
     num_child_instances_[parent_module].push_back(1); /* By default give one */
     /* Update the instance name list */
@@ -641,8 +1159,32 @@ void ModuleManager::set_child_instance_name(const ModuleId& parent_module,
   size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
   /* We must find something! */
   VTR_ASSERT(size_t(-1) != child_index);
-  /* Set the name */
-  child_instance_names_[parent_module][child_index][instance_id] = instance_name;
+  std::vector<std::string>& instance_names = child_instance_names_[parent_module][child_index];
+
+  /* Remove the old name from the look-up, which may be taken over by another instance in the same name */
+  const std::string old_name = instance_names[instance_id];
+  instance_names[instance_id] = instance_name;
+  if (false == old_name.empty()) {
+    auto result = instance_name_lookup_[parent_module].find(ChildInstanceName(child_module, old_name));
+    if ( (result != instance_name_lookup_[parent_module].end())
+      && (instance_id == result->second) ) {
+      instance_name_lookup_[parent_module].erase(result);
+      for (size_t name_id = instance_id + 1; name_id < instance_names.size(); ++name_id) {
+        if (old_name == instance_names[name_id]) {
+          instance_name_lookup_[parent_module][ChildInstanceName(child_module, old_name)] = name_id;
+          break;
+        }
+      }
+    }
+  }
+
+  /* Index the new name, which refers to the first instance in the name */
+  if (false == instance_name.empty()) {
+    auto result = instance_name_lookup_[parent_module].emplace(ChildInstanceName(child_module, instance_name), instance_id);
+    if (instance_id < result.first->second) {
+      result.first->second = instance_id;
+    }
+  }
 }
 
 /* Add a configurable child module to module
@@ -675,11 +1217,39 @@ void ModuleManager::reserve_configurable_child(const ModuleId& parent_module,
   }
 }
 
+/* Add a configuration region to a module
+ * The region starts from the configurable child next to the last region,
+ * so that the regions are always contiguous and ordered
+ */
+ConfigRegionId ModuleManager::add_config_region(const ModuleId& parent_module,
+                                                const size_t& num_children) {
+  VTR_ASSERT ( valid_module_id(parent_module) );
+
+  size_t first_child = 0;
+  if (0 < config_region_ids_[parent_module].size()) {
+    ConfigRegionId last_region = config_region_ids_[parent_module].back();
+    first_child = config_region_first_children_[parent_module][last_region]
+                + config_region_num_children_[parent_module][last_region];
+  }
+  /* The region must be covered by the configurable children */
+  VTR_ASSERT ( first_child + num_children <= configurable_children_[parent_module].size() );
+
+  ConfigRegionId region = ConfigRegionId(config_region_ids_[parent_module].size());
+  config_region_ids_[parent_module].push_back(region);
+  config_region_first_children_[parent_module].push_back(first_child);
+  config_region_num_children_[parent_module].push_back(num_children);
+
+  return region;
+}
+
 void ModuleManager::reserve_module_nets(const ModuleId& module,
                                         const size_t& num_nets) {
   /* Validate the module id */
   VTR_ASSERT ( valid_module_id(module) );
 
+  /* Changes on nets are only applicable to editable storage */
+  thaw_nets(module);
+
   net_names_[module].reserve(num_nets);
   net_src_ids_[module].reserve(num_nets);
   net_src_terminal_ids_[module].reserve(num_nets);
@@ -697,6 +1267,9 @@ ModuleNetId ModuleManager::create_module_net(const ModuleId& module) {
   /* Validate the module id */
   VTR_ASSERT ( valid_module_id(module) );
 
+  /* Changes on nets are only applicable to editable storage */
+  thaw_nets(module);
+
   /* Create an new id */
   ModuleNetId net = ModuleNetId(num_nets_[module]);
   num_nets_[module]++;
@@ -736,6 +1309,9 @@ void ModuleManager::reserve_module_net_sources(const ModuleId& module, const Mod
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
+  /* Changes on nets are only applicable to editable storage */
+  thaw_nets(module);
+
   net_src_ids_[module][net].reserve(num_sources);
   net_src_terminal_ids_[module][net].reserve(num_sources);
   net_src_instance_ids_[module][net].reserve(num_sources);
@@ -749,6 +1325,9 @@ ModuleNetSrcId ModuleManager::add_module_net_source(const ModuleId& module, cons
   /* Validate the module and net id */
   VTR_ASSERT(valid_module_net_id(module, net));
 
+  /* Changes on nets are only applicable to editable storage */
+  thaw_nets(module);
+
   /* Create a new id for src node */
   ModuleNetSrcId net_src = ModuleNetSrcId(net_src_ids_[module][net].size());
   net_src_ids_[module][net].push_back(net_src);
@@ -763,17 +1342,8 @@ ModuleNetSrcId ModuleManager::add_module_net_source(const ModuleId& module, cons
    * Search in the storage. If found, use the existing pair
    * Otherwise, add the pair
    */
-  std::pair<ModuleId, ModulePortId> terminal(src_module, src_port);
-  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it = std::find(net_terminal_storage_.begin(),
-                                                                          net_terminal_storage_.end(),
-                                                                          terminal);
-  if (it == net_terminal_storage_.end()) {
-    net_src_terminal_ids_[module][net].push_back(net_terminal_storage_.size());
-    net_terminal_storage_.push_back(terminal);
-  } else {
-   VTR_ASSERT_SAFE(it != net_terminal_storage_.end());
-   net_src_terminal_ids_[module][net].push_back(std::distance(net_terminal_storage_.begin(), it));
-  }
+  size_t terminal_id = find_or_add_net_terminal(src_module, src_port);
+  net_src_terminal_ids_[module][net].push_back(terminal_id);
 
   /* if it has the same id as module, our instance id will be by default 0 */
   size_t src_instance_id = instance_id;
@@ -793,6 +1363,11 @@ ModuleNetSrcId ModuleManager::add_module_net_source(const ModuleId& module, cons
   /* Update fast look-up for nets */
   net_lookup_[module][src_module][src_instance_id][src_port][src_pin] = net;
 
+  /* Update fast look-up for net terminal pins if it has been built */
+  if (true == net_terminal_pin_lookup_built_[module]) {
+    net_src_terminal_pin_lookup_[module].insert(NetTerminalPin(net, terminal_id, src_instance_id, src_pin));
+  }
+
   return net_src;
 }
 
@@ -801,6 +1376,9 @@ void ModuleManager::reserve_module_net_sinks(const ModuleId& module, const Modul
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
+  /* Changes on nets are only applicable to editable storage */
+  thaw_nets(module);
+
   net_sink_ids_[module][net].reserve(num_sinks);
   net_sink_terminal_ids_[module][net].reserve(num_sinks);
   net_sink_instance_ids_[module][net].reserve(num_sinks);
@@ -814,6 +1392,9 @@ ModuleNetSinkId ModuleManager::add_module_net_sink(const ModuleId& module, const
   /* Validate the module and net id */
   VTR_ASSERT(valid_module_net_id(module, net));
 
+  /* Changes on nets are only applicable to editable storage */
+  thaw_nets(module);
+
   /* Create a new id for sink node */
   ModuleNetSinkId net_sink = ModuleNetSinkId(net_sink_ids_[module][net].size());
   net_sink_ids_[module][net].push_back(net_sink);
@@ -828,17 +1409,8 @@ ModuleNetSinkId ModuleManager::add_module_net_sink(const ModuleId& module, const
    * Search in the storage. If found, use the existing pair
    * Otherwise, add the pair
    */
-  std::pair<ModuleId, ModulePortId> terminal(sink_module, sink_port);
-  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it = std::find(net_terminal_storage_.begin(),
-                                                                          net_terminal_storage_.end(),
-                                                                          terminal);
-  if (it == net_terminal_storage_.end()) {
-    net_sink_terminal_ids_[module][net].push_back(net_terminal_storage_.size());
-    net_terminal_storage_.push_back(terminal);
-  } else {
-   VTR_ASSERT_SAFE(it != net_terminal_storage_.end());
-   net_sink_terminal_ids_[module][net].push_back(std::distance(net_terminal_storage_.begin(), it));
-  }
+  size_t terminal_id = find_or_add_net_terminal(sink_module, sink_port);
+  net_sink_terminal_ids_[module][net].push_back(terminal_id);
 
   /* if it has the same id as module, our instance id will be by default 0 */
   size_t sink_instance_id = instance_id;
@@ -858,9 +1430,31 @@ ModuleNetSinkId ModuleManager::add_module_net_sink(const ModuleId& module, const
   /* Update fast look-up for nets */
   net_lookup_[module][sink_module][sink_instance_id][sink_port][sink_pin] = net;
 
+  /* Update fast look-up for net terminal pins if it has been built */
+  if (true == net_terminal_pin_lookup_built_[module]) {
+    net_sink_terminal_pin_lookup_[module].insert(NetTerminalPin(net, terminal_id, sink_instance_id, sink_pin));
+  }
+
   return net_sink;
 }
 
+/* Compact the nets of all the modules into flat arrays */
+void ModuleManager::freeze_module_nets() {
+  /* Index the pins of each module, which is required by the dense pin look-up */
+  for (const ModuleId& module : ids_) {
+    port_pin_offsets_[module].clear();
+    port_pin_offsets_[module].reserve(port_ids_[module].size() + 1);
+    port_pin_offsets_[module].push_back(0);
+    for (const ModulePortId& port : port_ids_[module]) {
+      port_pin_offsets_[module].push_back(port_pin_offsets_[module].back() + ports_[module][port].get_width());
+    }
+  }
+
+  for (const ModuleId& module : ids_) {
+    freeze_nets(module);
+  }
+}
+
 /******************************************************************************
  * Public Deconstructor
  ******************************************************************************/
@@ -869,6 +1463,10 @@ void ModuleManager::clear_configurable_children(const ModuleId& parent_module) {
 
   configurable_children_[parent_module].clear();
   configurable_child_instances_[parent_module].clear();
+
+  config_region_ids_[parent_module].clear();
+  config_region_first_children_[parent_module].clear();
+  config_region_num_children_[parent_module].clear();
 }
 
 /******************************************************************************
@@ -892,6 +1490,13 @@ bool ModuleManager::valid_module_net_id(const ModuleId& module, const ModuleNetI
   return ( size_t(net) < num_nets_[module] ); 
 }
 
+bool ModuleManager::valid_region_id(const ModuleId& module, const ConfigRegionId& region) const {
+  if (false == valid_module_id(module)) {
+    return false;
+  }
+  return ( size_t(region) < config_region_ids_[module].size() ) && ( region == config_region_ids_[module][region] ); 
+}
+
 bool ModuleManager::valid_module_instance_id(const ModuleId& parent_module,
                                              const ModuleId& child_module,
                                              const size_t& instance_id) const {
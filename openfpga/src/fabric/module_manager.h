@@ -124,12 +124,14 @@ class ModuleManager {
     typedef lazy_id_iterator<ModuleNetId> module_net_iterator;
     typedef vtr::vector<ModuleNetSrcId, ModuleNetSrcId>::const_iterator module_net_src_iterator;
     typedef vtr::vector<ModuleNetSinkId, ModuleNetSinkId>::const_iterator module_net_sink_iterator;
+    typedef vtr::vector<ConfigRegionId, ConfigRegionId>::const_iterator config_region_iterator;
 
     typedef vtr::Range<module_iterator> module_range;
     typedef vtr::Range<module_port_iterator> module_port_range;
     typedef vtr::Range<module_net_iterator> module_net_range;
     typedef vtr::Range<module_net_src_iterator> module_net_src_range;
     typedef vtr::Range<module_net_sink_iterator> module_net_sink_range;
+    typedef vtr::Range<config_region_iterator> config_region_range;
 
   public: /* Public aggregators */
     /* Find all the modules */
@@ -143,9 +145,11 @@ class ModuleManager {
     /* Find all the instances under a parent module */
     std::vector<size_t> child_module_instances(const ModuleId& parent_module, const ModuleId& child_module) const;
     /* Find all the configurable child modules under a parent module */
-    std::vector<ModuleId> configurable_children(const ModuleId& parent_module) const;
+    const std::vector<ModuleId>& configurable_children(const ModuleId& parent_module) const;
     /* Find all the instances of configurable child modules under a parent module */
-    std::vector<size_t> configurable_child_instances(const ModuleId& parent_module) const;
+    const std::vector<size_t>& configurable_child_instances(const ModuleId& parent_module) const;
+    /* Find all the configuration regions under a parent module */
+    config_region_range regions(const ModuleId& parent_module) const;
     /* Find the source ids of modules */
     module_net_src_range module_net_sources(const ModuleId& module, const ModuleNetId& net) const;
     /* Find the sink ids of modules */
@@ -154,6 +158,10 @@ class ModuleManager {
   public: /* Public accessors */
     size_t num_modules() const;
     size_t num_nets(const ModuleId& module) const;
+    /* Find the index of the first configurable child in a configuration region */
+    size_t region_first_configurable_child(const ModuleId& parent_module, const ConfigRegionId& region) const;
+    /* Find the number of configurable children in a configuration region */
+    size_t region_num_configurable_children(const ModuleId& parent_module, const ConfigRegionId& region) const;
     std::string module_name(const ModuleId& module_id) const;
     e_module_usage_type module_usage(const ModuleId& module_id) const;
     std::string module_port_type_str(const enum e_module_port_type& port_type) const;
@@ -168,8 +176,8 @@ class ModuleManager {
     /* Find the number of instances of a child module in the parent module */
     size_t num_instance(const ModuleId& parent_module, const ModuleId& child_module) const;
     /* Find the instance name of a child module */
-    std::string instance_name(const ModuleId& parent_module, const ModuleId& child_module,
-                              const size_t& instance_id) const;
+    const std::string& instance_name(const ModuleId& parent_module, const ModuleId& child_module,
+                                     const size_t& instance_id) const;
     /* Find the instance id of a given instance name */
     size_t instance_id(const ModuleId& parent_module, const ModuleId& child_module,
                        const std::string& instance_name) const;
@@ -179,6 +187,8 @@ class ModuleManager {
     bool port_is_register(const ModuleId& module, const ModulePortId& port) const;
     /* Return the pre-processing flag of a port */
     std::string port_preproc_flag(const ModuleId& module, const ModulePortId& port) const;
+    /* Return the type of a port */
+    e_module_port_type port_type(const ModuleId& module, const ModulePortId& port) const;
     /* Find a net from an instance of a module */
     ModuleNetId module_instance_port_net(const ModuleId& parent_module, 
                                          const ModuleId& child_module, const size_t& child_instance,
@@ -193,6 +203,14 @@ class ModuleManager {
     vtr::vector<ModuleNetSrcId, ModulePortId> net_source_ports(const ModuleId& module, const ModuleNetId& net) const;
     /* Find the source pin indices of a net */
     vtr::vector<ModuleNetSrcId, size_t> net_source_pins(const ModuleId& module, const ModuleNetId& net) const;
+    /* Find the source module/instance/port/pin of a given source of a net
+     * These are preferred over the net_source_xxx() functions returning vectors in loops,
+     * as they do not create any temporary vector
+     */
+    ModuleId net_source_module(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
+    size_t net_source_instance(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
+    ModulePortId net_source_port(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
+    size_t net_source_pin(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
     /* Identify if a pin of a port in a module already exists in the net source list*/
     bool net_source_exist(const ModuleId& module, const ModuleNetId& net,
                           const ModuleId& src_module, const size_t& instance_id,
@@ -206,6 +224,11 @@ class ModuleManager {
     vtr::vector<ModuleNetSinkId, ModulePortId> net_sink_ports(const ModuleId& module, const ModuleNetId& net) const;
     /* Find the sink pin indices of a net */
     vtr::vector<ModuleNetSinkId, size_t> net_sink_pins(const ModuleId& module, const ModuleNetId& net) const;
+    /* Find the sink module/instance/port/pin of a given sink of a net */
+    ModuleId net_sink_module(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
+    size_t net_sink_instance(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
+    ModulePortId net_sink_port(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
+    size_t net_sink_pin(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
     /* Identify if a pin of a port in a module already exists in the net sink list*/
     bool net_sink_exist(const ModuleId& module, const ModuleNetId& net,
                         const ModuleId& sink_module, const size_t& instance_id,
@@ -213,6 +236,19 @@ class ModuleManager {
 
   private: /* Private accessors */
     size_t find_child_module_index_in_parent_module(const ModuleId& parent_module, const ModuleId& child_module) const;
+    /* Find the index of a net terminal in the frozen storage of a module */
+    size_t frozen_net_source_index(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
+    size_t frozen_net_sink_index(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
+  private: /* Private mutators */
+    /* Find the index of a pair of module and port in the net terminal storage, add it if not found */
+    size_t find_or_add_net_terminal(const ModuleId& terminal_module, const ModulePortId& terminal_port);
+    /* Build the fast look-ups on the sources and sinks of all the nets in a module */
+    void build_net_terminal_lookup(const ModuleId& module);
+    void build_port_name_lookup(const ModuleId& module);
+    /* Compact the nets of a module into the frozen storage and release the editable storage */
+    void freeze_nets(const ModuleId& module);
+    /* Restore the editable storage of nets from the frozen storage of a module */
+    void thaw_nets(const ModuleId& module);
   public: /* Public mutators */
     /* Add a module */
     ModuleId add_module(const std::string& name);
@@ -241,6 +277,10 @@ class ModuleManager {
      * for memory efficiency
      */
     void reserve_configurable_child(const ModuleId& module, const size_t& num_children);
+    /* Add a configuration region to a module, which includes
+     * a number of configurable children following the last region
+     */
+    ConfigRegionId add_config_region(const ModuleId& module, const size_t& num_children);
 
     /* Reserved a number of module nets for a given module
      * for memory efficiency
@@ -274,9 +314,17 @@ class ModuleManager {
     ModuleNetSinkId add_module_net_sink(const ModuleId& module, const ModuleNetId& net,
                                         const ModuleId& sink_module, const size_t& instance_id,
                                         const ModulePortId& sink_port, const size_t& sink_pin);
+
+    /* Compact the nets of all the modules into flat arrays, which are
+     * much faster and lighter for the read-only accessors.
+     * This should be called once the module graph is built, e.g., by build_fabric.
+     * Any mutator on nets/ports/children of a frozen module is still allowed
+     * but it will restore the editable storage of the module at a runtime cost
+     */
+    void freeze_module_nets();
   public: /* Public deconstructors */
     /* This is a strong function which will remove all the configurable children 
-     * under a given parent module
+     * as well as the configuration regions under a given parent module
      * It is mainly used by loading fabric keys
      * Do NOT use unless you know what you are doing!!!
      */
@@ -285,6 +333,7 @@ class ModuleManager {
     bool valid_module_id(const ModuleId& module) const;
     bool valid_module_port_id(const ModuleId& module, const ModulePortId& port) const;
     bool valid_module_net_id(const ModuleId& module, const ModuleNetId& net) const;
+    bool valid_region_id(const ModuleId& module, const ConfigRegionId& region) const;
     bool valid_module_instance_id(const ModuleId& parent_module,
                                   const ModuleId& child_module,
                                   const size_t& instance_id) const;
@@ -292,6 +341,29 @@ class ModuleManager {
     void invalidate_name2id_map();
     void invalidate_port_lookup();
     void invalidate_net_lookup();
+  private: /* Internal data types */
+    /* A pair of a module and a port, which is the terminal of a net */
+    typedef std::pair<ModuleId, ModulePortId> NetTerminal;
+    struct NetTerminalHash {
+      size_t operator()(const NetTerminal& terminal) const;
+    };
+    /* A pin of a net terminal: [net_id][net_terminal_storage_id][instance_id][pin_id] */
+    typedef std::tuple<ModuleNetId, size_t, size_t, size_t> NetTerminalPin;
+    struct NetTerminalPinHash {
+      size_t operator()(const NetTerminalPin& terminal_pin) const;
+    };
+    /* An instance name of a child module in a parent module */
+    typedef std::pair<ModuleId, std::string> ChildInstanceName;
+    struct ChildInstanceNameHash {
+      size_t operator()(const ChildInstanceName& instance_name) const;
+    };
+    /* A terminal pin of a net in the frozen storage */
+    struct FrozenNetTerminal {
+      ModuleId module;
+      ModulePortId port;
+      size_t instance;
+      size_t pin;
+    };
   private: /* Internal data */
     /* Module-level data */
     vtr::vector<ModuleId, ModuleId> ids_;                                  /* Unique identifier for each Module */
@@ -311,6 +383,13 @@ class ModuleManager {
     vtr::vector<ModuleId, std::vector<ModuleId>> configurable_children_;                /* Child modules with configurable memory bits that this module contain */
     vtr::vector<ModuleId, std::vector<size_t>> configurable_child_instances_;           /* Instances of child modules with configurable memory bits that this module contain */
 
+    /* Configuration regions split the configurable children into contiguous groups,
+     * each of which is configured through its own ports, in parallel to the others
+     */
+    vtr::vector<ModuleId, vtr::vector<ConfigRegionId, ConfigRegionId>> config_region_ids_;
+    vtr::vector<ModuleId, vtr::vector<ConfigRegionId, size_t>> config_region_first_children_; /* Index of the first configurable child in each region */
+    vtr::vector<ModuleId, vtr::vector<ConfigRegionId, size_t>> config_region_num_children_;   /* Number of configurable children in each region */
+
     /* Port-level data */
     vtr::vector<ModuleId, vtr::vector<ModulePortId, ModulePortId>> port_ids_;    /* List of ports for each Module */ 
     vtr::vector<ModuleId, vtr::vector<ModulePortId, BasicPort>> ports_;    /* List of ports for each Module */ 
@@ -344,6 +423,17 @@ class ModuleManager {
     /* fast look-up for ports */
     typedef vtr::vector<ModuleId, std::vector<std::vector<ModulePortId>>> PortLookup;
     mutable PortLookup port_lookup_; /* [module_ids][port_types][port_ids] */ 
+    /* fast look-up for ports by names: [module_id][port_name] -> the first port in the name */
+    vtr::vector<ModuleId, std::unordered_map<std::string, ModulePortId>> port_name_lookup_;
+
+    /* fast look-up for child modules: [parent_module][child_module] -> index in children_ */
+    vtr::vector<ModuleId, std::unordered_map<ModuleId, size_t>> child_index_lookup_;
+    /* fast look-up for instances by names: [parent_module][(child_module, instance_name)] -> the first instance in the name
+     * Instances without names are not indexed
+     * The look-ups are kept up-to-date by the mutators rather than built in the accessors,
+     * so that a module graph can be queried by multiple threads
+     */
+    vtr::vector<ModuleId, std::unordered_map<ChildInstanceName, size_t, ChildInstanceNameHash>> instance_name_lookup_;
 
     /* fast look-up for nets */
     typedef vtr::vector<ModuleId, std::map<ModuleId, std::vector<std::map<ModulePortId, std::vector<ModuleNetId>>>>> NetLookup;
@@ -352,7 +442,39 @@ class ModuleManager {
     /* Store pairs of a module and a port, which are frequently used in net terminals
      * (either source or sink)
      */
-    std::vector<std::pair<ModuleId, ModulePortId>> net_terminal_storage_;
+    std::vector<NetTerminal> net_terminal_storage_;
+    /* fast look-up for the net terminal storage: [module_id, port_id] -> index in net_terminal_storage_ */
+    std::unordered_map<NetTerminal, size_t, NetTerminalHash> net_terminal_lookup_;
+
+    /* fast look-up for the terminal pins of nets, which are used to check if a source/sink already exists
+     * To avoid large memory footprint, the look-up of a module is built only when it is queried for the first time,
+     * and then kept up-to-date when new sources/sinks are added
+     */
+    vtr::vector<ModuleId, bool> net_terminal_pin_lookup_built_;
+    vtr::vector<ModuleId, std::unordered_set<NetTerminalPin, NetTerminalPinHash>> net_src_terminal_pin_lookup_;
+    vtr::vector<ModuleId, std::unordered_set<NetTerminalPin, NetTerminalPinHash>> net_sink_terminal_pin_lookup_;
+
+    /* Frozen storage of nets, see freeze_module_nets()
+     * In a frozen module, the sources (sinks) of all the nets are stored in a flat array,
+     * in the way of Compressed Sparse Row (CSR):
+     *   the sources of net <i> are frozen_net_srcs_[module][frozen_net_src_offsets_[module][i] : frozen_net_src_offsets_[module][i + 1]]
+     * The nets of the pins of the module itself and its child instances are stored in a dense array:
+     *   frozen_pin_nets_[module][frozen_child_pin_offsets_[module][child_index] + instance * <num_pins_of_child> + port_pin_offsets_[child][port] + pin]
+     * where child_index = 0 is reserved for the module itself and children_[module][i] is indexed by i + 1.
+     * The editable storage (net_src_xxx_, net_sink_xxx_ and net_lookup_) of a frozen module is released
+     */
+    vtr::vector<ModuleId, bool> nets_frozen_;
+    vtr::vector<ModuleId, std::vector<size_t>> frozen_net_src_offsets_;
+    vtr::vector<ModuleId, std::vector<FrozenNetTerminal>> frozen_net_srcs_;
+    vtr::vector<ModuleId, std::vector<size_t>> frozen_net_sink_offsets_;
+    vtr::vector<ModuleId, std::vector<FrozenNetTerminal>> frozen_net_sinks_;
+    vtr::vector<ModuleId, std::vector<size_t>> frozen_child_pin_offsets_;
+    vtr::vector<ModuleId, std::vector<ModuleNetId>> frozen_pin_nets_;
+    /* [module][port] index of the first pin of a port among all the pins of a module, the last element is the total number of pins */
+    vtr::vector<ModuleId, std::vector<size_t>> port_pin_offsets_;
+    /* Sequences of source/sink ids (0, 1, 2 ...) which are shared by the source/sink ranges of frozen nets */
+    vtr::vector<ModuleNetSrcId, ModuleNetSrcId> frozen_net_src_ids_;
+    vtr::vector<ModuleNetSinkId, ModuleNetSinkId> frozen_net_sink_ids_;
 };
 
 } /* end namespace openfpga */
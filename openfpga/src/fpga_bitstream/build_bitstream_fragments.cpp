@@ -0,0 +1,129 @@
+/********************************************************************
+ * This file includes functions to build the bitstream of 
+ * independent parts of a FPGA fabric, e.g., grids and routing blocks,
+ * with multiple threads
+ *******************************************************************/
+#include <algorithm>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+#include "openfpga_parallel_utils.h"
+#include "bitstream_manager_utils.h"
+#include "build_bitstream_fragments.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Number of fragments to be built by each thread before they are merged,
+ * which limits the memory held by the fragments which are waiting for merging
+ */
+constexpr size_t NUM_BITSTREAM_FRAGMENTS_PER_THREAD = 64;
+
+/********************************************************************
+ * Build a number of bitstream fragments under a parent block 
+ * The function build_fragment(bitstream_manager, parent_block, ifragment)
+ * adds the blocks and bits of the i-th fragment under the given parent block,
+ * and must only read shared data.
+ *
+ * When a single thread is used, the fragments are built directly 
+ * in the bitstream manager.
+ * Otherwise, each fragment is built in a private bitstream manager 
+ * and then merged into the bitstream manager in the ascending order of indices.
+ * In both cases, the resulting bitstream manager is exactly the same
+ *******************************************************************/
+void build_bitstream_fragments(BitstreamManager& bitstream_manager,
+                               const ConfigBlockId& parent_block,
+                               const size_t& num_fragments,
+                               const size_t& num_threads,
+                               const std::function<void(BitstreamManager&, const ConfigBlockId&, const size_t&)>& build_fragment) {
+  if (1 >= num_threads) {
+    for (size_t ifragment = 0; ifragment < num_fragments; ++ifragment) {
+      build_fragment(bitstream_manager, parent_block, ifragment);
+    }
+    return;
+  }
+
+  /* Build the fragments batch by batch, so that only a small number of fragments
+   * are held in memory at the same time 
+   */
+  size_t batch_size = num_threads * NUM_BITSTREAM_FRAGMENTS_PER_THREAD;
+  std::vector<BitstreamManager> fragments;
+
+  for (size_t batch_start = 0; batch_start < num_fragments; batch_start += batch_size) {
+    size_t num_batch_fragments = std::min(batch_size, num_fragments - batch_start);
+    fragments.clear();
+    fragments.resize(num_batch_fragments);
+
+    parallel_for(num_batch_fragments, num_threads,
+                 [&](const size_t& ifragment) {
+      /* The root block of a fragment stands for the parent block */
+      BitstreamManager& fragment = fragments[ifragment];
+      ConfigBlockId fragment_root = fragment.add_block(bitstream_manager.block_name(parent_block));
+      VTR_ASSERT(ConfigBlockId(0) == fragment_root);
+      build_fragment(fragment, fragment_root, batch_start + ifragment);
+    });
+
+    for (const BitstreamManager& fragment : fragments) {
+      bitstream_manager.add_fragment(parent_block, fragment);
+    }
+  }
+}
+
+/********************************************************************
+ * Build a number of bitstream fragments under a parent block,
+ * reusing the blocks of a previous run when possible
+ * Each fragment is a tile, which creates at most one block 
+ * named as fragment_block_names[i] under the parent block.
+ * The function build_fingerprint(ifragment) accumulates all the inputs 
+ * of the bitstream of the i-th fragment into a fingerprint.
+ * When the fingerprint is the same as the previous run, 
+ * the block (if any) is copied from the previous bitstream.
+ * Otherwise, the fragment is built by build_fragment()
+ *
+ * When incremental build is not enabled, all the fragments are built
+ * without computing their fingerprints
+ *******************************************************************/
+void build_incremental_bitstream_fragments(BitstreamManager& bitstream_manager,
+                                           const ConfigBlockId& parent_block,
+                                           IncrementalBitstream& incremental_bitstream,
+                                           const std::vector<std::string>& fragment_block_names,
+                                           const size_t& num_threads,
+                                           const std::function<std::string(const size_t&)>& build_fingerprint,
+                                           const std::function<void(BitstreamManager&, const ConfigBlockId&, const size_t&)>& build_fragment) {
+  if (false == incremental_bitstream.enabled()) {
+    build_bitstream_fragments(bitstream_manager, parent_block, fragment_block_names.size(), num_threads, build_fragment);
+    return;
+  }
+
+  std::vector<std::string> fingerprints(fragment_block_names.size());
+  parallel_for(fragment_block_names.size(), num_threads,
+               [&](const size_t& ifragment) {
+    fingerprints[ifragment] = build_fingerprint(ifragment);
+  });
+
+  /* Find the tiles which can be reused from the previous run */
+  std::vector<bool> reusable_fragments(fragment_block_names.size(), false);
+  for (size_t ifragment = 0; ifragment < fragment_block_names.size(); ++ifragment) {
+    reusable_fragments[ifragment] = incremental_bitstream.is_tile_reusable(fragment_block_names[ifragment], fingerprints[ifragment]);
+    incremental_bitstream.add_fingerprint(fragment_block_names[ifragment], fingerprints[ifragment],
+                                          reusable_fragments[ifragment]);
+  }
+
+  const BitstreamManager& previous_bitstream = incremental_bitstream.previous_bitstream();
+  build_bitstream_fragments(bitstream_manager, parent_block, fragment_block_names.size(), num_threads,
+                            [&](BitstreamManager& fragment, const ConfigBlockId& fragment_parent_block, const size_t& ifragment) {
+    if (false == reusable_fragments[ifragment]) {
+      build_fragment(fragment, fragment_parent_block, ifragment);
+      return;
+    }
+    /* A reused tile may have no block, when it contains no configuration bits */
+    ConfigBlockId previous_block = incremental_bitstream.previous_tile_block(fragment_block_names[ifragment]);
+    if (ConfigBlockId::INVALID() != previous_block) {
+      rec_copy_bitstream_manager_block(fragment, fragment_parent_block, previous_bitstream, previous_block);
+    }
+  });
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,37 @@
+#ifndef BUILD_BITSTREAM_FRAGMENTS_H
+#define BUILD_BITSTREAM_FRAGMENTS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "bitstream_manager.h"
+#include "incremental_bitstream.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+void build_bitstream_fragments(BitstreamManager& bitstream_manager,
+                               const ConfigBlockId& parent_block,
+                               const size_t& num_fragments,
+                               const size_t& num_threads,
+                               const std::function<void(BitstreamManager&, const ConfigBlockId&, const size_t&)>& build_fragment);
+
+void build_incremental_bitstream_fragments(BitstreamManager& bitstream_manager,
+                                           const ConfigBlockId& parent_block,
+                                           IncrementalBitstream& incremental_bitstream,
+                                           const std::vector<std::string>& fragment_block_names,
+                                           const size_t& num_threads,
+                                           const std::function<std::string(const size_t&)>& build_fingerprint,
+                                           const std::function<void(BitstreamManager&, const ConfigBlockId&, const size_t&)>& build_fragment);
+
+} /* end namespace openfpga */
+
+#endif
@@ -72,6 +72,20 @@ size_t rec_estimate_device_bitstream_num_bits(const ModuleManager& module_manage
     return 1;
   }
 
+  /* The top-level module has its decoders at the end of each configuration region */
+  std::string top_block_name = generate_fpga_top_module_name();
+  if (top_module == module_manager.find_module(top_block_name)) {
+    for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+      size_t first_child = module_manager.region_first_configurable_child(top_module, config_region);
+      size_t num_memory_children = find_top_module_region_num_memory_children(module_manager, top_module, config_region, config_protocol_type);
+      for (size_t ichild = first_child; ichild < first_child + num_memory_children; ++ichild) {
+        ModuleId child_module = module_manager.configurable_children(top_module)[ichild];
+        num_bits += rec_estimate_device_bitstream_num_bits(module_manager, child_module, config_protocol_type);
+      }
+    }
+    return num_bits;
+  }
+
   size_t num_configurable_children = module_manager.configurable_children(top_module).size();
   /* Frame-based configuration protocol will have 1 decoder
    * if there are more than 1 configurable children
@@ -81,15 +95,6 @@ size_t rec_estimate_device_bitstream_num_bits(const ModuleManager& module_manage
     num_configurable_children--;
   }
 
-  /* Memory configuration protocol will have 2 decoders
-   * at the top-level
-   */
-  if (CONFIG_MEM_MEMORY_BANK == config_protocol_type) {
-    std::string top_block_name = generate_fpga_top_module_name();
-    if (top_module == module_manager.find_module(top_block_name)) {
-      num_configurable_children -= 2;
-    }
-  }
   for (size_t ichild = 0; ichild < num_configurable_children; ++ichild) {
     ModuleId child_module = module_manager.configurable_children(top_module)[ichild];
     num_bits += rec_estimate_device_bitstream_num_bits(module_manager, child_module, config_protocol_type);
@@ -98,6 +103,40 @@ size_t rec_estimate_device_bitstream_num_bits(const ModuleManager& module_manage
   return num_bits;
 }
 
+/********************************************************************
+ * Build the fingerprint of the fabric, which the bitstreams of all the tiles depend on.
+ * The fingerprints of tiles only cover the netlist and routing results,
+ * so the fabric fingerprint should cover anything else which may change
+ * the configuration bits while keeping the number of bits, e.g., 
+ * the circuit models of multiplexers and SRAMs.
+ * The architectures are identified by the digests of their files
+ *******************************************************************/
+static 
+std::string build_device_bitstream_fabric_fingerprint(const VprContext& vpr_ctx,
+                                                      const OpenfpgaContext& openfpga_ctx,
+                                                      const ModuleId& top_module,
+                                                      const size_t& num_blocks,
+                                                      const size_t& num_bits) {
+  FingerprintHasher fabric_hasher;
+  fabric_hasher.add(num_blocks);
+  fabric_hasher.add(num_bits);
+
+  /* VPR architecture */
+  fabric_hasher.add(nullptr == vpr_ctx.device().arch->architecture_id ? std::string() : std::string(vpr_ctx.device().arch->architecture_id));
+
+  /* OpenFPGA architecture */
+  fabric_hasher.add(openfpga_ctx.arch().architecture_id);
+
+  /* Configuration protocol and its regions */
+  fabric_hasher.add(size_t(openfpga_ctx.arch().config_protocol.type()));
+  fabric_hasher.add(openfpga_ctx.module_graph().regions(top_module).size());
+  for (const ConfigRegionId& config_region : openfpga_ctx.module_graph().regions(top_module)) {
+    fabric_hasher.add(openfpga_ctx.module_graph().region_num_configurable_children(top_module, config_region));
+  }
+
+  return fabric_hasher.fingerprint();
+}
+
 /********************************************************************
  * A top-level function to build a bistream from the FPGA device
  * 1. It will organize the bitstream w.r.t. the hierarchy of module graphs 
@@ -110,9 +149,17 @@ size_t rec_estimate_device_bitstream_num_bits(const ModuleManager& module_manage
  * Note: this function create a bitstream which is binding to the module graphs
  * of the FPGA fabric that FPGA-X2P generates!
  * But it can be used to output a generic bitstream for VPR mapping FPGA
+ *
+ * The bitstreams of grids and routing blocks can be built with multiple threads,
+ * and the result is the same regardless of the number of threads
+ *
+ * When incremental build is enabled, the bitstreams of grids and routing blocks
+ * whose inputs are unchanged since a previous run are reused
  *******************************************************************/
 BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                                         const OpenfpgaContext& openfpga_ctx,
+                                        IncrementalBitstream& incremental_bitstream,
+                                        const size_t& num_threads,
                                         const bool& verbose) {
 
   std::string timer_message = std::string("\nBuild fabric-independent bitstream for implementation '") + vpr_ctx.atom().nlist.netlist_name() + std::string("'\n");
@@ -146,6 +193,24 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
   bitstream_manager.reserve_bits(num_bits_to_reserve);
   VTR_LOGV(verbose, "Reserved %lu configuration bits\n", num_bits_to_reserve);
 
+  /* The fabric is identified by the architectures, the configuration protocol
+   * and the number of blocks and bits. 
+   * Reuse nothing from the previous run if the fabric is changed
+   */
+  if (true == incremental_bitstream.enabled()) {
+    std::string fabric_fingerprint = build_device_bitstream_fabric_fingerprint(vpr_ctx, openfpga_ctx, top_module,
+                                                                               num_blocks_to_reserve,
+                                                                               num_bits_to_reserve);
+    if (false == incremental_bitstream.is_tile_reusable(top_block_name, fabric_fingerprint)) {
+      /* Report only when there is a previous bitstream to reuse */
+      if (0 < incremental_bitstream.previous_bitstream().num_blocks()) {
+        VTR_LOG("Fabric or architecture is changed since the previous run, build the bitstream of all the tiles\n");
+      }
+      incremental_bitstream.clear_previous_bitstream();
+    }
+    incremental_bitstream.add_fabric_fingerprint(top_block_name, fabric_fingerprint);
+  }
+
   /* Reserve child blocks for the top level block */
   bitstream_manager.reserve_child_blocks(top_block,
                                          count_module_manager_module_configurable_children(openfpga_ctx.module_graph(), top_module)); 
@@ -161,6 +226,8 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                        openfpga_ctx.vpr_device_annotation(),
                        openfpga_ctx.vpr_clustering_annotation(),
                        openfpga_ctx.vpr_placement_annotation(),
+                       incremental_bitstream,
+                       num_threads,
                        verbose);
   VTR_LOGV(verbose, "Done\n");
 
@@ -175,7 +242,9 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                           openfpga_ctx.vpr_routing_annotation(),
                           vpr_ctx.device().rr_graph,
                           openfpga_ctx.device_rr_gsb(),
-                          openfpga_ctx.flow_manager().compress_routing());
+                          openfpga_ctx.flow_manager().compress_routing(),
+                          incremental_bitstream,
+                          num_threads);
   VTR_LOGV(verbose, "Done\n");
 
   VTR_LOGV(verbose,
@@ -183,9 +252,23 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
            bitstream_manager.num_bits(),
            bitstream_manager.num_blocks());
 
+  if (true == incremental_bitstream.enabled()) {
+    VTR_LOG("Reused the bitstream of %lu tiles and rebuilt %lu tiles\n",
+            incremental_bitstream.num_reused_tiles(),
+            incremental_bitstream.num_rebuilt_tiles());
+  }
+
   VTR_ASSERT(num_blocks_to_reserve == bitstream_manager.num_blocks());
   VTR_ASSERT(num_bits_to_reserve == bitstream_manager.num_bits());
 
+  /* Report the memory footprint, which matters for large devices */
+  size_t num_bytes = bitstream_manager.memory_usage();
+  VTR_LOG("Fabric-independent bitstream occupies %.2f MB for %lu configuration bits in %lu blocks (%.2f bytes per bit)\n",
+          float(num_bytes) / (1024 * 1024),
+          bitstream_manager.num_bits(),
+          bitstream_manager.num_blocks(),
+          0 == bitstream_manager.num_bits() ? 0. : float(num_bytes) / bitstream_manager.num_bits());
+
   return bitstream_manager;
 }
 
@@ -7,6 +7,7 @@
 #include <vector>
 #include "vpr_context.h"
 #include "openfpga_context.h"
+#include "incremental_bitstream.h"
 
 /********************************************************************
  * Function declaration
@@ -17,6 +18,8 @@ namespace openfpga {
 
 BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                                         const OpenfpgaContext& openfpga_ctx,
+                                        IncrementalBitstream& incremental_bitstream,
+                                        const size_t& num_threads,
                                         const bool& verbose);
 
 } /* end namespace openfpga */
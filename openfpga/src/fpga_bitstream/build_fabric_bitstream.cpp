@@ -4,190 +4,361 @@
 #include <string>
 #include <cmath>
 #include <algorithm>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
-
-/* Headers from openfpgautil library */
-#include "openfpga_decode.h"
+#include "vtr_hash.h"
 
 #include "openfpga_reserved_words.h"
 #include "openfpga_naming.h"
 
 #include "decoder_library_utils.h"
 #include "bitstream_manager_utils.h"
+#include "module_manager_utils.h"
 #include "build_fabric_bitstream.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
 /********************************************************************
- * This function aims to build a bitstream for configuration chain-like protocol
- * It will walk through all the configurable children under a module
- * in a recursive way, following a Depth-First Search (DFS) strategy
- * For each configuration child, we use its instance name as a key to spot the 
- * configuration bits in bitstream manager.
- * Note that it is guarentee that the instance name in module manager is 
+ * The builders below visit the configurable children of the module graph
+ * and the blocks of the bitstream manager at the same time, in a 
+ * Depth-First Search (DFS) way.
+ * Large fabrics contain millions of blocks, therefore
+ * - an explicit stack is used instead of recursion, and
+ *   no list of blocks, modules or addresses is copied between levels
+ * - child blocks are found through a precomputed index rather than
+ *   comparing the names of all the children of a block
+ *******************************************************************/
+
+/* A node in the DFS stack */
+struct t_fabric_bitstream_dfs_node {
+  ConfigBlockId block;
+  ModuleId module;
+  /* The configurable children to be visited are [first_child, num_children),
+   * and the next one to visit 
+   * Only the top-level module visits a part of its configurable children,
+   * i.e., a configuration region
+   */
+  size_t num_children;
+  size_t first_child;
+  size_t next_child;
+  /* Only used by frame-based protocol:
+   * - the address code of the block is stored from this position 
+   *   to the end of the address buffer
+   * - the address size of the frame decoder of the block
+   * - the maximum address size of the configurable children of the block
+   */
+  size_t addr_lsb;
+  size_t decoder_addr_size;
+  size_t max_child_addr_size;
+};
+
+/* Index of child blocks, the key is a hash of the parent block and the name of a child block */
+typedef std::unordered_map<size_t, ConfigBlockId> t_child_block_index;
+
+static 
+size_t child_block_index_key(const ConfigBlockId& parent_block,
+                             const std::string& child_block_name) {
+  size_t key = std::hash<std::string>()(child_block_name);
+  vtr::hash_combine(key, parent_block);
+  return key;
+}
+
+/********************************************************************
+ * Index all the blocks which have a parent in the bitstream manager
+ * Blocks whose keys are duplicated are marked invalid in the index,
+ * so that they will be resolved by a slow search
+ *******************************************************************/
+static 
+t_child_block_index build_child_block_index(const BitstreamManager& bitstream_manager) {
+  t_child_block_index child_block_index;
+  child_block_index.reserve(bitstream_manager.num_blocks());
+
+  for (const ConfigBlockId& block : bitstream_manager.blocks()) {
+    const ConfigBlockId& parent_block = bitstream_manager.block_parent(block);
+    if (false == bitstream_manager.valid_block_id(parent_block)) {
+      continue;
+    }
+    auto result = child_block_index.emplace(child_block_index_key(parent_block, bitstream_manager.block_name(block)), block);
+    if (false == result.second) {
+      result.first->second = ConfigBlockId::INVALID();
+    }
+  }
+
+  return child_block_index;
+}
+
+/********************************************************************
+ * Find the child block of a block with a given name using the index.
+ * This is the same as BitstreamManager::find_child_block() 
+ *******************************************************************/
+static 
+ConfigBlockId find_indexed_child_block(const BitstreamManager& bitstream_manager,
+                                       const t_child_block_index& child_block_index,
+                                       const ConfigBlockId& parent_block,
+                                       const std::string& child_block_name) {
+  auto result = child_block_index.find(child_block_index_key(parent_block, child_block_name));
+  if (result == child_block_index.end()) {
+    return ConfigBlockId::INVALID();
+  }
+
+  const ConfigBlockId& child_block = result->second;
+  if ( (true == bitstream_manager.valid_block_id(child_block))
+    && (parent_block == bitstream_manager.block_parent(child_block))
+    && (child_block_name == bitstream_manager.block_name(child_block))) {
+    return child_block;
+  }
+
+  /* Hash collision, fall back to the slow search */
+  return bitstream_manager.find_child_block(parent_block, child_block_name);
+}
+
+/********************************************************************
+ * Find the child block of a block for a configurable child of a module.
+ * Note that it is guarenteed that the instance name in module manager is 
  * consistent with the block names in bitstream manager
- * We use this link to reorganize the bitstream in the sequence of memories as we stored
- * in the configurable_children() and configurable_child_instances() of each module of module manager 
  *******************************************************************/
 static 
-void rec_build_module_fabric_dependent_chain_bitstream(const BitstreamManager& bitstream_manager,
-                                                       const ConfigBlockId& parent_block,
-                                                       const ModuleManager& module_manager,
-                                                       const ModuleId& parent_module,
-                                                       FabricBitstream& fabric_bitstream) {
-
-  /* Depth-first search: if we have any children in the parent_block, 
-   * we dive to the next level first! 
-   */
-  if (0 < bitstream_manager.block_children(parent_block).size()) {
-    for (size_t child_id = 0; child_id < module_manager.configurable_children(parent_module).size(); ++child_id) {
-      ModuleId child_module = module_manager.configurable_children(parent_module)[child_id]; 
-      size_t child_instance = module_manager.configurable_child_instances(parent_module)[child_id]; 
-      /* Get the instance name and ensure it is not empty */
-      std::string instance_name = module_manager.instance_name(parent_module, child_module, child_instance);
+ConfigBlockId find_configurable_child_block(const BitstreamManager& bitstream_manager,
+                                            const t_child_block_index& child_block_index,
+                                            const ModuleManager& module_manager,
+                                            const t_fabric_bitstream_dfs_node& parent_node,
+                                            const size_t& child_id) {
+  const ModuleId& child_module = module_manager.configurable_children(parent_node.module)[child_id]; 
+  const size_t& child_instance = module_manager.configurable_child_instances(parent_node.module)[child_id]; 
+  const std::string& instance_name = module_manager.instance_name(parent_node.module, child_module, child_instance);
        
-      /* Find the child block that matches the instance name! */ 
-      ConfigBlockId child_block = bitstream_manager.find_child_block(parent_block, instance_name); 
-      /* We must have one valid block id! */
-      if (true != bitstream_manager.valid_block_id(child_block))
-      VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
-
-      /* Go recursively */
-      rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, child_block,
-                                                        module_manager, child_module,
-                                                        fabric_bitstream);
-    }
-    /* Ensure that there should be no configuration bits in the parent block */
-    VTR_ASSERT(0 == bitstream_manager.block_bits(parent_block).size());
+  /* Find the child block that matches the instance name! */ 
+  ConfigBlockId child_block = find_indexed_child_block(bitstream_manager, child_block_index,
+                                                       parent_node.block, instance_name); 
+  /* We must have one valid block id! */
+  VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
+
+  return child_block;
+}
+
+/********************************************************************
+ * Write the binary code of an integer to an address buffer from a given position
+ * The binary code is the same as itobin_charvec() but no memory is allocated
+ *******************************************************************/
+static 
+void write_address_code(const size_t& in_int,
+                        const size_t& bin_len,
+                        const size_t& lsb,
+                        std::vector<char>& addr_code) {
+  /* Make sure we do not have any overflow! */
+  VTR_ASSERT(in_int < pow(2., bin_len));
+  VTR_ASSERT(lsb + bin_len <= addr_code.size());
+  
+  size_t temp = in_int;
+  for (size_t i = 0; i < bin_len; i++) {
+    addr_code[lsb + i] = (1 == temp % 2) ? '1' : '0';
+    temp = temp / 2;
   }
+}
 
-  /* Note that, reach here, it means that this is a leaf node. 
-   * We add the configuration bits to the fabric_bitstream,
-   * And then, we can return
-   */
-  for (const ConfigBitId& config_bit : bitstream_manager.block_bits(parent_block)) {
-    fabric_bitstream.add_bit(config_bit);
+/********************************************************************
+ * Find the width of the address port of a module
+ * The width is cached, as it is requested for each instance of the module 
+ *******************************************************************/
+static 
+size_t find_module_address_port_width(const ModuleManager& module_manager,
+                                      const ModuleId& module,
+                                      vtr::vector<ModuleId, size_t>& addr_port_widths) {
+  if (size_t(-1) == addr_port_widths[module]) {
+    const ModulePortId& addr_port_id = module_manager.find_module_port(module, std::string(DECODER_ADDRESS_PORT_NAME));
+    addr_port_widths[module] = module_manager.module_port(module, addr_port_id).get_width();
   }
+  return addr_port_widths[module];
 }
 
 /********************************************************************
- * This function aims to build a bitstream for memory-bank protocol
- * It will walk through all the configurable children under a module
- * in a recursive way, following a Depth-First Search (DFS) strategy
+ * Create a DFS node for a block in the frame-based protocol
+ * - For only 1 configurable child,
+ *   there is no frame decoder here, we can pass on addr code directly
+ * - For more than 2 children, there is a decoder in the tail of the list
+ *   We will not decode that, but will access the address size from that module
+ *   So, we reduce the number of children by 1
+ * - A leaf node (a memory module) always has a decoder inside
+ *   which is the last of configurable children.
+ *******************************************************************/
+static 
+t_fabric_bitstream_dfs_node build_frame_dfs_node(const BitstreamManager& bitstream_manager,
+                                                 const ModuleManager& module_manager,
+                                                 const ConfigBlockId& block,
+                                                 const ModuleId& module,
+                                                 const size_t& addr_lsb,
+                                                 vtr::vector<ModuleId, size_t>& addr_port_widths) {
+  const std::vector<ModuleId>& configurable_children = module_manager.configurable_children(module);
+  t_fabric_bitstream_dfs_node node = {block, module, configurable_children.size(), 0, 0, addr_lsb, 0, 0};
+
+  if (true == bitstream_manager.block_children(block).empty()) {
+    VTR_ASSERT(1 < configurable_children.size());
+    node.decoder_addr_size = find_module_address_port_width(module_manager, configurable_children.back(), addr_port_widths);
+    return node;
+  }
+
+  if (1 < configurable_children.size()) {
+    VTR_ASSERT(2 < configurable_children.size());
+    node.num_children--;
+    node.decoder_addr_size = find_module_address_port_width(module_manager, configurable_children.back(), addr_port_widths);
+
+    /* The address code size is the max. of address port of all the configurable children */
+    for (size_t child_id = 0; child_id < node.num_children; ++child_id) {
+      node.max_child_addr_size = std::max(find_module_address_port_width(module_manager, configurable_children[child_id], addr_port_widths),
+                                          node.max_child_addr_size);
+    }
+  }
+
+  return node;
+}
+
+/********************************************************************
+ * This function aims to build a bitstream for configuration chain-like protocol
+ * It will walk through all the configurable children under a configuration region
+ * of the top module following a Depth-First Search (DFS) strategy
  * For each configuration child, we use its instance name as a key to spot the 
  * configuration bits in bitstream manager.
- * Note that it is guarentee that the instance name in module manager is 
- * consistent with the block names in bitstream manager
  * We use this link to reorganize the bitstream in the sequence of memories as we stored
  * in the configurable_children() and configurable_child_instances() of each module of module manager 
- *
- * In such configuration organization, each memory cell has an unique index.
- * Using this index, we can infer the address codes for both BL and WL decoders.
- * Note that, we must get the number of BLs and WLs before using this function!
  *******************************************************************/
 static 
-void rec_build_module_fabric_dependent_memory_bank_bitstream(const BitstreamManager& bitstream_manager,
-                                                             const ConfigBlockId& parent_block,
-                                                             const ModuleManager& module_manager,
-                                                             const ModuleId& top_module,
-                                                             const ModuleId& parent_module,
-                                                             const size_t& bl_addr_size,
-                                                             const size_t& wl_addr_size,
-                                                             const size_t& num_bls,
-                                                             const size_t& num_wls, 
-                                                             size_t& cur_mem_index,
-                                                             FabricBitstream& fabric_bitstream) {
-
-  /* Depth-first search: if we have any children in the parent_block, 
-   * we dive to the next level first! 
-   */
-  if (0 < bitstream_manager.block_children(parent_block).size()) {
-    /* For top module, we will skip the two decoders at the end of the configurable children list */
-    std::vector<ModuleId> configurable_children = module_manager.configurable_children(parent_module);
-
-    size_t num_configurable_children = configurable_children.size();
-    if (parent_module == top_module) {
-      VTR_ASSERT(2 <= configurable_children.size()); 
-      num_configurable_children -= 2;
+void build_module_fabric_dependent_chain_bitstream(const BitstreamManager& bitstream_manager,
+                                                   const t_child_block_index& child_block_index,
+                                                   const ConfigBlockId& top_block,
+                                                   const ModuleManager& module_manager,
+                                                   const ModuleId& top_module,
+                                                   const ConfigRegionId& config_region,
+                                                   FabricBitstream& fabric_bitstream) {
+  size_t first_child = module_manager.region_first_configurable_child(top_module, config_region);
+  size_t num_children = module_manager.region_num_configurable_children(top_module, config_region);
+
+  std::vector<t_fabric_bitstream_dfs_node> dfs_stack;
+  dfs_stack.push_back({top_block, top_module, first_child + num_children, first_child, first_child, 0, 0, 0});
+
+  while (false == dfs_stack.empty()) {
+    t_fabric_bitstream_dfs_node& node = dfs_stack.back();
+
+    /* A leaf node: we add the configuration bits to the fabric_bitstream */
+    if (true == bitstream_manager.block_children(node.block).empty()) {
+      for (const ConfigBitId& config_bit : bitstream_manager.block_bit_range(node.block)) {
+        fabric_bitstream.add_bit(config_bit);
+      }
+      dfs_stack.pop_back();
+      continue;
     }
 
-    /* Early exit if there is no configurable children */
-    if (0 == num_configurable_children) {
-      /* Ensure that there should be no configuration bits in the parent block */
-      VTR_ASSERT(0 == bitstream_manager.block_bits(parent_block).size());
-      return;
+    /* Depth-first search: if we have any children in the block, 
+     * we dive to the next level first! 
+     */
+    if (node.next_child < node.num_children) {
+      size_t child_id = node.next_child++;
+      ConfigBlockId child_block = find_configurable_child_block(bitstream_manager, child_block_index,
+                                                                module_manager, node, child_id);
+      ModuleId child_module = module_manager.configurable_children(node.module)[child_id]; 
+      /* Note that the node is no longer accessible after pushing */
+      dfs_stack.push_back({child_block, child_module, module_manager.configurable_children(child_module).size(), 0, 0, 0, 0, 0});
+      continue;
     }
 
-    for (size_t child_id = 0; child_id < num_configurable_children; ++child_id) {
-      ModuleId child_module = configurable_children[child_id]; 
-      size_t child_instance = module_manager.configurable_child_instances(parent_module)[child_id]; 
-      /* Get the instance name and ensure it is not empty */
-      std::string instance_name = module_manager.instance_name(parent_module, child_module, child_instance);
-       
-      /* Find the child block that matches the instance name! */ 
-      ConfigBlockId child_block = bitstream_manager.find_child_block(parent_block, instance_name); 
-      /* We must have one valid block id! */
-      if (true != bitstream_manager.valid_block_id(child_block)) 
-      VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
-
-      /* Go recursively */
-      rec_build_module_fabric_dependent_memory_bank_bitstream(bitstream_manager, child_block,
-                                                              module_manager, top_module, child_module,
-                                                              bl_addr_size, wl_addr_size,
-                                                              num_bls, num_wls,
-                                                              cur_mem_index,
-                                                              fabric_bitstream);
-    }
     /* Ensure that there should be no configuration bits in the parent block */
-    VTR_ASSERT(0 == bitstream_manager.block_bits(parent_block).size());
-
-    return;
+    VTR_ASSERT(0 == bitstream_manager.block_bit_range(node.block).size());
+    dfs_stack.pop_back();
   }
+}
 
-  /* Note that, reach here, it means that this is a leaf node. 
-   * We add the configuration bits to the fabric_bitstream,
-   * And then, we can return
-   */
-  for (const ConfigBitId& config_bit : bitstream_manager.block_bits(parent_block)) {
-    FabricBitId fabric_bit = fabric_bitstream.add_bit(config_bit);
-  
-    /* Find BL address */
-    size_t cur_bl_index = std::floor(cur_mem_index / num_bls);
-    std::vector<char> bl_addr_bits_vec = itobin_charvec(cur_bl_index, bl_addr_size);
-
-    /* Find WL address */
-    size_t cur_wl_index = cur_mem_index % num_wls;
-    std::vector<char> wl_addr_bits_vec = itobin_charvec(cur_wl_index, wl_addr_size);
+/********************************************************************
+ * This function aims to build a bitstream for memory-bank protocol
+ * It will walk through all the configurable children under a module
+ * following a Depth-First Search (DFS) strategy, 
+ * in the same way as the configuration chain-like protocol
+ *
+ * In such configuration organization, each memory cell has an unique index in its region.
+ * Using this index, we can infer the address codes for both BL and WL decoders.
+ * Note that, we must get the number of BLs and WLs before using this function!
+ *******************************************************************/
+static 
+void build_module_fabric_dependent_memory_bank_bitstream(const BitstreamManager& bitstream_manager,
+                                                         const t_child_block_index& child_block_index,
+                                                         const ConfigBlockId& top_block,
+                                                         const ModuleManager& module_manager,
+                                                         const ModuleId& top_module,
+                                                         const ConfigRegionId& config_region,
+                                                         const size_t& bl_addr_size,
+                                                         const size_t& wl_addr_size,
+                                                         const size_t& num_bls,
+                                                         const size_t& num_wls, 
+                                                         FabricBitstream& fabric_bitstream) {
+  /* For top module, we will skip the two decoders at the end of the configuration region */
+  size_t first_child = module_manager.region_first_configurable_child(top_module, config_region);
+  size_t num_children = find_top_module_region_num_memory_children(module_manager, top_module, config_region, CONFIG_MEM_MEMORY_BANK);
+
+  std::vector<t_fabric_bitstream_dfs_node> dfs_stack;
+  dfs_stack.push_back({top_block, top_module, first_child + num_children, first_child, first_child, 0, 0, 0});
+
+  /* Address buffers shared by all the bits */
+  std::vector<char> bl_addr_code(bl_addr_size, '0');
+  std::vector<char> wl_addr_code(wl_addr_size, '0');
+  size_t cur_mem_index = 0;
+
+  while (false == dfs_stack.empty()) {
+    t_fabric_bitstream_dfs_node& node = dfs_stack.back();
+
+    /* A leaf node: we add the configuration bits to the fabric_bitstream */
+    if (true == bitstream_manager.block_children(node.block).empty()) {
+      for (const ConfigBitId& config_bit : bitstream_manager.block_bit_range(node.block)) {
+        FabricBitId fabric_bit = fabric_bitstream.add_bit(config_bit);
+
+        /* Find BL address */
+        write_address_code(cur_mem_index / num_bls, bl_addr_size, 0, bl_addr_code);
+
+        /* Find WL address */
+        write_address_code(cur_mem_index % num_wls, wl_addr_size, 0, wl_addr_code);
+
+        /* Set BL address */
+        fabric_bitstream.set_bit_bl_address(fabric_bit, bl_addr_code);
+
+        /* Set WL address */
+        fabric_bitstream.set_bit_wl_address(fabric_bit, wl_addr_code);
+    
+        /* Set data input */
+        fabric_bitstream.set_bit_din(fabric_bit, bitstream_manager.bit_value(config_bit));
 
-    /* Set BL address */
-    fabric_bitstream.set_bit_bl_address(fabric_bit, bl_addr_bits_vec);
+        /* Increase the memory index */
+        cur_mem_index++;
+      }
+      dfs_stack.pop_back();
+      continue;
+    }
 
-    /* Set WL address */
-    fabric_bitstream.set_bit_wl_address(fabric_bit, wl_addr_bits_vec);
-    
-    /* Set data input */
-    fabric_bitstream.set_bit_din(fabric_bit, bitstream_manager.bit_value(config_bit));
+    /* Depth-first search: if we have any children in the block, 
+     * we dive to the next level first! 
+     */
+    if (node.next_child < node.num_children) {
+      size_t child_id = node.next_child++;
+      ConfigBlockId child_block = find_configurable_child_block(bitstream_manager, child_block_index,
+                                                                module_manager, node, child_id);
+      ModuleId child_module = module_manager.configurable_children(node.module)[child_id]; 
+      /* Note that the node is no longer accessible after pushing */
+      dfs_stack.push_back({child_block, child_module, module_manager.configurable_children(child_module).size(), 0, 0, 0, 0, 0});
+      continue;
+    }
 
-    /* Increase the memory index */
-    cur_mem_index++;
+    /* Ensure that there should be no configuration bits in the parent block */
+    VTR_ASSERT(0 == bitstream_manager.block_bit_range(node.block).size());
+    dfs_stack.pop_back();
   }
 }
 
 /********************************************************************
  * This function aims to build a bitstream for frame-based configuration protocol
  * It will walk through all the configurable children under a module
- * in a recursive way, following a Depth-First Search (DFS) strategy
- * For each configuration child, we use its instance name as a key to spot the 
- * configuration bits in bitstream manager.
- * Note that it is guarenteed that the instance name in module manager is 
- * consistent with the block names in bitstream manager
- * We use this link to reorganize the bitstream in the sequence of memories as we stored
- * in the configurable_children() and configurable_child_instances() of each module of module manager 
+ * following a Depth-First Search (DFS) strategy, 
+ * in the same way as the configuration chain-like protocol
  *
  * For each configuration bits, we will infer its address based on 
  *  - the child index in the configurable children list of current module
@@ -198,170 +369,137 @@ void rec_build_module_fabric_dependent_memory_bank_bitstream(const BitstreamMana
  *  <Address_in_top> ... <Address_in_parent_module>
  * The address will be decoded to a binary format
  *
+ * The address code of a block is its prefix in the address of the bits
+ * under the block. All the address codes share a buffer, where 
+ * the address code of the top block is at the end, and that of 
+ * a child block is put just before the address code of its parent.
+ *
+ * Note that the address port size of a child module may be smaller than the maximum
+ * of other child modules at the same level.
+ * We will add dummy '0's to the head of the address code of the child.
+ *
+ * For example:
+ *  Decoder is the decoder to access all the child modules
+ *  whose address is decoded by the addr_bits_vec
+ *  The child modules may use part of the address lines,
+ *  we should add dummy '0' to fill the gap
+ *
+ *  Addr_code for child[0]: '000' + addr_bits_vec
+ *  Addr_code for child[1]: '0'  + addr_bits_vec 
+ *  Addr_code for child[2]: addr_bits_vec 
+ *
+ *                   Addr[6:8]
+ *                     |
+ *                     v
+ *  +-------------------------------------------+
+ *  |            Decoder Module                 |
+ *  +-------------------------------------------+
+ *   
+ *     Addr[0:2]       Addr[0:4]        Addr[0:5]
+ *        |                |               |
+ *        v                v               v
+ * +-----------+  +-------------+  +------------+
+ * | Child[0]  |  |  Child[1]   |  |  Child[2]  |
+ * +-----------+  +-------------+  +------------+
+ *
+ * Child[2] has the maximum address lines among the children
+ *
  * For each configuration bit, the data_in for the frame-based decoders will be 
  * the same as the configuration bit in bitstream manager.
  *******************************************************************/
 static 
-void rec_build_module_fabric_dependent_frame_bitstream(const BitstreamManager& bitstream_manager,
-                                                       const std::vector<ConfigBlockId>& parent_blocks,
-                                                       const ModuleManager& module_manager,
-                                                       const std::vector<ModuleId>& parent_modules,
-                                                       const std::vector<char>& addr_code,
-                                                       FabricBitstream& fabric_bitstream) {
-
-  /* Depth-first search: if we have any children in the parent_block, 
-   * we dive to the next level first! 
+void build_module_fabric_dependent_frame_bitstream(const BitstreamManager& bitstream_manager,
+                                                   const t_child_block_index& child_block_index,
+                                                   const ConfigBlockId& top_block,
+                                                   const ModuleManager& module_manager,
+                                                   const ModuleId& top_module,
+                                                   const ConfigRegionId& config_region,
+                                                   vtr::vector<ModuleId, size_t>& addr_port_widths,
+                                                   FabricBitstream& fabric_bitstream) {
+  /* Address buffer shared by all the bits */
+  std::vector<char> addr_code(fabric_bitstream.address_length(), '0');
+
+  /* The top module is visited for the configurable children in the region
+   * - For only 1 configurable child, there is no frame decoder, 
+   *   the child is driven by the LSBs of the address 
+   * - For more than 2 children, the frame decoder in the tail of the region
+   *   is driven by the MSBs of the address. 
+   *   The gap between the decoder and the children is filled by dummy codes 
    */
-  if (0 < bitstream_manager.block_children(parent_blocks.back()).size()) {
-    const ConfigBlockId& parent_block = parent_blocks.back();
-    const ModuleId& parent_module = parent_modules.back();
-
-    size_t num_configurable_children = module_manager.configurable_children(parent_modules.back()).size();
- 
-    size_t max_child_addr_code_size = 0;
-    bool add_addr_code = true;
-    ModuleId decoder_module = ModuleId::INVALID();
-
-    /* Early exit if there is no configurable children */
-    if (0 == num_configurable_children) {
-      /* Ensure that there should be no configuration bits in the parent block */
-      VTR_ASSERT(0 == bitstream_manager.block_bits(parent_block).size());
-      return;
-    }
+  size_t first_child = module_manager.region_first_configurable_child(top_module, config_region);
+  size_t num_children = find_top_module_region_num_memory_children(module_manager, top_module, config_region, CONFIG_MEM_FRAME_BASED);
+  t_fabric_bitstream_dfs_node top_node = {top_block, top_module, first_child + num_children, first_child, first_child, addr_code.size(), 0, 0};
+  if (1 == num_children) {
+    top_node.addr_lsb = find_module_address_port_width(module_manager, module_manager.configurable_children(top_module)[first_child], addr_port_widths);
+  } else {
+    top_node.decoder_addr_size = find_module_address_port_width(module_manager, module_manager.configurable_children(top_module)[first_child + num_children], addr_port_widths);
+    VTR_ASSERT(top_node.decoder_addr_size <= addr_code.size());
+    top_node.max_child_addr_size = addr_code.size() - top_node.decoder_addr_size;
+  }
 
-    /* For only 1 configurable child,
-     * there is no frame decoder here, we can pass on addr code directly
-     */
-    if (1 == num_configurable_children) {
-      add_addr_code = false;
-    } else {
-    /* For more than 2 children, there is a decoder in the tail of the list
-     * We will not decode that, but will access the address size from that module
-     * So, we reduce the number of children by 1
+  std::vector<t_fabric_bitstream_dfs_node> dfs_stack;
+  dfs_stack.push_back(top_node);
+
+  while (false == dfs_stack.empty()) {
+    t_fabric_bitstream_dfs_node& node = dfs_stack.back();
+
+    /* A leaf node: we will find the address bit and add it to addr_code
+     * Then we can add the configuration bits to the fabric_bitstream.
      */
-      VTR_ASSERT(2 < num_configurable_children);
-      num_configurable_children--;
-      decoder_module = module_manager.configurable_children(parent_module).back();
-
-      /* The address code size is the max. of address port of all the configurable children */
-      for (size_t child_id = 0; child_id < num_configurable_children; ++child_id) {
-        ModuleId child_module = module_manager.configurable_children(parent_module)[child_id]; 
-        const ModulePortId& child_addr_port_id = module_manager.find_module_port(child_module, std::string(DECODER_ADDRESS_PORT_NAME));
-        const BasicPort& child_addr_port = module_manager.module_port(child_module, child_addr_port_id);
-        max_child_addr_code_size = std::max((int)child_addr_port.get_width(), (int)max_child_addr_code_size);
-      } 
-    }
+    if (true == bitstream_manager.block_children(node.block).empty()) {
+      /* The address of bits should fill the whole buffer */
+      VTR_ASSERT(node.decoder_addr_size == node.addr_lsb);
 
-    for (size_t child_id = 0; child_id < num_configurable_children; ++child_id) {
-      ModuleId child_module = module_manager.configurable_children(parent_module)[child_id]; 
-      size_t child_instance = module_manager.configurable_child_instances(parent_module)[child_id]; 
-      /* Get the instance name and ensure it is not empty */
-      std::string instance_name = module_manager.instance_name(parent_module, child_module, child_instance);
-       
-      /* Find the child block that matches the instance name! */ 
-      ConfigBlockId child_block = bitstream_manager.find_child_block(parent_block, instance_name); 
-      /* We must have one valid block id! */
-      if (true != bitstream_manager.valid_block_id(child_block))
-      VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
-
-      /* Pass on the list of blocks, modules and address lists */
-      std::vector<ConfigBlockId> child_blocks = parent_blocks;
-      child_blocks.push_back(child_block);
-
-      std::vector<ModuleId> child_modules = parent_modules;
-      child_modules.push_back(child_module);
-
-      /* Set address, apply binary conversion from the first to the last element in the address list */
-      std::vector<char> child_addr_code = addr_code;
-
-      if (true == add_addr_code) { 
-        /* Find the address port from the decoder module */
-        const ModulePortId& decoder_addr_port_id = module_manager.find_module_port(decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
-        const BasicPort& decoder_addr_port = module_manager.module_port(decoder_module, decoder_addr_port_id);
-        std::vector<char> addr_bits_vec = itobin_charvec(child_id, decoder_addr_port.get_width());
-
-        child_addr_code.insert(child_addr_code.begin(), addr_bits_vec.begin(), addr_bits_vec.end());
-
-        /* Note that the address port size of the child module may be smaller than the maximum
-         * of other child modules at this level.
-         * We will add dummy '0's to the head of addr_bit_vec.
-         *
-         * For example:
-         *  Decoder is the decoder to access all the child modules
-         *  whose address is decoded by the addr_bits_vec
-         *  The child modules may use part of the address lines,
-         *  we should add dummy '0' to fill the gap
-         *
-         *  Addr_code for child[0]: '000' + addr_bits_vec
-         *  Addr_code for child[1]: '0'  + addr_bits_vec 
-         *  Addr_code for child[2]: addr_bits_vec 
-         *
-         *                   Addr[6:8]
-         *                     |
-         *                     v
-         *  +-------------------------------------------+
-         *  |            Decoder Module                 |
-         *  +-------------------------------------------+
-         *   
-         *     Addr[0:2]       Addr[0:4]        Addr[0:5]
-         *        |                |               |
-         *        v                v               v
-         * +-----------+  +-------------+  +------------+
-         * | Child[0]  |  |  Child[1]   |  |  Child[2]  |
-         * +-----------+  +-------------+  +------------+
-         *
-         * Child[2] has the maximum address lines among the children
-         *
-         */
-        const ModulePortId& child_addr_port_id = module_manager.find_module_port(child_module, std::string(DECODER_ADDRESS_PORT_NAME));
-        const BasicPort& child_addr_port = module_manager.module_port(child_module, child_addr_port_id);
-        if (0 < max_child_addr_code_size - child_addr_port.get_width()) {
-          std::vector<char> dummy_codes(max_child_addr_code_size - child_addr_port.get_width(), '0');
-          child_addr_code.insert(child_addr_code.begin(), dummy_codes.begin(), dummy_codes.end());
-        }
-      }
+      size_t ibit = 0;
+      for (const ConfigBitId& config_bit : bitstream_manager.block_bit_range(node.block)) {
+        write_address_code(ibit, node.decoder_addr_size, 0, addr_code);
 
-      /* Go recursively */
-      rec_build_module_fabric_dependent_frame_bitstream(bitstream_manager, child_blocks,
-                                                        module_manager, child_modules,
-                                                        child_addr_code,
-                                                        fabric_bitstream);
-    }
-    /* Ensure that there should be no configuration bits in the parent block */
-    VTR_ASSERT(0 == bitstream_manager.block_bits(parent_block).size());
-   
-    return;
-  }
+        const FabricBitId& fabric_bit = fabric_bitstream.add_bit(config_bit);
 
-  /* Note that, reach here, it means that this is a leaf node. 
-   * A leaf node (a memory module) always has a decoder inside
-   * which is the last of configurable children.
-   * We will find the address bit and add it to addr_code
-   * Then we can add the configuration bits to the fabric_bitstream.
-   */
-  if (!(1 < module_manager.configurable_children(parent_modules.back()).size()))
-  VTR_ASSERT(1 < module_manager.configurable_children(parent_modules.back()).size());
-  ModuleId decoder_module = module_manager.configurable_children(parent_modules.back()).back();
-  /* Find the address port from the decoder module */
-  const ModulePortId& decoder_addr_port_id = module_manager.find_module_port(decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
-  const BasicPort& decoder_addr_port = module_manager.module_port(decoder_module, decoder_addr_port_id);
-
-  for (size_t ibit = 0; ibit < bitstream_manager.block_bits(parent_blocks.back()).size(); ++ibit) {
+        /* Set address */
+        fabric_bitstream.set_bit_address(fabric_bit, addr_code);
     
-    ConfigBitId config_bit = bitstream_manager.block_bits(parent_blocks.back())[ibit];
-    std::vector<char> addr_bits_vec = itobin_charvec(ibit, decoder_addr_port.get_width());
+        /* Set data input */
+        fabric_bitstream.set_bit_din(fabric_bit, bitstream_manager.bit_value(config_bit));
 
-    std::vector<char> child_addr_code = addr_code;
+        ibit++;
+      }
+      dfs_stack.pop_back();
+      continue;
+    }
 
-    child_addr_code.insert(child_addr_code.begin(), addr_bits_vec.begin(), addr_bits_vec.end());
+    /* Depth-first search: if we have any children in the block, 
+     * we dive to the next level first! 
+     */
+    if (node.next_child < node.num_children) {
+      size_t child_id = node.next_child++;
+      ConfigBlockId child_block = find_configurable_child_block(bitstream_manager, child_block_index,
+                                                                module_manager, node, child_id);
+      ModuleId child_module = module_manager.configurable_children(node.module)[child_id]; 
+      size_t child_addr_lsb = node.addr_lsb;
+
+      /* Set address when there is a frame decoder:
+       * the child address code is the dummy codes, followed by the 
+       * binary code of the child index and the address code of the parent
+       */
+      if (0 < node.decoder_addr_size) {
+        size_t num_dummy_codes = node.max_child_addr_size - find_module_address_port_width(module_manager, child_module, addr_port_widths);
+        VTR_ASSERT(num_dummy_codes + node.decoder_addr_size <= node.addr_lsb);
+        child_addr_lsb = node.addr_lsb - node.decoder_addr_size - num_dummy_codes;
+        std::fill(addr_code.begin() + child_addr_lsb, addr_code.begin() + child_addr_lsb + num_dummy_codes, '0');
+        write_address_code(child_id - node.first_child, node.decoder_addr_size, child_addr_lsb + num_dummy_codes, addr_code);
+      }
 
-    const FabricBitId& fabric_bit = fabric_bitstream.add_bit(config_bit);
+      /* Note that the node is no longer accessible after pushing */
+      dfs_stack.push_back(build_frame_dfs_node(bitstream_manager, module_manager,
+                                               child_block, child_module, child_addr_lsb,
+                                               addr_port_widths));
+      continue;
+    }
 
-    /* Set address */
-    fabric_bitstream.set_bit_address(fabric_bit, child_addr_code);
-    
-    /* Set data input */
-    fabric_bitstream.set_bit_din(fabric_bit, bitstream_manager.bit_value(config_bit));
+    /* Ensure that there should be no configuration bits in the parent block */
+    VTR_ASSERT(0 == bitstream_manager.block_bit_range(node.block).size());
+    dfs_stack.pop_back();
   }
 }
 
@@ -377,29 +515,36 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
                                              const ModuleId& top_module,
                                              FabricBitstream& fabric_bitstream) {
 
+  /* Index the child blocks to be found by their names */
+  t_child_block_index child_block_index = build_child_block_index(bitstream_manager);
+
   switch (config_protocol.type()) {
   case CONFIG_MEM_STANDALONE: {
     /* Reserve bits before build-up */
     fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
 
-    rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, top_block,
-                                                      module_manager, top_module, 
-                                                      fabric_bitstream);
+    for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+      fabric_bitstream.add_region();
+      build_module_fabric_dependent_chain_bitstream(bitstream_manager, child_block_index, top_block,
+                                                    module_manager, top_module, config_region,
+                                                    fabric_bitstream);
+    }
     break;
   }
   case CONFIG_MEM_SCAN_CHAIN: { 
     /* Reserve bits before build-up */
     fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
 
-    rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, top_block,
-                                                      module_manager, top_module, 
-                                                      fabric_bitstream);
+    for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+      fabric_bitstream.add_region();
+      build_module_fabric_dependent_chain_bitstream(bitstream_manager, child_block_index, top_block,
+                                                    module_manager, top_module, config_region,
+                                                    fabric_bitstream);
+    }
     fabric_bitstream.reverse();
     break;
   }
   case CONFIG_MEM_MEMORY_BANK: { 
-
-    size_t cur_mem_index = 0;
     /* Find BL address port size */
     ModulePortId bl_addr_port = module_manager.find_module_port(top_module, std::string(DECODER_BL_ADDRESS_PORT_NAME));
     BasicPort bl_addr_port_info = module_manager.module_port(top_module, bl_addr_port);
@@ -408,13 +553,22 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
     ModulePortId wl_addr_port = module_manager.find_module_port(top_module, std::string(DECODER_WL_ADDRESS_PORT_NAME));
     BasicPort wl_addr_port_info = module_manager.module_port(top_module, wl_addr_port);
 
-    /* Find BL and WL decoders which are the last two configurable children*/
-    std::vector<ModuleId> configurable_children = module_manager.configurable_children(top_module);
-    VTR_ASSERT(2 <= configurable_children.size()); 
-    ModuleId bl_decoder_module = configurable_children[configurable_children.size() - 2];
-    VTR_ASSERT(0 == module_manager.configurable_child_instances(top_module)[configurable_children.size() - 2]);
-    ModuleId wl_decoder_module = configurable_children[configurable_children.size() - 1];
-    VTR_ASSERT(0 == module_manager.configurable_child_instances(top_module)[configurable_children.size() - 1]);
+    /* Each region has its own slice of the address ports */
+    size_t num_regions = module_manager.regions(top_module).size();
+    VTR_ASSERT(0 < num_regions);
+    size_t bl_addr_size = bl_addr_port_info.get_width() / num_regions;
+    size_t wl_addr_size = wl_addr_port_info.get_width() / num_regions;
+
+    /* Find BL and WL decoders which are the last two configurable children of a region 
+     * All the regions share the same decoder modules
+     */
+    const ConfigRegionId& first_region = *(module_manager.regions(top_module).begin());
+    size_t first_region_end = module_manager.region_first_configurable_child(top_module, first_region)
+                            + module_manager.region_num_configurable_children(top_module, first_region);
+    const std::vector<ModuleId>& configurable_children = module_manager.configurable_children(top_module);
+    VTR_ASSERT(2 <= first_region_end); 
+    ModuleId bl_decoder_module = configurable_children[first_region_end - 2];
+    ModuleId wl_decoder_module = configurable_children[first_region_end - 1];
 
     ModulePortId bl_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
     BasicPort bl_port_info = module_manager.module_port(bl_decoder_module, bl_port);
@@ -425,17 +579,20 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
     /* Reserve bits before build-up */
     fabric_bitstream.set_use_address(true);
     fabric_bitstream.set_use_wl_address(true);
-    fabric_bitstream.set_bl_address_length(bl_addr_port_info.get_width());
-    fabric_bitstream.set_wl_address_length(wl_addr_port_info.get_width());
+    fabric_bitstream.set_bl_address_length(bl_addr_size);
+    fabric_bitstream.set_wl_address_length(wl_addr_size);
     fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
 
-    rec_build_module_fabric_dependent_memory_bank_bitstream(bitstream_manager, top_block,
-                                                            module_manager, top_module, top_module, 
-                                                            bl_addr_port_info.get_width(),
-                                                            wl_addr_port_info.get_width(),
-                                                            bl_port_info.get_width(),
-                                                            wl_port_info.get_width(),
-                                                            cur_mem_index, fabric_bitstream);
+    for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+      fabric_bitstream.add_region();
+      build_module_fabric_dependent_memory_bank_bitstream(bitstream_manager, child_block_index, top_block,
+                                                          module_manager, top_module, config_region,
+                                                          bl_addr_size,
+                                                          wl_addr_size,
+                                                          bl_port_info.get_width(),
+                                                          wl_port_info.get_width(),
+                                                          fabric_bitstream);
+    }
     break;
   }
   case CONFIG_MEM_FRAME_BASED: {
@@ -444,17 +601,25 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
     ModulePortId addr_port = module_manager.find_module_port(top_module, std::string(DECODER_ADDRESS_PORT_NAME));
     BasicPort addr_port_info = module_manager.module_port(top_module, addr_port);
 
+    /* Each region has its own slice of the address port */
+    size_t num_regions = module_manager.regions(top_module).size();
+    VTR_ASSERT(0 < num_regions);
+
     /* Reserve bits before build-up */
     fabric_bitstream.set_use_address(true);
+    fabric_bitstream.set_address_length(addr_port_info.get_width() / num_regions);
     fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
-    fabric_bitstream.set_address_length(addr_port_info.get_width());
-
-    rec_build_module_fabric_dependent_frame_bitstream(bitstream_manager,
-                                                      std::vector<ConfigBlockId>(1, top_block),
-                                                      module_manager,
-                                                      std::vector<ModuleId>(1, top_module),
-													  std::vector<char>(),
-                                                      fabric_bitstream);
+
+    /* Cache the address port width of modules */
+    vtr::vector<ModuleId, size_t> addr_port_widths(module_manager.num_modules(), size_t(-1));
+
+    for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+      fabric_bitstream.add_region();
+      build_module_fabric_dependent_frame_bitstream(bitstream_manager, child_block_index, top_block,
+                                                    module_manager, top_module, config_region,
+                                                    addr_port_widths,
+                                                    fabric_bitstream);
+    }
     break;
   }
   default:
@@ -3,6 +3,7 @@
  * for grids (CLBs, heterogenerous blocks, I/Os, etc.)
  *******************************************************************/
 #include <cmath>
+#include <map>
 #include <string>
 
 /* Headers from vtrutil library */
@@ -27,6 +28,7 @@
 #include "module_manager_utils.h"
 
 #include "build_mux_bitstream.h"
+#include "build_bitstream_fragments.h"
 #include "build_grid_bitstream.h"
 
 /* begin namespace openfpga */
@@ -676,6 +678,136 @@ void build_physical_block_bitstream(BitstreamManager& bitstream_manager,
 }
 
 
+/********************************************************************
+ * Accumulate all the inputs of the bitstream of a grid into a fingerprint,
+ * including the type of the grid and the physical pbs mapped to it
+ * The physical pbs are identified by the names of their pb_graph nodes, pins and nets,
+ * so that the fingerprint is the same across runs
+ *******************************************************************/
+static 
+std::string build_physical_block_bitstream_fingerprint(const AtomContext& atom_ctx,
+                                                       const VprClusteringAnnotation& cluster_annotation,
+                                                       const VprPlacementAnnotation& place_annotation,
+                                                       const DeviceGrid& grids,
+                                                       const vtr::Point<size_t>& grid_coord,
+                                                       const e_side& border_side) {
+  FingerprintHasher hasher;
+
+  t_physical_tile_type_ptr grid_type = grids[grid_coord.x()][grid_coord.y()].type;
+  hasher.add(std::string(grid_type->name));
+  hasher.add(size_t(border_side));
+
+  for (const ClusterBlockId& grid_block : place_annotation.grid_blocks(grid_coord)) {
+    if (ClusterBlockId::INVALID() == grid_block) {
+      hasher.add(std::string("unused"));
+      continue;
+    }
+    const PhysicalPb& phy_pb = cluster_annotation.physical_pb(grid_block);
+    for (const PhysicalPbId& pb : phy_pb.pbs()) {
+      const t_pb_graph_node* pb_graph_node = phy_pb.pb_graph_node(pb);
+      hasher.add(pb_graph_node->hierarchical_type_name());
+
+      for (const size_t& mode_bit : phy_pb.mode_bits(pb)) {
+        hasher.add(mode_bit);
+      }
+
+      /* Nets mapped to the pins */
+      std::vector<t_pb_graph_pin*> pb_graph_pins;
+      for (int iport = 0; iport < pb_graph_node->num_input_ports; ++iport) {
+        for (int ipin = 0; ipin < pb_graph_node->num_input_pins[iport]; ++ipin) {
+          pb_graph_pins.push_back(&(pb_graph_node->input_pins[iport][ipin]));
+        }
+      }
+      for (int iport = 0; iport < pb_graph_node->num_output_ports; ++iport) {
+        for (int ipin = 0; ipin < pb_graph_node->num_output_pins[iport]; ++ipin) {
+          pb_graph_pins.push_back(&(pb_graph_node->output_pins[iport][ipin]));
+        }
+      }
+      for (int iport = 0; iport < pb_graph_node->num_clock_ports; ++iport) {
+        for (int ipin = 0; ipin < pb_graph_node->num_clock_pins[iport]; ++ipin) {
+          pb_graph_pins.push_back(&(pb_graph_node->clock_pins[iport][ipin]));
+        }
+      }
+      for (const t_pb_graph_pin* pb_graph_pin : pb_graph_pins) {
+        AtomNetId atom_net = phy_pb.pb_graph_pin_atom_net(pb, pb_graph_pin);
+        if (AtomNetId::INVALID() == atom_net) {
+          continue;
+        }
+        hasher.add(size_t(pb_graph_pin->pin_count_in_cluster));
+        hasher.add(atom_ctx.nlist.net_name(atom_net));
+      }
+
+      /* Truth tables, which are sorted by pins rather than pointers */
+      std::map<int, AtomNetlist::TruthTable> truth_tables;
+      for (const auto& truth_table : phy_pb.truth_tables(pb)) {
+        truth_tables[truth_table.first->pin_count_in_cluster] = truth_table.second;
+      }
+      for (const auto& truth_table : truth_tables) {
+        hasher.add(size_t(truth_table.first));
+        for (const std::vector<vtr::LogicValue>& cube : truth_table.second) {
+          std::string cube_str;
+          for (const vtr::LogicValue& value : cube) {
+            cube_str.push_back('0' + char(value));
+          }
+          hasher.add(cube_str);
+        }
+      }
+    }
+  }
+
+  return hasher.fingerprint();
+}
+
+/********************************************************************
+ * Generate bitstreams for a list of grids with a given number of threads
+ * The bitstream of each grid is built as a fragment, and fragments are
+ * merged in the sequence of the list, so the bitstream is the same 
+ * regardless of the number of threads
+ * Grids whose fingerprints are unchanged reuse the bitstream of a previous run
+ *******************************************************************/
+static 
+void build_physical_block_bitstreams(BitstreamManager& bitstream_manager,
+                                     const ConfigBlockId& top_block,
+                                     const ModuleManager& module_manager,
+                                     const CircuitLibrary& circuit_lib,
+                                     const MuxLibrary& mux_lib,
+                                     const AtomContext& atom_ctx,
+                                     const VprDeviceAnnotation& device_annotation,
+                                     const VprClusteringAnnotation& cluster_annotation,
+                                     const VprPlacementAnnotation& place_annotation,
+                                     const DeviceGrid& grids,
+                                     const std::vector<vtr::Point<size_t>>& grid_coords,
+                                     const std::vector<e_side>& border_sides,
+                                     IncrementalBitstream& incremental_bitstream,
+                                     const size_t& num_threads) {
+  VTR_ASSERT(grid_coords.size() == border_sides.size());
+
+  /* Names of grid blocks, which are the same as the grid instances in top module */
+  std::string grid_module_name_prefix(GRID_MODULE_NAME_PREFIX);
+  std::vector<std::string> grid_block_names;
+  grid_block_names.reserve(grid_coords.size());
+  for (size_t igrid = 0; igrid < grid_coords.size(); ++igrid) {
+    t_physical_tile_type_ptr grid_type = grids[grid_coords[igrid].x()][grid_coords[igrid].y()].type;
+    grid_block_names.push_back(generate_grid_block_instance_name(grid_module_name_prefix, std::string(grid_type->name), 
+                                                                 is_io_type(grid_type), border_sides[igrid], grid_coords[igrid]));
+  }
+
+  build_incremental_bitstream_fragments(bitstream_manager, top_block, 
+                                        incremental_bitstream, grid_block_names, num_threads,
+                                        [&](const size_t& igrid) {
+    return build_physical_block_bitstream_fingerprint(atom_ctx, cluster_annotation, place_annotation,
+                                                      grids, grid_coords[igrid], border_sides[igrid]);
+  },
+                                        [&](BitstreamManager& fragment, const ConfigBlockId& fragment_top_block, const size_t& igrid) {
+    build_physical_block_bitstream(fragment, fragment_top_block, module_manager,
+                                   circuit_lib, mux_lib,
+                                   atom_ctx,
+                                   device_annotation, cluster_annotation,
+                                   place_annotation,
+                                   grids, grid_coords[igrid], border_sides[igrid]);
+  });
+}
+
 /********************************************************************
  * Top-level function of this file: 
  * Generate bitstreams for all the grids, including 
@@ -692,11 +824,14 @@ void build_grid_bitstream(BitstreamManager& bitstream_manager,
                           const VprDeviceAnnotation& device_annotation,
                           const VprClusteringAnnotation& cluster_annotation,
                           const VprPlacementAnnotation& place_annotation,
+                          IncrementalBitstream& incremental_bitstream,
+                          const size_t& num_threads,
                           const bool& verbose) {
 
   VTR_LOGV(verbose, "Generating bitstream for core grids...");
 
-  /* Generate bitstream for the core logic block one by one */
+  /* Collect the core logic blocks, whose bitstream is generated one by one */
+  std::vector<vtr::Point<size_t>> core_coordinates;
   for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
     for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
       /* Bypass EMPTY grid */
@@ -711,15 +846,18 @@ void build_grid_bitstream(BitstreamManager& bitstream_manager,
       /* We should not meet any I/O grid */
       VTR_ASSERT(true != is_io_type(grids[ix][iy].type));
       /* Add a grid module to top_module*/
-      vtr::Point<size_t> grid_coord(ix, iy);
-      build_physical_block_bitstream(bitstream_manager, top_block, module_manager,
-                                     circuit_lib, mux_lib,
-                                     atom_ctx,
-                                     device_annotation, cluster_annotation,
-                                     place_annotation,
-                                     grids, grid_coord, NUM_SIDES);
+      core_coordinates.push_back(vtr::Point<size_t>(ix, iy));
     }
   }
+  build_physical_block_bitstreams(bitstream_manager, top_block, module_manager,
+                                  circuit_lib, mux_lib,
+                                  atom_ctx,
+                                  device_annotation, cluster_annotation,
+                                  place_annotation,
+                                  grids, core_coordinates,
+                                  std::vector<e_side>(core_coordinates.size(), NUM_SIDES),
+                                  incremental_bitstream,
+                                  num_threads);
   VTR_LOGV(verbose, "Done\n");
 
   VTR_LOGV(verbose, "Generating bitstream for I/O grids...");
@@ -748,7 +886,9 @@ void build_grid_bitstream(BitstreamManager& bitstream_manager,
     io_coordinates[LEFT].push_back(vtr::Point<size_t>(0, iy));
   }
 
-  /* Add instances of I/O grids to top_module */
+  /* Collect the I/O grids in the sequence of instances in top_module */
+  std::vector<vtr::Point<size_t>> io_grid_coordinates;
+  std::vector<e_side> io_grid_sides;
   for (const e_side& io_side : io_sides) {
     for (const vtr::Point<size_t>& io_coordinate : io_coordinates[io_side]) {
       /* Bypass EMPTY grid */
@@ -760,14 +900,18 @@ void build_grid_bitstream(BitstreamManager& bitstream_manager,
         || (0 < grids[io_coordinate.x()][io_coordinate.y()].height_offset) ) {
         continue;
       }
-      build_physical_block_bitstream(bitstream_manager, top_block, module_manager,
-                                     circuit_lib, mux_lib,
-                                     atom_ctx,
-                                     device_annotation, cluster_annotation, 
-                                     place_annotation,
-                                     grids, io_coordinate, io_side);
+      io_grid_coordinates.push_back(io_coordinate);
+      io_grid_sides.push_back(io_side);
     }
   }
+  build_physical_block_bitstreams(bitstream_manager, top_block, module_manager,
+                                  circuit_lib, mux_lib,
+                                  atom_ctx,
+                                  device_annotation, cluster_annotation, 
+                                  place_annotation,
+                                  grids, io_grid_coordinates, io_grid_sides,
+                                  incremental_bitstream,
+                                  num_threads);
   VTR_LOGV(verbose, "Done\n");
 }
 
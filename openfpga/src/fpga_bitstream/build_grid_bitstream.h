@@ -14,6 +14,7 @@
 #include "vpr_device_annotation.h"
 #include "vpr_clustering_annotation.h"
 #include "vpr_placement_annotation.h"
+#include "incremental_bitstream.h"
 
 /********************************************************************
  * Function declaration
@@ -32,6 +33,8 @@ void build_grid_bitstream(BitstreamManager& bitstream_manager,
                           const VprDeviceAnnotation& device_annotation,
                           const VprClusteringAnnotation& cluster_annotation,
                           const VprPlacementAnnotation& place_annotation,
+                          IncrementalBitstream& incremental_bitstream,
+                          const size_t& num_threads,
                           const bool& verbose);
 
 } /* end namespace openfpga */
@@ -52,7 +52,8 @@ size_t find_mux_default_path_id(const CircuitLibrary& circuit_lib,
  * Thanks to MuxGraph object has already describe the internal multiplexing 
  * structure, bitstream generation is simply done by routing the signal
  * to from a given input to the output
- * All the memory bits can be generated by an API of MuxGraph
+ * All the memory bits have been decoded for each input when 
+ * the MuxGraph is added to MuxLibrary, which are copied here
  *
  * To be generic, this function only returns a vector bit values
  * without touching an bitstream-relate data structure
@@ -70,7 +71,7 @@ std::vector<bool> build_cmos_mux_bitstream(const CircuitLibrary& circuit_lib,
   size_t implemented_mux_size = find_mux_implementation_num_inputs(circuit_lib, mux_model, mux_size);
   /* Note that the mux graph is indexed using datapath MUX size!!!! */
   MuxId mux_graph_id = mux_lib.mux_graph(mux_model, mux_size);
-  const MuxGraph mux_graph = mux_lib.mux_graph(mux_graph_id);
+  const MuxGraph& mux_graph = mux_lib.mux_graph(mux_graph_id);
 
   size_t datapath_id = path_id;
 
@@ -81,25 +82,20 @@ std::vector<bool> build_cmos_mux_bitstream(const CircuitLibrary& circuit_lib,
     VTR_ASSERT( datapath_id < mux_size);
   }
   /* Path id should makes sense */
-  VTR_ASSERT(datapath_id < mux_graph.inputs().size());
+  VTR_ASSERT(datapath_id < mux_graph.num_inputs());
   /* We should have only one output for this MUX! */
-  VTR_ASSERT(1 == mux_graph.outputs().size());
+  VTR_ASSERT(1 == mux_graph.num_outputs());
 
   /* Generate the memory bits */
-  vtr::vector<MuxMemId, bool> raw_bitstream = mux_graph.decode_memory_bits(MuxInputId(datapath_id), mux_graph.output_id(mux_graph.outputs()[0]));
-
-  std::vector<bool> mux_bitstream;
-  for (const bool& bit : raw_bitstream) {
-    mux_bitstream.push_back(bit);
-  }
+  std::vector<bool> raw_bitstream = mux_lib.decode_memory_bits(mux_graph_id, MuxInputId(datapath_id));
 
   /* Consider local encoder support, we need further encode the bitstream */
   if (false == circuit_lib.mux_use_local_encoder(mux_model)) {
-    return mux_bitstream;
+    return raw_bitstream;
   }
 
-  /* Clear the mux_bitstream, we need to apply encoding */
-  mux_bitstream.clear();
+  /* We need to apply encoding */
+  std::vector<bool> mux_bitstream;
 
   /* Encode the memory bits level by level,
    * One local encoder is used for each level of multiplexers 
@@ -113,14 +109,14 @@ std::vector<bool> build_cmos_mux_bitstream(const CircuitLibrary& circuit_lib,
 
     /* Exception: there is only 1 memory at this level, bitstream will not be changed!!! */
     if (1 == mux_graph.memories_at_level(level).size()) {
-      mux_bitstream.push_back(raw_bitstream[mux_graph.memories_at_level(level)[0]]);
+      mux_bitstream.push_back(raw_bitstream[size_t(mux_graph.memories_at_level(level)[0])]);
       continue;
     }
 
     /* Otherwise: we follow a regular recipe */
     for (size_t mem_index = 0; mem_index < mux_graph.memories_at_level(level).size(); ++mem_index) {
       /* Conversion rule: true = 1, false = 0 */
-      if (true == raw_bitstream[mux_graph.memories_at_level(level)[mem_index]]) {
+      if (true == raw_bitstream[size_t(mux_graph.memories_at_level(level)[mem_index])]) {
         encoder_data.push_back(mem_index);
       } 
     }
@@ -22,6 +22,7 @@
 
 #include "mux_bitstream_constants.h"
 #include "build_mux_bitstream.h"
+#include "build_bitstream_fragments.h"
 #include "build_routing_bitstream.h"
 
 /* begin namespace openfpga */
@@ -415,8 +416,92 @@ void build_connection_block_bitstream(BitstreamManager& bitstream_manager,
   }
 }
 
+/********************************************************************
+ * Accumulate the routing results of a node into a fingerprint,
+ * including the net mapped to the node, its previous node, 
+ * and the nets mapped to its driver nodes
+ * The nets are identified by names, so that the fingerprint is the same across runs
+ *******************************************************************/
+static 
+void add_rr_node_routing_to_fingerprint(FingerprintHasher& hasher,
+                                        const AtomContext& atom_ctx,
+                                        const VprRoutingAnnotation& routing_annotation,
+                                        const RRGraph& rr_graph,
+                                        const RRNodeId& rr_node) {
+  hasher.add(size_t(rr_node));
+
+  AtomNetId atom_net = atom_ctx.lookup.atom_net(routing_annotation.rr_node_net(rr_node));
+  if (true == atom_ctx.nlist.valid_net_id(atom_net)) {
+    hasher.add(atom_ctx.nlist.net_name(atom_net));
+    hasher.add(size_t(routing_annotation.rr_node_prev_node(rr_node)));
+  } else {
+    hasher.add(std::string("unmapped"));
+  }
+
+  for (const RREdgeId& edge : rr_graph.node_in_edges(rr_node)) {
+    RRNodeId driver_node = rr_graph.edge_src_node(edge);
+    hasher.add(size_t(driver_node));
+    AtomNetId driver_atom_net = atom_ctx.lookup.atom_net(routing_annotation.rr_node_net(driver_node));
+    if (true == atom_ctx.nlist.valid_net_id(driver_atom_net)) {
+      hasher.add(atom_ctx.nlist.net_name(driver_atom_net));
+    } else {
+      hasher.add(std::string("unmapped"));
+    }
+  }
+}
+
+/********************************************************************
+ * Accumulate all the inputs of the bitstream of a Switch Block into a fingerprint,
+ * which are the routing results of the output nodes
+ *******************************************************************/
+static 
+std::string build_switch_block_bitstream_fingerprint(const AtomContext& atom_ctx,
+                                                     const VprRoutingAnnotation& routing_annotation,
+                                                     const RRGraph& rr_graph,
+                                                     const RRGSB& rr_gsb) {
+  FingerprintHasher hasher;
+
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(side_manager.get_side()); ++itrack) {
+      if (OUT_PORT != rr_gsb.get_chan_node_direction(side_manager.get_side(), itrack)) {
+        continue;
+      }
+      add_rr_node_routing_to_fingerprint(hasher, atom_ctx, routing_annotation, rr_graph,
+                                         rr_gsb.get_chan_node(side_manager.get_side(), itrack));
+    }
+  }
+
+  return hasher.fingerprint();
+}
+
+/********************************************************************
+ * Accumulate all the inputs of the bitstream of a Connection Block into a fingerprint,
+ * which are the routing results of the IPIN nodes
+ *******************************************************************/
+static 
+std::string build_connection_block_bitstream_fingerprint(const AtomContext& atom_ctx,
+                                                         const VprRoutingAnnotation& routing_annotation,
+                                                         const RRGraph& rr_graph,
+                                                         const RRGSB& rr_gsb,
+                                                         const t_rr_type& cb_type) {
+  FingerprintHasher hasher;
+
+  for (const e_side& cb_ipin_side : rr_gsb.get_cb_ipin_sides(cb_type)) {
+    for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(cb_ipin_side); ++inode) { 
+      add_rr_node_routing_to_fingerprint(hasher, atom_ctx, routing_annotation, rr_graph,
+                                         rr_gsb.get_ipin_node(cb_ipin_side, inode));
+    }
+  }
+
+  return hasher.fingerprint();
+}
+
 /********************************************************************
  * Create bitstream for a X-direction or Y-direction Connection Blocks
+ * The bitstream of each connection block is built as a fragment, 
+ * and fragments are merged in the sequence of the GSB coordinates,
+ * so the bitstream is the same regardless of the number of threads
  *******************************************************************/
 static 
 void build_connection_block_bitstreams(BitstreamManager& bitstream_manager,
@@ -430,9 +515,14 @@ void build_connection_block_bitstreams(BitstreamManager& bitstream_manager,
                                        const RRGraph& rr_graph,
                                        const DeviceRRGSB& device_rr_gsb,
                                        const bool& compact_routing_hierarchy,
-                                       const t_rr_type& cb_type) {
+                                       const t_rr_type& cb_type,
+                                       IncrementalBitstream& incremental_bitstream,
+                                       const size_t& num_threads) {
 
+  /* Collect the connection blocks which contain any configuration bits */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
+  std::vector<vtr::Point<size_t>> gsb_coords;
+  std::vector<std::string> cb_block_names;
 
   for (size_t ix = 0; ix < cb_range.x(); ++ix) {
     for (size_t iy = 0; iy < cb_range.y(); ++iy) {
@@ -448,37 +538,130 @@ void build_connection_block_bitstreams(BitstreamManager& bitstream_manager,
       if (true == connection_block_contain_only_routing_tracks(rr_gsb, cb_type)) {
         continue;
       }
+      gsb_coords.push_back(vtr::Point<size_t>(ix, iy));
+      cb_block_names.push_back(generate_connection_block_module_name(cb_type, vtr::Point<size_t>(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type))));
+    }
+  }
 
-      /* Find the cb module so that we can precisely reserve child blocks */
-      vtr::Point<size_t> cb_coord(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
-      std::string cb_module_name = generate_connection_block_module_name(cb_type, cb_coord);
-      if (true == compact_routing_hierarchy) {
-        vtr::Point<size_t> unique_cb_coord(ix, iy);
-        /* Note: use GSB coordinate when inquire for unique modules!!! */
-        const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, unique_cb_coord);
-        unique_cb_coord.set_x(unique_mirror.get_cb_x(cb_type)); 
-        unique_cb_coord.set_y(unique_mirror.get_cb_y(cb_type)); 
-        cb_module_name = generate_connection_block_module_name(cb_type, unique_cb_coord);
-      } 
-      ModuleId cb_module = module_manager.find_module(cb_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
-
-      /* Create a block for the bitstream which corresponds to the Switch block */
-      ConfigBlockId cb_configurable_block = bitstream_manager.add_block(generate_connection_block_module_name(cb_type, cb_coord));
-      /* Set switch block as a child of top block */
-      bitstream_manager.add_child_block(top_configurable_block, cb_configurable_block);
-
-      /* Reserve child blocks for new created block */
-      bitstream_manager.reserve_child_blocks(cb_configurable_block,
-                                             count_module_manager_module_configurable_children(module_manager, cb_module)); 
-  
-      build_connection_block_bitstream(bitstream_manager, cb_configurable_block, module_manager,  
-                                       circuit_lib, mux_lib,
-                                       atom_ctx, device_annotation, routing_annotation,
-                                       rr_graph,
-                                       rr_gsb, cb_type);
+  build_incremental_bitstream_fragments(bitstream_manager, top_configurable_block,
+                                        incremental_bitstream, cb_block_names, num_threads,
+                                        [&](const size_t& igsb) {
+    return build_connection_block_bitstream_fingerprint(atom_ctx, routing_annotation, rr_graph,
+                                                        device_rr_gsb.get_gsb(gsb_coords[igsb]), cb_type);
+  },
+                                        [&](BitstreamManager& fragment, const ConfigBlockId& fragment_top_block, const size_t& igsb) {
+    const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coords[igsb]);
+
+    /* Find the cb module so that we can precisely reserve child blocks */
+    vtr::Point<size_t> cb_coord(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
+    std::string cb_module_name = generate_connection_block_module_name(cb_type, cb_coord);
+    if (true == compact_routing_hierarchy) {
+      vtr::Point<size_t> unique_cb_coord(gsb_coords[igsb]);
+      /* Note: use GSB coordinate when inquire for unique modules!!! */
+      const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, unique_cb_coord);
+      unique_cb_coord.set_x(unique_mirror.get_cb_x(cb_type)); 
+      unique_cb_coord.set_y(unique_mirror.get_cb_y(cb_type)); 
+      cb_module_name = generate_connection_block_module_name(cb_type, unique_cb_coord);
+    } 
+    ModuleId cb_module = module_manager.find_module(cb_module_name);
+    VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
+
+    /* Create a block for the bitstream which corresponds to the Switch block */
+    ConfigBlockId cb_configurable_block = fragment.add_block(generate_connection_block_module_name(cb_type, cb_coord));
+    /* Set switch block as a child of top block */
+    fragment.add_child_block(fragment_top_block, cb_configurable_block);
+
+    /* Reserve child blocks for new created block */
+    fragment.reserve_child_blocks(cb_configurable_block,
+                                  count_module_manager_module_configurable_children(module_manager, cb_module)); 
+
+    build_connection_block_bitstream(fragment, cb_configurable_block, module_manager,  
+                                     circuit_lib, mux_lib,
+                                     atom_ctx, device_annotation, routing_annotation,
+                                     rr_graph,
+                                     rr_gsb, cb_type);
+  });
+}
+
+/********************************************************************
+ * Create bitstream for all the Switch Blocks
+ * The bitstream of each switch block is built as a fragment, 
+ * and fragments are merged in the sequence of the GSB coordinates,
+ * so the bitstream is the same regardless of the number of threads
+ *******************************************************************/
+static 
+void build_switch_block_bitstreams(BitstreamManager& bitstream_manager,
+                                   const ConfigBlockId& top_configurable_block,
+                                   const ModuleManager& module_manager,
+                                   const CircuitLibrary& circuit_lib,
+                                   const MuxLibrary& mux_lib,
+                                   const AtomContext& atom_ctx,
+                                   const VprDeviceAnnotation& device_annotation,
+                                   const VprRoutingAnnotation& routing_annotation,
+                                   const RRGraph& rr_graph,
+                                   const DeviceRRGSB& device_rr_gsb,
+                                   const bool& compact_routing_hierarchy,
+                                   IncrementalBitstream& incremental_bitstream,
+                                   const size_t& num_threads) {
+
+  /* Collect the switch blocks in the device */
+  vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
+  std::vector<vtr::Point<size_t>> gsb_coords;
+  std::vector<std::string> sb_block_names;
+
+  for (size_t ix = 0; ix < sb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < sb_range.y(); ++iy) {
+      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+      /* Check if the switch block exists in the device!
+       * Some of them do NOT exist due to heterogeneous blocks (width > 1) 
+       * We will skip those modules
+       */
+      if (false == rr_gsb.is_sb_exist()) {
+        continue;
+      }
+      gsb_coords.push_back(vtr::Point<size_t>(ix, iy));
+      sb_block_names.push_back(generate_switch_block_module_name(vtr::Point<size_t>(rr_gsb.get_sb_x(), rr_gsb.get_sb_y())));
     }
   }
+
+  build_incremental_bitstream_fragments(bitstream_manager, top_configurable_block,
+                                        incremental_bitstream, sb_block_names, num_threads,
+                                        [&](const size_t& igsb) {
+    return build_switch_block_bitstream_fingerprint(atom_ctx, routing_annotation, rr_graph,
+                                                    device_rr_gsb.get_gsb(gsb_coords[igsb]));
+  },
+                                        [&](BitstreamManager& fragment, const ConfigBlockId& fragment_top_block, const size_t& igsb) {
+    const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coords[igsb]);
+
+    vtr::Point<size_t> sb_coord(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+
+    /* Find the sb module so that we can precisely reserve child blocks */
+    std::string sb_module_name = generate_switch_block_module_name(sb_coord);
+    if (true == compact_routing_hierarchy) {
+      vtr::Point<size_t> unique_sb_coord(gsb_coords[igsb]);
+      const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(sb_coord);
+      unique_sb_coord.set_x(unique_mirror.get_sb_x()); 
+      unique_sb_coord.set_y(unique_mirror.get_sb_y()); 
+      sb_module_name = generate_switch_block_module_name(unique_sb_coord);
+    } 
+    ModuleId sb_module = module_manager.find_module(sb_module_name);
+    VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
+
+    /* Create a block for the bitstream which corresponds to the Switch block */
+    ConfigBlockId sb_configurable_block = fragment.add_block(generate_switch_block_module_name(sb_coord));
+    /* Set switch block as a child of top block */
+    fragment.add_child_block(fragment_top_block, sb_configurable_block);
+
+    /* Reserve child blocks for new created block */
+    fragment.reserve_child_blocks(sb_configurable_block,
+                                  count_module_manager_module_configurable_children(module_manager, sb_module)); 
+
+    build_switch_block_bitstream(fragment, sb_configurable_block, module_manager,  
+                                 circuit_lib, mux_lib,
+                                 atom_ctx, device_annotation, routing_annotation,
+                                 rr_graph,
+                                 rr_gsb);
+  });
 }
 
 /********************************************************************
@@ -497,55 +680,24 @@ void build_routing_bitstream(BitstreamManager& bitstream_manager,
                              const VprRoutingAnnotation& routing_annotation,
                              const RRGraph& rr_graph,
                              const DeviceRRGSB& device_rr_gsb,
-                             const bool& compact_routing_hierarchy) {
+                             const bool& compact_routing_hierarchy,
+                             IncrementalBitstream& incremental_bitstream,
+                             const size_t& num_threads) {
 
   /* Generate bitstream for each switch blocks
    * To organize the bitstream in blocks, we create a block for each switch block 
    * and give names which are same as they are in top-level module managers
    */
   VTR_LOG("Generating bitstream for Switch blocks...");
-  vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
-  for (size_t ix = 0; ix < sb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < sb_range.y(); ++iy) {
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      /* Check if the switch block exists in the device!
-       * Some of them do NOT exist due to heterogeneous blocks (width > 1) 
-       * We will skip those modules
-       */
-      if (false == rr_gsb.is_sb_exist()) {
-        continue;
-      }
 
-      vtr::Point<size_t> sb_coord(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
-
-      /* Find the sb module so that we can precisely reserve child blocks */
-      std::string sb_module_name = generate_switch_block_module_name(sb_coord);
-      if (true == compact_routing_hierarchy) {
-        vtr::Point<size_t> unique_sb_coord(ix, iy);
-        const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(sb_coord);
-        unique_sb_coord.set_x(unique_mirror.get_sb_x()); 
-        unique_sb_coord.set_y(unique_mirror.get_sb_y()); 
-        sb_module_name = generate_switch_block_module_name(unique_sb_coord);
-      } 
-      ModuleId sb_module = module_manager.find_module(sb_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
-
-      /* Create a block for the bitstream which corresponds to the Switch block */
-      ConfigBlockId sb_configurable_block = bitstream_manager.add_block(generate_switch_block_module_name(sb_coord));
-      /* Set switch block as a child of top block */
-      bitstream_manager.add_child_block(top_configurable_block, sb_configurable_block);
-
-      /* Reserve child blocks for new created block */
-      bitstream_manager.reserve_child_blocks(sb_configurable_block,
-                                             count_module_manager_module_configurable_children(module_manager, sb_module)); 
-
-      build_switch_block_bitstream(bitstream_manager, sb_configurable_block, module_manager,  
-                                   circuit_lib, mux_lib,
-                                   atom_ctx, device_annotation, routing_annotation,
-                                   rr_graph,
-                                   rr_gsb);
-    }
-  }
+  build_switch_block_bitstreams(bitstream_manager, top_configurable_block, module_manager,  
+                                circuit_lib, mux_lib,
+                                atom_ctx, device_annotation, routing_annotation,
+                                rr_graph,
+                                device_rr_gsb,
+                                compact_routing_hierarchy,
+                                incremental_bitstream,
+                                num_threads);
   VTR_LOG("Done\n");
 
   /* Generate bitstream for each connection blocks
@@ -560,7 +712,9 @@ void build_routing_bitstream(BitstreamManager& bitstream_manager,
                                     rr_graph,
                                     device_rr_gsb,
                                     compact_routing_hierarchy,
-                                    CHANX);
+                                    CHANX,
+                                    incremental_bitstream,
+                                    num_threads);
   VTR_LOG("Done\n");
 
   VTR_LOG("Generating bitstream for Y-direction Connection blocks ...");
@@ -571,7 +725,9 @@ void build_routing_bitstream(BitstreamManager& bitstream_manager,
                                     rr_graph,
                                     device_rr_gsb,
                                     compact_routing_hierarchy,
-                                    CHANY);
+                                    CHANY,
+                                    incremental_bitstream,
+                                    num_threads);
   VTR_LOG("Done\n");
 
 }
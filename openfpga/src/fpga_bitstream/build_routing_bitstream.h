@@ -16,6 +16,7 @@
 #include "device_rr_gsb.h"
 #include "vpr_device_annotation.h"
 #include "vpr_routing_annotation.h"
+#include "incremental_bitstream.h"
 
 /********************************************************************
  * Function declaration
@@ -34,7 +35,9 @@ void build_routing_bitstream(BitstreamManager& bitstream_manager,
                              const VprRoutingAnnotation& routing_annotation,
                              const RRGraph& rr_graph,
                              const DeviceRRGSB& device_rr_gsb,
-                             const bool& compact_routing_hierarchy);
+                             const bool& compact_routing_hierarchy,
+                             IncrementalBitstream& incremental_bitstream,
+                             const size_t& num_threads);
 
 } /* end namespace openfpga */
 
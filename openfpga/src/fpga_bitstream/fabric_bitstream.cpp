@@ -4,7 +4,6 @@
 #include <algorithm>
 
 #include "vtr_assert.h"
-#include "openfpga_decode.h"
 #include "fabric_bitstream.h"
 
 /* begin namespace openfpga */
@@ -16,8 +15,12 @@ namespace openfpga {
 FabricBitstream::FabricBitstream() {
   num_bits_ = 0;
   invalid_bit_ids_.clear();
+  use_address_ = false;
+  use_wl_address_ = false;
   address_length_ = 0;
   wl_address_length_ = 0;
+  address_num_words_ = 0;
+  wl_address_num_words_ = 0;
 }
 
 /**************************************************
@@ -33,6 +36,31 @@ FabricBitstream::fabric_bit_range FabricBitstream::bits() const {
                          fabric_bit_iterator(FabricBitId(num_bits_), invalid_bit_ids_));
 }
 
+size_t FabricBitstream::num_regions() const {
+  return region_ids_.size();
+}
+
+/* Find all the configuration regions */
+FabricBitstream::fabric_bit_region_range FabricBitstream::regions() const {
+  return vtr::make_range(region_ids_.begin(), region_ids_.end());
+}
+
+/* Find all the configuration bits in a region */
+FabricBitstream::fabric_bit_range FabricBitstream::region_bits(const FabricBitRegionId& region_id) const {
+  VTR_ASSERT(true == valid_region_id(region_id));
+  size_t first_bit = region_first_bits_[region_id];
+  return vtr::make_range(fabric_bit_iterator(FabricBitId(first_bit), invalid_bit_ids_),
+                         fabric_bit_iterator(FabricBitId(first_bit + region_num_bits(region_id)), invalid_bit_ids_));
+}
+
+size_t FabricBitstream::region_num_bits(const FabricBitRegionId& region_id) const {
+  VTR_ASSERT(true == valid_region_id(region_id));
+  if (region_id == region_ids_.back()) {
+    return num_bits_ - region_first_bits_[region_id];
+  }
+  return region_first_bits_[FabricBitRegionId(size_t(region_id) + 1)] - region_first_bits_[region_id];
+}
+
 /******************************************************************************
  * Public Accessors
  ******************************************************************************/
@@ -48,7 +76,9 @@ std::vector<char> FabricBitstream::bit_address(const FabricBitId& bit_id) const
   VTR_ASSERT(true == valid_bit_id(bit_id));
   VTR_ASSERT(true == use_address_);
 
-  return itobin_charvec(bit_addresses_[bit_id], address_length_);
+  std::vector<char> address(address_length_);
+  emit_bit_address(bit_id, address.data());
+  return address;
 }
 
 std::vector<char> FabricBitstream::bit_bl_address(const FabricBitId& bit_id) const {
@@ -61,7 +91,42 @@ std::vector<char> FabricBitstream::bit_wl_address(const FabricBitId& bit_id) con
   VTR_ASSERT(true == use_address_);
   VTR_ASSERT(true == use_wl_address_);
 
-  return itobin_charvec(bit_wl_addresses_[bit_id], wl_address_length_);
+  std::vector<char> address(wl_address_length_);
+  emit_bit_wl_address(bit_id, address.data());
+  return address;
+}
+
+size_t FabricBitstream::address_length() const {
+  return address_length_;
+}
+
+size_t FabricBitstream::bl_address_length() const {
+  return address_length();
+}
+
+size_t FabricBitstream::wl_address_length() const {
+  return wl_address_length_;
+}
+
+char* FabricBitstream::emit_bit_address(const FabricBitId& bit_id, char* buffer) const {
+  /* Ensure a valid id */
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+  VTR_ASSERT(true == use_address_);
+
+  return emit_address(bit_addresses_.data() + size_t(bit_id) * address_num_words_, address_length_, buffer);
+}
+
+char* FabricBitstream::emit_bit_bl_address(const FabricBitId& bit_id, char* buffer) const {
+  return emit_bit_address(bit_id, buffer);
+}
+
+char* FabricBitstream::emit_bit_wl_address(const FabricBitId& bit_id, char* buffer) const {
+  /* Ensure a valid id */
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+  VTR_ASSERT(true == use_address_);
+  VTR_ASSERT(true == use_wl_address_);
+
+  return emit_address(bit_wl_addresses_.data() + size_t(bit_id) * wl_address_num_words_, wl_address_length_, buffer);
 }
 
 char FabricBitstream::bit_din(const FabricBitId& bit_id) const {
@@ -87,11 +152,11 @@ void FabricBitstream::reserve_bits(const size_t& num_bits) {
   config_bit_ids_.reserve(num_bits);
  
   if (true == use_address_) {
-    bit_addresses_.reserve(num_bits);
+    bit_addresses_.reserve(num_bits * address_num_words_);
     bit_dins_.reserve(num_bits);
  
     if (true == use_wl_address_) {
-      bit_wl_addresses_.reserve(num_bits);
+      bit_wl_addresses_.reserve(num_bits * wl_address_num_words_);
     }
   }
 }
@@ -102,15 +167,32 @@ FabricBitId FabricBitstream::add_bit(const ConfigBitId& config_bit_id) {
   num_bits_++;
   config_bit_ids_.push_back(config_bit_id);
 
+  if (true == use_address_) {
+    bit_addresses_.resize(num_bits_ * address_num_words_, 0);
+    bit_dins_.push_back(0);
+
+    if (true == use_wl_address_) {
+      bit_wl_addresses_.resize(num_bits_ * wl_address_num_words_, 0);
+    }
+  }
+
   return bit; 
 }
 
+FabricBitRegionId FabricBitstream::add_region() {
+  FabricBitRegionId region = FabricBitRegionId(region_ids_.size());
+  region_ids_.push_back(region);
+  region_first_bits_.push_back(num_bits_);
+
+  return region;
+}
+
 void FabricBitstream::set_bit_address(const FabricBitId& bit_id,
                                       const std::vector<char>& address) {
   VTR_ASSERT(true == valid_bit_id(bit_id));
   VTR_ASSERT(true == use_address_);
   VTR_ASSERT(address_length_ == address.size());
-  bit_addresses_[bit_id] = bintoi_charvec(address);
+  pack_address(address, bit_addresses_.data() + size_t(bit_id) * address_num_words_);
 }
 
 void FabricBitstream::set_bit_bl_address(const FabricBitId& bit_id,
@@ -124,7 +206,7 @@ void FabricBitstream::set_bit_wl_address(const FabricBitId& bit_id,
   VTR_ASSERT(true == use_address_);
   VTR_ASSERT(true == use_wl_address_);
   VTR_ASSERT(wl_address_length_ == address.size());
-  bit_wl_addresses_[bit_id] = bintoi_charvec(address);
+  pack_address(address, bit_wl_addresses_.data() + size_t(bit_id) * wl_address_num_words_);
 }
 
 void FabricBitstream::set_bit_din(const FabricBitId& bit_id,
@@ -135,15 +217,14 @@ void FabricBitstream::set_bit_din(const FabricBitId& bit_id,
 }
 
 void FabricBitstream::reverse() {
-  std::reverse(config_bit_ids_.begin(), config_bit_ids_.end());
-
-  if (true == use_address_) {
-    std::reverse(bit_addresses_.begin(), bit_addresses_.end());
-    std::reverse(bit_dins_.begin(), bit_dins_.end());
+  /* Without any region, the bits are reversed as a whole */
+  if (0 == region_ids_.size()) {
+    reverse_bits(0, num_bits_);
+    return;
+  }
 
-    if (true == use_wl_address_) {
-      std::reverse(bit_wl_addresses_.begin(), bit_wl_addresses_.end());
-    }
+  for (const FabricBitRegionId& region : region_ids_) {
+    reverse_bits(region_first_bits_[region], region_first_bits_[region] + region_num_bits(region));
   }
 }
 
@@ -155,8 +236,10 @@ void FabricBitstream::set_use_address(const bool& enable) {
 }
 
 void FabricBitstream::set_address_length(const size_t& length) {
-  if (true == use_address_) {
+  /* Add a lock, only can be modified when num bits are zero*/
+  if ((true == use_address_) && (0 == num_bits_)) {
     address_length_ = length; 
+    address_num_words_ = num_address_words(length);
   }
 }
 
@@ -172,8 +255,10 @@ void FabricBitstream::set_use_wl_address(const bool& enable) {
 }
 
 void FabricBitstream::set_wl_address_length(const size_t& length) {
-  if (true == use_address_) {
+  /* Add a lock, only can be modified when num bits are zero*/
+  if ((true == use_address_) && (0 == num_bits_)) {
     wl_address_length_ = length; 
+    wl_address_num_words_ = num_address_words(length);
   }
 }
 
@@ -184,4 +269,65 @@ char FabricBitstream::valid_bit_id(const FabricBitId& bit_id) const {
   return (size_t(bit_id) < num_bits_);
 }
 
+char FabricBitstream::valid_region_id(const FabricBitRegionId& region_id) const {
+  return (size_t(region_id) < region_ids_.size()) && (region_id == region_ids_[region_id]);
+}
+
+/******************************************************************************
+ * Private utilities
+ ******************************************************************************/
+size_t FabricBitstream::num_address_words(const size_t& length) const {
+  return (length + ADDRESS_WORD_SIZE - 1) / ADDRESS_WORD_SIZE;
+}
+
+char* FabricBitstream::emit_address(const uint64_t* address_words,
+                                    const size_t& length,
+                                    char* buffer) const {
+  for (size_t iword = 0; iword < num_address_words(length); ++iword) {
+    uint64_t word = address_words[iword];
+    size_t num_word_bits = length - iword * ADDRESS_WORD_SIZE;
+    if (ADDRESS_WORD_SIZE < num_word_bits) {
+      num_word_bits = ADDRESS_WORD_SIZE;
+    }
+    for (size_t ibit = 0; ibit < num_word_bits; ++ibit) {
+      *buffer = (1 == ((word >> ibit) & 1)) ? '1' : '0';
+      ++buffer;
+    }
+  }
+  return buffer;
+}
+
+void FabricBitstream::pack_address(const std::vector<char>& address,
+                                   uint64_t* address_words) const {
+  std::fill(address_words, address_words + num_address_words(address.size()), 0);
+  for (size_t ibit = 0; ibit < address.size(); ++ibit) {
+    if ('1' == address[ibit]) {
+      address_words[ibit / ADDRESS_WORD_SIZE] |= (uint64_t(1) << (ibit % ADDRESS_WORD_SIZE));
+    }
+  }
+}
+
+void FabricBitstream::reverse_bits(const size_t& first_bit, const size_t& last_bit) {
+  VTR_ASSERT(first_bit <= last_bit && last_bit <= num_bits_);
+
+  std::reverse(config_bit_ids_.begin() + first_bit, config_bit_ids_.begin() + last_bit);
+
+  if (true == use_address_) {
+    std::reverse(bit_dins_.begin() + first_bit, bit_dins_.begin() + last_bit);
+
+    /* Reverse the sequence of addresses, while keeping the words inside each address in order */
+    for (size_t ibit = first_bit, jbit = last_bit; ibit + 1 < jbit; ++ibit) {
+      --jbit;
+      std::swap_ranges(bit_addresses_.begin() + ibit * address_num_words_,
+                       bit_addresses_.begin() + (ibit + 1) * address_num_words_,
+                       bit_addresses_.begin() + jbit * address_num_words_);
+      if (true == use_wl_address_) {
+        std::swap_ranges(bit_wl_addresses_.begin() + ibit * wl_address_num_words_,
+                         bit_wl_addresses_.begin() + (ibit + 1) * wl_address_num_words_,
+                         bit_wl_addresses_.begin() + jbit * wl_address_num_words_);
+      }
+    }
+  }
+}
+
 } /* end namespace openfpga */
@@ -24,10 +24,28 @@
  *    and multiple child block
  * 2. Each bit inside BitstreamManager should have only 1 parent block 
  * 
+ * Addresses
+ * ---------
+ * Addresses of configuration bits (for memory decoders) can be of any width.
+ * They are stored as packed bit fields, each of which occupies a fixed number of
+ * 64-bit words. For each address, the n-th character in its binary representation
+ * is bit (n % 64) of the (n / 64)-th word.
+ * Writers with large bitstreams should use the emit_*() accessors, 
+ * which output an address into a buffer without any memory allocation.
+ * 
+ * Regions
+ * -------
+ * The bits are grouped into configuration regions, each of which is
+ * a contiguous range of bits that is loaded through its own configuration ports.
+ * All the regions are configured in parallel. Each bit belongs to the region
+ * which was the last one added before the bit. The addresses of a bit
+ * are local to its region.
+ * 
  ******************************************************************************/
 #ifndef FABRIC_BITSTREAM_H
 #define FABRIC_BITSTREAM_H
 
+#include <cstdint>
 #include <vector>
 #include <unordered_set>
 #include <unordered_map>
@@ -93,8 +111,10 @@ class FabricBitstream {
     class lazy_id_iterator;
 
     typedef lazy_id_iterator<FabricBitId> fabric_bit_iterator;
+    typedef vtr::vector<FabricBitRegionId, FabricBitRegionId>::const_iterator fabric_bit_region_iterator;
 
     typedef vtr::Range<fabric_bit_iterator> fabric_bit_range;
+    typedef vtr::Range<fabric_bit_region_iterator> fabric_bit_region_range;
 
   public: /* Public constructor */
     FabricBitstream();
@@ -104,6 +124,14 @@ class FabricBitstream {
     size_t num_bits() const;
     fabric_bit_range bits() const;
 
+    /* Find all the configuration regions */
+    size_t num_regions() const;
+    fabric_bit_region_range regions() const;
+
+    /* Find all the configuration bits in a region */
+    fabric_bit_range region_bits(const FabricBitRegionId& region_id) const;
+    size_t region_num_bits(const FabricBitRegionId& region_id) const;
+
   public:  /* Public Accessors */
     /* Find the configuration bit id in architecture bitstream database */
     ConfigBitId config_bit(const FabricBitId& bit_id) const;
@@ -113,6 +141,20 @@ class FabricBitstream {
     std::vector<char> bit_bl_address(const FabricBitId& bit_id) const;
     std::vector<char> bit_wl_address(const FabricBitId& bit_id) const;
 
+    /* Find the length of addresses, i.e., the number of characters in their binary representation */
+    size_t address_length() const;
+    size_t bl_address_length() const;
+    size_t wl_address_length() const;
+
+    /* Output the binary representation ('0' or '1') of the address of a bit 
+     * to a buffer, which should be able to hold the length of the address.
+     * Return the position in the buffer just after the last character written.
+     * No memory allocation is involved, which is the preferred way for writers
+     */
+    char* emit_bit_address(const FabricBitId& bit_id, char* buffer) const;
+    char* emit_bit_bl_address(const FabricBitId& bit_id, char* buffer) const;
+    char* emit_bit_wl_address(const FabricBitId& bit_id, char* buffer) const;
+
     /* Find the data-in of bitstream */
     char bit_din(const FabricBitId& bit_id) const;
 
@@ -127,6 +169,11 @@ class FabricBitstream {
     /* Add a new configuration bit to the bitstream manager */
     FabricBitId add_bit(const ConfigBitId& config_bit_id);
 
+    /* Add a new configuration region, which will include
+     * all the bits to be added until the next region is added 
+     */
+    FabricBitRegionId add_region();
+
     void set_bit_address(const FabricBitId& bit_id,
                          const std::vector<char>& address);
 
@@ -139,7 +186,7 @@ class FabricBitstream {
     void set_bit_din(const FabricBitId& bit_id,
                      const char& din);
 
-    /* Reverse bit sequence of the fabric bitstream
+    /* Reverse bit sequence of the fabric bitstream inside each region
      * This is required by configuration chain protocol 
      */
     void reverse();
@@ -149,7 +196,8 @@ class FabricBitstream {
      * and users can access/modify the data
      * Otherwise, it will NOT be allocated and accessible.
      *
-     * This function is only applicable before any bits are added
+     * These functions, including the ones setting address lengths,
+     * are only applicable before any bits are added
      */
     void set_use_address(const bool& enable);
     void set_address_length(const size_t& length);
@@ -163,6 +211,21 @@ class FabricBitstream {
 
   public:  /* Public Validators */
     char valid_bit_id(const FabricBitId& bit_id) const;
+    char valid_region_id(const FabricBitRegionId& region_id) const;
+
+  private: /* Internal utilities */
+    /* Number of address bits that can be stored in a word */
+    static constexpr size_t ADDRESS_WORD_SIZE = 64;
+
+    /* Number of words required by an address with a given length */
+    size_t num_address_words(const size_t& length) const;
+
+    /* Convert between the binary representation and the packed words of an address */
+    char* emit_address(const uint64_t* address_words, const size_t& length, char* buffer) const;
+    void pack_address(const std::vector<char>& address, uint64_t* address_words) const;
+
+    /* Reverse the sequence of the bits in the range [first_bit, last_bit) */
+    void reverse_bits(const size_t& first_bit, const size_t& last_bit);
 
   private: /* Internal data */
     /* Unique id of a bit in the Bitstream */
@@ -170,6 +233,12 @@ class FabricBitstream {
     std::unordered_set<FabricBitId> invalid_bit_ids_;
     vtr::vector<FabricBitId, ConfigBitId> config_bit_ids_; 
 
+    /* Unique id of a region in the Bitstream, and the index of its first bit 
+     * A region ends where the next region starts
+     */
+    vtr::vector<FabricBitRegionId, FabricBitRegionId> region_ids_;
+    vtr::vector<FabricBitRegionId, size_t> region_first_bits_;
+
     /* Flags to indicate if the addresses and din should be enabled */
     bool use_address_;
     bool use_wl_address_;
@@ -177,14 +246,21 @@ class FabricBitstream {
     size_t address_length_;
     size_t wl_address_length_;
 
+    /* Number of words occupied by each address */
+    size_t address_num_words_;
+    size_t wl_address_num_words_;
+
     /* Address bits: this is designed for memory decoders
      * Here we store the binary format of the address, which can be loaded
      * to the configuration protocol directly 
      *
-     * We use a 2-element array, as we may have a BL address and a WL address
+     * The addresses of all the bits are packed in a flat array,
+     * the address of a bit starts from word (bit_id * address_num_words_) 
+     *
+     * We use two arrays, as we may have a BL address and a WL address
      */
-    vtr::vector<FabricBitId, size_t> bit_addresses_;
-    vtr::vector<FabricBitId, size_t> bit_wl_addresses_;
+    std::vector<uint64_t> bit_addresses_;
+    std::vector<uint64_t> bit_wl_addresses_;
 
     /* Data input (Din) bits: this is designed for memory decoders */
     vtr::vector<FabricBitId, char> bit_dins_;
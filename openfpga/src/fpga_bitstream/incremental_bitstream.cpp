@@ -0,0 +1,207 @@
+/******************************************************************************
+ * This file includes member functions for data structure IncrementalBitstream
+ * and the functions to read/write the fingerprints of tiles
+ ******************************************************************************/
+#include <fstream>
+#include <sstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "bitstream_manager_utils.h"
+#include "incremental_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Parameters of 64-bit FNV-1a hash */
+constexpr uint64_t FINGERPRINT_FNV_OFFSET_BASIS = 14695981039346656037ULL;
+constexpr uint64_t FINGERPRINT_FNV_PRIME = 1099511628211ULL;
+
+/**************************************************
+ * Member functions of FingerprintHasher
+ *************************************************/
+FingerprintHasher::FingerprintHasher() {
+  hash_ = FINGERPRINT_FNV_OFFSET_BASIS;
+}
+
+void FingerprintHasher::add(const std::string& data) {
+  for (const char& c : data) {
+    hash_ ^= uint64_t((unsigned char)c);
+    hash_ *= FINGERPRINT_FNV_PRIME;
+  }
+  /* Add a terminator, so that ("ab", "c") differs from ("a", "bc") */
+  hash_ ^= uint64_t(0xff);
+  hash_ *= FINGERPRINT_FNV_PRIME;
+}
+
+void FingerprintHasher::add(const size_t& data) {
+  /* Hash byte by byte in a fixed order, regardless of the endianness */
+  uint64_t value = data;
+  for (size_t ibyte = 0; ibyte < sizeof(uint64_t); ++ibyte) {
+    hash_ ^= (value >> (8 * ibyte)) & 0xff;
+    hash_ *= FINGERPRINT_FNV_PRIME;
+  }
+}
+
+std::string FingerprintHasher::fingerprint() const {
+  std::stringstream ss;
+  ss << std::hex;
+  ss.width(16);
+  ss.fill('0');
+  ss << hash_;
+  return ss.str();
+}
+
+/**************************************************
+ * Public Constructors
+ *************************************************/
+IncrementalBitstream::IncrementalBitstream() {
+  enabled_ = false;
+  num_reused_tiles_ = 0;
+  num_rebuilt_tiles_ = 0;
+}
+
+/**************************************************
+ * Public Accessors
+ *************************************************/
+bool IncrementalBitstream::enabled() const {
+  return enabled_;
+}
+
+const BitstreamManager& IncrementalBitstream::previous_bitstream() const {
+  return previous_bitstream_;
+}
+
+bool IncrementalBitstream::is_tile_reusable(const std::string& block_name,
+                                            const std::string& fingerprint) const {
+  std::map<std::string, std::string>::const_iterator it = previous_fingerprints_.find(block_name);
+  return (it != previous_fingerprints_.end()) && (it->second == fingerprint);
+}
+
+ConfigBlockId IncrementalBitstream::previous_tile_block(const std::string& block_name) const {
+  std::unordered_map<std::string, ConfigBlockId>::const_iterator it = previous_tile_blocks_.find(block_name);
+  if (it == previous_tile_blocks_.end()) {
+    return ConfigBlockId::INVALID();
+  }
+  return it->second;
+}
+
+const std::map<std::string, std::string>& IncrementalBitstream::fingerprints() const {
+  return fingerprints_;
+}
+
+size_t IncrementalBitstream::num_reused_tiles() const {
+  return num_reused_tiles_;
+}
+
+size_t IncrementalBitstream::num_rebuilt_tiles() const {
+  return num_rebuilt_tiles_;
+}
+
+/**************************************************
+ * Public Mutators
+ *************************************************/
+void IncrementalBitstream::enable() {
+  enabled_ = true;
+}
+
+void IncrementalBitstream::set_previous_bitstream(BitstreamManager&& bitstream_manager,
+                                                  std::map<std::string, std::string>&& fingerprints) {
+  previous_bitstream_ = std::move(bitstream_manager);
+  previous_fingerprints_ = std::move(fingerprints);
+
+  /* Index the tile blocks by their names */
+  previous_tile_blocks_.clear();
+  for (const ConfigBlockId& top_block : find_bitstream_manager_top_blocks(previous_bitstream_)) {
+    for (const ConfigBlockId& tile_block : previous_bitstream_.block_children(top_block)) {
+      previous_tile_blocks_[previous_bitstream_.block_name(tile_block)] = tile_block;
+    }
+  }
+}
+
+void IncrementalBitstream::clear_previous_bitstream() {
+  previous_bitstream_ = BitstreamManager();
+  previous_fingerprints_.clear();
+  previous_tile_blocks_.clear();
+}
+
+void IncrementalBitstream::add_fabric_fingerprint(const std::string& top_block_name,
+                                                  const std::string& fingerprint) {
+  VTR_ASSERT(0 == fingerprints_.count(top_block_name));
+  fingerprints_[top_block_name] = fingerprint;
+}
+
+void IncrementalBitstream::add_fingerprint(const std::string& block_name,
+                                           const std::string& fingerprint,
+                                           const bool& reused) {
+  /* Each tile should have only one fingerprint */
+  VTR_ASSERT(0 == fingerprints_.count(block_name));
+  fingerprints_[block_name] = fingerprint;
+
+  if (true == reused) {
+    num_reused_tiles_++;
+  } else {
+    num_rebuilt_tiles_++;
+  }
+}
+
+/********************************************************************
+ * Read the fingerprints of tiles from a plain text file
+ * Return an empty list if the file does not exist
+ *******************************************************************/
+std::map<std::string, std::string> read_bitstream_fingerprints(const std::string& fname) {
+  std::map<std::string, std::string> fingerprints;
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::in);
+  if (false == fp.is_open()) {
+    return fingerprints;
+  }
+
+  std::string block_name;
+  std::string fingerprint;
+  while (fp >> block_name >> fingerprint) {
+    fingerprints[block_name] = fingerprint;
+  }
+  fp.close();
+
+  return fingerprints;
+}
+
+/********************************************************************
+ * Write the fingerprints of tiles to a plain text file
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_bitstream_fingerprints(const std::map<std::string, std::string>& fingerprints,
+                                 const std::string& fname) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output bitstream fingerprints!\n\tPlease specify a valid file name.\n");
+    return 1;
+  }
+
+  std::string timer_message = std::string("Write ") + std::to_string(fingerprints.size()) + std::string(" tile fingerprints into plain text file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(fname.c_str(), fp);
+
+  for (const auto& fingerprint : fingerprints) {
+    fp << fingerprint.first << " " << fingerprint.second << "\n";
+  }
+  fp.close();
+
+  return 0;
+}
+
+} /* end namespace openfpga */
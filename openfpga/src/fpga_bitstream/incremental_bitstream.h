@@ -0,0 +1,126 @@
+/******************************************************************************
+ * This file introduces a data structure to build the architecture bitstream
+ * incrementally from the bitstream of a previous run
+ *
+ * General concept
+ * ---------------
+ * The bitstream of a tile (a grid, a switch block or a connection block)
+ * only depends on a small set of inputs, e.g., the physical pbs mapped to a grid
+ * or the routing results in a GSB.
+ * These inputs are accumulated into a fingerprint for each tile, which is
+ * indexed by the name of the tile block under the top-level block.
+ * When the fingerprint of a tile is the same as the one in a previous run,
+ * the blocks of the tile are copied from the previous bitstream
+ * rather than being built again.
+ *
+ * The fingerprints are stored in a plain text file next to the bitstream file,
+ * where each line is
+ *   <block_name> <fingerprint>
+ *
+ * Restrictions:
+ * 1. The fingerprints only cover the mapping results of a design.
+ *    The fabric is covered by a fingerprint of the top-level block,
+ *    which is derived from the estimated number of blocks and bits.
+ *    When it changes, nothing is reused from the previous run.
+ *
+ ******************************************************************************/
+#ifndef INCREMENTAL_BITSTREAM_H
+#define INCREMENTAL_BITSTREAM_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#include "bitstream_manager.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Accumulate the inputs of a tile bitstream into a 64-bit FNV-1a hash
+ * The hash only depends on the data, so it is stable across runs and platforms
+ */
+class FingerprintHasher {
+  public: /* Public constructor */
+    FingerprintHasher();
+
+  public: /* Public mutators */
+    void add(const std::string& data);
+    void add(const size_t& data);
+
+  public: /* Public accessors */
+    /* Output the hash as a hexadecimal string */
+    std::string fingerprint() const;
+
+  private: /* Internal data */
+    uint64_t hash_;
+};
+
+class IncrementalBitstream {
+  public: /* Public constructor */
+    IncrementalBitstream();
+
+  public: /* Public accessors */
+    /* Check if the fingerprints of tiles should be built */
+    bool enabled() const;
+
+    const BitstreamManager& previous_bitstream() const;
+
+    /* Check if a tile has the same fingerprint as in the previous run */
+    bool is_tile_reusable(const std::string& block_name,
+                          const std::string& fingerprint) const;
+
+    /* Find the block of a tile in the previous bitstream,
+     * Return an invalid id if the tile has no block, e.g., it contains no configuration bits 
+     */
+    ConfigBlockId previous_tile_block(const std::string& block_name) const;
+
+    const std::map<std::string, std::string>& fingerprints() const;
+
+    size_t num_reused_tiles() const;
+    size_t num_rebuilt_tiles() const;
+
+  public: /* Public mutators */
+    void enable();
+
+    /* Load the bitstream and the fingerprints of a previous run */
+    void set_previous_bitstream(BitstreamManager&& bitstream_manager,
+                                std::map<std::string, std::string>&& fingerprints);
+
+    /* Clear the previous run, so that all the tiles will be rebuilt */
+    void clear_previous_bitstream();
+
+    /* Record the fingerprint of the fabric in the current run, 
+     * which is not counted as a tile 
+     */
+    void add_fabric_fingerprint(const std::string& top_block_name,
+                                const std::string& fingerprint);
+
+    /* Record the fingerprint of a tile in the current run */
+    void add_fingerprint(const std::string& block_name,
+                         const std::string& fingerprint,
+                         const bool& reused);
+
+  private: /* Internal data */
+    bool enabled_;
+
+    /* Bitstream of the previous run and the fingerprints of its tiles */
+    BitstreamManager previous_bitstream_;
+    std::map<std::string, std::string> previous_fingerprints_;
+    /* Fast look-up on the tile blocks, which are children of the top-level block */
+    std::unordered_map<std::string, ConfigBlockId> previous_tile_blocks_;
+
+    /* Fingerprints of the tiles in the current run */
+    std::map<std::string, std::string> fingerprints_;
+    size_t num_reused_tiles_;
+    size_t num_rebuilt_tiles_;
+};
+
+std::map<std::string, std::string> read_bitstream_fingerprints(const std::string& fname);
+
+int write_bitstream_fingerprints(const std::map<std::string, std::string>& fingerprints,
+                                 const std::string& fname);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,117 @@
+/********************************************************************
+ * This file includes functions that output a fabric-dependent 
+ * bitstream database to files in binary format
+ *******************************************************************/
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from fpgabitstream library */
+#include "binary_fabric_bitstream_writer.h"
+
+#include "write_binary_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Write the fabric bitstream to a binary file
+ * (see binary_fabric_bitstream_format.h for the file format)
+ * Bits are written in the same sequence as the plain text file
+ * - Vanilla (standalone) and configuration chain: no address is written
+ * - Memory bank : both BL and WL addresses are written
+ * - Frame-based configuration protocol : only the address is written
+ * The bits of each configuration region are listed in the region table
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_fabric_bitstream_to_binary_file(const BitstreamManager& bitstream_manager,
+                                          const FabricBitstream& fabric_bitstream,
+                                          const ConfigProtocol& config_protocol,
+                                          const std::string& fname,
+                                          const bool& verbose) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output bitstream!\n\tPlease specify a valid file name.\n");
+    return 1;
+  }
+
+  std::string timer_message = std::string("Write ") + std::to_string(fabric_bitstream.num_bits()) + std::string(" fabric bitstream into binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Find the length of addresses to be written */
+  size_t address_length = 0;
+  size_t wl_address_length = 0;
+  switch (config_protocol.type()) {
+  case CONFIG_MEM_STANDALONE: 
+  case CONFIG_MEM_SCAN_CHAIN:
+    break;
+  case CONFIG_MEM_MEMORY_BANK:
+    address_length = fabric_bitstream.bl_address_length();
+    wl_address_length = fabric_bitstream.wl_address_length();
+    break;
+  case CONFIG_MEM_FRAME_BASED:
+    address_length = fabric_bitstream.address_length();
+    break;
+  default:
+    VTR_LOGF_ERROR(__FILE__, __LINE__,
+                   "Invalid configuration protocol type!\n");
+    return 1;
+  }
+
+  /* Bits of each configuration region are contiguous in the fabric bitstream */
+  std::vector<size_t> region_num_bits;
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    region_num_bits.push_back(fabric_bitstream.region_num_bits(region));
+  }
+  if (true == region_num_bits.empty()) {
+    region_num_bits.push_back(fabric_bitstream.num_bits());
+  }
+
+  BinaryFabricBitstreamWriter writer(fname, config_protocol.type(),
+                                     fabric_bitstream.num_bits(),
+                                     address_length, wl_address_length,
+                                     region_num_bits);
+
+  /* Allocate buffers which can hold any address */
+  std::vector<char> addr_buffer(address_length);
+  std::vector<char> wl_addr_buffer(wl_address_length);
+
+  /* Output fabric bitstream to the file */
+  int status = 0;
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    if (0 < address_length) {
+      if (CONFIG_MEM_MEMORY_BANK == config_protocol.type()) {
+        fabric_bitstream.emit_bit_bl_address(fabric_bit, addr_buffer.data());
+      } else {
+        fabric_bitstream.emit_bit_address(fabric_bit, addr_buffer.data());
+      }
+    }
+    if (0 < wl_address_length) {
+      fabric_bitstream.emit_bit_wl_address(fabric_bit, wl_addr_buffer.data());
+    }
+    status = writer.add_bit(bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit)),
+                            addr_buffer.data(), wl_addr_buffer.data());
+    if (1 == status) {
+      break;
+    }
+  }
+
+  /* Output the bit values and close the file */
+  if (1 == writer.close()) {
+    status = 1;
+  }
+
+  VTR_LOGV(verbose,
+           "Outputted %lu configuration bits to binary file: %s\n",
+           fabric_bitstream.bits().size(),
+           fname.c_str());
+
+  return status;
+}
+
+} /* end namespace openfpga */
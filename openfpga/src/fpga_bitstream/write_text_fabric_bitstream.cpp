@@ -2,6 +2,7 @@
  * This file includes functions that output a fabric-dependent 
  * bitstream database to files in plain text
  *******************************************************************/
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <fstream>
@@ -30,6 +31,9 @@ namespace openfpga {
  * - Memory bank :  <BL address> <WL address> <bit>
  * - Frame-based configuration protocol :  <address> <bit>
  *
+ * The address buffer is shared across bits to avoid memory allocation,
+ * it should be able to hold the longest address
+ *
  * Return:
  *  - 0 if succeed
  *  - 1 if critical errors occured
@@ -39,7 +43,8 @@ int write_fabric_config_bit_to_text_file(std::fstream& fp,
                                          const BitstreamManager& bitstream_manager,
                                          const FabricBitstream& fabric_bitstream,
                                          const FabricBitId& fabric_bit,
-                                         const e_config_protocol_type& config_type) {
+                                         const e_config_protocol_type& config_type,
+                                         std::vector<char>& addr_buffer) {
   if (false == valid_file_stream(fp)) {
     return 1;
   }
@@ -50,22 +55,16 @@ int write_fabric_config_bit_to_text_file(std::fstream& fp,
     fp << bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
     break;
   case CONFIG_MEM_MEMORY_BANK: { 
-    for (const char& addr_bit : fabric_bitstream.bit_bl_address(fabric_bit)) {
-      fp << addr_bit;
-    }
+    fp.write(addr_buffer.data(), fabric_bitstream.emit_bit_bl_address(fabric_bit, addr_buffer.data()) - addr_buffer.data());
     write_space_to_file(fp, 1);
-    for (const char& addr_bit : fabric_bitstream.bit_wl_address(fabric_bit)) {
-      fp << addr_bit;
-    }
+    fp.write(addr_buffer.data(), fabric_bitstream.emit_bit_wl_address(fabric_bit, addr_buffer.data()) - addr_buffer.data());
     write_space_to_file(fp, 1);
     fp << bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
     fp << "\n";
     break;
   }
   case CONFIG_MEM_FRAME_BASED: {
-    for (const char& addr_bit : fabric_bitstream.bit_address(fabric_bit)) {
-      fp << addr_bit;
-    }
+    fp.write(addr_buffer.data(), fabric_bitstream.emit_bit_address(fabric_bit, addr_buffer.data()) - addr_buffer.data());
     write_space_to_file(fp, 1);
     fp << bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
     fp << "\n";
@@ -80,6 +79,102 @@ int write_fabric_config_bit_to_text_file(std::fstream& fp,
   return 0;
 }
 
+/********************************************************************
+ * Write the fabric bitstream of multiple configuration regions into a plain text file
+ * All the regions are loaded in parallel, so that each line is a configuration cycle,
+ * where the information of all the regions are concatenated, region 0 first
+ * - Vanilla (standalone): not applicable, which has only 1 region
+ * - Configuration chain: <bit of region 0><bit of region 1>...
+ *   Shorter regions are padded by '0's at the head, which are shifted out of
+ *   the chain before the last cycle
+ * - Memory bank : <BL addresses> <WL addresses> <bits>
+ * - Frame-based configuration protocol :  <addresses> <bits>
+ *   Shorter regions repeat their last bit, which does not change the configuration
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+static 
+int write_regional_fabric_bitstream_to_text_file(std::fstream& fp,
+                                                 const BitstreamManager& bitstream_manager,
+                                                 const FabricBitstream& fabric_bitstream,
+                                                 const e_config_protocol_type& config_type) {
+  if (false == valid_file_stream(fp)) {
+    return 1;
+  }
+
+  if ( (CONFIG_MEM_SCAN_CHAIN != config_type)
+    && (CONFIG_MEM_MEMORY_BANK != config_type)
+    && (CONFIG_MEM_FRAME_BASED != config_type)) {
+    VTR_LOGF_ERROR(__FILE__, __LINE__,
+                   "Configuration protocol type does not support multiple regions!\n");
+    return 1;
+  }
+
+  /* The number of configuration cycles is determined by the longest region */
+  size_t num_cycles = 0;
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    num_cycles = std::max(num_cycles, fabric_bitstream.region_num_bits(region));
+  }
+
+  /* Allocate buffers for the addresses and bits of all the regions in a cycle */
+  size_t num_regions = fabric_bitstream.num_regions();
+  size_t addr_length = fabric_bitstream.address_length();
+  size_t wl_addr_length = 0;
+  if (CONFIG_MEM_MEMORY_BANK == config_type) {
+    addr_length = fabric_bitstream.bl_address_length();
+    wl_addr_length = fabric_bitstream.wl_address_length();
+  }
+  std::vector<char> addr_buffer(num_regions * addr_length, '0');
+  std::vector<char> wl_addr_buffer(num_regions * wl_addr_length, '0');
+  std::vector<char> bit_buffer(num_regions, '0');
+
+  for (size_t icycle = 0; icycle < num_cycles; ++icycle) {
+    for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+      size_t region_num_bits = fabric_bitstream.region_num_bits(region);
+      if (0 == region_num_bits) {
+        continue;
+      }
+
+      size_t ibit = icycle;
+      if (CONFIG_MEM_SCAN_CHAIN == config_type) {
+        /* Pad '0's at the head */
+        if (icycle < num_cycles - region_num_bits) {
+          bit_buffer[size_t(region)] = '0';
+          continue;
+        }
+        ibit = icycle - (num_cycles - region_num_bits);
+      } else {
+        /* Repeat the last bit */
+        ibit = std::min(icycle, region_num_bits - 1);
+      }
+
+      FabricBitId fabric_bit = FabricBitId(size_t(*fabric_bitstream.region_bits(region).begin()) + ibit);
+      bit_buffer[size_t(region)] = bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit)) ? '1' : '0';
+      if (CONFIG_MEM_MEMORY_BANK == config_type) {
+        fabric_bitstream.emit_bit_bl_address(fabric_bit, addr_buffer.data() + size_t(region) * addr_length);
+        fabric_bitstream.emit_bit_wl_address(fabric_bit, wl_addr_buffer.data() + size_t(region) * wl_addr_length);
+      } else if (CONFIG_MEM_FRAME_BASED == config_type) {
+        fabric_bitstream.emit_bit_address(fabric_bit, addr_buffer.data() + size_t(region) * addr_length);
+      }
+    }
+
+    if (CONFIG_MEM_SCAN_CHAIN != config_type) {
+      fp.write(addr_buffer.data(), addr_buffer.size());
+      write_space_to_file(fp, 1);
+    }
+    if (CONFIG_MEM_MEMORY_BANK == config_type) {
+      fp.write(wl_addr_buffer.data(), wl_addr_buffer.size());
+      write_space_to_file(fp, 1);
+    }
+    fp.write(bit_buffer.data(), bit_buffer.size());
+    fp << "\n";
+  }
+
+  return 0;
+}
+
 /********************************************************************
  * Write the fabric bitstream to a plain text file 
  * Notes: 
@@ -111,15 +206,25 @@ int write_fabric_bitstream_to_text_file(const BitstreamManager& bitstream_manage
 
   check_file_stream(fname.c_str(), fp);
 
+  /* Allocate a buffer which can hold any address */
+  std::vector<char> addr_buffer(std::max(fabric_bitstream.address_length(), fabric_bitstream.wl_address_length()));
+
   /* Output fabric bitstream to the file */
   int status = 0;
-  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
-    status = write_fabric_config_bit_to_text_file(fp, bitstream_manager,
-                                                  fabric_bitstream,
-                                                  fabric_bit,
-                                                  config_protocol.type());
-    if (1 == status) {
-      break;
+  if (1 < fabric_bitstream.num_regions()) {
+    status = write_regional_fabric_bitstream_to_text_file(fp, bitstream_manager,
+                                                          fabric_bitstream,
+                                                          config_protocol.type());
+  } else {
+    for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+      status = write_fabric_config_bit_to_text_file(fp, bitstream_manager,
+                                                    fabric_bitstream,
+                                                    fabric_bit,
+                                                    config_protocol.type(),
+                                                    addr_buffer);
+      if (1 == status) {
+        break;
+      }
     }
   }
   /* Print an end to the file here */
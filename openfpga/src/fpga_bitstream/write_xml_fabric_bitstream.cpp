@@ -2,6 +2,7 @@
  * This file includes functions that output a fabric-dependent 
  * bitstream database to files in XML format
  *******************************************************************/
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <fstream>
@@ -45,7 +46,8 @@ void write_fabric_bitstream_xml_file_head(std::fstream& fp) {
 
 /********************************************************************
  * Write a configuration bit into a plain text file
- * General format
+ * General format, where the bits are grouped by configuration regions
+ *   <region id="<region>">
  *   <bit id="<fabric_bit>" value="<config_bit_value>">
  *     <hierarchy>
  *       <!-- configurable memory hierarchy -->
@@ -53,6 +55,7 @@ void write_fabric_bitstream_xml_file_head(std::fstream& fp) {
  *     <!-- address information -->
  *     ...
  *   </bit>
+ *   </region>
  * The format depends on the type of configuration protocol
  * - Vanilla (standalone): No more information to be included
  * - Configuration chain: No more information to be included
@@ -62,6 +65,9 @@ void write_fabric_bitstream_xml_file_head(std::fstream& fp) {
  * - Frame-based configuration protocol :
  *     <frame address="<frame_address_value>"/>
  *
+ * The address buffer is shared across bits to avoid memory allocation,
+ * it should be able to hold the longest address
+ *
  * Return:
  *  - 0 if succeed
  *  - 1 if critical errors occured
@@ -71,12 +77,13 @@ int write_fabric_config_bit_to_xml_file(std::fstream& fp,
                                         const BitstreamManager& bitstream_manager,
                                         const FabricBitstream& fabric_bitstream,
                                         const FabricBitId& fabric_bit,
-                                        const e_config_protocol_type& config_type) {
+                                        const e_config_protocol_type& config_type,
+                                        std::vector<char>& addr_buffer) {
   if (false == valid_file_stream(fp)) {
     return 1;
   }
 
-  write_tab_to_file(fp, 1);
+  write_tab_to_file(fp, 2);
   fp << "<bit id=\"" << size_t(fabric_bit) << "\"";
   fp << " value=\"";
   fp << bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
@@ -104,27 +111,21 @@ int write_fabric_config_bit_to_xml_file(std::fstream& fp,
     break;
   case CONFIG_MEM_MEMORY_BANK: { 
     /* Bit line address */
-    write_tab_to_file(fp, 2);
+    write_tab_to_file(fp, 3);
     fp << "<bl address=\"";
-    for (const char& addr_bit : fabric_bitstream.bit_bl_address(fabric_bit)) {
-      fp << addr_bit;
-    }
+    fp.write(addr_buffer.data(), fabric_bitstream.emit_bit_bl_address(fabric_bit, addr_buffer.data()) - addr_buffer.data());
     fp << "\"/>\n";   
  
-    write_tab_to_file(fp, 2);
+    write_tab_to_file(fp, 3);
     fp << "<wl address=\"";
-    for (const char& addr_bit : fabric_bitstream.bit_wl_address(fabric_bit)) {
-      fp << addr_bit;
-    }
+    fp.write(addr_buffer.data(), fabric_bitstream.emit_bit_wl_address(fabric_bit, addr_buffer.data()) - addr_buffer.data());
     fp << "\"/>\n";   
     break;
   }
   case CONFIG_MEM_FRAME_BASED: {
-    write_tab_to_file(fp, 2);
+    write_tab_to_file(fp, 3);
     fp << "<frame address=\"";
-    for (const char& addr_bit : fabric_bitstream.bit_address(fabric_bit)) {
-      fp << addr_bit;
-    }
+    fp.write(addr_buffer.data(), fabric_bitstream.emit_bit_address(fabric_bit, addr_buffer.data()) - addr_buffer.data());
     fp << "\"/>\n";   
     break;
   }
@@ -134,7 +135,7 @@ int write_fabric_config_bit_to_xml_file(std::fstream& fp,
     return 1;
   }
 
-  write_tab_to_file(fp, 1);
+  write_tab_to_file(fp, 2);
   fp << "</bit>\n";
 
   return 0;
@@ -175,13 +176,26 @@ int write_fabric_bitstream_to_xml_file(const BitstreamManager& bitstream_manager
 
   fp << "<fabric_bitstream>\n";
 
+  /* Allocate a buffer which can hold any address */
+  std::vector<char> addr_buffer(std::max(fabric_bitstream.address_length(), fabric_bitstream.wl_address_length()));
+
   /* Output fabric bitstream to the file */
   int status = 0;
-  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
-    status = write_fabric_config_bit_to_xml_file(fp, bitstream_manager,
-                                                 fabric_bitstream,
-                                                 fabric_bit,
-                                                 config_protocol.type());
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    write_tab_to_file(fp, 1);
+    fp << "<region id=\"" << size_t(region) << "\">\n";
+    for (const FabricBitId& fabric_bit : fabric_bitstream.region_bits(region)) {
+      status = write_fabric_config_bit_to_xml_file(fp, bitstream_manager,
+                                                   fabric_bitstream,
+                                                   fabric_bit,
+                                                   config_protocol.type(),
+                                                   addr_buffer);
+      if (1 == status) {
+        break;
+      }
+    }
+    write_tab_to_file(fp, 1);
+    fp << "</region>\n";
     if (1 == status) {
       break;
     }
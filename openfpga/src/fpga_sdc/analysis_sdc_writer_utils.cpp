@@ -65,8 +65,8 @@ void disable_analysis_module_input_pin_net_sinks(std::fstream& fp,
 
   /* Touch each sink of the net! */
   for (const ModuleNetSinkId& sink_id : module_manager.module_net_sinks(parent_module, module_net)) {
-    ModuleId sink_module = module_manager.net_sink_modules(parent_module, module_net)[sink_id]; 
-    size_t sink_instance = module_manager.net_sink_instances(parent_module, module_net)[sink_id]; 
+    ModuleId sink_module = module_manager.net_sink_module(parent_module, module_net, sink_id); 
+    size_t sink_instance = module_manager.net_sink_instance(parent_module, module_net, sink_id); 
 
     /* Skip when sink module is the parent module, 
      * the output ports of parent modules have been disabled/enabled already! 
@@ -96,9 +96,9 @@ void disable_analysis_module_input_pin_net_sinks(std::fstream& fp,
       continue;
     }
 
-    BasicPort sink_port = module_manager.module_port(sink_module, module_manager.net_sink_ports(parent_module, module_net)[sink_id]);
-    sink_port.set_width(module_manager.net_sink_pins(parent_module, module_net)[sink_id],
-                        module_manager.net_sink_pins(parent_module, module_net)[sink_id]);
+    BasicPort sink_port = module_manager.module_port(sink_module, module_manager.net_sink_port(parent_module, module_net, sink_id));
+    sink_port.set_width(module_manager.net_sink_pin(parent_module, module_net, sink_id),
+                        module_manager.net_sink_pin(parent_module, module_net, sink_id));
 
     VTR_ASSERT(!sink_instance_name.empty());
     /* Get the input id that is used! Disable the unused inputs! */
@@ -190,8 +190,8 @@ void disable_analysis_module_output_pin_net_sinks(std::fstream& fp,
 
   /* Touch each sink of the net! */
   for (const ModuleNetSinkId& sink_id : module_manager.module_net_sinks(parent_module, module_net)) {
-    ModuleId sink_module = module_manager.net_sink_modules(parent_module, module_net)[sink_id]; 
-    size_t sink_instance = module_manager.net_sink_instances(parent_module, module_net)[sink_id]; 
+    ModuleId sink_module = module_manager.net_sink_module(parent_module, module_net, sink_id); 
+    size_t sink_instance = module_manager.net_sink_instance(parent_module, module_net, sink_id); 
 
     /* Skip when sink module is the parent module, 
      * the output ports of parent modules have been disabled/enabled already! 
@@ -221,9 +221,9 @@ void disable_analysis_module_output_pin_net_sinks(std::fstream& fp,
       continue;
     }
 
-    BasicPort sink_port = module_manager.module_port(sink_module, module_manager.net_sink_ports(parent_module, module_net)[sink_id]);
-    sink_port.set_width(module_manager.net_sink_pins(parent_module, module_net)[sink_id],
-                        module_manager.net_sink_pins(parent_module, module_net)[sink_id]);
+    BasicPort sink_port = module_manager.module_port(sink_module, module_manager.net_sink_port(parent_module, module_net, sink_id));
+    sink_port.set_width(module_manager.net_sink_pin(parent_module, module_net, sink_id),
+                        module_manager.net_sink_pin(parent_module, module_net, sink_id));
 
     VTR_ASSERT(!sink_instance_name.empty());
     /* Get the input id that is used! Disable the unused inputs! */
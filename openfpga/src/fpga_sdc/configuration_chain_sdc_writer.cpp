@@ -28,6 +28,29 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Find the hierarchical path of a configurable child of a module 
+ *******************************************************************/
+static 
+std::string generate_configurable_child_module_path(const ModuleManager& module_manager, 
+                                                    const ModuleId& parent_module,
+                                                    const std::string& parent_module_path,
+                                                    const size_t& child_index) {
+  std::string child_module_path = parent_module_path;
+  ModuleId child_module_id = module_manager.configurable_children(parent_module)[child_index];
+  size_t child_instance_id = module_manager.configurable_child_instances(parent_module)[child_index];
+  std::string child_instance_name;
+  if (true == module_manager.instance_name(parent_module, child_module_id, child_instance_id).empty()) {
+    child_instance_name = generate_instance_name(module_manager.module_name(child_module_id), child_instance_id);
+  } else {
+    child_instance_name = module_manager.instance_name(parent_module, child_module_id, child_instance_id);
+  }
+
+  child_module_path += child_instance_name;
+  
+  return format_dir_path(child_module_path);
+}
+
 /********************************************************************
  * Print SDC commands to constrain the timing between outputs and inputs
  * of all the configurable memory modules
@@ -56,19 +79,8 @@ void rec_print_pnr_sdc_constrain_configurable_chain(std::fstream& fp,
 
   /* For each configurable child, we will go one level down in priority */
   for (size_t child_index = 0; child_index < module_manager.configurable_children(parent_module).size(); ++child_index) {
-    std::string child_module_path = parent_module_path;
     ModuleId child_module_id = module_manager.configurable_children(parent_module)[child_index];
-    size_t child_instance_id = module_manager.configurable_child_instances(parent_module)[child_index];
-    std::string child_instance_name;
-    if (true == module_manager.instance_name(parent_module, child_module_id, child_instance_id).empty()) {
-      child_instance_name = generate_instance_name(module_manager.module_name(child_module_id), child_instance_id);
-    } else {
-      child_instance_name = module_manager.instance_name(parent_module, child_module_id, child_instance_id);
-    }
-
-    child_module_path += child_instance_name;
-    
-    child_module_path = format_dir_path(child_module_path);
+    std::string child_module_path = generate_configurable_child_module_path(module_manager, parent_module, parent_module_path, child_index);
 
     rec_print_pnr_sdc_constrain_configurable_chain(fp,
                                                    tmax, tmin,
@@ -158,15 +170,26 @@ void print_pnr_sdc_constrain_configurable_chain(const std::string& sdc_fname,
   ModuleId top_module = module_manager.find_module(top_module_name);
   VTR_ASSERT(true == module_manager.valid_module_id(top_module));
 
-  /* Go recursively in the module manager, starting from the top-level module: instance id of the top-level module is 0 by default */
-  std::string previous_module_path;
-  ModuleId previous_module = ModuleId::INVALID();
-  rec_print_pnr_sdc_constrain_configurable_chain(fp,
-                                                 max_delay, min_delay, 
-                                                 module_manager, top_module, 
-                                                 format_dir_path(module_manager.module_name(top_module)),
-                                                 previous_module_path,
-                                                 previous_module);
+  /* Go recursively in the module manager, starting from the top-level module: instance id of the top-level module is 0 by default
+   * Each configuration region of the top-level module has its own chain,
+   * so the chain restarts at the first configurable child of each region
+   */
+  std::string top_module_path = format_dir_path(module_manager.module_name(top_module));
+  for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+    std::string previous_module_path;
+    ModuleId previous_module = ModuleId::INVALID();
+    size_t first_child = module_manager.region_first_configurable_child(top_module, config_region);
+    size_t num_children = module_manager.region_num_configurable_children(top_module, config_region);
+    for (size_t child_index = first_child; child_index < first_child + num_children; ++child_index) {
+      rec_print_pnr_sdc_constrain_configurable_chain(fp,
+                                                     max_delay, min_delay, 
+                                                     module_manager, 
+                                                     module_manager.configurable_children(top_module)[child_index],
+                                                     generate_configurable_child_module_path(module_manager, top_module, top_module_path, child_index),
+                                                     previous_module_path,
+                                                     previous_module);
+    }
+  }
 
   /* Close file handler */
   fp.close();
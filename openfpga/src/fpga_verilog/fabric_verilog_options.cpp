@@ -20,6 +20,7 @@ FabricVerilogOption::FabricVerilogOption() {
   compress_routing_ = false;
   print_user_defined_template_ = false;
   verbose_output_ = false;
+  num_threads_ = 1;
 }
 
 /**************************************************
@@ -57,6 +58,10 @@ bool FabricVerilogOption::verbose_output() const {
   return verbose_output_;
 }
 
+size_t FabricVerilogOption::num_threads() const {
+  return num_threads_;
+}
+
 /******************************************************************************
  * Private Mutators
  ******************************************************************************/
@@ -92,4 +97,9 @@ void FabricVerilogOption::set_verbose_output(const bool& enabled) {
   verbose_output_ = enabled;
 }
 
+void FabricVerilogOption::set_num_threads(const size_t& num_threads) {
+  VTR_ASSERT(0 < num_threads);
+  num_threads_ = num_threads;
+}
+
 } /* end namespace openfpga */
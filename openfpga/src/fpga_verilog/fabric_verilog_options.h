@@ -4,6 +4,7 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
+#include <cstddef>
 #include <string>
 
 /* Begin namespace openfpga */
@@ -25,6 +26,7 @@ class FabricVerilogOption {
     bool compress_routing() const;
     bool print_user_defined_template() const;
     bool verbose_output() const;
+    size_t num_threads() const;
   public: /* Public mutators */
     void set_output_directory(const std::string& output_dir);
     void set_support_icarus_simulator(const bool& enabled);
@@ -34,6 +36,7 @@ class FabricVerilogOption {
     void set_compress_routing(const bool& enabled);
     void set_print_user_defined_template(const bool& enabled);
     void set_verbose_output(const bool& enabled);
+    void set_num_threads(const size_t& num_threads);
   private: /* Internal Data */
     std::string output_directory_;
     bool support_icarus_simulator_;
@@ -43,6 +46,8 @@ class FabricVerilogOption {
     bool compress_routing_;
     bool print_user_defined_template_;
     bool verbose_output_;
+    /* Number of threads to write netlists */
+    size_t num_threads_;
 };
 
 } /* End namespace openfpga*/
@@ -98,14 +98,18 @@ namespace openfpga
                             submodule_dir_path,
                             options);
 
-    /* Generate routing blocks */
+    /* Generate routing blocks
+     * Routing blocks and grids are written with multiple threads when specified,
+     * while the netlists are always registered in the same sequence
+     */
     if (true == options.compress_routing())
     {
       print_verilog_unique_routing_modules(netlist_manager,
                                            const_cast<const ModuleManager &>(module_manager),
                                            device_rr_gsb,
                                            rr_dir_path,
-                                           options.explicit_port_mapping());
+                                           options.explicit_port_mapping(),
+                                           options.num_threads());
     }
     else
     {
@@ -114,7 +118,8 @@ namespace openfpga
                                             const_cast<const ModuleManager &>(module_manager),
                                             device_rr_gsb,
                                             rr_dir_path,
-                                            options.explicit_port_mapping());
+                                            options.explicit_port_mapping(),
+                                            options.num_threads());
     }
 
     /* Generate grids */
@@ -123,6 +128,7 @@ namespace openfpga
                         device_ctx, device_annotation,
                         lb_dir_path,
                         options.explicit_port_mapping(),
+                        options.num_threads(),
                         options.verbose_output());
 
     /* Generate FPGA fabric */
@@ -186,12 +192,21 @@ namespace openfpga
     if (true == options.print_formal_verification_top_netlist())
     {
       std::string formal_verification_top_netlist_file_path = src_dir_path + netlist_name + std::string(FORMAL_VERIFICATION_VERILOG_FILE_POSTFIX);
+      /* Load the bitstream from an image file when specified */
+      std::string bitstream_image_file_path;
+      std::string bitstream_loader_file_path;
+      if (true == options.load_bitstream_image()) {
+        bitstream_image_file_path = src_dir_path + netlist_name + std::string(FORMAL_VERIFICATION_BITSTREAM_IMAGE_FILE_POSTFIX);
+        bitstream_loader_file_path = src_dir_path + std::string(PRECONFIG_BITSTREAM_LOADER_VERILOG_FILE_NAME);
+      }
       print_verilog_preconfig_top_module(module_manager, bitstream_manager,
                                          circuit_lib, global_ports,
                                          atom_ctx, place_ctx, io_location_map,
                                          netlist_annotation,
                                          netlist_name,
                                          formal_verification_top_netlist_file_path,
+                                         bitstream_image_file_path,
+                                         bitstream_loader_file_path,
                                          options.explicit_port_mapping());
     }
 
@@ -211,6 +226,11 @@ namespace openfpga
     if (true == options.print_top_testbench())
     {
       std::string top_testbench_file_path = src_dir_path + netlist_name + std::string(AUTOCHECK_TOP_TESTBENCH_VERILOG_FILE_POSTFIX);
+      /* The bitstream image is written next to the testbench */
+      std::string bitstream_image_file_path;
+      if (true == options.load_bitstream_image()) {
+        bitstream_image_file_path = src_dir_path + netlist_name + std::string(AUTOCHECK_TOP_TESTBENCH_BITSTREAM_IMAGE_FILE_POSTFIX);
+      }
       print_verilog_top_testbench(module_manager,
                                   bitstream_manager, fabric_bitstream,
                                   config_protocol_type,
@@ -219,6 +239,7 @@ namespace openfpga
                                   netlist_annotation,
                                   netlist_name,
                                   top_testbench_file_path,
+                                  bitstream_image_file_path,
                                   simulation_setting,
                                   options.fast_configuration(),
                                   options.explicit_port_mapping());
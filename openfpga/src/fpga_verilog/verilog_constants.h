@@ -1,9 +1,14 @@
 #ifndef VERILOG_CONSTANTS_H
 #define VERILOG_CONSTANTS_H
 
+#include <cstddef>
+
 /* global parameters for dumping synthesizable verilog */
 
 constexpr char* VERILOG_NETLIST_FILE_POSTFIX = ".v";
+constexpr size_t VERILOG_NETLIST_FILE_BUFFER_SIZE = 1 << 20; // Size of the user-space buffer to write a netlist file, 1MB
+constexpr size_t VERILOG_FILE_HEADER_DATE_BUFFER_SIZE = 26; // Size of the buffer required by ctime_r()
+constexpr size_t VERILOG_BITSTREAM_IMAGE_FILE_NAME_SIZE = 1024; // Maximum number of characters in the file name of a bitstream image loaded by $readmemb
 constexpr float VERILOG_SIM_TIMESCALE = 1e-9; // Verilog Simulation time scale (minimum time unit) : 1ns
 
 constexpr char* VERILOG_TIMING_PREPROC_FLAG = "ENABLE_TIMING"; // the flag to enable timing definition during compilation
@@ -23,8 +28,11 @@ constexpr char* FABRIC_INCLUDE_NETLIST_FILE_NAME = "fabric_netlists.v";
 constexpr char* TOP_INCLUDE_NETLIST_FILE_NAME_POSTFIX = "_include_netlists.v";
 constexpr char* VERILOG_TOP_POSTFIX = "_top.v";
 constexpr char* FORMAL_VERIFICATION_VERILOG_FILE_POSTFIX = "_top_formal_verification.v"; 
+constexpr char* FORMAL_VERIFICATION_BITSTREAM_IMAGE_FILE_POSTFIX = "_top_formal_verification_bitstream.mem"; 
+constexpr char* PRECONFIG_BITSTREAM_LOADER_VERILOG_FILE_NAME = "preconfig_bitstream_loader.v";
 constexpr char* TOP_TESTBENCH_VERILOG_FILE_POSTFIX = "_top_tb.v"; /* !!! must be consist with the modelsim_testbench_module_postfix */ 
 constexpr char* AUTOCHECK_TOP_TESTBENCH_VERILOG_FILE_POSTFIX = "_autocheck_top_tb.v"; /* !!! must be consist with the modelsim_autocheck_testbench_module_postfix */ 
+constexpr char* AUTOCHECK_TOP_TESTBENCH_BITSTREAM_IMAGE_FILE_POSTFIX = "_autocheck_top_tb_bitstream.mem"; 
 constexpr char* RANDOM_TOP_TESTBENCH_VERILOG_FILE_POSTFIX = "_formal_random_top_tb.v"; 
 constexpr char* DEFINES_VERILOG_FILE_NAME = "fpga_defines.v";
 constexpr char* DEFINES_VERILOG_SIMULATION_FILE_NAME = "define_simulation.v";
@@ -51,6 +59,10 @@ constexpr char* GRID_VERILOG_FILE_NAME_PREFIX = "grid_";
 constexpr char* FORMAL_VERIFICATION_TOP_MODULE_POSTFIX = "_top_formal_verification";
 constexpr char* FORMAL_VERIFICATION_TOP_MODULE_PORT_POSTFIX = "_fm";
 constexpr char* FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME = "U0_formal_verification";
+constexpr char* PRECONFIG_BITSTREAM_IMAGE_MEMORY_NAME = "preconfig_bitstream_image";
+constexpr char* PRECONFIG_BITSTREAM_IMAGE_FILE_NAME = "preconfig_bitstream_image_file";
+constexpr char* PRECONFIG_BITSTREAM_IMAGE_FILE_MACRO = "PRECONFIG_BITSTREAM_IMAGE_FILE"; // the macro to define the default bitstream image of the pre-configured top module
+constexpr char* PRECONFIG_BITSTREAM_IMAGE_PLUSARG = "preconfig_bitstream_image"; // the plusarg to override the bitstream image of the pre-configured top module
 
 constexpr char* FORMAL_RANDOM_TOP_TESTBENCH_POSTFIX = "_top_formal_verification_random_tb";
 
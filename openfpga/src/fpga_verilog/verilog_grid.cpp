@@ -4,6 +4,7 @@
  *******************************************************************/
 /* System header files */
 #include <vector>
+#include <set>
 #include <fstream>
 
 /* Headers from vtrutil library */
@@ -18,6 +19,8 @@
 #include "openfpga_digest.h"
 #include "openfpga_side_manager.h"
 
+#include "openfpga_parallel_utils.h"
+
 /* Headers from vpr library */
 #include "vpr_utils.h"
 
@@ -36,6 +39,20 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Add the netlists of logic blocks to the netlist manager
+ * in the sequence of the list
+ *******************************************************************/
+static 
+void add_verilog_grid_netlists(NetlistManager& netlist_manager,
+                               const std::vector<std::string>& netlist_names) {
+  for (const std::string& netlist_name : netlist_names) {
+    NetlistId nlist_id = netlist_manager.add_netlist(netlist_name);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
+  }
+}
+
 /********************************************************************
  * Print Verilog modules of a primitive node in the pb_graph_node graph
  * This generic function can support all the different types of primitive nodes
@@ -61,36 +78,29 @@ namespace openfpga {
  *     |                                       | 
  *     +---------------------------------------+
  *
+ * Return the name of the netlist, which is NOT added to the netlist manager
+ * so that netlists can be written in parallel
  *******************************************************************/
 static 
-void print_verilog_primitive_block(NetlistManager& netlist_manager,
-                                   const ModuleManager& module_manager,
-                                   const std::string& subckt_dir,
-                                   t_pb_graph_node* primitive_pb_graph_node,
-                                   const bool& use_explicit_mapping,
-                                   const bool& verbose) {
-  /* Ensure a valid pb_graph_node */ 
-  if (nullptr == primitive_pb_graph_node) {
-    VTR_LOGF_ERROR(__FILE__, __LINE__,
-                   "Invalid primitive_pb_graph_node!\n");
-    exit(1);
-  }
-
+std::string print_verilog_primitive_block(const ModuleManager& module_manager,
+                                          const std::string& subckt_dir,
+                                          t_pb_graph_node* primitive_pb_graph_node,
+                                          const bool& use_explicit_mapping,
+                                          const bool& verbose) {
   /* Give a name to the Verilog netlist */
   /* Create the file name for Verilog */
   std::string verilog_fname(subckt_dir 
                           + generate_logical_tile_netlist_name(std::string(), primitive_pb_graph_node, std::string(VERILOG_NETLIST_FILE_POSTFIX))
                            );
 
-  VTR_LOG("Writing Verilog netlist '%s' for primitive pb_type '%s' ...",
+  /* Netlists may be written in parallel, so each message is printed at once */
+  VTR_LOG("Writing Verilog netlist '%s' for primitive pb_type '%s'\n",
           verilog_fname.c_str(), primitive_pb_graph_node->pb_type->name);
-  VTR_LOGV(verbose, "\n");
 
   /* Create the file stream */
+  std::vector<char> fp_buffer;
   std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
-
-  check_file_stream(verilog_fname.c_str(), fp);
+  open_verilog_netlist_file(fp, fp_buffer, verilog_fname);
 
   print_verilog_file_header(fp, std::string("Verilog modules for primitive pb_type: " + std::string(primitive_pb_graph_node->pb_type->name))); 
 
@@ -103,7 +113,7 @@ void print_verilog_primitive_block(NetlistManager& netlist_manager,
   VTR_ASSERT(true == module_manager.valid_module_id(primitive_module));
 
   VTR_LOGV(verbose,
-          "Writing Verilog codes of logical tile primitive block '%s'...",
+          "Writing Verilog codes of logical tile primitive block '%s'\n",
            module_manager.module_name(primitive_module).c_str());
   
   /* Write the verilog module */
@@ -112,96 +122,38 @@ void print_verilog_primitive_block(NetlistManager& netlist_manager,
   /* Close file handler */
   fp.close();
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
-
-  VTR_LOGV(verbose, "Done\n");
+  return verilog_fname;
 }
 
 /********************************************************************
- * Print Verilog modules of physical blocks inside a grid (CLB, I/O. etc.)
- * This function will traverse the graph of complex logic block (t_pb_graph_node)
- * in a recursive way, using a Depth First Search (DFS) algorithm.
- * As such, primitive physical blocks (LUTs, FFs, etc.), leaf node of the pb_graph
- * will be printed out first, while the top-level will be printed out in the last
- *
- * Note: this function will print a unique Verilog module for each type of 
- * t_pb_graph_node, i.e., t_pb_type, in the graph, in order to enable highly 
- * hierarchical Verilog organization as well as simplify the Verilog file sizes.
+ * Print Verilog modules of a non-primitive node in the pb_graph_node graph
  *
- * Note: DFS is the right way. Do NOT use BFS.
- * DFS can guarantee that all the sub-modules can be registered properly
- * to its parent in module manager  
+ * Return the name of the netlist, which is NOT added to the netlist manager
+ * so that netlists can be written in parallel
  *******************************************************************/
 static 
-void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
-                                    const ModuleManager& module_manager,
-                                    const VprDeviceAnnotation& device_annotation,
-                                    const std::string& subckt_dir,
-                                    t_pb_graph_node* physical_pb_graph_node,
-                                    const bool& use_explicit_mapping,
-                                    const bool& verbose) {
-
-  /* Check cur_pb_graph_node*/
-  if (nullptr == physical_pb_graph_node) {
-    VTR_LOGF_ERROR(__FILE__, __LINE__,
-                   "Invalid physical_pb_graph_node\n"); 
-    exit(1);
-  }
-
+std::string print_verilog_logical_tile_pb_block(const ModuleManager& module_manager,
+                                                const std::string& subckt_dir,
+                                                t_pb_graph_node* physical_pb_graph_node,
+                                                const bool& use_explicit_mapping,
+                                                const bool& verbose) {
   /* Get the pb_type definition related to the node */
   t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type; 
 
-  /* Find the mode that physical implementation of a pb_type */
-  t_mode* physical_mode = device_annotation.physical_mode(physical_pb_type);
-
-  /* For non-leaf node in the pb_type graph: 
-   * Recursively Depth-First Generate all the child pb_type at the level 
-   */
-  if (false == is_primitive_pb_type(physical_pb_type)) { 
-    for (int ipb = 0; ipb < physical_mode->num_pb_type_children; ++ipb) {
-      /* Go recursive to visit the children */
-      rec_print_verilog_logical_tile(netlist_manager,
-                                     module_manager, device_annotation,
-                                     subckt_dir, 
-                                     &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb][0]),
-                                     use_explicit_mapping,
-                                     verbose);
-    }
-  }
-
-  /* For leaf node, a primitive Verilog module will be generated.
-   * Note that the primitive may be mapped to a standard cell, we force to use 
-   * explict port mapping. This aims to avoid any port sequence issues!!!
-   */
-  if (true == is_primitive_pb_type(physical_pb_type)) { 
-    print_verilog_primitive_block(netlist_manager,
-                                  module_manager,
-                                  subckt_dir,
-                                  physical_pb_graph_node, 
-                                  true, 
-                                  verbose);
-    /* Finish for primitive node, return */
-    return;
-  }
-
   /* Give a name to the Verilog netlist */
   /* Create the file name for Verilog */
   std::string verilog_fname(subckt_dir 
                           + generate_logical_tile_netlist_name(std::string(), physical_pb_graph_node, std::string(VERILOG_NETLIST_FILE_POSTFIX))
                            );
 
-  VTR_LOG("Writing Verilog netlist '%s' for pb_type '%s' ...",
+  /* Netlists may be written in parallel, so each message is printed at once */
+  VTR_LOG("Writing Verilog netlist '%s' for pb_type '%s'\n",
           verilog_fname.c_str(), physical_pb_type->name);
-  VTR_LOGV(verbose, "\n");
 
   /* Create the file stream */
+  std::vector<char> fp_buffer;
   std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
-
-  check_file_stream(verilog_fname.c_str(), fp);
+  open_verilog_netlist_file(fp, fp_buffer, verilog_fname);
 
   print_verilog_file_header(fp, std::string("Verilog modules for pb_type: " + std::string(physical_pb_type->name))); 
 
@@ -213,7 +165,7 @@ void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
   VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
 
   VTR_LOGV(verbose,
-          "Writing Verilog codes of pb_type '%s'...",
+          "Writing Verilog codes of pb_type '%s'\n",
            module_manager.module_name(pb_module).c_str());
 
   /* Comment lines */
@@ -227,48 +179,56 @@ void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
   /* Close file handler */
   fp.close();
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
-
-  VTR_LOGV(verbose, "Done\n");
+  return verilog_fname;
 }
 
-/*****************************************************************************
- * This function will create a Verilog file and print out a Verilog netlist 
- * for the logical tile (pb_graph/pb_type) 
- *****************************************************************************/
+/********************************************************************
+ * Collect the physical blocks inside a grid (CLB, I/O. etc.) whose
+ * Verilog modules should be printed
+ * This function will traverse the graph of complex logic block (t_pb_graph_node)
+ * in a recursive way, using a Depth First Search (DFS) algorithm.
+ * As such, primitive physical blocks (LUTs, FFs, etc.), leaf node of the pb_graph
+ * will be collected first, while the top-level will be collected in the last
+ *
+ * Note: this function will collect a unique pb_graph_node for each type of 
+ * t_pb_graph_node, i.e., t_pb_type, in the graph, in order to enable highly 
+ * hierarchical Verilog organization as well as simplify the Verilog file sizes.
+ *
+ * Note: DFS is the right way. Do NOT use BFS.
+ * DFS can guarantee that the netlists of all the sub-modules are listed
+ * before their parent in the netlist manager
+ *******************************************************************/
 static 
-void print_verilog_logical_tile_netlist(NetlistManager& netlist_manager,
-                                        const ModuleManager& module_manager,
-                                        const VprDeviceAnnotation& device_annotation,
-                                        const std::string& subckt_dir,
-                                        t_pb_graph_node* pb_graph_head,
-                                        const bool& use_explicit_mapping,
-                                        const bool& verbose) {
-
-  VTR_LOG("Writing Verilog netlists for logic tile '%s' ...",
-          pb_graph_head->pb_type->name);
-  VTR_LOG("\n");
+void rec_collect_verilog_logical_tile_pb_graph_nodes(std::vector<t_pb_graph_node*>& pb_graph_nodes,
+                                                     const VprDeviceAnnotation& device_annotation,
+                                                     t_pb_graph_node* physical_pb_graph_node) {
 
-  /* Print Verilog modules for all the pb_types/pb_graph_nodes
-   * use a Depth-First Search Algorithm to print the sub-modules 
-   * Note: DFS is the right way. Do NOT use BFS.
-   * DFS can guarantee that all the sub-modules can be registered properly
-   * to its parent in module manager  
+  /* Check cur_pb_graph_node*/
+  if (nullptr == physical_pb_graph_node) {
+    VTR_LOGF_ERROR(__FILE__, __LINE__,
+                   "Invalid physical_pb_graph_node\n"); 
+    exit(1);
+  }
+
+  /* Get the pb_type definition related to the node */
+  t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type; 
+
+  /* For non-leaf node in the pb_type graph: 
+   * Recursively Depth-First Collect all the child pb_type at the level 
    */
-  /* Print Verilog modules starting from the top-level pb_type/pb_graph_node, and traverse the graph in a recursive way */
-  rec_print_verilog_logical_tile(netlist_manager,
-                                 module_manager,
-                                 device_annotation, 
-                                 subckt_dir,
-                                 pb_graph_head,
-                                 use_explicit_mapping,
-                                 verbose);
+  if (false == is_primitive_pb_type(physical_pb_type)) { 
+    /* Find the mode that physical implementation of a pb_type */
+    t_mode* physical_mode = device_annotation.physical_mode(physical_pb_type);
 
-  VTR_LOG("Done\n");
-  VTR_LOG("\n");
+    for (int ipb = 0; ipb < physical_mode->num_pb_type_children; ++ipb) {
+      /* Go recursive to visit the children */
+      rec_collect_verilog_logical_tile_pb_graph_nodes(pb_graph_nodes,
+                                                      device_annotation,
+                                                      &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb][0]));
+    }
+  }
+
+  pb_graph_nodes.push_back(physical_pb_graph_node);
 }
 
 /*****************************************************************************
@@ -278,14 +238,16 @@ void print_verilog_logical_tile_netlist(NetlistManager& netlist_manager,
  * For IO blocks: 
  * The param 'border_side' is required, which is specify which side of fabric
  * the I/O block locates at.
+ *
+ * Return the name of the netlist, which is NOT added to the netlist manager
+ * so that netlists can be written in parallel
  *****************************************************************************/
 static 
-void print_verilog_physical_tile_netlist(NetlistManager& netlist_manager,
-                                         const ModuleManager& module_manager,
-                                         const std::string& subckt_dir,
-                                         t_physical_tile_type_ptr phy_block_type,
-                                         const e_side& border_side,
-                                         const bool& use_explicit_mapping) {
+std::string print_verilog_physical_tile_netlist(const ModuleManager& module_manager,
+                                                const std::string& subckt_dir,
+                                                t_physical_tile_type_ptr phy_block_type,
+                                                const e_side& border_side,
+                                                const bool& use_explicit_mapping) {
   /* Check code: if this is an IO block, the border side MUST be valid */
   if (true == is_io_type(phy_block_type)) {
     VTR_ASSERT(NUM_SIDES != border_side);
@@ -300,22 +262,21 @@ void print_verilog_physical_tile_netlist(NetlistManager& netlist_manager,
                                                              std::string(VERILOG_NETLIST_FILE_POSTFIX))
                            );
 
-  /* Echo status */
+  /* Echo status, netlists may be written in parallel, so each message is printed at once */
   if (true == is_io_type(phy_block_type)) {
     SideManager side_manager(border_side);
-    VTR_LOG("Writing Verilog Netlist '%s' for physical tile '%s' at %s side ...",
+    VTR_LOG("Writing Verilog Netlist '%s' for physical tile '%s' at %s side\n",
             verilog_fname.c_str(), phy_block_type->name, 
             side_manager.c_str());
   } else { 
-    VTR_LOG("Writing Verilog Netlist '%s' for physical_tile '%s'...",
+    VTR_LOG("Writing Verilog Netlist '%s' for physical_tile '%s'\n",
             verilog_fname.c_str(), phy_block_type->name);
   }
 
   /* Create the file stream */
+  std::vector<char> fp_buffer;
   std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
-
-  check_file_stream(verilog_fname.c_str(), fp);
+  open_verilog_netlist_file(fp, fp_buffer, verilog_fname);
 
   print_verilog_file_header(fp, std::string("Verilog modules for physical tile: " + std::string(phy_block_type->name) + "]")); 
 
@@ -331,17 +292,12 @@ void print_verilog_physical_tile_netlist(NetlistManager& netlist_manager,
   print_verilog_comment(fp, std::string("----- END Grid Verilog module: " + module_manager.module_name(grid_module) + " -----"));
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Close file handler */
   fp.close();
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
-
-  VTR_LOG("Done\n");
+  return verilog_fname;
 }
 
 /*****************************************************************************
@@ -349,6 +305,10 @@ void print_verilog_physical_tile_netlist(NetlistManager& netlist_manager,
  * 1. Only one module for each I/O on each border side (IO_TYPE)
  * 2. Only one module for each CLB (FILL_TYPE)
  * 3. Only one module for each heterogeneous block
+ *
+ * Netlists are written with a given number of threads, 
+ * while they are added to the netlist manager in the same sequence
+ * regardless of the number of threads
  ****************************************************************************/
 void print_verilog_grids(NetlistManager& netlist_manager,
                          const ModuleManager& module_manager,
@@ -356,32 +316,51 @@ void print_verilog_grids(NetlistManager& netlist_manager,
                          const VprDeviceAnnotation& device_annotation,
                          const std::string& subckt_dir,
                          const bool& use_explicit_mapping,
+                         const size_t& num_threads,
                          const bool& verbose) {
-  /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
-  std::vector<std::string> netlist_names;
-
   /* Enumerate the types of logical tiles, and build a module for each 
    * Write modules for all the pb_types/pb_graph_nodes
-   * use a Depth-First Search Algorithm to print the sub-modules 
+   * use a Depth-First Search Algorithm to collect the sub-modules 
    * Note: DFS is the right way. Do NOT use BFS.
-   * DFS can guarantee that all the sub-modules can be registered properly
-   * to its parent in module manager  
+   * DFS can guarantee that the netlists of all the sub-modules are listed
+   * before their parent in the netlist manager
    */
   VTR_LOG("Writing logical tiles...");
-  VTR_LOGV(verbose, "\n");
+  VTR_LOG("\n");
+  std::vector<t_pb_graph_node*> pb_graph_nodes;
   for (const t_logical_block_type& logical_tile : device_ctx.logical_block_types) {
     /* Bypass empty pb_graph */
     if (nullptr == logical_tile.pb_graph_head) {
       continue;
     }
-    print_verilog_logical_tile_netlist(netlist_manager,
-                                       module_manager,
-                                       device_annotation,
-                                       subckt_dir,
-                                       logical_tile.pb_graph_head,
-                                       use_explicit_mapping,
-                                       verbose);
+    rec_collect_verilog_logical_tile_pb_graph_nodes(pb_graph_nodes,
+                                                    device_annotation,
+                                                    logical_tile.pb_graph_head);
   }
+
+  std::vector<std::string> logical_tile_netlist_names(pb_graph_nodes.size());
+  parallel_for(pb_graph_nodes.size(), num_threads, 
+               [&](const size_t& inode) {
+    /* For leaf node, a primitive Verilog module will be generated.
+     * Note that the primitive may be mapped to a standard cell, we force to use 
+     * explict port mapping. This aims to avoid any port sequence issues!!!
+     */
+    if (true == is_primitive_pb_type(pb_graph_nodes[inode]->pb_type)) { 
+      logical_tile_netlist_names[inode] = print_verilog_primitive_block(module_manager,
+                                                                        subckt_dir,
+                                                                        pb_graph_nodes[inode], 
+                                                                        true, 
+                                                                        verbose);
+    } else {
+      logical_tile_netlist_names[inode] = print_verilog_logical_tile_pb_block(module_manager,
+                                                                              subckt_dir,
+                                                                              pb_graph_nodes[inode], 
+                                                                              use_explicit_mapping,
+                                                                              verbose);
+    }
+  });
+  add_verilog_grid_netlists(netlist_manager, logical_tile_netlist_names);
+
   VTR_LOG("Writing logical tiles...");
   VTR_LOG("Done\n");
 
@@ -391,7 +370,8 @@ void print_verilog_grids(NetlistManager& netlist_manager,
    * Use the logical tile module to build the physical tiles
    */
   VTR_LOG("Building physical tiles...");
-  VTR_LOGV(verbose, "\n");
+  VTR_LOG("\n");
+  std::vector<std::pair<t_physical_tile_type_ptr, e_side>> physical_tiles;
   for (const t_physical_tile_type& physical_tile : device_ctx.physical_tile_types) {
     /* Bypass empty type or nullptr */
     if (true == is_empty_type(&physical_tile)) {
@@ -408,38 +388,29 @@ void print_verilog_grids(NetlistManager& netlist_manager,
       std::set<e_side> io_type_sides = find_physical_io_tile_located_sides(device_ctx.grid,
                                                                            &physical_tile);
       for (const e_side& io_type_side : io_type_sides) {
-        print_verilog_physical_tile_netlist(netlist_manager,
-                                            module_manager,
-                                            subckt_dir, 
-                                            &physical_tile,
-                                            io_type_side,
-                                            use_explicit_mapping);
+        physical_tiles.push_back(std::make_pair(&physical_tile, io_type_side));
       } 
       continue;
     } else {
       /* For CLB and heterogenenous blocks */
-      print_verilog_physical_tile_netlist(netlist_manager,
-                                          module_manager,
-                                          subckt_dir, 
-                                          &physical_tile,
-                                          NUM_SIDES,
-                                          use_explicit_mapping);
+      physical_tiles.push_back(std::make_pair(&physical_tile, NUM_SIDES));
     }
   }
+
+  std::vector<std::string> physical_tile_netlist_names(physical_tiles.size());
+  parallel_for(physical_tiles.size(), num_threads, 
+               [&](const size_t& itile) {
+    physical_tile_netlist_names[itile] = print_verilog_physical_tile_netlist(module_manager,
+                                                                             subckt_dir, 
+                                                                             physical_tiles[itile].first,
+                                                                             physical_tiles[itile].second,
+                                                                             use_explicit_mapping);
+  });
+  add_verilog_grid_netlists(netlist_manager, physical_tile_netlist_names);
+
   VTR_LOG("Building physical tiles...");
   VTR_LOG("Done\n");
   VTR_LOG("\n");
-
-  /* Output a header file for all the logic blocks */
-  /*
-  std::string grid_verilog_fname(LOGIC_BLOCK_VERILOG_FILE_NAME);
-  VTR_LOG("Writing header file for grid Verilog modules '%s' ...",
-          grid_verilog_fname.c_str());
-  print_verilog_netlist_include_header_file(netlist_names,
-                                            subckt_dir.c_str(),
-                                            grid_verilog_fname.c_str());
-  VTR_LOG("Done\n");
-   */
 }
 
 } /* end namespace openfpga */
@@ -23,6 +23,7 @@ void print_verilog_grids(NetlistManager& netlist_manager,
                          const VprDeviceAnnotation& device_annotation,
                          const std::string& subckt_dir,
                          const bool& use_explicit_mapping,
+                         const size_t& num_threads,
                          const bool& verbose);
 
 
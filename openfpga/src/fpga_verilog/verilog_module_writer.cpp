@@ -8,6 +8,9 @@
  * Please use const keyword to restrict this!
  *******************************************************************/
 #include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -69,20 +72,20 @@ BasicPort generate_verilog_port_for_module_net(const ModuleManager& module_manag
    * if we have a source module is the current module, this is not local wire 
    */
   for (ModuleNetSrcId src_id : module_manager.module_net_sources(module_id, module_net)) {
-    if (module_id == module_manager.net_source_modules(module_id, module_net)[src_id]) {
+    if (module_id == module_manager.net_source_module(module_id, module_net, src_id)) {
       /* Here, this is not a local wire, return the port name of the src_port */
-      ModulePortId net_src_port = module_manager.net_source_ports(module_id, module_net)[src_id];
-      size_t src_pin_index = module_manager.net_source_pins(module_id, module_net)[src_id];
+      ModulePortId net_src_port = module_manager.net_source_port(module_id, module_net, src_id);
+      size_t src_pin_index = module_manager.net_source_pin(module_id, module_net, src_id);
       return BasicPort(module_manager.module_port(module_id, net_src_port).get_name(), src_pin_index, src_pin_index);
     }
   }
 
   /* Check all the sink modules of the net */
   for (ModuleNetSinkId sink_id : module_manager.module_net_sinks(module_id, module_net)) {
-    if (module_id == module_manager.net_sink_modules(module_id, module_net)[sink_id]) {
+    if (module_id == module_manager.net_sink_module(module_id, module_net, sink_id)) {
       /* Here, this is not a local wire, return the port name of the sink_port */
-      ModulePortId net_sink_port = module_manager.net_sink_ports(module_id, module_net)[sink_id];
-      size_t sink_pin_index = module_manager.net_sink_pins(module_id, module_net)[sink_id];
+      ModulePortId net_sink_port = module_manager.net_sink_port(module_id, module_net, sink_id);
+      size_t sink_pin_index = module_manager.net_sink_pin(module_id, module_net, sink_id);
       return BasicPort(module_manager.module_port(module_id, net_sink_port).get_name(), sink_pin_index, sink_pin_index);
     }
   }
@@ -91,16 +94,16 @@ BasicPort generate_verilog_port_for_module_net(const ModuleManager& module_manag
   std::string net_name;
 
   /* Each net must only one 1 source */ 
-  VTR_ASSERT(1 == module_manager.net_source_modules(module_id, module_net).size());
+  VTR_ASSERT(1 == module_manager.module_net_sources(module_id, module_net).size());
 
   /* Get the source module */
-  ModuleId net_src_module = module_manager.net_source_modules(module_id, module_net)[ModuleNetSrcId(0)];
+  ModuleId net_src_module = module_manager.net_source_module(module_id, module_net, ModuleNetSrcId(0));
   /* Get the instance id */
-  size_t net_src_instance = module_manager.net_source_instances(module_id, module_net)[ModuleNetSrcId(0)]; 
+  size_t net_src_instance = module_manager.net_source_instance(module_id, module_net, ModuleNetSrcId(0)); 
   /* Get the port id */
-  ModulePortId net_src_port = module_manager.net_source_ports(module_id, module_net)[ModuleNetSrcId(0)]; 
+  ModulePortId net_src_port = module_manager.net_source_port(module_id, module_net, ModuleNetSrcId(0)); 
   /* Get the pin id */
-  size_t net_src_pin = module_manager.net_source_pins(module_id, module_net)[ModuleNetSrcId(0)]; 
+  size_t net_src_pin = module_manager.net_source_pin(module_id, module_net, ModuleNetSrcId(0)); 
 
   /* Load user-defined name if we have it */
   if (false == module_manager.net_name(module_id, module_net).empty()) {
@@ -114,6 +117,53 @@ BasicPort generate_verilog_port_for_module_net(const ModuleManager& module_manag
   return BasicPort(net_name, net_src_pin, net_src_pin);
 }
 
+/********************************************************************
+ * Verilog ports of the nets of a module, indexed by nets
+ * A net is named once by generate_verilog_port_for_module_net()
+ * and the name is shared by the local wire declaration and all the instances
+ * which are connected to the net.
+ * This saves a lot of runtime for modules with many instances, e.g., the top module
+ *******************************************************************/
+struct t_verilog_module_net_ports {
+  std::vector<BasicPort> ports;
+  std::vector<bool> found;
+};
+
+static 
+const BasicPort& find_verilog_port_for_module_net(t_verilog_module_net_ports& net_ports,
+                                                  const ModuleManager& module_manager,
+                                                  const ModuleId& module_id,
+                                                  const ModuleNetId& module_net) {
+  size_t net_index = size_t(module_net);
+  if (net_index >= net_ports.found.size()) {
+    net_ports.ports.resize(net_index + 1);
+    net_ports.found.resize(net_index + 1, false);
+  }
+  if (false == net_ports.found[net_index]) {
+    net_ports.ports[net_index] = generate_verilog_port_for_module_net(module_manager, module_id, module_net);
+    net_ports.found[net_index] = true;
+  }
+  return net_ports.ports[net_index];
+}
+
+/********************************************************************
+ * Find the ports of a child module in the sequence to be connected
+ * in its instances: global, inout, input, output and clock ports.
+ * The sequence only depends on the child module,
+ * so it is found once and shared by all the instances of the child module
+ *******************************************************************/
+static 
+std::vector<std::pair<ModulePortId, BasicPort>> find_verilog_instance_port_sequence(const ModuleManager& module_manager,
+                                                                                     const ModuleId& child_module) {
+  std::vector<std::pair<ModulePortId, BasicPort>> port_sequence;
+  for (size_t port_type = 0; port_type < ModuleManager::NUM_MODULE_PORT_TYPES; ++port_type) {
+    for (const ModulePortId& child_port_id : module_manager.module_port_ids_by_type(child_module, ModuleManager::e_module_port_type(port_type))) {
+      port_sequence.push_back(std::make_pair(child_port_id, module_manager.module_port(child_module, child_port_id)));
+    }
+  }
+  return port_sequence;
+}
+
 /********************************************************************
  * Find all the nets that are going to be local wires
  * And organize it in a vector of ports
@@ -121,7 +171,8 @@ BasicPort generate_verilog_port_for_module_net(const ModuleManager& module_manag
  * to write up local wire declaration in Verilog format
  *******************************************************************/
 static 
-std::map<std::string, std::vector<BasicPort>> find_verilog_module_local_wires(const ModuleManager& module_manager,
+std::map<std::string, std::vector<BasicPort>> find_verilog_module_local_wires(t_verilog_module_net_ports& net_ports,
+                                                                              const ModuleManager& module_manager,
                                                                               const ModuleId& module_id) {
   std::map<std::string, std::vector<BasicPort>> local_wires;
 
@@ -144,7 +195,7 @@ std::map<std::string, std::vector<BasicPort>> find_verilog_module_local_wires(co
       continue;
     }
     /* Find the name for this local wire */
-    BasicPort local_wire_candidate = generate_verilog_port_for_module_net(module_manager, module_id, module_net);
+    const BasicPort& local_wire_candidate = find_verilog_port_for_module_net(net_ports, module_manager, module_id, module_net);
     /* Cache the net name, try to find it in the cache.
      * If you can find one, it means this port may be mergeable, try to do merging. If merge fail, add to the local wire list
      * If you cannot find one, it means that this port is not mergeable, add to the local wire list immediately.
@@ -153,7 +204,7 @@ std::map<std::string, std::vector<BasicPort>> find_verilog_module_local_wires(co
     bool merged = false;
     if (it != local_wires.end()) {
       /* Try to merge to one the port in the list that can absorb the current local wire */
-      for (BasicPort& local_wire : local_wires[local_wire_candidate.get_name()]) {
+      for (BasicPort& local_wire : it->second) {
         /* check if the candidate can be combined to an existing local wire */
         if (true == two_verilog_ports_mergeable(local_wire, local_wire_candidate)) {
           /* Merge the ports */
@@ -223,14 +274,14 @@ void print_verilog_module_output_short_connection(std::fstream& fp,
 
   /* We have found a module input, now check all the sink modules of the net */
   for (ModuleNetSinkId net_sink : module_manager.module_net_sinks(module_id, module_net)) {
-    ModuleId sink_module = module_manager.net_sink_modules(module_id, module_net)[net_sink];
+    ModuleId sink_module = module_manager.net_sink_module(module_id, module_net, net_sink);
     if (module_id != sink_module) {
       continue;
     }
 
     /* Find the sink port and pin information */
-    ModulePortId sink_port_id = module_manager.net_sink_ports(module_id, module_net)[net_sink];
-    size_t sink_pin = module_manager.net_sink_pins(module_id, module_net)[net_sink];
+    ModulePortId sink_port_id = module_manager.net_sink_port(module_id, module_net, net_sink);
+    size_t sink_pin = module_manager.net_sink_pin(module_id, module_net, net_sink);
     BasicPort sink_port(module_manager.module_port(module_id, sink_port_id).get_name(), sink_pin, sink_pin);
 
     /* For the first module output, this is the source port, we do nothing and go to the next */
@@ -263,27 +314,27 @@ void print_verilog_module_local_short_connection(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   for (ModuleNetSrcId net_src : module_manager.module_net_sources(module_id, module_net)) {
-    ModuleId src_module = module_manager.net_source_modules(module_id, module_net)[net_src];
+    ModuleId src_module = module_manager.net_source_module(module_id, module_net, net_src);
     if (module_id != src_module) {
       continue;
     }
     /* Find the source port and pin information */
     print_verilog_comment(fp, std::string("----- Net source id " + std::to_string(size_t(net_src)) + " -----"));
-    ModulePortId src_port_id = module_manager.net_source_ports(module_id, module_net)[net_src];
-    size_t src_pin = module_manager.net_source_pins(module_id, module_net)[net_src];
+    ModulePortId src_port_id = module_manager.net_source_port(module_id, module_net, net_src);
+    size_t src_pin = module_manager.net_source_pin(module_id, module_net, net_src);
     BasicPort src_port(module_manager.module_port(module_id, src_port_id).get_name(), src_pin, src_pin);
 
     /* We have found a module input, now check all the sink modules of the net */
     for (ModuleNetSinkId net_sink : module_manager.module_net_sinks(module_id, module_net)) {
-      ModuleId sink_module = module_manager.net_sink_modules(module_id, module_net)[net_sink];
+      ModuleId sink_module = module_manager.net_sink_module(module_id, module_net, net_sink);
       if (module_id != sink_module) {
         continue;
       }
 
       /* Find the sink port and pin information */
       print_verilog_comment(fp, std::string("----- Net sink id " + std::to_string(size_t(net_sink)) + " -----"));
-      ModulePortId sink_port_id = module_manager.net_sink_ports(module_id, module_net)[net_sink];
-      size_t sink_pin = module_manager.net_sink_pins(module_id, module_net)[net_sink];
+      ModulePortId sink_port_id = module_manager.net_sink_port(module_id, module_net, net_sink);
+      size_t sink_pin = module_manager.net_sink_pin(module_id, module_net, net_sink);
       BasicPort sink_port(module_manager.module_port(module_id, sink_port_id).get_name(), sink_pin, sink_pin);
 
       /* We need to print a wire connection here */
@@ -372,10 +423,12 @@ void print_verilog_module_output_short_connections(std::fstream& fp,
  *******************************************************************/
 static 
 void write_verilog_instance_to_file(std::fstream& fp,
+                                    t_verilog_module_net_ports& net_ports,
                                     const ModuleManager& module_manager,
                                     const ModuleId& parent_module,
                                     const ModuleId& child_module,
                                     const size_t& instance_id,
+                                    const std::vector<std::pair<ModulePortId, BasicPort>>& child_port_sequence,
                                     const bool& use_explicit_port_map) {
   /* Ensure a valid file stream */
   VTR_ASSERT(true == valid_file_stream(fp));
@@ -387,73 +440,71 @@ void write_verilog_instance_to_file(std::fstream& fp,
    * if not, we use a default name <name>_<num_instance_in_parent_module> 
    */
   if (true == module_manager.instance_name(parent_module, child_module, instance_id).empty()) {
-    fp << generate_instance_name(module_manager.module_name(child_module), instance_id) << " (" << std::endl;
+    fp << generate_instance_name(module_manager.module_name(child_module), instance_id) << " (\n";
   } else {
-    fp << module_manager.instance_name(parent_module, child_module, instance_id) << " (" << std::endl;
+    fp << module_manager.instance_name(parent_module, child_module, instance_id) << " (\n";
   }
 
   /* Print each port with/without explicit port map */
-  /* port type2type mapping */
-  std::map<ModuleManager::e_module_port_type, enum e_dump_verilog_port_type> port_type2type_map;
-  port_type2type_map[ModuleManager::MODULE_GLOBAL_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPIN_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPOUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPIO_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_INOUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_INPUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_OUTPUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_CLOCK_PORT] = VERILOG_PORT_CONKT;
-
   /* Port sequence: global, inout, input, output and clock ports, */
-  size_t port_cnt = 0;
-  for (const auto& kv : port_type2type_map) {
-    for (const ModulePortId& child_port_id : module_manager.module_port_ids_by_type(child_module, kv.first)) {
-      BasicPort child_port = module_manager.module_port(child_module, child_port_id);
-      if (0 != port_cnt) {
-        /* Do not dump a comma for the first port */
-        fp << "," << std::endl; 
-      }
-      /* Print port */
-      fp << "\t\t";
-      /* if explicit port map is required, output the port name */
-      if (true == use_explicit_port_map) {
-        fp << "." << child_port.get_name() << "(";
-      }
+  std::vector<BasicPort> merged_ports;
+  for (const auto& child_port_info : child_port_sequence) {
+    const ModulePortId& child_port_id = child_port_info.first;
+    const BasicPort& child_port = child_port_info.second;
+    if (&child_port_info != &child_port_sequence.front()) {
+      /* Do not dump a comma for the first port */
+      fp << ",\n"; 
+    }
+    /* Print port */
+    fp << "\t\t";
+    /* if explicit port map is required, output the port name */
+    if (true == use_explicit_port_map) {
+      fp << "." << child_port.get_name() << "(";
+    }
 
-      /* Create the port name and width to be used by the instance */
-      std::vector<BasicPort> instance_ports; 
-      for (size_t child_pin : child_port.pins()) {
-        /* Find the net linked to the pin */
-        ModuleNetId net = module_manager.module_instance_port_net(parent_module, child_module, instance_id, 
-                                                                  child_port_id, child_pin);
-        BasicPort instance_port;
-        if (ModuleNetId::INVALID() == net) {
-          /* We give the same port name as child module, this case happens to global ports */
-          instance_port.set_name(generate_verilog_undriven_local_wire_name(module_manager, parent_module, child_module, instance_id, child_port_id));
-          instance_port.set_width(child_pin, child_pin); 
-        } else {
-          /* Find the name for this child port */
-          instance_port = generate_verilog_port_for_module_net(module_manager, parent_module, net);
+    /* Create the port name and width to be used by the instance 
+     * Merge the port of each pin to the last port when possible, 
+     * which is the same as combine_verilog_ports() but avoids creating a port for each pin
+     */
+    merged_ports.clear();
+    BasicPort undriven_port;
+    for (size_t child_pin : child_port.pins()) {
+      /* Find the net linked to the pin */
+      ModuleNetId net = module_manager.module_instance_port_net(parent_module, child_module, instance_id, 
+                                                                child_port_id, child_pin);
+      const BasicPort* instance_port = nullptr;
+      if (ModuleNetId::INVALID() == net) {
+        /* We give the same port name as child module, this case happens to global ports */
+        if (true == undriven_port.get_name().empty()) {
+          undriven_port.set_name(generate_verilog_undriven_local_wire_name(module_manager, parent_module, child_module, instance_id, child_port_id));
         }
-        /* Create the port information for the net */
-        instance_ports.push_back(instance_port);
-      } 
-      /* Try to merge the ports */
-      std::vector<BasicPort> merged_ports = combine_verilog_ports(instance_ports); 
-
-      /* Print a verilog port by combining the instance ports */
-      fp << generate_verilog_ports(merged_ports);
-
-      /* if explicit port map is required, output the pair of branket */
-      if (true == use_explicit_port_map) {
-        fp << ")";
+        undriven_port.set_width(child_pin, child_pin); 
+        instance_port = &undriven_port;
+      } else {
+        /* Find the name for this child port */
+        instance_port = &find_verilog_port_for_module_net(net_ports, module_manager, parent_module, net);
+      }
+
+      if ( (false == merged_ports.empty())
+        && (true == instance_port->mergeable(merged_ports.back()))
+        && (merged_ports.back().get_msb() + 1 == instance_port->get_lsb()) ) {
+        merged_ports.back().set_msb(instance_port->get_msb());
+      } else {
+        merged_ports.push_back(*instance_port);
       }
-      port_cnt++;
+    } 
+
+    /* Print a verilog port by combining the instance ports */
+    fp << generate_verilog_ports(merged_ports);
+
+    /* if explicit port map is required, output the pair of branket */
+    if (true == use_explicit_port_map) {
+      fp << ")";
     }
   }
   
   /* Print an end to the instance */
-  fp << ");" << std::endl;
+  fp << ");\n";
 }
 
 /********************************************************************
@@ -475,18 +526,21 @@ void write_verilog_module_to_file(std::fstream& fp,
   print_verilog_module_declaration(fp, module_manager, module_id);
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
    
+  /* Names of the nets which are shared by local wires and instances */
+  t_verilog_module_net_ports net_ports;
+
   /* Print internal wires */
-  std::map<std::string, std::vector<BasicPort>> local_wires = find_verilog_module_local_wires(module_manager, module_id);
-  for (std::pair<std::string, std::vector<BasicPort>> port_group : local_wires) {
+  std::map<std::string, std::vector<BasicPort>> local_wires = find_verilog_module_local_wires(net_ports, module_manager, module_id);
+  for (const std::pair<const std::string, std::vector<BasicPort>>& port_group : local_wires) {
     for (const BasicPort& local_wire : port_group.second) {
-      fp << generate_verilog_port(VERILOG_PORT_WIRE, local_wire) << ";" << std::endl;
+      fp << generate_verilog_port(VERILOG_PORT_WIRE, local_wire) << ";\n";
     }
   }
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Print local connection (from module inputs to output! */
   print_verilog_comment(fp, std::string("----- BEGIN Local short connections -----"));
@@ -498,15 +552,17 @@ void write_verilog_module_to_file(std::fstream& fp,
  
   print_verilog_comment(fp, std::string("----- END Local output short connections -----"));
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Print instances */
   for (ModuleId child_module : module_manager.child_modules(module_id)) {
+    /* All the instances of a child module share the same port sequence */
+    std::vector<std::pair<ModulePortId, BasicPort>> child_port_sequence = find_verilog_instance_port_sequence(module_manager, child_module);
     for (size_t instance : module_manager.child_module_instances(module_id, child_module)) {
       /* Print an instance */
-      write_verilog_instance_to_file(fp, module_manager, module_id, child_module, instance, use_explicit_port_map); 
+      write_verilog_instance_to_file(fp, net_ports, module_manager, module_id, child_module, instance, child_port_sequence, use_explicit_port_map); 
       /* Print an empty line as splitter */
-      fp << std::endl;
+      fp << "\n";
     }
   }
 
@@ -514,7 +570,7 @@ void write_verilog_module_to_file(std::fstream& fp,
   print_verilog_module_end(fp, module_manager.module_name(module_id)); 
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 } /* end namespace openfpga */
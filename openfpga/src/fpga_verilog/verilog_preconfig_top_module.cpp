@@ -3,6 +3,7 @@
  * a Verilog module of a pre-configured FPGA fabric
  *******************************************************************/
 #include <fstream>
+#include <algorithm>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -181,6 +182,34 @@ namespace openfpga
     fp << std::endl;
   }
 
+  /********************************************************************
+ * Build the hierarchical path of a configuration block in the
+ * pre-configured FPGA top module, which ends with a '.'
+ * The top block is replaced by the instance name of the FPGA fabric
+ *******************************************************************/
+  static std::string generate_preconfig_top_module_block_path(const ModuleManager &module_manager,
+                                                              const ModuleId &top_module,
+                                                              const BitstreamManager &bitstream_manager,
+                                                              const ConfigBlockId &config_block_id)
+  {
+    /* Build the hierarchical path of the configuration bit in modules */
+    std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id);
+    /* Drop the first block, which is the top module, it should be replaced by the instance name here */
+    /* Ensure that this is the module we want to drop! */
+    VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(block_hierarchy[0])));
+    block_hierarchy.erase(block_hierarchy.begin());
+    /* Build the full hierarchy path */
+    std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
+    for (const ConfigBlockId &temp_block : block_hierarchy)
+    {
+      bit_hierarchy_path += std::string(".");
+      bit_hierarchy_path += bitstream_manager.block_name(temp_block);
+    }
+    bit_hierarchy_path += std::string(".");
+
+    return bit_hierarchy_path;
+  }
+
   /********************************************************************
  * Impose the bitstream on the configuration memories
  * This function uses 'assign' syntax to impost the bitstream at mem port
@@ -204,19 +233,8 @@ namespace openfpga
         continue;
       }
       /* Build the hierarchical path of the configuration bit in modules */
-      std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id);
-      /* Drop the first block, which is the top module, it should be replaced by the instance name here */
-      /* Ensure that this is the module we want to drop! */
-      VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(block_hierarchy[0])));
-      block_hierarchy.erase(block_hierarchy.begin());
-      /* Build the full hierarchy path */
-      std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-      for (const ConfigBlockId &temp_block : block_hierarchy)
-      {
-        bit_hierarchy_path += std::string(".");
-        bit_hierarchy_path += bitstream_manager.block_name(temp_block);
-      }
-      bit_hierarchy_path += std::string(".");
+      std::string bit_hierarchy_path = generate_preconfig_top_module_block_path(module_manager, top_module,
+                                                                                bitstream_manager, config_block_id);
 
       /* Find the bit index in the parent block */
       BasicPort config_data_port(bit_hierarchy_path + generate_configurable_memory_data_out_name(),
@@ -241,19 +259,8 @@ namespace openfpga
         continue;
       }
       /* Build the hierarchical path of the configuration bit in modules */
-      std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id);
-      /* Drop the first block, which is the top module, it should be replaced by the instance name here */
-      /* Ensure that this is the module we want to drop! */
-      VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(block_hierarchy[0])));
-      block_hierarchy.erase(block_hierarchy.begin());
-      /* Build the full hierarchy path */
-      std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-      for (const ConfigBlockId &temp_block : block_hierarchy)
-      {
-        bit_hierarchy_path += std::string(".");
-        bit_hierarchy_path += bitstream_manager.block_name(temp_block);
-      }
-      bit_hierarchy_path += std::string(".");
+      std::string bit_hierarchy_path = generate_preconfig_top_module_block_path(module_manager, top_module,
+                                                                                bitstream_manager, config_block_id);
 
       /* Find the bit index in the parent block */
       BasicPort config_datab_port(bit_hierarchy_path + generate_configurable_memory_inverted_data_out_name(),
@@ -296,19 +303,8 @@ namespace openfpga
         continue;
       }
       /* Build the hierarchical path of the configuration bit in modules */
-      std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id);
-      /* Drop the first block, which is the top module, it should be replaced by the instance name here */
-      /* Ensure that this is the module we want to drop! */
-      VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(block_hierarchy[0])));
-      block_hierarchy.erase(block_hierarchy.begin());
-      /* Build the full hierarchy path */
-      std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-      for (const ConfigBlockId &temp_block : block_hierarchy)
-      {
-        bit_hierarchy_path += std::string(".");
-        bit_hierarchy_path += bitstream_manager.block_name(temp_block);
-      }
-      bit_hierarchy_path += std::string(".");
+      std::string bit_hierarchy_path = generate_preconfig_top_module_block_path(module_manager, top_module,
+                                                                                bitstream_manager, config_block_id);
 
       /* Find the bit index in the parent block */
       BasicPort config_data_port(bit_hierarchy_path + generate_configurable_memory_data_out_name(),
@@ -338,6 +334,189 @@ namespace openfpga
     print_verilog_comment(fp, std::string("----- End deposit bitstream to configuration memories -----"));
   }
 
+  /********************************************************************
+ * Find the word size of the bitstream image,
+ * which is the largest number of configuration bits among the blocks
+ *******************************************************************/
+  static size_t find_preconfig_top_module_bitstream_image_word_size(const BitstreamManager &bitstream_manager)
+  {
+    size_t word_size = 0;
+    for (const ConfigBlockId &config_block_id : bitstream_manager.blocks())
+    {
+      word_size = std::max(word_size, bitstream_manager.block_bits(config_block_id).size());
+    }
+    return word_size;
+  }
+
+  /********************************************************************
+ * Write the bitstream of the configuration memories to a memory image file,
+ * which can be loaded by $readmemb
+ * Each line is the bits of a configuration block, in the same sequence as
+ * the blocks in the bitstream manager. Blocks without any bits are skipped.
+ * Lines are padded by '0's to the size of the largest block,
+ * so that the i-th bit of a block is the i-th bit of the memory word
+ *******************************************************************/
+  static void write_verilog_preconfig_top_module_bitstream_image(const std::string &image_fname,
+                                                                 const BitstreamManager &bitstream_manager)
+  {
+    std::string timer_message = std::string("Write bitstream image for pre-configured FPGA top-level Verilog netlist to '") + image_fname + std::string("'");
+    vtr::ScopedStartFinishTimer timer(timer_message);
+
+    /* Create the file stream */
+    std::fstream fp;
+    fp.open(image_fname, std::fstream::out | std::fstream::trunc);
+
+    check_file_stream(image_fname.c_str(), fp);
+
+    size_t word_size = find_preconfig_top_module_bitstream_image_word_size(bitstream_manager);
+    std::vector<char> word(word_size, '0');
+
+    for (const ConfigBlockId &config_block_id : bitstream_manager.blocks())
+    {
+      /* We only cares blocks with configuration bits */
+      if (0 == bitstream_manager.block_bits(config_block_id).size())
+      {
+        continue;
+      }
+      std::fill(word.begin(), word.end(), '0');
+      size_t ibit = 0;
+      for (const ConfigBitId config_bit : bitstream_manager.block_bits(config_block_id))
+      {
+        word[ibit] = bitstream_manager.bit_value(config_bit) ? '1' : '0';
+        ibit++;
+      }
+      fp.write(word.data(), word.size());
+      fp << "\n";
+    }
+
+    fp.close();
+  }
+
+  /********************************************************************
+ * Impose the bitstream on the configuration memories
+ * by loading the bitstream image, which is written by
+ * write_verilog_preconfig_top_module_bitstream_image()
+ * The k-th word of the image is applied to the k-th block with configuration bits
+ *
+ * The loader only depends on the FPGA fabric rather than the bitstream,
+ * so it is written to a separated netlist, which is included by the
+ * pre-configured FPGA top module. The netlist is the same for
+ * any design implemented on the fabric.
+ * The image file is defined by the macro PRECONFIG_BITSTREAM_IMAGE_FILE_MACRO
+ * in the pre-configured FPGA top module, which can be changed in simulation by
+ * the plusarg '+<PRECONFIG_BITSTREAM_IMAGE_PLUSARG>=<file>'
+ *
+ * We branch here for different simulators:
+ * 1. iVerilog Icarus prefers using 'assign' syntax to force the values
+ * 2. Mentor Modelsim prefers using '$deposit' syntax to do so
+ *******************************************************************/
+  static void print_verilog_preconfig_top_module_bitstream_image_loader(const std::string &loader_fname,
+                                                                        const ModuleManager &module_manager,
+                                                                        const ModuleId &top_module,
+                                                                        const BitstreamManager &bitstream_manager)
+  {
+    std::string timer_message = std::string("Write bitstream image loader for pre-configured FPGA top-level Verilog netlist to '") + loader_fname + std::string("'");
+    vtr::ScopedStartFinishTimer timer(timer_message);
+
+    /* Create the file stream */
+    std::fstream fp;
+    fp.open(loader_fname, std::fstream::out | std::fstream::trunc);
+
+    /* Validate the file stream */
+    check_file_stream(loader_fname.c_str(), fp);
+
+    /* Generate a brief description on the Verilog file*/
+    print_verilog_file_header(fp, std::string("Bitstream image loader for pre-configured FPGA fabric"));
+
+    /* Collect the blocks with configuration bits, which are the words of the image */
+    std::vector<ConfigBlockId> image_blocks;
+    for (const ConfigBlockId &config_block_id : bitstream_manager.blocks())
+    {
+      if (0 < bitstream_manager.block_bits(config_block_id).size())
+      {
+        image_blocks.push_back(config_block_id);
+      }
+    }
+    size_t word_size = find_preconfig_top_module_bitstream_image_word_size(bitstream_manager);
+
+    if (true == image_blocks.empty())
+    {
+      fp.close();
+      return;
+    }
+
+    print_verilog_comment(fp, std::string("----- Begin load bitstream image to configuration memories -----"));
+
+    fp << "reg [0:" << word_size - 1 << "] " << PRECONFIG_BITSTREAM_IMAGE_MEMORY_NAME;
+    fp << " [0:" << image_blocks.size() - 1 << "];" << std::endl;
+    fp << "reg [8*" << VERILOG_BITSTREAM_IMAGE_FILE_NAME_SIZE << "-1:0] " << PRECONFIG_BITSTREAM_IMAGE_FILE_NAME << ";" << std::endl;
+    fp << std::endl;
+
+    fp << "initial begin" << std::endl;
+    fp << "\tif (0 == $value$plusargs(\"" << PRECONFIG_BITSTREAM_IMAGE_PLUSARG << "=%s\", " << PRECONFIG_BITSTREAM_IMAGE_FILE_NAME << ")) begin" << std::endl;
+    fp << "\t\t" << PRECONFIG_BITSTREAM_IMAGE_FILE_NAME << " = `" << PRECONFIG_BITSTREAM_IMAGE_FILE_MACRO << ";" << std::endl;
+    fp << "\tend" << std::endl;
+    fp << "\t$readmemb(" << PRECONFIG_BITSTREAM_IMAGE_FILE_NAME << ", " << PRECONFIG_BITSTREAM_IMAGE_MEMORY_NAME << ");" << std::endl;
+    fp << "end" << std::endl;
+    fp << std::endl;
+
+    /* The hierarchical paths of the memory ports and their words in the image */
+    std::vector<BasicPort> config_data_ports;
+    std::vector<BasicPort> config_datab_ports;
+    std::vector<std::string> image_words;
+    for (size_t iword = 0; iword < image_blocks.size(); ++iword)
+    {
+      const ConfigBlockId &config_block_id = image_blocks[iword];
+      std::string bit_hierarchy_path = generate_preconfig_top_module_block_path(module_manager, top_module,
+                                                                                bitstream_manager, config_block_id);
+      size_t num_bits = bitstream_manager.block_bits(config_block_id).size();
+      config_data_ports.push_back(BasicPort(bit_hierarchy_path + generate_configurable_memory_data_out_name(), num_bits));
+      config_datab_ports.push_back(BasicPort(bit_hierarchy_path + generate_configurable_memory_inverted_data_out_name(), num_bits));
+      image_words.push_back(std::string(PRECONFIG_BITSTREAM_IMAGE_MEMORY_NAME) + std::string("[") + std::to_string(iword) + std::string("][0:") + std::to_string(num_bits - 1) + std::string("]"));
+    }
+
+    print_verilog_preprocessing_flag(fp, std::string(ICARUS_SIMULATOR_FLAG));
+
+    /* Use assign syntax for Icarus simulator */
+    for (size_t iword = 0; iword < image_blocks.size(); ++iword)
+    {
+      fp << "\tassign " << generate_verilog_port(VERILOG_PORT_CONKT, config_data_ports[iword]);
+      fp << " = " << image_words[iword] << ";" << std::endl;
+    }
+
+    fp << "initial begin" << std::endl;
+    /* Wait for the image to be loaded */
+    fp << "\t#0;" << std::endl;
+    for (size_t iword = 0; iword < image_blocks.size(); ++iword)
+    {
+      fp << "\tforce " << generate_verilog_port(VERILOG_PORT_CONKT, config_datab_ports[iword]);
+      fp << " = ~" << image_words[iword] << ";" << std::endl;
+    }
+    fp << "end" << std::endl;
+
+    fp << "`else" << std::endl;
+
+    /* Use deposit syntax for other simulators */
+    fp << "initial begin" << std::endl;
+    /* Wait for the image to be loaded */
+    fp << "\t#0;" << std::endl;
+    for (size_t iword = 0; iword < image_blocks.size(); ++iword)
+    {
+      fp << "\t$deposit(" << generate_verilog_port(VERILOG_PORT_CONKT, config_data_ports[iword]);
+      fp << ", " << image_words[iword] << ");" << std::endl;
+      fp << "\t$deposit(" << generate_verilog_port(VERILOG_PORT_CONKT, config_datab_ports[iword]);
+      fp << ", ~" << image_words[iword] << ");" << std::endl;
+    }
+    fp << "end" << std::endl;
+
+    print_verilog_endif(fp);
+
+    print_verilog_comment(fp, std::string("----- End load bitstream image to configuration memories -----"));
+
+    /* Close the file stream */
+    fp.close();
+  }
+
   /********************************************************************
  * Impose the bitstream on the configuration memories
  * We branch here for different simulators:
@@ -397,6 +576,10 @@ namespace openfpga
  * the port map of input benchmark.
  * It includes wires to force constant values to part of FPGA datapath I/Os
  * All these are hard to implement as a module in module manager
+ *
+ * When the file name of bitstream image is not empty, the bitstream is
+ * written to the image file, and loaded by a separated loader netlist,
+ * instead of being embedded in the module.
  *******************************************************************/
   void print_verilog_preconfig_top_module(const ModuleManager &module_manager,
                                           const BitstreamManager &bitstream_manager,
@@ -408,6 +591,8 @@ namespace openfpga
                                           const VprNetlistAnnotation &netlist_annotation,
                                           const std::string &circuit_name,
                                           const std::string &verilog_fname,
+                                          const std::string &bitstream_image_fname,
+                                          const std::string &bitstream_loader_fname,
                                           const bool &explicit_port_mapping)
   {
     std::string timer_message = std::string("Write pre-configured FPGA top-level Verilog netlist for design '") + circuit_name + std::string("'");
@@ -457,9 +642,25 @@ namespace openfpga
                                              std::string(FORMAL_VERIFICATION_TOP_MODULE_PORT_POSTFIX),
                                              (size_t)VERILOG_DEFAULT_SIGNAL_INIT_VALUE);
 
-    /* Assign FPGA internal SRAM/Memory ports to bitstream values */
-    print_verilog_preconfig_top_module_load_bitstream(fp, module_manager, top_module,
-                                                      bitstream_manager);
+    /* Assign FPGA internal SRAM/Memory ports to bitstream values
+     * When the bitstream image is used, the values are loaded from the image
+     * by the loader netlist, which is included here
+     */
+    if (true == bitstream_image_fname.empty())
+    {
+      print_verilog_preconfig_top_module_load_bitstream(fp, module_manager, top_module,
+                                                        bitstream_manager);
+    }
+    else
+    {
+      write_verilog_preconfig_top_module_bitstream_image(bitstream_image_fname, bitstream_manager);
+      print_verilog_preconfig_top_module_bitstream_image_loader(bitstream_loader_fname,
+                                                                module_manager, top_module,
+                                                                bitstream_manager);
+      fp << "`define " << PRECONFIG_BITSTREAM_IMAGE_FILE_MACRO << " \"" << bitstream_image_fname << "\"" << std::endl;
+      print_verilog_include_netlist(fp, bitstream_loader_fname);
+      fp << std::endl;
+    }
 
     /* Testbench ends*/
     print_verilog_module_end(fp, std::string(circuit_name) + std::string(FORMAL_VERIFICATION_TOP_MODULE_POSTFIX));
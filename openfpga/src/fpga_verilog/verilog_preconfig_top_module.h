@@ -30,6 +30,8 @@ void print_verilog_preconfig_top_module(const ModuleManager& module_manager,
                                         const VprNetlistAnnotation& netlist_annotation,
                                         const std::string& circuit_name,
                                         const std::string& verilog_fname,
+                                        const std::string& bitstream_image_fname,
+                                        const std::string& bitstream_loader_fname,
                                         const bool& explicit_port_mapping);
 
 } /* end namespace openfpga */
@@ -2,6 +2,8 @@
  * This file includes functions that are used for 
  * Verilog generation of FPGA routing architecture (global routing) 
  *********************************************************************/
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_time.h"
@@ -10,6 +12,8 @@
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
 
+#include "openfpga_parallel_utils.h"
+
 /* Include FPGA-Verilog header files*/
 #include "openfpga_naming.h"
 #include "verilog_constants.h"
@@ -73,23 +77,23 @@ namespace openfpga {
  *
  *  W: routing channel width
  *              
+ * Return the name of the netlist, which is NOT added to the netlist manager
+ * so that netlists can be written in parallel
  ********************************************************************/
 static 
-void print_verilog_routing_connection_box_unique_module(NetlistManager& netlist_manager,
-                                                        const ModuleManager& module_manager, 
-                                                        const std::string& subckt_dir, 
-                                                        const RRGSB& rr_gsb,
-                                                        const t_rr_type& cb_type,
-                                                        const bool& use_explicit_port_map) {
+std::string print_verilog_routing_connection_box_unique_module(const ModuleManager& module_manager, 
+                                                               const std::string& subckt_dir, 
+                                                               const RRGSB& rr_gsb,
+                                                               const t_rr_type& cb_type,
+                                                               const bool& use_explicit_port_map) {
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
   std::string verilog_fname(subckt_dir + generate_connection_block_netlist_name(cb_type, gsb_coordinate, std::string(VERILOG_NETLIST_FILE_POSTFIX)));
 
   /* Create the file stream */
+  std::vector<char> fp_buffer;
   std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
-
-  check_file_stream(verilog_fname.c_str(), fp);
+  open_verilog_netlist_file(fp, fp_buffer, verilog_fname);
 
   print_verilog_file_header(fp, std::string("Verilog modules for Unique Connection Blocks[" + std::to_string(rr_gsb.get_cb_x(cb_type)) + "]["+ std::to_string(rr_gsb.get_cb_y(cb_type)) + "]")); 
 
@@ -101,15 +105,12 @@ void print_verilog_routing_connection_box_unique_module(NetlistManager& netlist_
   write_verilog_module_to_file(fp, module_manager, cb_module, use_explicit_port_map);
  
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Close file handler */
   fp.close();
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  return verilog_fname;
 }
 
 /*********************************************************************
@@ -173,23 +174,22 @@ void print_verilog_routing_connection_box_unique_module(NetlistManager& netlist_
  *                       Grid[x][y]     ChanY[x][y]      Grid[x+1][y] 
  *                       right_pins    inputs/outputs      left_pins
  *
- *
+ * Return the name of the netlist, which is NOT added to the netlist manager
+ * so that netlists can be written in parallel
  ********************************************************************/
 static 
-void print_verilog_routing_switch_box_unique_module(NetlistManager& netlist_manager,
-                                                    const ModuleManager& module_manager, 
-                                                    const std::string& subckt_dir, 
-                                                    const RRGSB& rr_gsb,
-                                                    const bool& use_explicit_port_map) {
+std::string print_verilog_routing_switch_box_unique_module(const ModuleManager& module_manager, 
+                                                           const std::string& subckt_dir, 
+                                                           const RRGSB& rr_gsb,
+                                                           const bool& use_explicit_port_map) {
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
   std::string verilog_fname(subckt_dir + generate_routing_block_netlist_name(SB_VERILOG_FILE_NAME_PREFIX, gsb_coordinate, std::string(VERILOG_NETLIST_FILE_POSTFIX)));
 
   /* Create the file stream */
+  std::vector<char> fp_buffer;
   std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
-
-  check_file_stream(verilog_fname.c_str(), fp);
+  open_verilog_netlist_file(fp, fp_buffer, verilog_fname);
 
   print_verilog_file_header(fp, std::string("Verilog modules for Unique Switch Blocks[" + std::to_string(rr_gsb.get_sb_x()) + "]["+ std::to_string(rr_gsb.get_sb_y()) + "]")); 
 
@@ -203,23 +203,67 @@ void print_verilog_routing_switch_box_unique_module(NetlistManager& netlist_mana
   /* Close file handler */
   fp.close();
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  return verilog_fname;
+}
+
+/********************************************************************
+ * A routing module to be written to a netlist
+ * For switch blocks, the type of connection block is NUM_RR_TYPES
+ *******************************************************************/
+struct t_verilog_routing_module {
+  const RRGSB* rr_gsb;
+  t_rr_type cb_type;
+};
+
+/********************************************************************
+ * Write the netlists of a list of routing modules with a given number of threads
+ * Each netlist is written to its own file, so that they can be written in parallel.
+ * The netlists are added to the netlist manager in the sequence of the list
+ * once all of them are written, so the netlist manager is the same
+ * regardless of the number of threads
+ *******************************************************************/
+static 
+void print_verilog_routing_module_netlists(NetlistManager& netlist_manager,
+                                           const ModuleManager& module_manager, 
+                                           const std::vector<t_verilog_routing_module>& routing_modules,
+                                           const std::string& subckt_dir,
+                                           const bool& use_explicit_port_map,
+                                           const size_t& num_threads) {
+  std::vector<std::string> netlist_names(routing_modules.size());
+
+  parallel_for(routing_modules.size(), num_threads, 
+               [&](const size_t& imodule) {
+    const t_verilog_routing_module& routing_module = routing_modules[imodule];
+    if (NUM_RR_TYPES == routing_module.cb_type) {
+      netlist_names[imodule] = print_verilog_routing_switch_box_unique_module(module_manager,
+                                                                              subckt_dir, 
+                                                                              *(routing_module.rr_gsb), 
+                                                                              use_explicit_port_map);
+    } else {
+      netlist_names[imodule] = print_verilog_routing_connection_box_unique_module(module_manager,
+                                                                                  subckt_dir, 
+                                                                                  *(routing_module.rr_gsb), 
+                                                                                  routing_module.cb_type,
+                                                                                  use_explicit_port_map);
+    }
+  });
+
+  /* Add fnames to the netlist name list */
+  for (const std::string& netlist_name : netlist_names) {
+    NetlistId nlist_id = netlist_manager.add_netlist(netlist_name);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  }
 }
 
 /********************************************************************
  * Iterate over all the connection blocks in a device
- * and build a module for each of them 
+ * and collect a module for each of them 
  *******************************************************************/
 static 
-void print_verilog_flatten_connection_block_modules(NetlistManager& netlist_manager,
-                                                    const ModuleManager& module_manager, 
-                                                    const DeviceRRGSB& device_rr_gsb,
-                                                    const std::string& subckt_dir,
-                                                    const t_rr_type& cb_type,
-                                                    const bool& use_explicit_port_map) {
+void collect_verilog_flatten_connection_block_modules(std::vector<t_verilog_routing_module>& routing_modules,
+                                                      const DeviceRRGSB& device_rr_gsb,
+                                                      const t_rr_type& cb_type) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
@@ -233,11 +277,7 @@ void print_verilog_flatten_connection_block_modules(NetlistManager& netlist_mana
       if (true != rr_gsb.is_cb_exist(cb_type)) {
         continue;
       }
-      print_verilog_routing_connection_box_unique_module(netlist_manager, 
-                                                         module_manager,
-                                                         subckt_dir, 
-                                                         rr_gsb, cb_type,  
-                                                         use_explicit_port_map);
+      routing_modules.push_back({&rr_gsb, cb_type});
     }
   }
 }
@@ -255,9 +295,9 @@ void print_verilog_flatten_routing_modules(NetlistManager& netlist_manager,
                                            const ModuleManager& module_manager,
                                            const DeviceRRGSB& device_rr_gsb,
                                            const std::string& subckt_dir,
-                                           const bool& use_explicit_port_map) {
-  /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
-  std::vector<std::string> netlist_names;
+                                           const bool& use_explicit_port_map,
+                                           const size_t& num_threads) {
+  std::vector<t_verilog_routing_module> routing_modules;
 
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
 
@@ -268,27 +308,19 @@ void print_verilog_flatten_routing_modules(NetlistManager& netlist_manager,
       if (true != rr_gsb.is_sb_exist()) {
         continue;
       }
-      print_verilog_routing_switch_box_unique_module(netlist_manager,
-                                                     module_manager, 
-                                                     subckt_dir, 
-                                                     rr_gsb, 
-                                                     use_explicit_port_map);
+      routing_modules.push_back({&rr_gsb, NUM_RR_TYPES});
     }
   }
 
-  print_verilog_flatten_connection_block_modules(netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANX, use_explicit_port_map);
+  collect_verilog_flatten_connection_block_modules(routing_modules, device_rr_gsb, CHANX);
 
-  print_verilog_flatten_connection_block_modules(netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANY, use_explicit_port_map);
+  collect_verilog_flatten_connection_block_modules(routing_modules, device_rr_gsb, CHANY);
 
-  /*
-  VTR_LOG("Writing header file for routing submodules '%s'...",
-          ROUTING_VERILOG_FILE_NAME);
-  print_verilog_netlist_include_header_file(netlist_names,
-                                            subckt_dir.c_str(),
-                                            ROUTING_VERILOG_FILE_NAME);
-  VTR_LOG("Done\n");
-  VTR_LOG("\n");
-   */
+  print_verilog_routing_module_netlists(netlist_manager, module_manager,
+                                        routing_modules,
+                                        subckt_dir,
+                                        use_explicit_port_map,
+                                        num_threads);
 }
 
 
@@ -306,50 +338,31 @@ void print_verilog_unique_routing_modules(NetlistManager& netlist_manager,
                                           const ModuleManager& module_manager,
                                           const DeviceRRGSB& device_rr_gsb,
                                           const std::string& subckt_dir,
-                                          const bool& use_explicit_port_map) {
-  /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
-  std::vector<std::string> netlist_names;
+                                          const bool& use_explicit_port_map,
+                                          const size_t& num_threads) {
+  std::vector<t_verilog_routing_module> routing_modules;
 
   /* Build unique switch block modules */
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
-    print_verilog_routing_switch_box_unique_module(netlist_manager,
-                                                   module_manager,
-                                                   subckt_dir, 
-                                                   unique_mirror, 
-                                                   use_explicit_port_map);
+    routing_modules.push_back({&device_rr_gsb.get_sb_unique_module(isb), NUM_RR_TYPES});
   }
 
   /* Build unique X-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
-
-    print_verilog_routing_connection_box_unique_module(netlist_manager,
-                                                       module_manager,
-                                                       subckt_dir, 
-                                                       unique_mirror, CHANX,  
-                                                       use_explicit_port_map);
+    routing_modules.push_back({&device_rr_gsb.get_cb_unique_module(CHANX, icb), CHANX});
   }
 
-  /* Build unique X-direction connection block modules */
+  /* Build unique Y-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    print_verilog_routing_connection_box_unique_module(netlist_manager, 
-                                                       module_manager,
-                                                       subckt_dir, 
-                                                       unique_mirror, CHANY,  
-                                                       use_explicit_port_map);
+    routing_modules.push_back({&device_rr_gsb.get_cb_unique_module(CHANY, icb), CHANY});
   }
 
-  /*
-  VTR_LOG("Writing header file for routing submodules '%s'...",
-          ROUTING_VERILOG_FILE_NAME);
-  print_verilog_netlist_include_header_file(netlist_names,
-                                            subckt_dir.c_str(),
-                                            ROUTING_VERILOG_FILE_NAME);
-  VTR_LOG("Done\n");
-   */
+  print_verilog_routing_module_netlists(netlist_manager, module_manager,
+                                        routing_modules,
+                                        subckt_dir,
+                                        use_explicit_port_map,
+                                        num_threads);
+
   VTR_LOG("\n");
 }
 
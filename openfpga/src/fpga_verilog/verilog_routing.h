@@ -21,13 +21,15 @@ void print_verilog_flatten_routing_modules(NetlistManager& netlist_manager,
                                            const ModuleManager& module_manager,
                                            const DeviceRRGSB& device_rr_gsb,
                                            const std::string& subckt_dir,
-                                           const bool& use_explicit_port_map);
+                                           const bool& use_explicit_port_map,
+                                           const size_t& num_threads);
 
 void print_verilog_unique_routing_modules(NetlistManager& netlist_manager,
                                           const ModuleManager& module_manager,
                                           const DeviceRRGSB& device_rr_gsb,
                                           const std::string& subckt_dir,
-                                          const bool& use_explicit_port_map);
+                                          const bool& use_explicit_port_map,
+                                          const size_t& num_threads);
 
 } /* end namespace openfpga */
 
@@ -18,6 +18,7 @@ VerilogTestbenchOption::VerilogTestbenchOption() {
   print_preconfig_top_testbench_ = false;
   print_formal_verification_top_netlist_ = false;
   print_top_testbench_ = false;
+  load_bitstream_image_ = false;
   simulation_ini_path_.clear();
   explicit_port_mapping_ = false;
   verbose_output_ = false;
@@ -50,6 +51,10 @@ bool VerilogTestbenchOption::fast_configuration() const {
   return fast_configuration_;
 }
 
+bool VerilogTestbenchOption::load_bitstream_image() const {
+  return load_bitstream_image_;
+}
+
 bool VerilogTestbenchOption::print_simulation_ini() const {
   return !simulation_ini_path_.empty();
 }
@@ -90,6 +95,10 @@ void VerilogTestbenchOption::set_fast_configuration(const bool& enabled) {
   fast_configuration_ = enabled;
 }
 
+void VerilogTestbenchOption::set_load_bitstream_image(const bool& enabled) {
+  load_bitstream_image_ = enabled;
+}
+
 void VerilogTestbenchOption::set_print_preconfig_top_testbench(const bool& enabled) {
   print_preconfig_top_testbench_ = enabled
                                  && (!reference_benchmark_file_path_.empty());
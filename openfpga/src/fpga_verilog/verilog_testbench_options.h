@@ -25,6 +25,7 @@ class VerilogTestbenchOption {
     std::string output_directory() const;
     std::string reference_benchmark_file_path() const;
     bool fast_configuration() const;
+    bool load_bitstream_image() const;
     bool print_formal_verification_top_netlist() const;
     bool print_preconfig_top_testbench() const;
     bool print_top_testbench() const;
@@ -46,6 +47,10 @@ class VerilogTestbenchOption {
     /* The preconfig top testbench generation can be enabled only when formal verification top netlist is enabled */
     void set_print_preconfig_top_testbench(const bool& enabled);
     void set_fast_configuration(const bool& enabled);
+    /* Write the bitstream to a memory image file, which is loaded by the full testbench,
+     * instead of embedding the bitstream in the testbench
+     */
+    void set_load_bitstream_image(const bool& enabled);
     void set_print_top_testbench(const bool& enabled);
     void set_print_simulation_ini(const std::string& simulation_ini_path);
     void set_explicit_port_mapping(const bool& enabled);
@@ -54,6 +59,7 @@ class VerilogTestbenchOption {
     std::string output_directory_;
     std::string reference_benchmark_file_path_;
     bool fast_configuration_;
+    bool load_bitstream_image_;
     bool print_formal_verification_top_netlist_;
     bool print_preconfig_top_testbench_;
     bool print_top_testbench_;
@@ -9,6 +9,7 @@
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
+#include "vtr_time.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
@@ -47,14 +48,13 @@ void print_verilog_top_module(NetlistManager& netlist_manager,
   /* Create the file name for Verilog netlist */
   std::string verilog_fname(verilog_dir + generate_fpga_top_netlist_name(std::string(VERILOG_NETLIST_FILE_POSTFIX)));
 
-  VTR_LOG("Writing Verilog netlist for top-level module of FPGA fabric '%s'...",
-          verilog_fname.c_str());
+  std::string timer_message = std::string("Write Verilog netlist for top-level module of FPGA fabric '") + verilog_fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
 
   /* Create the file stream */
+  std::vector<char> fp_buffer;
   std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
-
-  check_file_stream(verilog_fname.c_str(), fp);
+  open_verilog_netlist_file(fp, fp_buffer, verilog_fname);
 
   print_verilog_file_header(fp, std::string("Top-level Verilog module for FPGA")); 
 
@@ -62,7 +62,7 @@ void print_verilog_top_module(NetlistManager& netlist_manager,
   write_verilog_module_to_file(fp, module_manager, top_module, use_explicit_mapping);
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Close file handler */
   fp.close();
@@ -71,8 +71,6 @@ void print_verilog_top_module(NetlistManager& netlist_manager,
   NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
   VTR_ASSERT(NetlistId::INVALID() != nlist_id);
   netlist_manager.set_netlist_type(nlist_id, NetlistManager::TOP_MODULE_NETLIST);
-
-  VTR_LOG("Done\n");
 }
 
 } /* end namespace openfpga */
@@ -5,6 +5,7 @@
 #include <fstream>
 #include <iomanip>
 #include <algorithm>
+#include <numeric>
 
 
 /* Headers from vtrutil library */
@@ -43,6 +44,11 @@ constexpr char* TOP_TESTBENCH_CHECKFLAG_PORT_POSTFIX = "_flag";
 
 constexpr char* TOP_TESTBENCH_PROG_TASK_NAME = "prog_cycle_task";
 
+constexpr char* TOP_TESTBENCH_BITSTREAM_IMAGE_MEMORY_NAME = "bitstream_image";
+constexpr char* TOP_TESTBENCH_BITSTREAM_IMAGE_INDEX_NAME = "bitstream_index";
+constexpr char* TOP_TESTBENCH_BITSTREAM_IMAGE_FILE_NAME = "bitstream_image_file";
+constexpr char* TOP_TESTBENCH_BITSTREAM_IMAGE_PLUSARG = "bitstream_image";
+
 constexpr char* TOP_TESTBENCH_SIM_START_PORT_NAME = "sim_start";
 
 constexpr int TOP_TESTBENCH_MAGIC_NUMBER_FOR_SIMULATION_TIME = 200;
@@ -88,18 +94,24 @@ void print_verilog_top_testbench_flatten_memory_port(std::fstream& fp,
  * Print local wires for configuration chain protocols
  *******************************************************************/
 static
-void print_verilog_top_testbench_config_chain_port(std::fstream& fp) {
+void print_verilog_top_testbench_config_chain_port(std::fstream& fp,
+                                                   const ModuleManager& module_manager,
+                                                   const ModuleId& top_module) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  /* Print the head of configuraion-chains here */
+  /* Print the head of configuraion-chains here 
+   * Each configuration region has its own chain 
+   */
   print_verilog_comment(fp, std::string("---- Configuration-chain head -----"));
-  BasicPort config_chain_head_port(generate_configuration_chain_head_name(), 1);
+  ModulePortId config_chain_head_port_id = module_manager.find_module_port(top_module, generate_configuration_chain_head_name());
+  BasicPort config_chain_head_port = module_manager.module_port(top_module, config_chain_head_port_id);
   fp << generate_verilog_port(VERILOG_PORT_REG, config_chain_head_port) << ";" << std::endl;
 
   /* Print the tail of configuration-chains here */
   print_verilog_comment(fp, std::string("---- Configuration-chain tail -----"));
-  BasicPort config_chain_tail_port(generate_configuration_chain_tail_name(), 1);
+  ModulePortId config_chain_tail_port_id = module_manager.find_module_port(top_module, generate_configuration_chain_tail_name());
+  BasicPort config_chain_tail_port = module_manager.module_port(top_module, config_chain_tail_port_id);
   fp << generate_verilog_port(VERILOG_PORT_WIRE, config_chain_tail_port) << ";" << std::endl;
 }
 
@@ -197,7 +209,7 @@ void print_verilog_top_testbench_config_protocol_port(std::fstream& fp,
     print_verilog_top_testbench_flatten_memory_port(fp, module_manager, top_module);
     break;
   case CONFIG_MEM_SCAN_CHAIN:
-    print_verilog_top_testbench_config_chain_port(fp);
+    print_verilog_top_testbench_config_chain_port(fp, module_manager, top_module);
     break;
   case CONFIG_MEM_MEMORY_BANK:
     print_verilog_top_testbench_memory_bank_port(fp, module_manager, top_module);
@@ -550,10 +562,56 @@ void print_verilog_top_testbench_ports(std::fstream& fp,
   fp << "\tinteger " << TOP_TESTBENCH_ERROR_COUNTER << "= 0;" << std::endl;
 }
 
+/********************************************************************
+ * Find the number of cycles to load the fabric bitstream,
+ * where all the configuration regions are loaded in parallel.
+ * It is determined by the region with the most bits
+ *******************************************************************/
+static
+size_t find_fabric_bitstream_num_region_cycles(const FabricBitstream& fabric_bitstream) {
+  size_t num_cycles = 0;
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    num_cycles = std::max(num_cycles, fabric_bitstream.region_num_bits(region));
+  }
+  return num_cycles;
+}
+
+/********************************************************************
+ * Find the bit of a configuration region to be loaded in a cycle
+ * As the regions may have different number of bits:
+ * - For configuration chain, shorter regions are padded at the head,
+ *   where an invalid id is returned, standing for a dummy '0'.
+ *   The dummy bits are shifted out of the chain before the last cycle
+ * - For the other protocols, shorter regions repeat their last bit,
+ *   which does not change the configuration
+ *******************************************************************/
+static
+FabricBitId find_fabric_bitstream_region_bit_in_cycle(const FabricBitstream& fabric_bitstream,
+                                                      const FabricBitRegionId& region,
+                                                      const size_t& cycle,
+                                                      const size_t& num_cycles,
+                                                      const bool& pad_head) {
+  size_t region_num_bits = fabric_bitstream.region_num_bits(region);
+  if (0 == region_num_bits) {
+    return FabricBitId::INVALID();
+  }
+
+  size_t first_bit = size_t(*fabric_bitstream.region_bits(region).begin());
+  if (true == pad_head) {
+    if (cycle < num_cycles - region_num_bits) {
+      return FabricBitId::INVALID();
+    }
+    return FabricBitId(first_bit + cycle - (num_cycles - region_num_bits));
+  }
+  return FabricBitId(first_bit + std::min(cycle, region_num_bits - 1));
+}
+
 /********************************************************************
  * Estimate the number of configuration clock cycles
  * by traversing the linked-list and count the number of SRAM=1 or BL=1&WL=1 in it.
  * We plus 1 additional config clock cycle here because we need to reset everything during the first clock cycle
+ * All the configuration regions are loaded in parallel, 
+ * so that a clock cycle counts the bits of all the regions.
  * If we consider fast configuration, the number of clock cycles will be
  * the number of non-zero data points in the fabric bitstream
  * Note that this will not applicable to configuration chain!!!
@@ -563,7 +621,8 @@ size_t calculate_num_config_clock_cycles(const e_config_protocol_type& sram_orgz
                                          const bool& fast_configuration,
                                          const BitstreamManager& bitstream_manager,
                                          const FabricBitstream& fabric_bitstream) {
-  size_t num_config_clock_cycles = 1 + fabric_bitstream.num_bits();
+  size_t num_cycles = find_fabric_bitstream_num_region_cycles(fabric_bitstream);
+  size_t num_config_clock_cycles = 1 + num_cycles;
 
   /* Branch on the type of configuration protocol */
   switch (sram_orgz_type) {
@@ -578,8 +637,16 @@ size_t calculate_num_config_clock_cycles(const e_config_protocol_type& sram_orgz
     if (true == fast_configuration) {
       size_t full_num_config_clock_cycles = num_config_clock_cycles;
       size_t num_bits_to_skip = 0;
-      for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-        if (true == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
+      for (size_t icycle = 0; icycle < num_cycles; ++icycle) {
+        bool start_config = false;
+        for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+          FabricBitId bit_id = find_fabric_bitstream_region_bit_in_cycle(fabric_bitstream, region, icycle, num_cycles, true);
+          if ( (true == fabric_bitstream.valid_bit_id(bit_id))
+            && (true == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id)))) {
+            start_config = true;
+          }
+        }
+        if (true == start_config) {
           break;
         }
         num_bits_to_skip++;
@@ -599,9 +666,14 @@ size_t calculate_num_config_clock_cycles(const e_config_protocol_type& sram_orgz
     if (true == fast_configuration) {
       size_t full_num_config_clock_cycles = num_config_clock_cycles;
       num_config_clock_cycles = 1;
-      for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-        if (true == fabric_bitstream.bit_din(bit_id)) {
-          num_config_clock_cycles++;
+      for (size_t icycle = 0; icycle < num_cycles; ++icycle) {
+        for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+          FabricBitId bit_id = find_fabric_bitstream_region_bit_in_cycle(fabric_bitstream, region, icycle, num_cycles, false);
+          if ( (true == fabric_bitstream.valid_bit_id(bit_id))
+            && (true == fabric_bitstream.bit_din(bit_id))) {
+            num_config_clock_cycles++;
+            break;
+          }
         }
       }
       VTR_LOG("Fast configuration reduces number of configuration clock cycles from %lu to %lu (compression_rate = %f%)\n",
@@ -672,16 +744,21 @@ void print_verilog_top_testbench_benchmark_instance(std::fstream& fp,
  * which is very useful in generating stimuli for each clock cycle
  * This function is tuned for configuration-chain manipulation:
  * During each programming cycle, we feed the input of scan chain with a memory bit
+ * There is one memory bit for each configuration region
  *******************************************************************/
 static
-void print_verilog_top_testbench_load_bitstream_task_configuration_chain(std::fstream& fp) {
+void print_verilog_top_testbench_load_bitstream_task_configuration_chain(std::fstream& fp,
+                                                                         const ModuleManager& module_manager,
+                                                                         const ModuleId& top_module) {
 
   /* Validate the file stream */
   valid_file_stream(fp);
 
   BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
-  BasicPort cc_head_port(generate_configuration_chain_head_name(), 1);
-  BasicPort cc_head_value(generate_configuration_chain_head_name() + std::string("_val"), 1);
+  ModulePortId cc_head_port_id = module_manager.find_module_port(top_module, generate_configuration_chain_head_name());
+  BasicPort cc_head_port = module_manager.module_port(top_module, cc_head_port_id);
+  BasicPort cc_head_value = cc_head_port;
+  cc_head_value.set_name(generate_configuration_chain_head_name() + std::string("_val"));
 
   /* Add an empty line as splitter */
   fp << std::endl;
@@ -870,7 +947,9 @@ void print_verilog_top_testbench_load_bitstream_task(std::fstream& fp,
     /* No need to have a specific task. Loading is done in 1 clock cycle */
     break;
   case CONFIG_MEM_SCAN_CHAIN:
-    print_verilog_top_testbench_load_bitstream_task_configuration_chain(fp);
+    print_verilog_top_testbench_load_bitstream_task_configuration_chain(fp,
+                                                                        module_manager,
+                                                                        top_module);
     break;
   case CONFIG_MEM_MEMORY_BANK:
     print_verilog_top_testbench_load_bitstream_task_memory_bank(fp,
@@ -1112,6 +1191,301 @@ void print_verilog_top_testbench_vanilla_bitstream(std::fstream& fp,
   print_verilog_comment(fp, "----- End bitstream loading during configuration phase -----");
 }
 
+/********************************************************************
+ * Find the widths of the arguments of the programming task,
+ * which are the values to be loaded in a configuration cycle
+ * - Configuration chain: <heads of the chains>
+ * - Memory bank: <BL addresses> <WL addresses> <data inputs>
+ * - Frame-based: <addresses> <data inputs>
+ * Each configuration region owns its slice of each argument
+ *******************************************************************/
+static
+std::vector<size_t> find_top_testbench_config_cycle_value_widths(const e_config_protocol_type& sram_orgz_type,
+                                                                 const FabricBitstream& fabric_bitstream) {
+  size_t num_regions = fabric_bitstream.num_regions();
+  std::vector<size_t> widths;
+
+  switch (sram_orgz_type) {
+  case CONFIG_MEM_SCAN_CHAIN:
+    widths.push_back(num_regions);
+    break;
+  case CONFIG_MEM_MEMORY_BANK:
+    widths.push_back(num_regions * fabric_bitstream.bl_address_length());
+    widths.push_back(num_regions * fabric_bitstream.wl_address_length());
+    widths.push_back(num_regions);
+    break;
+  case CONFIG_MEM_FRAME_BASED:
+    widths.push_back(num_regions * fabric_bitstream.address_length());
+    widths.push_back(num_regions);
+    break;
+  default:
+    VTR_LOGF_ERROR(__FILE__, __LINE__,
+                   "Invalid SRAM organization type!\n");
+    exit(1);
+  }
+
+  return widths;
+}
+
+/********************************************************************
+ * Find the values to be loaded in a configuration cycle, which are the
+ * arguments of the programming task concatenated in a binary format
+ * (see find_top_testbench_config_cycle_value_widths())
+ * The value buffer is shared across cycles to avoid memory allocation
+ *
+ * Return true if any configuration data is '1' in the cycle,
+ * which is required by the fast configuration
+ *******************************************************************/
+static
+bool find_top_testbench_config_cycle_values(const e_config_protocol_type& sram_orgz_type,
+                                            const BitstreamManager& bitstream_manager,
+                                            const FabricBitstream& fabric_bitstream,
+                                            const size_t& cycle,
+                                            const size_t& num_cycles,
+                                            std::vector<char>& values) {
+  size_t num_regions = fabric_bitstream.num_regions();
+  size_t addr_length = fabric_bitstream.address_length();
+  size_t wl_addr_length = 0;
+  if (CONFIG_MEM_MEMORY_BANK == sram_orgz_type) {
+    addr_length = fabric_bitstream.bl_address_length();
+    wl_addr_length = fabric_bitstream.wl_address_length();
+  }
+  if (CONFIG_MEM_SCAN_CHAIN == sram_orgz_type) {
+    addr_length = 0;
+  }
+  size_t wl_addr_offset = num_regions * addr_length;
+  size_t din_offset = wl_addr_offset + num_regions * wl_addr_length;
+  VTR_ASSERT(din_offset + num_regions == values.size());
+
+  bool has_din = false;
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    FabricBitId bit_id = find_fabric_bitstream_region_bit_in_cycle(fabric_bitstream, region, cycle, num_cycles,
+                                                                   CONFIG_MEM_SCAN_CHAIN == sram_orgz_type);
+    values[din_offset + size_t(region)] = '0';
+    if (false == fabric_bitstream.valid_bit_id(bit_id)) {
+      continue;
+    }
+
+    bool din = false;
+    if (CONFIG_MEM_SCAN_CHAIN == sram_orgz_type) {
+      din = bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id));
+    } else {
+      din = fabric_bitstream.bit_din(bit_id);
+    }
+
+    if (CONFIG_MEM_MEMORY_BANK == sram_orgz_type) {
+      fabric_bitstream.emit_bit_bl_address(bit_id, values.data() + size_t(region) * addr_length);
+      fabric_bitstream.emit_bit_wl_address(bit_id, values.data() + wl_addr_offset + size_t(region) * wl_addr_length);
+    } else if (CONFIG_MEM_FRAME_BASED == sram_orgz_type) {
+      fabric_bitstream.emit_bit_address(bit_id, values.data() + size_t(region) * addr_length);
+    }
+
+    if (true == din) {
+      values[din_offset + size_t(region)] = '1';
+      has_din = true;
+    }
+  }
+
+  return has_din;
+}
+
+/********************************************************************
+ * Visit the configuration cycles to be loaded by the programming task
+ * Attention: when the fast configuration is enabled,
+ * - For configuration chain, we will start from the first bit '1'
+ *   This requires a reset signal (as we forced in the first clock cycle)
+ * - For the others, we will skip all the zero data points
+ * Return true if the cycle should be loaded
+ *******************************************************************/
+static
+bool is_top_testbench_config_cycle_loaded(const e_config_protocol_type& sram_orgz_type,
+                                          const bool& fast_configuration,
+                                          const bool& has_din,
+                                          bool& start_config) {
+  if (true == has_din) {
+    start_config = true;
+  }
+  if (false == fast_configuration) {
+    return true;
+  }
+  if (CONFIG_MEM_SCAN_CHAIN == sram_orgz_type) {
+    return start_config;
+  }
+  return has_din;
+}
+
+/********************************************************************
+ * Print the calls of the programming task for all the configuration cycles,
+ * each of which loads a configuration bit in each configuration region
+ *******************************************************************/
+static
+void print_verilog_top_testbench_config_cycles(std::fstream& fp,
+                                               const e_config_protocol_type& sram_orgz_type,
+                                               const bool& fast_configuration,
+                                               const BitstreamManager& bitstream_manager,
+                                               const FabricBitstream& fabric_bitstream) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  std::vector<size_t> widths = find_top_testbench_config_cycle_value_widths(sram_orgz_type, fabric_bitstream);
+  std::vector<char> values(std::accumulate(widths.begin(), widths.end(), size_t(0)), '0');
+
+  size_t num_cycles = find_fabric_bitstream_num_region_cycles(fabric_bitstream);
+  bool start_config = false;
+  for (size_t icycle = 0; icycle < num_cycles; ++icycle) {
+    bool has_din = find_top_testbench_config_cycle_values(sram_orgz_type, bitstream_manager, fabric_bitstream,
+                                                          icycle, num_cycles, values);
+    if (false == is_top_testbench_config_cycle_loaded(sram_orgz_type, fast_configuration, has_din, start_config)) {
+      continue;
+    }
+
+    fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
+    fp << "(";
+    size_t offset = 0;
+    for (size_t iarg = 0; iarg < widths.size(); ++iarg) {
+      if (0 < iarg) {
+        fp << ", ";
+      }
+      fp << widths[iarg] << "'b";
+      fp.write(values.data() + offset, widths[iarg]);
+      offset += widths[iarg];
+    }
+    fp << ");" << std::endl;
+  }
+}
+
+/********************************************************************
+ * Write the configuration cycles to a memory image file, 
+ * which can be loaded by $readmemb in the testbench
+ * Each line is the values of a configuration cycle, i.e., the arguments of 
+ * the programming task concatenated in a binary format
+ * Only the cycles to be loaded are written,
+ * so that the fast configuration applies to the image
+ *******************************************************************/
+static
+void write_verilog_top_testbench_bitstream_image(const std::string& image_fname,
+                                                 const e_config_protocol_type& sram_orgz_type,
+                                                 const bool& fast_configuration,
+                                                 const BitstreamManager& bitstream_manager,
+                                                 const FabricBitstream& fabric_bitstream) {
+  std::string timer_message = std::string("Write bitstream image for autocheck testbench to '") + image_fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(image_fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(image_fname.c_str(), fp);
+
+  std::vector<size_t> widths = find_top_testbench_config_cycle_value_widths(sram_orgz_type, fabric_bitstream);
+  std::vector<char> values(std::accumulate(widths.begin(), widths.end(), size_t(0)), '0');
+
+  size_t num_cycles = find_fabric_bitstream_num_region_cycles(fabric_bitstream);
+  size_t num_loaded_cycles = 0;
+  bool start_config = false;
+  for (size_t icycle = 0; icycle < num_cycles; ++icycle) {
+    bool has_din = find_top_testbench_config_cycle_values(sram_orgz_type, bitstream_manager, fabric_bitstream,
+                                                          icycle, num_cycles, values);
+    if (false == is_top_testbench_config_cycle_loaded(sram_orgz_type, fast_configuration, has_din, start_config)) {
+      continue;
+    }
+    fp.write(values.data(), values.size());
+    fp << "\n";
+    num_loaded_cycles++;
+  }
+
+  fp.close();
+
+  VTR_LOG("Wrote %lu configuration cycles to bitstream image\n",
+          num_loaded_cycles);
+}
+
+/********************************************************************
+ * Print the memory which holds the bitstream image and its file name
+ * The memory is as deep as the full bitstream, so that the testbench
+ * can be reused by any bitstream of the same fabric
+ *******************************************************************/
+static
+void print_verilog_top_testbench_bitstream_image_memory(std::fstream& fp,
+                                                        const e_config_protocol_type& sram_orgz_type,
+                                                        const FabricBitstream& fabric_bitstream) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  std::vector<size_t> widths = find_top_testbench_config_cycle_value_widths(sram_orgz_type, fabric_bitstream);
+  size_t word_size = std::accumulate(widths.begin(), widths.end(), size_t(0));
+  size_t num_cycles = find_fabric_bitstream_num_region_cycles(fabric_bitstream);
+
+  print_verilog_comment(fp, "----- Bitstream image to be loaded during configuration phase -----");
+  fp << "reg [0:" << word_size - 1 << "] " << TOP_TESTBENCH_BITSTREAM_IMAGE_MEMORY_NAME;
+  fp << " [0:" << std::max(num_cycles, size_t(1)) - 1 << "];" << std::endl;
+  fp << "reg [8*" << VERILOG_BITSTREAM_IMAGE_FILE_NAME_SIZE << "-1:0] " << TOP_TESTBENCH_BITSTREAM_IMAGE_FILE_NAME << ";" << std::endl;
+  fp << "integer " << TOP_TESTBENCH_BITSTREAM_IMAGE_INDEX_NAME << ";" << std::endl;
+  fp << std::endl;
+}
+
+/********************************************************************
+ * Print a loop which calls the programming task for each configuration cycle
+ * in the bitstream image.
+ * The image file can be changed by the plusarg '+<TOP_TESTBENCH_BITSTREAM_IMAGE_PLUSARG>=<file>'
+ * The loop stops at the first word which is not loaded from the file
+ *******************************************************************/
+static
+void print_verilog_top_testbench_bitstream_image_loop(std::fstream& fp,
+                                                      const e_config_protocol_type& sram_orgz_type,
+                                                      const FabricBitstream& fabric_bitstream,
+                                                      const std::string& image_fname) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  std::vector<size_t> widths = find_top_testbench_config_cycle_value_widths(sram_orgz_type, fabric_bitstream);
+  size_t num_cycles = find_fabric_bitstream_num_region_cycles(fabric_bitstream);
+  std::string mem_word = std::string(TOP_TESTBENCH_BITSTREAM_IMAGE_MEMORY_NAME) + std::string("[") + std::string(TOP_TESTBENCH_BITSTREAM_IMAGE_INDEX_NAME) + std::string("]");
+
+  print_verilog_comment(fp, "----- Load bitstream image -----");
+  fp << "\t\tif (0 == $value$plusargs(\"" << TOP_TESTBENCH_BITSTREAM_IMAGE_PLUSARG << "=%s\", " << TOP_TESTBENCH_BITSTREAM_IMAGE_FILE_NAME << ")) begin" << std::endl;
+  fp << "\t\t\t" << TOP_TESTBENCH_BITSTREAM_IMAGE_FILE_NAME << " = \"" << image_fname << "\";" << std::endl;
+  fp << "\t\tend" << std::endl;
+  fp << "\t\t$readmemb(" << TOP_TESTBENCH_BITSTREAM_IMAGE_FILE_NAME << ", " << TOP_TESTBENCH_BITSTREAM_IMAGE_MEMORY_NAME << ");" << std::endl;
+  fp << "\t\t" << TOP_TESTBENCH_BITSTREAM_IMAGE_INDEX_NAME << " = 0;" << std::endl;
+  fp << "\t\twhile ((" << TOP_TESTBENCH_BITSTREAM_IMAGE_INDEX_NAME << " < " << num_cycles << ")";
+  fp << " && (1'bx !== ^" << mem_word << ")) begin" << std::endl;
+  fp << "\t\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME) << "(";
+  size_t offset = 0;
+  for (size_t iarg = 0; iarg < widths.size(); ++iarg) {
+    if (0 < iarg) {
+      fp << ", ";
+    }
+    fp << mem_word << "[" << offset << ":" << offset + widths[iarg] - 1 << "]";
+    offset += widths[iarg];
+  }
+  fp << ");" << std::endl;
+  fp << "\t\t\t" << TOP_TESTBENCH_BITSTREAM_IMAGE_INDEX_NAME << " = " << TOP_TESTBENCH_BITSTREAM_IMAGE_INDEX_NAME << " + 1;" << std::endl;
+  fp << "\t\tend" << std::endl;
+}
+
+/********************************************************************
+ * Print the configuration cycles in a testbench, either 
+ * - by calling the programming task for each cycle, or
+ * - by loading the bitstream image, when its file name is given
+ *******************************************************************/
+static
+void print_verilog_top_testbench_config_cycles_or_image(std::fstream& fp,
+                                                        const e_config_protocol_type& sram_orgz_type,
+                                                        const bool& fast_configuration,
+                                                        const BitstreamManager& bitstream_manager,
+                                                        const FabricBitstream& fabric_bitstream,
+                                                        const std::string& bitstream_image_fname) {
+  if (true == bitstream_image_fname.empty()) {
+    print_verilog_top_testbench_config_cycles(fp, sram_orgz_type, fast_configuration,
+                                              bitstream_manager, fabric_bitstream);
+  } else if (0 < fabric_bitstream.num_bits()) {
+    print_verilog_top_testbench_bitstream_image_loop(fp, sram_orgz_type,
+                                                     fabric_bitstream,
+                                                     bitstream_image_fname);
+  }
+}
+
 /********************************************************************
  * Print stimulus for a FPGA fabric with a configuration chain protocol
  * where configuration bits are programming in serial (one by one)
@@ -1127,8 +1501,11 @@ void print_verilog_top_testbench_vanilla_bitstream(std::fstream& fp,
 static
 void print_verilog_top_testbench_configuration_chain_bitstream(std::fstream& fp,
                                                                const bool& fast_configuration,
+                                                               const ModuleManager& module_manager,
+                                                               const ModuleId& top_module,
                                                                const BitstreamManager& bitstream_manager,
-                                                               const FabricBitstream& fabric_bitstream) {
+                                                               const FabricBitstream& fabric_bitstream,
+                                                               const std::string& bitstream_image_fname) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
@@ -1138,9 +1515,17 @@ void print_verilog_top_testbench_configuration_chain_bitstream(std::fstream& fp,
    * We do not care the value of scan_chain head during the first programming cycle
    * It is reset anyway
    */
-  BasicPort config_chain_head_port(generate_configuration_chain_head_name(), 1);
+  ModulePortId config_chain_head_port_id = module_manager.find_module_port(top_module, generate_configuration_chain_head_name());
+  BasicPort config_chain_head_port = module_manager.module_port(top_module, config_chain_head_port_id);
   std::vector<size_t> initial_values(config_chain_head_port.get_width(), 0);
 
+  /* Each configuration region has its own chain, whose bits are fed in parallel */
+  VTR_ASSERT(config_chain_head_port.get_width() == fabric_bitstream.num_regions());
+
+  if (false == bitstream_image_fname.empty()) {
+    print_verilog_top_testbench_bitstream_image_memory(fp, CONFIG_MEM_SCAN_CHAIN, fabric_bitstream);
+  }
+
   print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
   fp << "initial" << std::endl;
   fp << "\tbegin" << std::endl;
@@ -1151,27 +1536,9 @@ void print_verilog_top_testbench_configuration_chain_bitstream(std::fstream& fp,
 
   fp << std::endl;
 
-  /* Attention: when the fast configuration is enabled, we will start from the first bit '1'
-   * This requires a reset signal (as we forced in the first clock cycle)
-   */
-  bool start_config = false;
-  for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-    if ( (false == start_config)
-      && (true == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id)))) {
-      start_config = true;
-    } 
-
-    /* In fast configuration mode, we do not output anything
-     * until we have to (the first bit '1' detected)
-     */
-    if ( (true == fast_configuration)
-      && (false == start_config)) {
-      continue;
-    }
-
-    fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
-    fp << "(1'b" << (size_t)bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id)) << ");" << std::endl;
-  }
+  print_verilog_top_testbench_config_cycles_or_image(fp, CONFIG_MEM_SCAN_CHAIN, fast_configuration,
+                                                     bitstream_manager, fabric_bitstream,
+                                                     bitstream_image_fname);
 
   /* Raise the flag of configuration done when bitstream loading is complete */
   BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
@@ -1200,7 +1567,9 @@ void print_verilog_top_testbench_memory_bank_bitstream(std::fstream& fp,
                                                        const bool& fast_configuration,
                                                        const ModuleManager& module_manager,
                                                        const ModuleId& top_module,
-                                                       const FabricBitstream& fabric_bitstream) {
+                                                       const BitstreamManager& bitstream_manager,
+                                                       const FabricBitstream& fabric_bitstream,
+                                                       const std::string& bitstream_image_fname) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
@@ -1223,6 +1592,18 @@ void print_verilog_top_testbench_memory_bank_bitstream(std::fstream& fp,
   BasicPort din_port = module_manager.module_port(top_module, din_port_id);
   std::vector<size_t> initial_din_values(din_port.get_width(), 0);
 
+  /* Each configuration region has its own slice of the address and data-input ports,
+   * which are loaded in parallel
+   */
+  size_t num_regions = fabric_bitstream.num_regions();
+  VTR_ASSERT(din_port.get_width() == num_regions);
+  VTR_ASSERT(bl_addr_port.get_width() == num_regions * fabric_bitstream.bl_address_length());
+  VTR_ASSERT(wl_addr_port.get_width() == num_regions * fabric_bitstream.wl_address_length());
+
+  if (false == bitstream_image_fname.empty()) {
+    print_verilog_top_testbench_bitstream_image_memory(fp, CONFIG_MEM_MEMORY_BANK, fabric_bitstream);
+  }
+
   print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
   fp << "initial" << std::endl;
   fp << "\tbegin" << std::endl;
@@ -1243,40 +1624,9 @@ void print_verilog_top_testbench_memory_bank_bitstream(std::fstream& fp,
 
   fp << std::endl;
 
-  /* Attention: the configuration chain protcol requires the last configuration bit is fed first
-   * We will visit the fabric bitstream in a reverse way
-   */
-  for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-    /* When fast configuration is enabled, we skip zero data_in values */
-    if ((true == fast_configuration)
-      && (false == fabric_bitstream.bit_din(bit_id))) {
-      continue;
-    }
-
-    fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
-    fp << "(" << bl_addr_port.get_width() << "'b";
-    VTR_ASSERT(bl_addr_port.get_width() == fabric_bitstream.bit_bl_address(bit_id).size());
-    for (const char& addr_bit : fabric_bitstream.bit_bl_address(bit_id)) {
-      fp << addr_bit;
-    }
-
-    fp << ", ";
-    fp << wl_addr_port.get_width() << "'b";
-    VTR_ASSERT(wl_addr_port.get_width() == fabric_bitstream.bit_wl_address(bit_id).size());
-    for (const char& addr_bit : fabric_bitstream.bit_wl_address(bit_id)) {
-      fp << addr_bit;
-    }
-
-    fp << ", ";
-    fp <<"1'b";
-    if (true == fabric_bitstream.bit_din(bit_id)) {
-      fp << "1";
-    } else {
-      VTR_ASSERT(false == fabric_bitstream.bit_din(bit_id));
-      fp << "0";
-    }
-    fp << ");" << std::endl;
-  }
+  print_verilog_top_testbench_config_cycles_or_image(fp, CONFIG_MEM_MEMORY_BANK, fast_configuration,
+                                                     bitstream_manager, fabric_bitstream,
+                                                     bitstream_image_fname);
 
   /* Raise the flag of configuration done when bitstream loading is complete */
   BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME), 1);
@@ -1305,7 +1655,9 @@ void print_verilog_top_testbench_frame_decoder_bitstream(std::fstream& fp,
                                                          const bool& fast_configuration,
                                                          const ModuleManager& module_manager,
                                                          const ModuleId& top_module,
-                                                         const FabricBitstream& fabric_bitstream) {
+                                                         const BitstreamManager& bitstream_manager,
+                                                         const FabricBitstream& fabric_bitstream,
+                                                         const std::string& bitstream_image_fname) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
@@ -1323,6 +1675,17 @@ void print_verilog_top_testbench_frame_decoder_bitstream(std::fstream& fp,
   BasicPort din_port = module_manager.module_port(top_module, din_port_id);
   std::vector<size_t> initial_din_values(din_port.get_width(), 0);
 
+  /* Each configuration region has its own slice of the address and data-input ports,
+   * which are loaded in parallel
+   */
+  size_t num_regions = fabric_bitstream.num_regions();
+  VTR_ASSERT(din_port.get_width() == num_regions);
+  VTR_ASSERT(addr_port.get_width() == num_regions * fabric_bitstream.address_length());
+
+  if (false == bitstream_image_fname.empty()) {
+    print_verilog_top_testbench_bitstream_image_memory(fp, CONFIG_MEM_FRAME_BASED, fabric_bitstream);
+  }
+
   print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
   fp << "initial" << std::endl;
   fp << "\tbegin" << std::endl;
@@ -1339,32 +1702,9 @@ void print_verilog_top_testbench_frame_decoder_bitstream(std::fstream& fp,
 
   fp << std::endl;
 
-  /* Attention: the configuration chain protcol requires the last configuration bit is fed first
-   * We will visit the fabric bitstream in a reverse way
-   */
-  for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-    /* When fast configuration is enabled, we skip zero data_in values */
-    if ((true == fast_configuration)
-      && (false == fabric_bitstream.bit_din(bit_id))) {
-      continue;
-    }
-
-    fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
-    fp << "(" << addr_port.get_width() << "'b";
-    VTR_ASSERT(addr_port.get_width() == fabric_bitstream.bit_address(bit_id).size());
-    for (const char& addr_bit : fabric_bitstream.bit_address(bit_id)) {
-      fp << addr_bit;
-    }
-    fp << ", ";
-    fp <<"1'b";
-    if (true == fabric_bitstream.bit_din(bit_id)) {
-      fp << "1";
-    } else {
-      VTR_ASSERT(false == fabric_bitstream.bit_din(bit_id));
-      fp << "0";
-    }
-    fp << ");" << std::endl;
-  }
+  print_verilog_top_testbench_config_cycles_or_image(fp, CONFIG_MEM_FRAME_BASED, fast_configuration,
+                                                     bitstream_manager, fabric_bitstream,
+                                                     bitstream_image_fname);
 
   /* Disable the address and din */
   fp << "\t\t" << std::string(TOP_TESTBENCH_PROG_TASK_NAME);
@@ -1374,7 +1714,11 @@ void print_verilog_top_testbench_frame_decoder_bitstream(std::fstream& fp,
     fp << addr_bit;
   }
   fp << ", ";
-  fp <<"1'b0";
+  fp << din_port.get_width() << "'b";
+  std::vector<size_t> all_zero_din(din_port.get_width(), 0);
+  for (const size_t& din_bit : all_zero_din) {
+    fp << din_bit;
+  }
   fp << ");" << std::endl;
 
   /* Raise the flag of configuration done when bitstream loading is complete */
@@ -1398,6 +1742,11 @@ void print_verilog_top_testbench_frame_decoder_bitstream(std::fstream& fp,
  * The simulation consists of two phases: configuration phase and operation phase
  * Configuration bits are loaded serially.
  * This is actually what we do for a physical FPGA
+ *
+ * When the file name of bitstream image is given, the configuration cycles
+ * are written to the image, which is loaded by the testbench.
+ * This is not applicable to the vanilla (standalone) protocol,
+ * whose bitstream is loaded in a single cycle
  *******************************************************************/
 static
 void print_verilog_top_testbench_bitstream(std::fstream& fp,
@@ -1406,7 +1755,15 @@ void print_verilog_top_testbench_bitstream(std::fstream& fp,
                                            const ModuleManager& module_manager,
                                            const ModuleId& top_module,
                                            const BitstreamManager& bitstream_manager,
-                                           const FabricBitstream& fabric_bitstream) {
+                                           const FabricBitstream& fabric_bitstream,
+                                           const std::string& bitstream_image_fname) {
+  if ( (false == bitstream_image_fname.empty())
+    && (CONFIG_MEM_STANDALONE != sram_orgz_type)) {
+    write_verilog_top_testbench_bitstream_image(bitstream_image_fname, sram_orgz_type,
+                                                fast_configuration,
+                                                bitstream_manager, fabric_bitstream);
+  }
+
   /* Branch on the type of configuration protocol */
   switch (sram_orgz_type) {
   case CONFIG_MEM_STANDALONE:
@@ -1416,17 +1773,21 @@ void print_verilog_top_testbench_bitstream(std::fstream& fp,
     break;
   case CONFIG_MEM_SCAN_CHAIN:
     print_verilog_top_testbench_configuration_chain_bitstream(fp, fast_configuration, 
-                                                              bitstream_manager, fabric_bitstream);
+                                                              module_manager, top_module,
+                                                              bitstream_manager, fabric_bitstream,
+                                                              bitstream_image_fname);
     break;
   case CONFIG_MEM_MEMORY_BANK:
     print_verilog_top_testbench_memory_bank_bitstream(fp, fast_configuration,
                                                       module_manager, top_module,
-                                                      fabric_bitstream);
+                                                      bitstream_manager, fabric_bitstream,
+                                                      bitstream_image_fname);
     break;
   case CONFIG_MEM_FRAME_BASED:
     print_verilog_top_testbench_frame_decoder_bitstream(fp, fast_configuration,
                                                         module_manager, top_module,
-                                                        fabric_bitstream);
+                                                        bitstream_manager, fabric_bitstream,
+                                                        bitstream_image_fname);
     break;
   default:
     VTR_LOGF_ERROR(__FILE__, __LINE__,
@@ -1454,6 +1815,8 @@ void print_verilog_top_testbench_bitstream(std::fstream& fp,
  *                             +----->| Benchmark |----->|            |
  *                                    +-----------+      +------------+
  *
+ * When the file name of bitstream image is not empty, the bitstream is
+ * written to the image file, instead of the testbench
  *******************************************************************/
 void print_verilog_top_testbench(const ModuleManager& module_manager,
                                  const BitstreamManager& bitstream_manager,
@@ -1467,6 +1830,7 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
                                  const VprNetlistAnnotation& netlist_annotation,
                                  const std::string& circuit_name,
                                  const std::string& verilog_fname,
+                                 const std::string& bitstream_image_fname,
                                  const SimulationSetting& simulation_parameters,
                                  const bool& fast_configuration,
                                  const bool& explicit_port_mapping) {
@@ -1502,9 +1866,14 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
   /* Find the clock period */
   float prog_clock_period = (1./simulation_parameters.programming_clock_frequency());
   float op_clock_period = (1./simulation_parameters.operating_clock_frequency());
-  /* Estimate the number of configuration clock cycles */
+  /* Estimate the number of configuration clock cycles 
+   * When the bitstream image is loaded, the testbench can be reused by any bitstream,
+   * whose number of configuration clock cycles is not known.
+   * The configuration phase is sized for the full bitstream
+   */
+  bool use_bitstream_image = (false == bitstream_image_fname.empty()) && (CONFIG_MEM_STANDALONE != sram_orgz_type);
   size_t num_config_clock_cycles = calculate_num_config_clock_cycles(sram_orgz_type,
-                                                                     fast_configuration,
+                                                                     fast_configuration && (false == use_bitstream_image),
                                                                      bitstream_manager,
                                                                      fabric_bitstream);
 
@@ -1549,7 +1918,8 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
   print_verilog_top_testbench_bitstream(fp, sram_orgz_type,
                                         fast_configuration,
                                         module_manager, top_module,
-                                        bitstream_manager, fabric_bitstream);
+                                        bitstream_manager, fabric_bitstream,
+                                        bitstream_image_fname);
 
   /* Add stimuli for reset, set, clock and iopad signals */
   print_verilog_testbench_random_stimuli(fp, atom_ctx,
@@ -34,6 +34,7 @@ void print_verilog_top_testbench(const ModuleManager& module_manager,
                                  const VprNetlistAnnotation& netlist_annotation,
                                  const std::string& circuit_name,
                                  const std::string& verilog_fname,
+                                 const std::string& bitstream_image_fname,
                                  const SimulationSetting& simulation_parameters,
                                  const bool& fast_configuration,
                                  const bool& explicit_port_mapping);
@@ -26,6 +26,23 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/************************************************
+ * Open a file stream to write a Verilog netlist
+ * The file stream writes through a large buffer which is provided by the caller.
+ * The buffer must outlive the file stream, so declare it before the file stream.
+ * Note that flushing the file stream (e.g., by std::endl) defeats the buffer
+ ***********************************************/
+void open_verilog_netlist_file(std::fstream& fp,
+                               std::vector<char>& buffer,
+                               const std::string& fname) {
+  buffer.resize(VERILOG_NETLIST_FILE_BUFFER_SIZE);
+  /* The buffer must be set before the file is opened */
+  fp.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(fname.c_str(), fp);
+}
+
 /************************************************
  * Generate header comments for a Verilog netlist
  * include the description 
@@ -36,17 +53,19 @@ void print_verilog_file_header(std::fstream& fp,
  
   auto end = std::chrono::system_clock::now(); 
   std::time_t end_time = std::chrono::system_clock::to_time_t(end);
-
-  fp << "//-------------------------------------------" << std::endl;
-  fp << "//\tFPGA Synthesizable Verilog Netlist" << std::endl;
-  fp << "//\tDescription: " << usage << std::endl;
-  fp << "//\tAuthor: Xifan TANG" << std::endl;
-  fp << "//\tOrganization: University of Utah" << std::endl;
-  fp << "//\tDate: " << std::ctime(&end_time) ;
-  fp << "//-------------------------------------------" << std::endl;
-  fp << "//----- Time scale -----" << std::endl;
-  fp << "`timescale 1ns / 1ps" << std::endl;
-  fp << std::endl;
+  /* Netlists may be written by multiple threads, std::ctime() is not reentrant */
+  char end_time_str[VERILOG_FILE_HEADER_DATE_BUFFER_SIZE];
+
+  fp << "//-------------------------------------------\n";
+  fp << "//\tFPGA Synthesizable Verilog Netlist\n";
+  fp << "//\tDescription: " << usage << "\n";
+  fp << "//\tAuthor: Xifan TANG\n";
+  fp << "//\tOrganization: University of Utah\n";
+  fp << "//\tDate: " << ctime_r(&end_time, end_time_str);
+  fp << "//-------------------------------------------\n";
+  fp << "//----- Time scale -----\n";
+  fp << "`timescale 1ns / 1ps\n";
+  fp << "\n";
 }
 
 /********************************************************************
@@ -56,7 +75,7 @@ void print_verilog_include_netlist(std::fstream& fp,
                                    const std::string& netlist_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`include \"" << netlist_name << "\"" << std::endl; 
+  fp << "`include \"" << netlist_name << "\"\n"; 
 }
 
 /********************************************************************
@@ -67,7 +86,7 @@ void print_verilog_define_flag(std::fstream& fp,
                                const int& flag_value) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`define " << flag_name << " " << flag_value << std::endl; 
+  fp << "`define " << flag_name << " " << flag_value << "\n"; 
 }
 
 /************************************************
@@ -90,7 +109,7 @@ void print_verilog_comment(std::fstream& fp,
                            const std::string& comment) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "// " << comment << std::endl;
+  fp << "// " << comment << "\n";
 }
 
 /************************************************
@@ -100,7 +119,7 @@ void print_verilog_preprocessing_flag(std::fstream& fp,
                                       const std::string& preproc_flag) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`ifdef " << preproc_flag << std::endl;
+  fp << "`ifdef " << preproc_flag << "\n";
 }
 
 /************************************************
@@ -109,7 +128,7 @@ void print_verilog_preprocessing_flag(std::fstream& fp,
 void print_verilog_endif(std::fstream& fp) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`endif" << std::endl;
+  fp << "`endif\n";
 }
 
 /************************************************
@@ -144,7 +163,7 @@ void print_verilog_module_definition(std::fstream& fp,
     for (const auto& port : module_manager.module_ports_by_type(module_id, kv.first)) {
       if (0 != port_cnt) {
         /* Do not dump a comma for the first port */
-        fp << "," << std::endl; 
+        fp << ",\n"; 
       }
 
       if (true == printed_ifdef) {
@@ -177,7 +196,7 @@ void print_verilog_module_definition(std::fstream& fp,
       port_cnt++;
     }
   }
-  fp << ");" << std::endl;
+  fp << ");\n";
 }
 
 /************************************************
@@ -211,9 +230,9 @@ void print_verilog_module_ports(std::fstream& fp,
       }
 
       /* Print port */
-      fp << "//----- " << module_manager.module_port_type_str(kv.first)  << " -----" << std::endl; 
+      fp << "//----- " << module_manager.module_port_type_str(kv.first)  << " -----\n"; 
       fp << generate_verilog_port(kv.second, port);
-      fp << ";" << std::endl;
+      fp << ";\n";
 
       if (false == preproc_flag.empty()) {
         /* Print an endif to pair the ifdef */
@@ -223,8 +242,8 @@ void print_verilog_module_ports(std::fstream& fp,
   }
 
   /* Output any port that is also wire connection */
-  fp << std::endl;
-  fp << "//----- BEGIN wire-connection ports -----" << std::endl; 
+  fp << "\n";
+  fp << "//----- BEGIN wire-connection ports -----\n"; 
   for (const auto& kv : port_type2type_map) {
     for (const auto& port : module_manager.module_ports_by_type(module_id, kv.first)) {
       /* Skip the ports that are not registered */
@@ -243,7 +262,7 @@ void print_verilog_module_ports(std::fstream& fp,
 
       /* Print port */
       fp << generate_verilog_port(VERILOG_PORT_WIRE, port);
-      fp << ";" << std::endl;
+      fp << ";\n";
 
       if (false == preproc_flag.empty()) {
         /* Print an endif to pair the ifdef */
@@ -251,13 +270,13 @@ void print_verilog_module_ports(std::fstream& fp,
       }
     }
   }
-  fp << "//----- END wire-connection ports -----" << std::endl; 
-  fp << std::endl;
+  fp << "//----- END wire-connection ports -----\n"; 
+  fp << "\n";
 
  
   /* Output any port that is registered */
-  fp << std::endl;
-  fp << "//----- BEGIN Registered ports -----" << std::endl; 
+  fp << "\n";
+  fp << "//----- BEGIN Registered ports -----\n"; 
   for (const auto& kv : port_type2type_map) {
     for (const auto& port : module_manager.module_ports_by_type(module_id, kv.first)) {
       /* Skip the ports that are not registered */
@@ -276,7 +295,7 @@ void print_verilog_module_ports(std::fstream& fp,
 
       /* Print port */
       fp << generate_verilog_port(VERILOG_PORT_REG, port);
-      fp << ";" << std::endl;
+      fp << ";\n";
 
       if (false == preproc_flag.empty()) {
         /* Print an endif to pair the ifdef */
@@ -284,8 +303,8 @@ void print_verilog_module_ports(std::fstream& fp,
       }
     }
   }
-  fp << "//----- END Registered ports -----" << std::endl; 
-  fp << std::endl;
+  fp << "//----- END Registered ports -----\n"; 
+  fp << "\n";
 }
 
 /************************************************
@@ -342,7 +361,7 @@ void print_verilog_module_instance(std::fstream& fp,
   /* Print module name */
   fp << "\t" << module_manager.module_name(module_id) << " ";
   /* Print instance name */
-  fp << instance_name << " (" << std::endl;
+  fp << instance_name << " (\n";
   
   /* Print each port with/without explicit port map */
   /* port type2type mapping */
@@ -362,7 +381,7 @@ void print_verilog_module_instance(std::fstream& fp,
     for (const auto& port : module_manager.module_ports_by_type(module_id, kv.first)) {
       if (0 != port_cnt) {
         /* Do not dump a comma for the first port */
-        fp << "," << std::endl; 
+        fp << ",\n"; 
       }
       /* Print port */
       fp << "\t\t";
@@ -392,7 +411,7 @@ void print_verilog_module_instance(std::fstream& fp,
   }
   
   /* Print an end to the instance */
-  fp << ");" << std::endl;
+  fp << ");\n";
 }
 
 
@@ -426,9 +445,9 @@ void print_verilog_module_end(std::fstream& fp,
                               const std::string& module_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "endmodule" << std::endl;
+  fp << "endmodule\n";
   print_verilog_comment(fp, std::string("----- END Verilog module for " + module_name + " -----"));
-  fp << std::endl;
+  fp << "\n";
 }
 
 /************************************************
@@ -709,7 +728,7 @@ void print_verilog_wire_constant_values(std::fstream& fp,
   fp << "\t";
   fp << "assign ";
   fp << generate_verilog_port_constant_values(output_port, const_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 }
 
 /********************************************************************
@@ -726,7 +745,7 @@ void print_verilog_deposit_wire_constant_values(std::fstream& fp,
   fp << generate_verilog_port(VERILOG_PORT_CONKT, output_port);
   fp << ", ";
   fp << generate_verilog_constant_values(const_values);
-  fp << ");" << std::endl;
+  fp << ");\n";
 }
 
 /********************************************************************
@@ -742,7 +761,7 @@ void print_verilog_force_wire_constant_values(std::fstream& fp,
   fp << "\t";
   fp << "force ";
   fp << generate_verilog_port_constant_values(output_port, const_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 }
 
 /********************************************************************
@@ -769,7 +788,7 @@ void print_verilog_wire_connection(std::fstream& fp,
   }
 
   fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port);
-  fp << ";" << std::endl;
+  fp << ";\n";
 }
 
 /********************************************************************
@@ -795,7 +814,7 @@ void print_verilog_register_connection(std::fstream& fp,
   }
 
   fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port);
-  fp << ";" << std::endl;
+  fp << ";\n";
 }
 
 
@@ -951,7 +970,7 @@ void print_verilog_local_sram_wires(std::fstream& fp,
     /* Generate the name of local wire for the CCFF inputs, CCFF output and inverted output */
     /* [0] => CCFF input */
     BasicPort ccff_config_bus_port(generate_local_config_bus_port_name(), port_size);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, ccff_config_bus_port) << ";" << std::endl; 
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, ccff_config_bus_port) << ";\n"; 
     /* Connect first CCFF to the head */
     /* Head is always a 1-bit port */
     BasicPort ccff_head_port(generate_sram_port_name(sram_orgz_type, CIRCUIT_MODEL_PORT_INPUT), 1); 
@@ -973,7 +992,7 @@ void print_verilog_local_sram_wires(std::fstream& fp,
     sram_ports.push_back(BasicPort(generate_sram_local_port_name(circuit_lib, sram_model, sram_orgz_type, CIRCUIT_MODEL_PORT_OUTPUT), port_size));
     /* Print local wire definition */
     for (const auto& sram_port : sram_ports) {
-      fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_port) << ";" << std::endl; 
+      fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_port) << ";\n"; 
     }
 
     break;
@@ -1061,10 +1080,10 @@ void print_verilog_local_config_bus(std::fstream& fp,
      */
     BasicPort config_port(generate_local_sram_port_name(prefix, instance_id, CIRCUIT_MODEL_PORT_INPUT), 
                           num_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, config_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, config_port) << ";\n";
     BasicPort inverted_config_port(generate_local_sram_port_name(prefix, instance_id, CIRCUIT_MODEL_PORT_OUTPUT), 
                                    num_conf_bits); 
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_config_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_config_port) << ";\n";
     break;
   }
   default:
@@ -1132,26 +1151,26 @@ void print_verilog_rram_mux_config_bus(std::fstream& fp,
     /* Print configuration bus to group reserved BL/WLs */
     BasicPort reserved_bl_bus(generate_reserved_sram_port_name(CIRCUIT_MODEL_PORT_BL), 
                               num_reserved_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_bl_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_bl_bus) << ";\n";
     BasicPort reserved_wl_bus(generate_reserved_sram_port_name(CIRCUIT_MODEL_PORT_WL), 
                               num_reserved_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_wl_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_wl_bus) << ";\n";
 
     /* Print configuration bus to group BL/WLs */
     BasicPort bl_bus(generate_mux_config_bus_port_name(circuit_lib, mux_model, mux_size, 0, false), 
                      num_conf_bits + num_reserved_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, bl_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, bl_bus) << ";\n";
     BasicPort wl_bus(generate_mux_config_bus_port_name(circuit_lib, mux_model, mux_size, 1, false), 
                      num_conf_bits + num_reserved_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, wl_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, wl_bus) << ";\n";
 
     /* Print bus to group SRAM outputs, this is to interface memory cells to routing multiplexers */
     BasicPort sram_output_bus(generate_mux_sram_port_name(circuit_lib, mux_model, mux_size, mux_instance_id, CIRCUIT_MODEL_PORT_INPUT), 
                           num_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_output_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_output_bus) << ";\n";
     BasicPort inverted_sram_output_bus(generate_mux_sram_port_name(circuit_lib, mux_model, mux_size, mux_instance_id, CIRCUIT_MODEL_PORT_OUTPUT), 
                                        num_conf_bits); 
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_sram_output_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_sram_output_bus) << ";\n";
 
     /* Get the SRAM model of the mux_model */
     std::vector<CircuitModelId> sram_models = find_circuit_sram_models(circuit_lib, mux_model);
@@ -1271,13 +1290,13 @@ void print_verilog_pulse_stimuli(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial\n";
+  fp << "\tbegin\n";
   fp << "\t";
   std::vector<size_t> initial_values(port.get_width(), initial_value);
   fp << "\t";
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
   
   /* if flip_value is the same as initial value, we do not need to flip the signal ! */
   if (flip_value != initial_value) {
@@ -1285,13 +1304,13 @@ void print_verilog_pulse_stimuli(std::fstream& fp,
     std::vector<size_t> port_flip_values(port.get_width(), flip_value);
     fp << "\t";
     fp << generate_verilog_port_constant_values(port, port_flip_values);
-    fp << ";" << std::endl;
+    fp << ";\n";
   }
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -1315,17 +1334,17 @@ void print_verilog_pulse_stimuli(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial\n";
+  fp << "\tbegin\n";
   fp << "\t";
   std::vector<size_t> initial_values(port.get_width(), initial_value);
   fp << "\t";
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
   /* Set a wait condition if specified */
   if (false == wait_condition.empty()) {
-    fp << "\twait(" << wait_condition << ")" << std::endl;
+    fp << "\twait(" << wait_condition << ")\n";
   }
   
   /* Number of flip conditions and values should match */
@@ -1335,13 +1354,13 @@ void print_verilog_pulse_stimuli(std::fstream& fp,
     std::vector<size_t> port_flip_value(port.get_width(), flip_values[ipulse]);
     fp << "\t";
     fp << generate_verilog_port_constant_values(port, port_flip_value);
-    fp << ";" << std::endl;
+    fp << ";\n";
   }
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -1365,25 +1384,25 @@ void print_verilog_clock_stimuli(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial\n";
+  fp << "\tbegin\n";
 
   std::vector<size_t> initial_values(port.get_width(), initial_value);
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
   fp << "always";
 
   /* Set a wait condition if specified */
   if (true == wait_condition.empty()) {
-    fp << std::endl;
+    fp << "\n";
   } else {
-    fp << " wait(" << wait_condition << ")" << std::endl;
+    fp << " wait(" << wait_condition << ")\n";
   }
 
-  fp << "\tbegin" << std::endl;
+  fp << "\tbegin\n";
   fp << "\t\t" << "#" << std::setprecision(10) << pulse_width;
 
   fp << "\t";
@@ -1391,12 +1410,12 @@ void print_verilog_clock_stimuli(std::fstream& fp,
   fp << " = ";
   fp << "~";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, port);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -1420,7 +1439,7 @@ void print_verilog_netlist_include_header_file(const std::vector<std::string>& n
 
   /* Output file names */
   for (const std::string& netlist_name : netlists_to_be_included) {
-    fp << "`include \"" << netlist_name << "\"" << std::endl;
+    fp << "`include \"" << netlist_name << "\"\n";
   }
 
   /* close file stream */
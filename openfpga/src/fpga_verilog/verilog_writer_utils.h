@@ -31,6 +31,10 @@ namespace openfpga {
  * as well maintain a easy way to identify the functions
  */
 
+void open_verilog_netlist_file(std::fstream& fp,
+                               std::vector<char>& buffer,
+                               const std::string& fname);
+
 void print_verilog_file_header(std::fstream& fp,
                                const std::string& usage);
 
@@ -40,6 +40,9 @@ int main(int argc, char** argv) {
   start_cmd.set_option_require_value(opt_script_mode, openfpga::OPT_STRING);
   start_cmd.set_option_short_name(opt_script_mode, "f");
 
+  openfpga::CommandOptionId opt_profile = start_cmd.add_option("profile", false, "Report the runtime and memory usage of each command to a file");
+  start_cmd.set_option_require_value(opt_profile, openfpga::OPT_STRING);
+
   openfpga::CommandOptionId opt_help = start_cmd.add_option("help", false, "Help desk"); 
   start_cmd.set_option_short_name(opt_help, "h");
 
@@ -91,7 +94,11 @@ int main(int argc, char** argv) {
     /* Parse fail: Echo the command */
     openfpga::print_command_options(start_cmd);
   } else {
-    /* Parse succeed. Start a shell */ 
+    /* Parse succeed. Enable profiling if required and then start a shell */ 
+    if (true == start_cmd_context.option_enable(start_cmd, opt_profile)) {
+      shell.set_profile_file(start_cmd_context.option_value(start_cmd, opt_profile));
+    }
+
     if (true == start_cmd_context.option_enable(start_cmd, opt_interactive)) {
 
       shell.run_interactive_mode(openfpga_context);
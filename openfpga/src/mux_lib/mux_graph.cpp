@@ -106,7 +106,7 @@ size_t MuxGraph::num_inputs() const {
   VTR_ASSERT_SAFE(valid_mux_graph());
   /* Sum up the number of INPUT nodes in each level */
   size_t num_inputs = 0;
-  for (auto node_per_level : node_lookup_) {
+  for (const auto& node_per_level : node_lookup_) {
     num_inputs += node_per_level[MUX_INPUT_NODE].size();
   }
   return num_inputs;
@@ -118,7 +118,7 @@ std::vector<MuxNodeId> MuxGraph::inputs() const {
   /* need to check if the graph is valid or not */
   VTR_ASSERT_SAFE(valid_mux_graph());
   /* Add the input nodes in each level */
-  for (auto node_per_level : node_lookup_) {
+  for (const auto& node_per_level : node_lookup_) {
     input_nodes.insert(input_nodes.end(), node_per_level[MUX_INPUT_NODE].begin(), node_per_level[MUX_INPUT_NODE].end());
   }
   return input_nodes;
@@ -130,7 +130,7 @@ size_t MuxGraph::num_outputs() const {
   VTR_ASSERT_SAFE(valid_mux_graph());
   /* Sum up the number of INPUT nodes in each level */
   size_t num_outputs = 0;
-  for (auto node_per_level : node_lookup_) {
+  for (const auto& node_per_level : node_lookup_) {
     num_outputs += node_per_level[MUX_OUTPUT_NODE].size();
   }
   return num_outputs;
@@ -142,7 +142,7 @@ std::vector<MuxNodeId> MuxGraph::outputs() const {
   /* need to check if the graph is valid or not */
   VTR_ASSERT_SAFE(valid_mux_graph());
   /* Add the output nodes in each level */
-  for (auto node_per_level : node_lookup_) {
+  for (const auto& node_per_level : node_lookup_) {
     output_nodes.insert(output_nodes.end(), node_per_level[MUX_OUTPUT_NODE].begin(), node_per_level[MUX_OUTPUT_NODE].end());
   }
   return output_nodes;
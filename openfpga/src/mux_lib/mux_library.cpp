@@ -32,7 +32,10 @@ MuxId MuxLibrary::mux_graph(const CircuitModelId& circuit_model,
   /* Validate circuit model id and mux_size */
   VTR_ASSERT_SAFE(valid_mux_size(circuit_model, mux_size));
 
-  return mux_lookup_[circuit_model][mux_size];
+  /* Use at() rather than operator[] on the maps, so that
+   * concurrent readers (e.g., bitstream builders) never modify the look-up
+   */
+  return mux_lookup_.at(circuit_model).at(mux_size);
 }
 
 const MuxGraph& MuxLibrary::mux_graph(const MuxId& mux_id) const {
@@ -46,6 +49,22 @@ CircuitModelId MuxLibrary::mux_circuit_model(const MuxId& mux_id) const {
   return mux_circuit_models_[mux_id];
 }
 
+/* Get the memory bits to route an input to the output of a MUX graph
+ * This is a copy from the decode table, which is equivalent to
+ * the results of MuxGraph::decode_memory_bits()
+ */
+std::vector<bool> MuxLibrary::decode_memory_bits(const MuxId& mux_id, const MuxInputId& input_id) const {
+  VTR_ASSERT_SAFE(valid_mux_id(mux_id));
+  const MuxGraph& mux_graph = mux_graphs_[mux_id];
+  /* Decode table is only available for single-output MUXes */
+  VTR_ASSERT(1 == mux_graph.num_outputs());
+  VTR_ASSERT(size_t(input_id) < mux_graph.num_inputs());
+
+  size_t num_mems = mux_graph.num_memory_bits();
+  std::vector<bool>::const_iterator first_bit = mux_decode_tables_[mux_id].begin() + size_t(input_id) * num_mems;
+  return std::vector<bool>(first_bit, first_bit + num_mems);
+}
+
 /* Find the maximum mux size among the mux graphs */
 size_t MuxLibrary::max_mux_size() const {
   /* Iterate over all the mux graphs and find their sizes */
@@ -74,11 +93,39 @@ void MuxLibrary::add_mux(const CircuitLibrary& circuit_lib, const CircuitModelId
   mux_graphs_.push_back(MuxGraph(circuit_lib, circuit_model, mux_size));
   /* Recorde mux cirucit model id */
   mux_circuit_models_.push_back(circuit_model);
+  /* Decode the memory bits for each input */
+  mux_decode_tables_.emplace_back();
+  build_mux_decode_table(mux);
 
   /* update mux_lookup*/
   mux_lookup_[circuit_model][mux_size] = mux;
 } 
 
+/**************************************************
+ * Private mutators: decode tables
+ *************************************************/
+/* Decode the memory bits for each input of a MUX graph, 
+ * and pack them in the sequence of inputs 
+ */
+void MuxLibrary::build_mux_decode_table(const MuxId& mux) {
+  const MuxGraph& mux_graph = mux_graphs_[mux];
+
+  mux_decode_tables_[mux].clear();
+  /* Only single-output MUXes are routed by bitstream generators */
+  if (1 != mux_graph.num_outputs()) {
+    return;
+  }
+
+  MuxOutputId output = mux_graph.output_id(mux_graph.outputs()[0]);
+  size_t num_inputs = mux_graph.num_inputs();
+  mux_decode_tables_[mux].reserve(num_inputs * mux_graph.num_memory_bits());
+  for (size_t input = 0; input < num_inputs; ++input) {
+    for (const bool& bit : mux_graph.decode_memory_bits(MuxInputId(input), output)) {
+      mux_decode_tables_[mux].push_back(bit);
+    }
+  }
+}
+
 /**************************************************
  * Private accessors: validator and invalidators
  *************************************************/
@@ -99,8 +146,8 @@ bool MuxLibrary::valid_mux_size(const CircuitModelId& circuit_model, const size_
   if (false == valid_mux_circuit_model_id(circuit_model)) {
     return false;
   }
-  std::map<size_t, MuxId>::iterator it = mux_lookup_[circuit_model].find(mux_size);
-  return (it != mux_lookup_[circuit_model].end());
+  std::map<size_t, MuxId>::const_iterator it = mux_lookup_.at(circuit_model).find(mux_size);
+  return (it != mux_lookup_.at(circuit_model).end());
 }
 
 /**************************************************
@@ -30,6 +30,8 @@ class MuxLibrary {
     const MuxGraph& mux_graph(const MuxId& mux_id) const;
     /* Get a mux circuit model id */
     CircuitModelId mux_circuit_model(const MuxId& mux_id) const;
+    /* Get the memory bits to route an input to the output of a MUX graph */
+    std::vector<bool> decode_memory_bits(const MuxId& mux_id, const MuxInputId& input_id) const;
     /* Find the mux sizes */
     size_t max_mux_size() const;
   public:  /* Public mutators */
@@ -41,6 +43,8 @@ class MuxLibrary {
     bool valid_mux_lookup() const;
     bool valid_mux_circuit_model_id(const CircuitModelId& circuit_model) const;
     bool valid_mux_size(const CircuitModelId& circuit_model, const size_t& mux_size) const;
+  private:  /* Private mutators: decode tables */
+    void build_mux_decode_table(const MuxId& mux);
   private:  /* Private mutators: mux_lookup */
     void build_mux_lookup();
     /* Invalidate (empty) the mux fast lookup*/
@@ -51,6 +55,13 @@ class MuxLibrary {
     vtr::vector<MuxId, MuxGraph> mux_graphs_; /* Graphs describing MUX internal structures */
     vtr::vector<MuxId, CircuitModelId> mux_circuit_models_; /* circuit model id in circuit library */
 
+    /* Memory bits to route each input to the output of a MUX graph,
+     * which are packed in the sequence of inputs: [mux_id][input_id * num_memory_bits + mem_id]
+     * Bitstream generators fetch the bits here rather than walking through the MUX graph.
+     * Only available for the MUX graphs with a single output
+     */
+    vtr::vector<MuxId, std::vector<bool>> mux_decode_tables_;
+
     /* Local encoder description */
     //vtr::vector<MuxLocalDecoderId, Decoder> mux_local_encoders_; /* Graphs describing MUX internal structures */
 
@@ -27,6 +27,11 @@ void save_lb_router_results_to_physical_pb(PhysicalPb& phy_pb,
                                            const LbRouter& lb_router,
                                            const LbRRGraph& lb_rr_graph);
 
+void save_lb_route_results_to_physical_pb(PhysicalPb& phy_pb,
+                                          const LbRRGraph& lb_rr_graph,
+                                          const std::vector<AtomNetId>& net_atom_nets,
+                                          const std::vector<std::vector<LbRRNodeId>>& net_routed_nodes);
+
 } /* end namespace openfpga */
 
 #endif
@@ -2,8 +2,12 @@
  * This file includes functions that are used to redo packing for physical pbs
  ***************************************************************************************/
 
+#include <map>
+#include <unordered_map>
+
 /* Headers from vtrutil library */
 #include "vtr_log.h"
+#include "vtr_hash.h"
 #include "vtr_assert.h"
 #include "vtr_time.h"
 
@@ -15,11 +19,55 @@
 #include "lb_router.h"
 #include "lb_router_utils.h"
 #include "physical_pb_utils.h"
+#include "openfpga_parallel_utils.h"
 #include "repack.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/***************************************************************************************
+ * Nets to be routed by the logical block router for a clustered block
+ * The nets are stored in the order that they are added to the router
+ *
+ * The pb_graph_head and the source/sink nodes of each net are the signature of 
+ * the clustered block: the router only depends on them as well as the physical modes,
+ * which are the same for all the clustered blocks sharing a pb_graph_head.
+ * Clustered blocks with the same signature have exactly the same routing results,
+ * while the atom nets mapped to the routing nodes are different.
+ ***************************************************************************************/
+struct t_repack_cluster_nets {
+  t_pb_graph_node* pb_graph_head = nullptr;
+  std::vector<std::vector<LbRRNodeId>> net_sources;
+  std::vector<std::vector<LbRRNodeId>> net_sinks;
+  std::vector<AtomNetId> net_atom_nets;
+};
+
+/* Hash and compare the signature of clustered blocks, atom nets are not considered */
+struct t_repack_cluster_signature_hash {
+  size_t operator()(const t_repack_cluster_nets* cluster_nets) const {
+    size_t signature = std::hash<const t_pb_graph_node*>()(cluster_nets->pb_graph_head);
+    for (size_t inet = 0; inet < cluster_nets->net_sources.size(); ++inet) {
+      vtr::hash_combine(signature, cluster_nets->net_sources[inet].size());
+      for (const LbRRNodeId& node : cluster_nets->net_sources[inet]) {
+        vtr::hash_combine(signature, node);
+      }
+      vtr::hash_combine(signature, cluster_nets->net_sinks[inet].size());
+      for (const LbRRNodeId& node : cluster_nets->net_sinks[inet]) {
+        vtr::hash_combine(signature, node);
+      }
+    }
+    return signature;
+  }
+};
+
+struct t_repack_cluster_signature_equal {
+  bool operator()(const t_repack_cluster_nets* a, const t_repack_cluster_nets* b) const {
+    return (a->pb_graph_head == b->pb_graph_head)
+        && (a->net_sources == b->net_sources)
+        && (a->net_sinks == b->net_sinks);
+  }
+};
+
 /***************************************************************************************
  * Try find all the sink pins which is mapped to a routing trace in the context of pb route
  * This function uses a recursive walk-through over the pb_route
@@ -196,21 +244,23 @@ std::vector<LbRRNodeId> find_lb_net_physical_sink_lb_rr_nodes(const LbRRGraph& l
 }
 
 /***************************************************************************************
- * Create nets to be routed, including the source nodes and terminals
- * And add them to the logical block router
+ * Find nets to be routed, including the source nodes and terminals
+ * The nets will be added to the logical block router later
  ***************************************************************************************/
 static 
-void add_lb_router_nets(LbRouter& lb_router,
-                        t_logical_block_type_ptr lb_type,
-                        const LbRRGraph& lb_rr_graph,
-                        const AtomContext& atom_ctx,
-                        const VprDeviceAnnotation& device_annotation,
-                        const ClusteringContext& clustering_ctx,
-                        const VprClusteringAnnotation& clustering_annotation,
-                        const ClusterBlockId& block_id,
-                        const bool& verbose) {
+void find_lb_router_nets(t_repack_cluster_nets& cluster_nets,
+                         t_logical_block_type_ptr lb_type,
+                         const LbRRGraph& lb_rr_graph,
+                         const AtomContext& atom_ctx,
+                         const VprDeviceAnnotation& device_annotation,
+                         const ClusteringContext& clustering_ctx,
+                         const VprClusteringAnnotation& clustering_annotation,
+                         const ClusterBlockId& block_id,
+                         const bool& verbose) {
   size_t net_counter = 0;
 
+  cluster_nets.pb_graph_head = lb_type->pb_graph_head;
+
   /* Two spots to find source nodes for each nets
    *  - nets that appear in the inputs of a clustered block
    *    Note that these nets may be moved to another input of the same cluster block
@@ -294,10 +344,9 @@ void add_lb_router_nets(LbRouter& lb_router,
     }
 
     /* Add the net */
-    add_lb_router_net_to_route(lb_router, lb_rr_graph,
-                               std::vector<LbRRNodeId>(1, source_lb_rr_node),
-                               sink_lb_rr_nodes,
-                               atom_ctx, atom_net_id);
+    cluster_nets.net_sources.push_back(std::vector<LbRRNodeId>(1, source_lb_rr_node));
+    cluster_nets.net_sinks.push_back(sink_lb_rr_nodes);
+    cluster_nets.net_atom_nets.push_back(atom_net_id);
 
     net_counter++;
   }
@@ -360,10 +409,9 @@ void add_lb_router_nets(LbRouter& lb_router,
     }
 
     /* Add the net */
-    add_lb_router_net_to_route(lb_router, lb_rr_graph,
-                               std::vector<LbRRNodeId>(1, source_lb_rr_node),
-                               sink_lb_rr_nodes,
-                               atom_ctx, atom_net_id);
+    cluster_nets.net_sources.push_back(std::vector<LbRRNodeId>(1, source_lb_rr_node));
+    cluster_nets.net_sinks.push_back(sink_lb_rr_nodes);
+    cluster_nets.net_atom_nets.push_back(atom_net_id);
     net_counter++;
   } 
 
@@ -371,27 +419,25 @@ void add_lb_router_nets(LbRouter& lb_router,
   free_pb_graph_pin_lookup_from_index(pb_graph_pin_lookup_from_index);
 
   VTR_LOGV(verbose,
-           "Added %lu nets to be routed.\n",
+           "Found %lu nets to be routed.\n",
            net_counter);
 }
 
 /***************************************************************************************
- * Repack a clustered block in the physical mode
+ * Find the nets to be routed in a clustered block
  * This function will do 
  * - Find the lb_rr_graph that is affiliated to the clustered block 
- *   and initilize the logcial tile router 
  * - Create nets to be routed, including the source nodes and terminals
  *   This should consider the net remapping in the clustering_annotation 
- * - Run the router to finish the repacking
- * - Output routing results to data structure PhysicalPb and store it in clustering annotation
  ***************************************************************************************/
 static 
-void repack_cluster(const AtomContext& atom_ctx,
-                    const ClusteringContext& clustering_ctx,
-                    const VprDeviceAnnotation& device_annotation,
-                    VprClusteringAnnotation& clustering_annotation,
-                    const ClusterBlockId& block_id,
-                    const bool& verbose) {
+void find_cluster_nets(const AtomContext& atom_ctx,
+                       const ClusteringContext& clustering_ctx,
+                       const VprDeviceAnnotation& device_annotation,
+                       const VprClusteringAnnotation& clustering_annotation,
+                       const ClusterBlockId& block_id,
+                       t_repack_cluster_nets& cluster_nets,
+                       const bool& verbose) {
   /* Get the pb graph that current clustered block is mapped to */
   t_logical_block_type_ptr lb_type = clustering_ctx.clb_nlist.block_type(block_id);
   t_pb_graph_node* pb_graph_head = lb_type->pb_graph_head;
@@ -401,17 +447,50 @@ void repack_cluster(const AtomContext& atom_ctx,
   const LbRRGraph& lb_rr_graph = device_annotation.physical_lb_rr_graph(pb_graph_head);
   VTR_ASSERT(!lb_rr_graph.empty());
 
-  VTR_LOG("Repack clustered block '%s'...",
-          clustering_ctx.clb_nlist.block_name(block_id).c_str());
-  VTR_LOGV(verbose, "\n");
+  VTR_LOGV(verbose,
+           "Find nets to route for clustered block '%s'\n",
+           clustering_ctx.clb_nlist.block_name(block_id).c_str());
+
+  find_lb_router_nets(cluster_nets, lb_type, lb_rr_graph, atom_ctx, device_annotation,
+                      clustering_ctx, clustering_annotation,
+                      block_id, verbose);
+}
+
+/***************************************************************************************
+ * Route a clustered block in the physical mode
+ * This function will do 
+ * - Initilize the logcial tile router with the nets to be routed 
+ * - Run the router to finish the repacking
+ * - Output the routing nodes used by each net
+ *
+ * Note: this function only reads the shared data structures,
+ *       so that it can be called for different clustered blocks concurrently.
+ ***************************************************************************************/
+static 
+bool route_cluster(const AtomContext& atom_ctx,
+                   const ClusteringContext& clustering_ctx,
+                   const VprDeviceAnnotation& device_annotation,
+                   const ClusterBlockId& block_id,
+                   const t_repack_cluster_nets& cluster_nets,
+                   std::vector<std::vector<LbRRNodeId>>& net_routed_nodes,
+                   const bool& verbose) {
+  t_logical_block_type_ptr lb_type = clustering_ctx.clb_nlist.block_type(block_id);
+  const LbRRGraph& lb_rr_graph = device_annotation.physical_lb_rr_graph(cluster_nets.pb_graph_head);
+
+  VTR_LOGV(verbose,
+           "Route clustered block '%s'\n",
+           clustering_ctx.clb_nlist.block_name(block_id).c_str());
 
   /* Initialize the router */
   LbRouter lb_router(lb_rr_graph, lb_type);
 
   /* Add nets to be routed with source and terminals */
-  add_lb_router_nets(lb_router, lb_type, lb_rr_graph, atom_ctx, device_annotation,
-                     clustering_ctx, const_cast<const VprClusteringAnnotation&>(clustering_annotation),
-                     block_id, verbose);
+  for (size_t inet = 0; inet < cluster_nets.net_atom_nets.size(); ++inet) {
+    add_lb_router_net_to_route(lb_router, lb_rr_graph,
+                               cluster_nets.net_sources[inet],
+                               cluster_nets.net_sinks[inet],
+                               atom_ctx, cluster_nets.net_atom_nets[inet]);
+  }
 
   /* Initialize the modes to expand routing trees with the physical modes in device annotation
    * This is a must-do before running the routeri in the purpose of repacking!!!
@@ -423,14 +502,38 @@ void repack_cluster(const AtomContext& atom_ctx,
 
   if (false == route_success) {
     VTR_LOGV(verbose, "Reroute failed\n");
-    exit(1);
+    return false;
   }
-  VTR_ASSERT(true == route_success);
   VTR_LOGV(verbose, "Reroute succeed\n");
 
+  /* Save routing results */
+  net_routed_nodes.clear();
+  for (const LbRouter::NetId& net : lb_router.nets()) {
+    net_routed_nodes.push_back(lb_router.net_routed_nodes(net));
+  }
+
+  return true;
+}
+
+/***************************************************************************************
+ * Build the physical pb of a clustered block
+ * The physical pb is copied from a template which is allocated from the pb_graph,
+ * and then annotated with the operating pb as well as the routing results
+ ***************************************************************************************/
+static 
+void build_cluster_physical_pb(const AtomContext& atom_ctx,
+                               const ClusteringContext& clustering_ctx,
+                               const VprDeviceAnnotation& device_annotation,
+                               const ClusterBlockId& block_id,
+                               const t_repack_cluster_nets& cluster_nets,
+                               const PhysicalPb& phy_pb_template,
+                               const std::vector<std::vector<LbRRNodeId>>& net_routed_nodes,
+                               PhysicalPb& phy_pb,
+                               const bool& verbose) {
+  const LbRRGraph& lb_rr_graph = device_annotation.physical_lb_rr_graph(cluster_nets.pb_graph_head);
+
   /* Annotate routing results to physical pb */
-  PhysicalPb phy_pb;
-  alloc_physical_pb_from_pb_graph(phy_pb, pb_graph_head, device_annotation);
+  phy_pb = phy_pb_template;
   rec_update_physical_pb_from_operating_pb(phy_pb,
                                            clustering_ctx.clb_nlist.block_pb(block_id),
                                            clustering_ctx.clb_nlist.block_pb(block_id)->pb_route,
@@ -438,31 +541,133 @@ void repack_cluster(const AtomContext& atom_ctx,
                                            device_annotation,
                                            verbose);
   /* Save routing results */
-  save_lb_router_results_to_physical_pb(phy_pb, lb_router, lb_rr_graph);
+  save_lb_route_results_to_physical_pb(phy_pb, lb_rr_graph,
+                                       cluster_nets.net_atom_nets,
+                                       net_routed_nodes);
   VTR_LOGV(verbose, "Saved results in physical pb\n");
-
-  /* Add the pb to clustering context */
-  clustering_annotation.add_physical_pb(block_id, phy_pb);
-
-  VTR_LOG("Done\n");
 }
 
 /***************************************************************************************
  * Repack each clustered blocks in the clustering context
+ * This function will do 
+ * - Find the nets to be routed for each clustered block
+ * - Group the clustered blocks by their signatures, i.e., the pb_graph_head and 
+ *   the source/sink nodes of each net. 
+ *   Only the first clustered block of each group is routed 
+ *   and its routing results are reused by the others in the group.
+ * - Build the physical pb for each clustered block 
+ *   from a template allocated once per pb_graph_head
+ * - Store the physical pbs in the clustering annotation
+ *
+ * When more than one thread is requested, each step runs on the clustered blocks concurrently
+ * and each block writes its results to its own data.
+ * The PhysicalPbs are then added to the clustering annotation in the same order
+ * as the serial flow, so that the results are identical regardless of the number of threads.
+ * Verbose outputs of different blocks would be mixed up when running in parallel,
+ * so the verbose mode always runs in a single thread
  ***************************************************************************************/
 static 
 void repack_clusters(const AtomContext& atom_ctx,
                      const ClusteringContext& clustering_ctx,
                      const VprDeviceAnnotation& device_annotation,
                      VprClusteringAnnotation& clustering_annotation,
+                     const size_t& num_threads,
                      const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Repack clustered blocks to physical implementation of logical tile");
 
-  for (auto blk_id : clustering_ctx.clb_nlist.blocks()) {
-    repack_cluster(atom_ctx, clustering_ctx, 
-                   device_annotation, clustering_annotation, 
-                   blk_id, verbose);
+  size_t num_repack_threads = num_threads;
+  if ((true == verbose) && (1 < num_repack_threads)) {
+    VTR_LOG_WARN("Verbose output is enabled. Repack clustered blocks with 1 thread instead of %lu\n",
+                 num_repack_threads);
+    num_repack_threads = 1;
   }
+
+  if (1 < num_repack_threads) {
+    VTR_LOG("Repack %lu clustered blocks with %lu threads\n",
+            clustering_ctx.clb_nlist.blocks().size(), num_repack_threads);
+  }
+
+  /* Cache the block ids so that each task can be found by an index */
+  std::vector<ClusterBlockId> blk_ids(clustering_ctx.clb_nlist.blocks().begin(),
+                                      clustering_ctx.clb_nlist.blocks().end());
+
+  /* Find the nets to be routed for each clustered block */
+  std::vector<t_repack_cluster_nets> blk_nets(blk_ids.size());
+  parallel_for(blk_ids.size(), num_repack_threads,
+               [&](const size_t& iblk) {
+                 find_cluster_nets(atom_ctx, clustering_ctx, 
+                                   device_annotation, const_cast<const VprClusteringAnnotation&>(clustering_annotation), 
+                                   blk_ids[iblk], blk_nets[iblk], verbose);
+               });
+
+  /* Group clustered blocks by signatures. 
+   * The first clustered block of each group is the one to be routed
+   */
+  std::unordered_map<const t_repack_cluster_nets*, size_t,
+                     t_repack_cluster_signature_hash,
+                     t_repack_cluster_signature_equal> signature_routes;
+  std::vector<size_t> blk_routes(blk_ids.size());
+  std::vector<size_t> routed_blks;
+  for (size_t iblk = 0; iblk < blk_ids.size(); ++iblk) {
+    auto result = signature_routes.insert(std::make_pair(&(blk_nets[iblk]), routed_blks.size()));
+    if (true == result.second) {
+      routed_blks.push_back(iblk);
+    }
+    blk_routes[iblk] = result.first->second;
+  }
+
+  /* Route the clustered blocks with unique signatures */
+  std::vector<std::vector<std::vector<LbRRNodeId>>> route_results(routed_blks.size());
+  /* Use char rather than bool to avoid concurrent writes to a packed std::vector<bool> */
+  std::vector<char> route_success(routed_blks.size(), false);
+  parallel_for(routed_blks.size(), num_repack_threads,
+               [&](const size_t& iroute) {
+                 route_success[iroute] = route_cluster(atom_ctx, clustering_ctx, device_annotation,
+                                                       blk_ids[routed_blks[iroute]], blk_nets[routed_blks[iroute]],
+                                                       route_results[iroute], verbose);
+               });
+
+  /* Allocate a physical pb for each pb_graph_head, which is the template of physical pbs */
+  std::map<const t_pb_graph_node*, PhysicalPb> phy_pb_templates;
+  for (const t_repack_cluster_nets& cluster_nets : blk_nets) {
+    if (0 < phy_pb_templates.count(cluster_nets.pb_graph_head)) {
+      continue;
+    }
+    alloc_physical_pb_from_pb_graph(phy_pb_templates[cluster_nets.pb_graph_head],
+                                    cluster_nets.pb_graph_head, device_annotation);
+  }
+
+  /* Build physical pbs for clustered blocks which are routed successfully */
+  std::vector<PhysicalPb> phy_pbs(blk_ids.size());
+  parallel_for(blk_ids.size(), num_repack_threads,
+               [&](const size_t& iblk) {
+                 if (false == bool(route_success[blk_routes[iblk]])) {
+                   return;
+                 }
+                 build_cluster_physical_pb(atom_ctx, clustering_ctx, device_annotation,
+                                           blk_ids[iblk], blk_nets[iblk],
+                                           phy_pb_templates.at(blk_nets[iblk].pb_graph_head),
+                                           route_results[blk_routes[iblk]],
+                                           phy_pbs[iblk], verbose);
+               });
+
+  /* Merge the results in the order of clustered blocks */
+  for (size_t iblk = 0; iblk < blk_ids.size(); ++iblk) {
+    VTR_LOG("Repack clustered block '%s'...",
+            clustering_ctx.clb_nlist.block_name(blk_ids[iblk]).c_str());
+    if (false == bool(route_success[blk_routes[iblk]])) {
+      exit(1);
+    }
+    /* Add the pb to clustering context and release the local copy */
+    clustering_annotation.add_physical_pb(blk_ids[iblk], phy_pbs[iblk]);
+    phy_pbs[iblk] = PhysicalPb();
+
+    VTR_LOG("Done\n");
+  }
+
+  VTR_LOG("Reused routing results for %lu out of %lu clustered blocks (hit rate %.2f%%)\n",
+          blk_ids.size() - routed_blks.size(), blk_ids.size(),
+          blk_ids.empty() ? 0. : 100. * (blk_ids.size() - routed_blks.size()) / blk_ids.size());
 }
 
 /***************************************************************************************
@@ -480,6 +685,7 @@ void pack_physical_pbs(const DeviceContext& device_ctx,
                        const ClusteringContext& clustering_ctx,
                        VprDeviceAnnotation& device_annotation,
                        VprClusteringAnnotation& clustering_annotation,
+                       const size_t& num_threads,
                        const bool& verbose) {
 
   /* build the routing resource graph for each logical tile */
@@ -490,7 +696,7 @@ void pack_physical_pbs(const DeviceContext& device_ctx,
   /* Call the LbRouter to re-pack each clustered block to physical implementation */ 
   repack_clusters(atom_ctx, clustering_ctx, 
                   const_cast<const VprDeviceAnnotation&>(device_annotation), clustering_annotation, 
-                  verbose);
+                  num_threads, verbose);
 }
 
 } /* end namespace openfpga */
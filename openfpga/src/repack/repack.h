@@ -21,6 +21,7 @@ void pack_physical_pbs(const DeviceContext& device_ctx,
                        const ClusteringContext& clustering_ctx,
                        VprDeviceAnnotation& device_annotation,
                        VprClusteringAnnotation& clustering_annotation,
+                       const size_t& num_threads,
                        const bool& verbose);
 
 } /* end namespace openfpga */
@@ -437,7 +437,8 @@ bool module_net_is_local_wire(const ModuleManager& module_manager,
   /* Check all the sink modules of the net, 
    * if we have a source module is the current module, this is not local wire 
    */
-  for (ModuleId src_module : module_manager.net_source_modules(module_id, module_net)) {
+  for (ModuleNetSrcId net_src : module_manager.module_net_sources(module_id, module_net)) {
+    ModuleId src_module = module_manager.net_source_module(module_id, module_net, net_src);
     if (module_id == src_module) {
       /* Here, this is not a local wire */
       return false;
@@ -445,7 +446,8 @@ bool module_net_is_local_wire(const ModuleManager& module_manager,
   }
 
   /* Check all the sink modules of the net */
-  for (ModuleId sink_module : module_manager.net_sink_modules(module_id, module_net)) {
+  for (ModuleNetSinkId net_sink : module_manager.module_net_sinks(module_id, module_net)) {
+    ModuleId sink_module = module_manager.net_sink_module(module_id, module_net, net_sink);
     if (module_id == sink_module) {
       /* Here, this is not a local wire */
       return false;
@@ -474,7 +476,8 @@ bool module_net_include_output_short_connection(const ModuleManager& module_mana
                                                 const ModuleId& module_id, const ModuleNetId& module_net) {
   /* Check all the sink modules of the net */
   size_t contain_num_module_output = 0;
-  for (ModuleId sink_module : module_manager.net_sink_modules(module_id, module_net)) {
+  for (ModuleNetSinkId net_sink : module_manager.module_net_sinks(module_id, module_net)) {
+    ModuleId sink_module = module_manager.net_sink_module(module_id, module_net, net_sink);
     if (module_id == sink_module) {
       contain_num_module_output++;
     }
@@ -504,7 +507,8 @@ bool module_net_include_local_short_connection(const ModuleManager& module_manag
    * if we have a source module is the current module, this is not local wire 
    */
   bool contain_module_input = false;
-  for (ModuleId src_module : module_manager.net_source_modules(module_id, module_net)) {
+  for (ModuleNetSrcId net_src : module_manager.module_net_sources(module_id, module_net)) {
+    ModuleId src_module = module_manager.net_source_module(module_id, module_net, net_src);
     if (module_id == src_module) {
       contain_module_input = true;
       break;
@@ -513,7 +517,8 @@ bool module_net_include_local_short_connection(const ModuleManager& module_manag
 
   /* Check all the sink modules of the net */
   bool contain_module_output = false;
-  for (ModuleId sink_module : module_manager.net_sink_modules(module_id, module_net)) {
+  for (ModuleNetSinkId net_sink : module_manager.module_net_sinks(module_id, module_net)) {
+    ModuleId sink_module = module_manager.net_sink_module(module_id, module_net, net_sink);
     if (module_id == sink_module) {
       contain_module_output = true;
       break;
@@ -1759,6 +1764,34 @@ size_t find_module_num_config_bits_from_child_modules(ModuleManager& module_mana
   return num_config_bits;
 }
 
+/********************************************************************
+ * Find the number of memory modules in a configuration region
+ * of the top-level module, i.e., the configurable children 
+ * excluding the decoders which are added to the end of each region
+ * by the configuration protocol:
+ * - Memory bank: a BL decoder and a WL decoder for each region
+ * - Frame-based: a frame decoder if there are 2+ memory modules in a region,
+ *   which means that the region has at least 3 configurable children 
+ *******************************************************************/
+size_t find_top_module_region_num_memory_children(const ModuleManager& module_manager,
+                                                  const ModuleId& top_module,
+                                                  const ConfigRegionId& config_region,
+                                                  const e_config_protocol_type& sram_orgz_type) {
+  size_t num_children = module_manager.region_num_configurable_children(top_module, config_region);
+
+  if (CONFIG_MEM_MEMORY_BANK == sram_orgz_type) {
+    VTR_ASSERT(2 < num_children);
+    return num_children - 2;
+  }
+
+  if ( (CONFIG_MEM_FRAME_BASED == sram_orgz_type)
+    && (2 <= num_children) ) {
+    return num_children - 1;
+  }
+
+  return num_children;
+}
+
 /********************************************************************
  * Try to create a net for the source pin
  * This function will try
@@ -0,0 +1,105 @@
+/********************************************************************
+ * This file includes functions to run independent tasks 
+ * on a pool of worker threads
+ *
+ * Tasks are dispatched by index, so the caller can store the results
+ * of each task in a pre-allocated container and merge them in 
+ * a deterministic order once all the tasks are finished
+ *******************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "openfpga_parallel_utils.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Find the number of threads to use from a user-defined number
+ * - A positive number is used as it is
+ * - Zero or a negative number means using all the hardware threads
+ *   that are available on the machine
+ *******************************************************************/
+size_t find_num_parallel_threads(const int& num_threads) {
+  if (0 < num_threads) {
+    return (size_t)num_threads;
+  }
+
+  size_t num_hw_threads = std::thread::hardware_concurrency();
+  /* The hardware concurrency may be unknown */
+  if (0 == num_hw_threads) {
+    return 1;
+  }
+  return num_hw_threads;
+}
+
+/********************************************************************
+ * Run a task for each index in the range [0, num_tasks) 
+ * with a given number of threads
+ *
+ * The tasks are picked dynamically by the worker threads,
+ * which balances the load when the runtime of each task differs a lot.
+ * The task function must only write to data owned by its index.
+ *
+ * When the number of threads is 1, all the tasks are executed
+ * in the calling thread in the ascending order of indices
+ *
+ * The first exception thrown by a task is re-thrown 
+ * in the calling thread after all the workers are joined
+ *******************************************************************/
+void parallel_for(const size_t& num_tasks,
+                  const size_t& num_threads,
+                  const std::function<void(const size_t&)>& task) {
+  if ((1 >= num_threads) || (1 >= num_tasks)) {
+    for (size_t itask = 0; itask < num_tasks; ++itask) {
+      task(itask);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next_task(0);
+  std::exception_ptr task_error = nullptr;
+  std::mutex task_error_mutex;
+
+  auto worker = [&]() {
+    while (true) {
+      size_t itask = next_task.fetch_add(1);
+      if (itask >= num_tasks) {
+        return;
+      }
+      try {
+        task(itask);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(task_error_mutex);
+        if (nullptr == task_error) {
+          task_error = std::current_exception();
+        }
+        /* Stop dispatching the remaining tasks */
+        next_task = num_tasks;
+      }
+    }
+  };
+
+  size_t num_workers = std::min(num_threads, num_tasks);
+  std::vector<std::thread> workers;
+  workers.reserve(num_workers - 1);
+  for (size_t iworker = 0; iworker < num_workers - 1; ++iworker) {
+    workers.emplace_back(worker);
+  }
+  /* The calling thread also works on the tasks */
+  worker();
+
+  for (std::thread& curr_worker : workers) {
+    curr_worker.join();
+  }
+
+  if (nullptr != task_error) {
+    std::rethrow_exception(task_error);
+  }
+}
+
+} /* end namespace openfpga */
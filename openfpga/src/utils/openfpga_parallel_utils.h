@@ -0,0 +1,25 @@
+#ifndef OPENFPGA_PARALLEL_UTILS_H
+#define OPENFPGA_PARALLEL_UTILS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstddef>
+#include <functional>
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+size_t find_num_parallel_threads(const int& num_threads);
+
+void parallel_for(const size_t& num_tasks,
+                  const size_t& num_threads,
+                  const std::function<void(const size_t&)>& task);
+
+} /* end namespace openfpga */
+
+#endif
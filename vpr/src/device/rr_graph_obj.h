@@ -576,6 +576,14 @@ class RRGraph {
   public:                                        /* Echos */
     void print_node(const RRNodeId& node) const; /* Print the detailed information of a node */
 
+  public: /* Fast look-up */
+    /* Build the fast look-up for nodes if it is not ready
+     * The fast look-up is built on the first call to accessors like find_node(),
+     * which is not thread-safe. 
+     * Call this function before the RRGraph is accessed by multiple threads
+     */
+    void initialize_fast_node_lookup() const;
+
   public: /* Public Validators */
     /* Check data structure for internal consistency
      * This function will 
@@ -825,7 +833,6 @@ class RRGraph {
     void build_fast_node_lookup() const;
     void invalidate_fast_node_lookup() const;
     bool valid_fast_node_lookup() const;
-    void initialize_fast_node_lookup() const;
 
     /* Graph property Validation */
     bool validate_sizes() const;
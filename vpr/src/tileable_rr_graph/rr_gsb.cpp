@@ -4,6 +4,7 @@
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "vtr_hash.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_side_manager.h"
@@ -585,6 +586,112 @@ bool RRGSB::is_sb_mirror(const RRGraph& rr_graph, const RRGSB& cand) const {
   return true;
 }
 
+/************************************************************************
+ * Get a fingerprint of the switch block
+ * The fingerprint covers exactly what is_sb_mirror() checks:
+ * - the number of sides
+ * - the channel width of each side
+ * - the number of opin/ipin nodes of each side, if the channel width is not zero
+ * - the directionality of each routing track
+ * - for each output routing track, if it is a passing wire
+ *   and, if not, the node type, switch, side and index of each driver
+ *
+ * Note that segment ids are not checked by is_sb_mirror() 
+ * and therefore must not be a part of the fingerprint
+ ***********************************************************************/
+size_t RRGSB::get_sb_fingerprint(const RRGraph& rr_graph) const {
+  size_t fingerprint = 0;
+
+  vtr::hash_combine(fingerprint, get_num_sides());
+
+  for (size_t side = 0; side < get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    e_side curr_side = side_manager.get_side();
+
+    vtr::hash_combine(fingerprint, get_chan_width(curr_side));
+    if (0 == get_chan_width(curr_side)) {
+      continue;
+    }
+    vtr::hash_combine(fingerprint, get_num_opin_nodes(curr_side));
+    vtr::hash_combine(fingerprint, get_num_ipin_nodes(curr_side));
+
+    for (size_t itrack = 0; itrack < get_chan_width(curr_side); ++itrack) {
+      vtr::hash_combine(fingerprint, size_t(get_chan_node_direction(curr_side, itrack)));
+      /* Only drivers of output tracks are checked */
+      if (OUT_PORT != get_chan_node_direction(curr_side, itrack)) {
+        continue;
+      }
+      bool is_short_conkt = is_sb_node_passing_wire(rr_graph, curr_side, itrack);
+      vtr::hash_combine(fingerprint, is_short_conkt);
+      if (true == is_short_conkt) {
+        continue;
+      }
+      std::vector<RREdgeId> node_in_edges = get_chan_node_in_edges(rr_graph, curr_side, itrack);
+      vtr::hash_combine(fingerprint, node_in_edges.size());
+      for (const RREdgeId& edge : node_in_edges) {
+        RRNodeId src_node = rr_graph.edge_src_node(edge);
+        int src_node_id;
+        enum e_side src_node_side; 
+        get_node_side_and_index(rr_graph, src_node, OUT_PORT, src_node_side, src_node_id);
+        vtr::hash_combine(fingerprint, size_t(rr_graph.node_type(src_node)));
+        vtr::hash_combine(fingerprint, size_t(rr_graph.edge_switch(edge)));
+        vtr::hash_combine(fingerprint, size_t(src_node_side));
+        vtr::hash_combine(fingerprint, src_node_id);
+      }
+    }
+  }
+
+  return fingerprint;
+}
+
+/************************************************************************
+ * Get a fingerprint of the connection block
+ * The fingerprint covers exactly what is_cb_mirror() checks:
+ * - the channel width
+ * - the node type, directionality and segment of each routing track 
+ * - the number of ipin nodes of each side
+ * - for each ipin node, the node type, switch and index of each driver
+ ***********************************************************************/
+size_t RRGSB::get_cb_fingerprint(const RRGraph& rr_graph, const t_rr_type& cb_type) const {
+  size_t fingerprint = 0;
+
+  vtr::hash_combine(fingerprint, get_cb_chan_width(cb_type));
+
+  enum e_side chan_side = get_cb_chan_side(cb_type);
+  const RRChan& chan = chan_node_[size_t(chan_side)];
+  vtr::hash_combine(fingerprint, size_t(chan.get_type()));
+  for (size_t inode = 0; inode < chan.get_chan_width(); ++inode) {
+    vtr::hash_combine(fingerprint, size_t(rr_graph.node_type(chan.get_node(inode))));
+    vtr::hash_combine(fingerprint, size_t(rr_graph.node_direction(chan.get_node(inode))));
+    vtr::hash_combine(fingerprint, size_t(chan.get_node_segment(inode)));
+  }
+
+  for (const e_side& ipin_side : get_cb_ipin_sides(cb_type)) {
+    vtr::hash_combine(fingerprint, get_num_ipin_nodes(ipin_side));
+    for (size_t inode = 0; inode < get_num_ipin_nodes(ipin_side); ++inode) {
+      RRNodeId node = get_ipin_node(ipin_side, inode);
+      vtr::hash_combine(fingerprint, rr_graph.node_in_edges(node).size());
+      for (const RREdgeId& edge : rr_graph.node_in_edges(node)) {
+        RRNodeId src_node = rr_graph.edge_src_node(edge);
+        vtr::hash_combine(fingerprint, size_t(rr_graph.node_type(src_node)));
+        vtr::hash_combine(fingerprint, size_t(rr_graph.edge_switch(edge)));
+        int src_node_id = -1;
+        enum e_side src_node_side = NUM_SIDES; 
+        if (OPIN == rr_graph.node_type(src_node)) {
+          get_node_side_and_index(rr_graph, src_node, OUT_PORT, src_node_side, src_node_id);
+        } else {
+          /* Routing tracks are found in the channel of the connection block */
+          src_node_id = get_chan_node_index(chan_side, src_node);
+        }
+        vtr::hash_combine(fingerprint, size_t(src_node_side));
+        vtr::hash_combine(fingerprint, src_node_id);
+      }
+    }
+  }
+
+  return fingerprint;
+}
+
 /* Public Accessors: Cooridinator conversion */
 
 /* get the x coordinate of this GSB */
@@ -167,6 +167,18 @@ class RRGSB {
      */
     bool is_sb_mirror(const RRGraph& rr_graph, const RRGSB& cand) const; 
 
+    /* Get a fingerprint of the switch block, which hashes all the features checked by is_sb_mirror()
+     * If two switch blocks are mirrors, their fingerprints must be the same.
+     * Different fingerprints can be used to quickly rule out mirrors
+     * before running a full check with is_sb_mirror()
+     */
+    size_t get_sb_fingerprint(const RRGraph& rr_graph) const;
+
+    /* Get a fingerprint of the connection block, which hashes all the features checked by is_cb_mirror()
+     * If two connection blocks are mirrors, their fingerprints must be the same.
+     */
+    size_t get_cb_fingerprint(const RRGraph& rr_graph, const t_rr_type& cb_type) const;
+
   public: /* Cooridinator conversion and output  */
     size_t get_x() const; /* get the x coordinate of this switch block */
     size_t get_y() const; /* get the y coordinate of this switch block */